@@ -0,0 +1,268 @@
+#include "BenchHarness.hpp"
+
+#include "wayland/Server.hpp"
+#include "wayland/Output.hpp"
+#include "wayland/WaylandTypes.hpp"
+#include "ui/CompositorState.hpp"
+#include "config/ConfigParser.hpp"
+#include "core/AllocationCounter.hpp"
+#include "Logger.hpp"
+
+#include <sys/resource.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <numeric>
+
+namespace Leviathan {
+namespace Bench {
+
+namespace {
+
+uint64_t ClockNs(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+long CurrentRssKb() {
+    long pages = 0;
+    long resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm) {
+        if (fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        fclose(statm);
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+long PeakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+double Percentile(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)] / 1e6;
+}
+
+void FindHeadless(struct wlr_backend* backend, void* data) {
+    if (wlr_backend_is_headless(backend)) {
+        *static_cast<struct wlr_backend**>(data) = backend;
+    }
+}
+
+} // namespace
+
+BenchHarness::BenchHarness() {
+}
+
+BenchHarness::~BenchHarness() {
+    Wayland::OutputManager::SetFrameObserver(nullptr);
+    clients_.clear();
+
+    if (server_) {
+        UI::SetCompositorState(nullptr);
+        delete server_;
+        server_ = nullptr;
+    }
+
+    if (!runtime_dir_.empty()) {
+        rmdir(runtime_dir_.c_str());
+    }
+}
+
+bool BenchHarness::Initialize() {
+    // Private runtime dir: the Wayland and IPC sockets must not collide with
+    // (or unlink) the ones of a compositor running in this session
+    char runtime_template[] = "/tmp/leviathan-bench-XXXXXX";
+    if (!mkdtemp(runtime_template)) {
+        fprintf(stderr, "leviathan-bench: failed to create runtime dir\n");
+        return false;
+    }
+    runtime_dir_ = runtime_template;
+    setenv("XDG_RUNTIME_DIR", runtime_dir_.c_str(), 1);
+
+    // Headless backend, no input devices. Software rendering unless the
+    // caller picked a renderer (WLR_RENDERER=gles2 to cover DMA-BUF import)
+    setenv("WLR_BACKENDS", "headless", 1);
+    setenv("WLR_RENDERER", "pixman", 0);
+    setenv("WLR_LIBINPUT_NO_DEVICES", "1", 1);
+    unsetenv("WAYLAND_DISPLAY");
+    unsetenv("DISPLAY");
+
+    // The notification daemon would claim the session bus name
+    Config().notifications.enabled = false;
+
+    // Initialization reports success on stdout, which carries the JSON report
+    std::streambuf* stdout_buffer = std::cout.rdbuf(nullptr);
+    server_ = Wayland::Server::Create();
+    std::cout.rdbuf(stdout_buffer);
+    if (!server_) {
+        fprintf(stderr, "leviathan-bench: failed to create compositor\n");
+        return false;
+    }
+    UI::SetCompositorState(server_);
+
+    Wayland::OutputManager::SetFrameObserver([this](Wayland::Output*, uint64_t render_ns) {
+        OnFrame(render_ns);
+    });
+
+    if (!server_->Start()) {
+        fprintf(stderr, "leviathan-bench: failed to start compositor\n");
+        return false;
+    }
+
+    struct wlr_backend* headless = nullptr;
+    if (wlr_backend_is_multi(server_->GetBackend())) {
+        wlr_multi_for_each_backend(server_->GetBackend(), FindHeadless, &headless);
+    } else if (wlr_backend_is_headless(server_->GetBackend())) {
+        headless = server_->GetBackend();
+    }
+    if (!headless || !wlr_headless_add_output(headless, OUTPUT_WIDTH, OUTPUT_HEIGHT)) {
+        fprintf(stderr, "leviathan-bench: headless backend unavailable\n");
+        return false;
+    }
+
+    Settle();
+    if (!GetOutput()) {
+        fprintf(stderr, "leviathan-bench: headless output was not set up\n");
+        return false;
+    }
+    return true;
+}
+
+Wayland::Output* BenchHarness::GetOutput() {
+    return server_ ? server_->GetFirstOutput() : nullptr;
+}
+
+SyntheticClient* BenchHarness::ConnectClient() {
+    auto client = SyntheticClient::Connect(server_->GetDisplay());
+    if (!client) {
+        return nullptr;
+    }
+
+    // Registry round trip
+    for (int i = 0; i < 100 && !client->IsReady() && client->IsConnected(); i++) {
+        client->Flush();
+        Pump(1);
+        client->Dispatch();
+    }
+    if (!client->IsReady()) {
+        return nullptr;
+    }
+
+    clients_.push_back(std::move(client));
+    return clients_.back().get();
+}
+
+void BenchHarness::DisconnectAll() {
+    clients_.clear();
+    Settle();
+}
+
+bool BenchHarness::OpenWindows(SyntheticClient* client, int count, const std::string& app_id) {
+    for (int i = 0; i < count; i++) {
+        if (!client->CreateWindow(app_id)) {
+            return false;
+        }
+    }
+
+    // Each map relayouts the tag, so give the compositor time to catch up
+    for (int i = 0; i < 1000; i++) {
+        Pump(1);
+        bool all_mapped = std::all_of(client->GetWindows().begin(), client->GetWindows().end(),
+                                      [](const std::unique_ptr<SyntheticWindow>& window) { return window->IsMapped(); });
+        if (all_mapped) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BenchHarness::Pump(int timeout_ms) {
+    for (auto& client : clients_) {
+        client->Flush();
+    }
+
+    server_->DispatchOnce(timeout_ms);
+    wl_display_flush_clients(server_->GetDisplay());
+
+    for (auto& client : clients_) {
+        client->Dispatch();
+    }
+}
+
+bool BenchHarness::PumpFrame(int timeout_ms) {
+    uint64_t start_frames = frame_count_;
+    uint64_t deadline = ClockNs(CLOCK_MONOTONIC) + static_cast<uint64_t>(timeout_ms) * 1000000ULL;
+
+    while (frame_count_ == start_frames) {
+        if (ClockNs(CLOCK_MONOTONIC) >= deadline) {
+            return false;
+        }
+        Pump(1);
+    }
+    return true;
+}
+
+void BenchHarness::Settle(int frames) {
+    for (int i = 0; i < frames; i++) {
+        PumpFrame();
+    }
+}
+
+void BenchHarness::BeginMeasure() {
+    // Reserved up front so recording samples does not show up as allocations
+    frame_samples_ns_.clear();
+    frame_samples_ns_.reserve(4096);
+    measuring_ = true;
+    measure_start_ns_ = ClockNs(CLOCK_MONOTONIC);
+    measure_cpu_start_ns_ = ClockNs(CLOCK_PROCESS_CPUTIME_ID);
+    measure_alloc_start_ = Core::GetAllocationCount();
+    measure_alloc_bytes_start_ = Core::GetAllocatedBytes();
+}
+
+ScenarioResult BenchHarness::EndMeasure(const std::string& name, int iterations) {
+    ScenarioResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.wall_ms = (ClockNs(CLOCK_MONOTONIC) - measure_start_ns_) / 1e6;
+    result.cpu_ms = (ClockNs(CLOCK_PROCESS_CPUTIME_ID) - measure_cpu_start_ns_) / 1e6;
+    result.allocations = Core::GetAllocationCount() - measure_alloc_start_;
+    result.allocated_bytes = Core::GetAllocatedBytes() - measure_alloc_bytes_start_;
+    result.rss_kb = CurrentRssKb();
+    result.peak_rss_kb = PeakRssKb();
+    measuring_ = false;
+
+    std::vector<uint64_t> sorted = frame_samples_ns_;
+    std::sort(sorted.begin(), sorted.end());
+    result.frames = sorted.size();
+    result.frame_p50_ms = Percentile(sorted, 0.50);
+    result.frame_p99_ms = Percentile(sorted, 0.99);
+    result.frame_max_ms = sorted.empty() ? 0.0 : sorted.back() / 1e6;
+    if (!sorted.empty()) {
+        uint64_t total = std::accumulate(sorted.begin(), sorted.end(), uint64_t{0});
+        result.frame_mean_ms = total / 1e6 / sorted.size();
+    }
+    return result;
+}
+
+void BenchHarness::OnFrame(uint64_t render_ns) {
+    frame_count_++;
+    if (measuring_) {
+        frame_samples_ns_.push_back(render_ns);
+    }
+}
+
+} // namespace Bench
+} // namespace Leviathan
@@ -0,0 +1,101 @@
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+
+#include "SyntheticClient.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Leviathan {
+namespace Wayland {
+    class Server;
+    struct Output;
+}
+
+namespace Bench {
+
+/**
+ * Measurements for one scenario run (the measured steps only, not setup)
+ */
+struct ScenarioResult {
+    std::string name;
+    int iterations = 0;
+    size_t frames = 0;             // Output frames rendered during the run
+    double frame_p50_ms = 0.0;     // Render + commit time per frame
+    double frame_p99_ms = 0.0;
+    double frame_max_ms = 0.0;
+    double frame_mean_ms = 0.0;
+    double wall_ms = 0.0;
+    double cpu_ms = 0.0;           // Process CPU time (user + system)
+    long rss_kb = 0;               // Resident set at the end of the run
+    long peak_rss_kb = 0;          // High-water mark of the process so far
+    uint64_t allocations = 0;      // operator new calls
+    uint64_t allocated_bytes = 0;
+    std::map<std::string, double> counters;  // Scenario-specific measurements
+    std::string error;             // Set when a scenario's own checks failed
+};
+
+/**
+ * Runs a Server on the headless backend (pixman renderer unless WLR_RENDERER
+ * says otherwise) and drives
+ * it together with in-process synthetic clients from a single thread.
+ */
+class BenchHarness {
+public:
+    static constexpr int OUTPUT_WIDTH = 1920;
+    static constexpr int OUTPUT_HEIGHT = 1080;
+
+    BenchHarness();
+    ~BenchHarness();
+
+    // Create the compositor and its headless output
+    bool Initialize();
+
+    Wayland::Server* GetServer() { return server_; }
+    Wayland::Output* GetOutput();
+
+    // New client connection (globals already bound); nullptr on failure
+    SyntheticClient* ConnectClient();
+    void DisconnectAll();
+    const std::vector<std::unique_ptr<SyntheticClient>>& GetClients() const { return clients_; }
+
+    // Open count windows on one client and wait until they are mapped
+    bool OpenWindows(SyntheticClient* client, int count, const std::string& app_id);
+
+    // One round trip of the loop: clients -> server -> clients
+    void Pump(int timeout_ms = 0);
+
+    // Pump until the output has rendered another frame (or timeout_ms passed)
+    bool PumpFrame(int timeout_ms = 100);
+
+    // Pump for a while so configures, maps and relayouts settle
+    void Settle(int frames = 3);
+
+    // Measurement window around a scenario's steps
+    void BeginMeasure();
+    ScenarioResult EndMeasure(const std::string& name, int iterations);
+
+private:
+    void OnFrame(uint64_t render_ns);
+
+    Wayland::Server* server_ = nullptr;
+    std::string runtime_dir_;
+    std::vector<std::unique_ptr<SyntheticClient>> clients_;
+
+    uint64_t frame_count_ = 0;
+    bool measuring_ = false;
+    std::vector<uint64_t> frame_samples_ns_;
+
+    uint64_t measure_start_ns_ = 0;
+    uint64_t measure_cpu_start_ns_ = 0;
+    uint64_t measure_alloc_start_ = 0;
+    uint64_t measure_alloc_bytes_start_ = 0;
+};
+
+} // namespace Bench
+} // namespace Leviathan
+
+#endif // BENCH_HARNESS_HPP
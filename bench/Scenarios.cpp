@@ -0,0 +1,660 @@
+#include "Scenarios.hpp"
+#include "BenchHarness.hpp"
+
+#include "wayland/Server.hpp"
+#include "wayland/Output.hpp"
+#include "wayland/LayerManager.hpp"
+#include "ui/menubar/MenuBarManager.hpp"
+#include "ipc/IPC.hpp"
+#include "core/SpawnHelper.hpp"
+#include "Types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <poll.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Leviathan {
+namespace Bench {
+
+namespace {
+
+constexpr int TAG_COUNT = 9;
+
+Wayland::LayerManager* FocusedLayerManager(BenchHarness& harness) {
+    auto* server = harness.GetServer();
+    return server->GetLayerManagerForScreen(server->GetFocusedScreen());
+}
+
+// Open count windows spread over clients of per_client windows each
+bool OpenSpread(BenchHarness& harness, int count, int per_client, const std::string& app_id) {
+    while (count > 0) {
+        SyntheticClient* client = harness.ConnectClient();
+        int batch = count < per_client ? count : per_client;
+        if (!client || !harness.OpenWindows(client, batch, app_id)) {
+            return false;
+        }
+        count -= batch;
+    }
+    harness.Settle();
+    return true;
+}
+
+/**
+ * Rapid tag switching with a few windows on every tag
+ */
+class TagSwitchStorm : public Scenario {
+public:
+    const char* GetName() const override { return "tag-switch-storm"; }
+    const char* GetDescription() const override { return "switch between 9 tags holding 4 windows each, one switch per frame"; }
+
+    bool Setup(BenchHarness& harness) override {
+        for (int tag = 0; tag < TAG_COUNT; tag++) {
+            harness.GetServer()->SwitchToTag(tag);
+            harness.Settle(1);
+            if (!OpenSpread(harness, 4, 4, "bench-tag-" + std::to_string(tag + 1))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        harness.GetServer()->SwitchToTag(iteration % TAG_COUNT);
+    }
+};
+
+/**
+ * Many windows on one tag, retiled every frame
+ */
+class Relayout500 : public Scenario {
+public:
+    const char* GetName() const override { return "relayout-500"; }
+    const char* GetDescription() const override { return "500 windows on one tag, alternating layout and master ratio every frame"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        return OpenSpread(harness, 500, 50, "bench-relayout");
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        auto* layer_manager = FocusedLayerManager(harness);
+        if (!layer_manager) {
+            return;
+        }
+        switch (iteration % 4) {
+        case 0: layer_manager->SetLayout(LayoutType::GRID); break;
+        case 1: layer_manager->SetLayout(LayoutType::MASTER_STACK); break;
+        case 2: layer_manager->IncreaseMasterRatio(); break;
+        case 3: layer_manager->DecreaseMasterRatio(); break;
+        }
+    }
+
+    void Teardown(BenchHarness& harness) override {
+        if (auto* layer_manager = FocusedLayerManager(harness)) {
+            layer_manager->SetLayout(LayoutType::MASTER_STACK);
+        }
+        Scenario::Teardown(harness);
+    }
+};
+
+/**
+ * Every window retitles itself every frame (terminals, media players)
+ */
+class TitleSpam : public Scenario {
+public:
+    const char* GetName() const override { return "title-spam"; }
+    const char* GetDescription() const override { return "20 windows each setting a new title every frame"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        return OpenSpread(harness, 20, 10, "bench-title");
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        int index = 0;
+        for (const auto& client : harness.GetClients()) {
+            for (const auto& window : client->GetWindows()) {
+                window->SetTitle("bench " + std::to_string(index++) + " - frame " + std::to_string(iteration));
+            }
+        }
+    }
+};
+
+/**
+ * Windows committing damage at a steady rate (video, animations)
+ */
+class DamageCommits : public Scenario {
+public:
+    const char* GetName() const override { return "damage-commits"; }
+    const char* GetDescription() const override { return "30 windows, 10 damaging a 64x64 region every frame and 20 every other frame"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        return OpenSpread(harness, 30, 10, "bench-damage");
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        int index = 0;
+        for (const auto& client : harness.GetClients()) {
+            for (const auto& window : client->GetWindows()) {
+                // The first ten run at the output rate, the rest at half of it
+                if (index < 10 || (iteration + index) % 2 == 0) {
+                    int span_x = window->GetWidth() > 64 ? window->GetWidth() - 64 : 1;
+                    int span_y = window->GetHeight() > 64 ? window->GetHeight() - 64 : 1;
+                    window->CommitDamage((iteration * 7) % span_x, (iteration * 5) % span_y, 64, 64);
+                }
+                index++;
+            }
+        }
+    }
+};
+
+/**
+ * SHM and DMA-BUF windows committing side by side. Besides timing both upload
+ * paths, this checks that get_clients counts every commit under the right
+ * buffer type. The DMA-BUF half needs /dev/udmabuf and a renderer that
+ * imports DMA-BUFs (WLR_RENDERER=gles2); without them only SHM is checked.
+ */
+class BufferImport : public Scenario {
+public:
+    const char* GetName() const override { return "buffer-import"; }
+    const char* GetDescription() const override { return "one SHM and one DMA-BUF window committing every frame, checking shm/dmabuf_commits"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        server_ = harness.GetServer();
+        SyntheticClient* client = harness.ConnectClient();
+        if (!client || !harness.OpenWindows(client, 1, SHM_APP_ID) || !harness.OpenWindows(client, 1, DMABUF_APP_ID)) {
+            return false;
+        }
+        harness.Settle();
+
+        shm_window_ = client->GetWindows()[0].get();
+        dmabuf_window_ = client->GetWindows()[1].get();
+        dmabuf_available_ = dmabuf_window_->SetBufferType(BufferType::Dmabuf);
+        harness.Settle();
+        if (!client->IsConnected()) {
+            return false;  // The compositor rejected the DMA-BUF it advertised
+        }
+
+        shm_start_ = ReadCommits(SHM_APP_ID);
+        dmabuf_start_ = ReadCommits(DMABUF_APP_ID);
+        shm_sent_ = 0;
+        dmabuf_sent_ = 0;
+        return true;
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        int x = (iteration * 7) % 256;
+        int y = (iteration * 5) % 256;
+        if (shm_window_->IsMapped()) {
+            shm_window_->CommitDamage(x, y, 64, 64);
+            shm_sent_++;
+        }
+        if (dmabuf_window_->IsMapped()) {
+            dmabuf_window_->CommitDamage(x, y, 64, 64);
+            (dmabuf_available_ ? dmabuf_sent_ : shm_sent_)++;
+        }
+    }
+
+    void Report(ScenarioResult& result) const override {
+        Commits shm = ReadCommits(SHM_APP_ID) - shm_start_;
+        Commits dmabuf = ReadCommits(DMABUF_APP_ID) - dmabuf_start_;
+        result.counters["dmabuf_available"] = dmabuf_available_ ? 1.0 : 0.0;
+        result.counters["shm_commits"] = static_cast<double>(shm.shm + dmabuf.shm);
+        result.counters["dmabuf_commits"] = static_cast<double>(shm.dmabuf + dmabuf.dmabuf);
+
+        if (shm.shm + dmabuf.shm != shm_sent_ || shm.dmabuf + dmabuf.dmabuf != dmabuf_sent_) {
+            result.error = "committed " + std::to_string(shm_sent_) + " SHM / " + std::to_string(dmabuf_sent_) +
+                           " DMA-BUF buffers, get_clients counted " + std::to_string(shm.shm + dmabuf.shm) + " / " +
+                           std::to_string(shm.dmabuf + dmabuf.dmabuf);
+        } else if (shm.dmabuf != 0 || (dmabuf_available_ && dmabuf.shm != 0)) {
+            result.error = "a commit was counted under the other buffer type";
+        }
+    }
+
+    void Teardown(BenchHarness& harness) override {
+        shm_window_ = nullptr;
+        dmabuf_window_ = nullptr;
+        Scenario::Teardown(harness);
+    }
+
+private:
+    static constexpr const char* SHM_APP_ID = "bench-import-shm";
+    static constexpr const char* DMABUF_APP_ID = "bench-import-dmabuf";
+
+    struct Commits {
+        uint64_t shm = 0;
+        uint64_t dmabuf = 0;
+
+        Commits operator-(const Commits& other) const { return {shm - other.shm, dmabuf - other.dmabuf}; }
+    };
+
+    // Through IPC, so the reported fields are what gets checked
+    Commits ReadCommits(const std::string& app_id) const {
+        Commits commits;
+        IPC::Response response = server_->ProcessIPCCommand("{\"command\":\"get_clients\"}");
+        for (const auto& info : response.clients) {
+            if (info.app_id == app_id) {
+                commits.shm += info.shm_commits;
+                commits.dmabuf += info.dmabuf_commits;
+            }
+        }
+        return commits;
+    }
+
+    Wayland::Server* server_ = nullptr;
+    SyntheticWindow* shm_window_ = nullptr;
+    SyntheticWindow* dmabuf_window_ = nullptr;
+    bool dmabuf_available_ = false;
+    Commits shm_start_;
+    Commits dmabuf_start_;
+    uint64_t shm_sent_ = 0;
+    uint64_t dmabuf_sent_ = 0;
+};
+
+/**
+ * The adaptive sync / tearing policy following a window in and out of
+ * fullscreen and toggling its tearing hint. The output runs with
+ * adaptive_sync: auto and allow_tearing; at the end of every phase the
+ * get_outputs sync fields are checked against what the policy must report.
+ * Whether the backend accepts VRR or async flips is counted, not required.
+ */
+class SyncPolicy : public Scenario {
+public:
+    const char* GetName() const override { return "sync-policy"; }
+    const char* GetDescription() const override { return "toggle fullscreen and the tearing hint every 8 frames, checking get_outputs sync fields"; }
+
+    bool Setup(BenchHarness& harness) override {
+        output_ = harness.GetOutput();
+        if (!output_) {
+            return false;
+        }
+        saved_sync_ = output_->sync;
+        output_->sync.adaptive_sync = AdaptiveSyncMode::AUTO;
+        output_->sync.allow_tearing = true;
+
+        harness.GetServer()->SwitchToTag(0);
+        SyntheticClient* client = harness.ConnectClient();
+        if (!client || !harness.OpenWindows(client, 1, "bench-sync")) {
+            return false;
+        }
+        window_ = client->GetWindows()[0].get();
+        server_ = harness.GetServer();
+        errors_.clear();
+        checks_ = 0;
+        vrr_accepted_ = 0;
+        tearing_accepted_ = 0;
+        return window_->SetTearingHint(false);
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        int phase = (iteration / PHASE_STEPS) % 4;
+        int step = iteration % PHASE_STEPS;
+        bool fullscreen = phase == 1 || phase == 2;
+        bool async = phase >= 2;
+
+        if (step == 0) {
+            window_->SetFullscreen(fullscreen);
+            window_->SetTearingHint(async);
+        } else if (step == PHASE_STEPS - 1) {
+            Check(fullscreen, async);
+        }
+        // Keep frames coming: the policy is applied when a frame is committed
+        window_->CommitDamage(0, 0, 64, 64);
+    }
+
+    void Report(ScenarioResult& result) const override {
+        result.counters["checks"] = static_cast<double>(checks_);
+        result.counters["vrr_accepted"] = static_cast<double>(vrr_accepted_);
+        result.counters["tearing_accepted"] = static_cast<double>(tearing_accepted_);
+        result.error = errors_;
+    }
+
+    void Teardown(BenchHarness& harness) override {
+        if (output_) {
+            output_->sync = saved_sync_;
+        }
+        window_ = nullptr;
+        Scenario::Teardown(harness);
+    }
+
+private:
+    static constexpr int PHASE_STEPS = 8;
+
+    void Check(bool fullscreen, bool async) {
+        IPC::Response response = server_->ProcessIPCCommand("{\"command\":\"get_outputs\"}");
+        for (const auto& info : response.outputs) {
+            if (info.name != output_->wlr_output->name) {
+                continue;
+            }
+            checks_++;
+            vrr_accepted_ += info.adaptive_sync_active ? 1 : 0;
+            tearing_accepted_ += info.tearing_active ? 1 : 0;
+
+            std::string phase = std::string(fullscreen ? "fullscreen" : "windowed") + (async ? "+async" : "");
+            if (info.adaptive_sync != "auto" || !info.tearing_allowed) {
+                AddError(phase + ": monitor sync config not reported");
+            }
+            if (info.adaptive_sync_wanted != fullscreen) {
+                AddError(phase + ": adaptive_sync_wanted is " + (info.adaptive_sync_wanted ? "true" : "false"));
+            }
+            if (info.adaptive_sync_active && !info.adaptive_sync_wanted) {
+                AddError(phase + ": adaptive sync left on");
+            }
+            if (info.tearing_active && !(fullscreen && async)) {
+                AddError(phase + ": tearing without a fullscreen async hint");
+            }
+            return;
+        }
+        AddError("output missing from get_outputs");
+    }
+
+    void AddError(const std::string& error) {
+        // First occurrence of each, the phases repeat
+        if (errors_.find(error) == std::string::npos) {
+            errors_ += errors_.empty() ? error : "; " + error;
+        }
+    }
+
+    Wayland::Server* server_ = nullptr;
+    Wayland::Output* output_ = nullptr;
+    Wayland::OutputSync saved_sync_;
+    SyntheticWindow* window_ = nullptr;
+    std::string errors_;
+    uint64_t checks_ = 0;
+    uint64_t vrr_accepted_ = 0;
+    uint64_t tearing_accepted_ = 0;
+};
+
+/**
+ * Screen capture of the output every frame, as a screen sharing client does.
+ *
+ * Compare against the same workload without capture (damage-commits for the
+ * busy case) to get the capture overhead.
+ */
+class CaptureScenario : public Scenario {
+public:
+    bool Setup(BenchHarness& harness) override {
+        SyntheticClient* client = harness.ConnectClient();
+        capture_ = client ? client->StartCapture() : nullptr;
+        if (!capture_) {
+            return false;
+        }
+
+        // Session constraints, then one full frame so the measured ones are incremental
+        for (int i = 0; i < 100 && !capture_->IsReady(); i++) {
+            harness.Pump(1);
+        }
+        capture_->RequestFrame();
+        for (int i = 0; i < 10 && capture_->IsFrameInFlight(); i++) {
+            harness.PumpFrame();
+        }
+        if (!capture_->IsReady() || capture_->GetFrames() == 0) {
+            return false;
+        }
+
+        start_frames_ = capture_->GetFrames();
+        start_failed_ = capture_->GetFailedFrames();
+        start_damaged_ = capture_->GetDamagedPixels();
+        return true;
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        capture_->RequestFrame();
+    }
+
+    void Report(ScenarioResult& result) const override {
+        double frames = static_cast<double>(capture_->GetFrames() - start_frames_);
+        double damaged = static_cast<double>(capture_->GetDamagedPixels() - start_damaged_);
+        double output_pixels = static_cast<double>(capture_->GetWidth()) * capture_->GetHeight();
+        result.counters["captured_frames"] = frames;
+        result.counters["failed_captures"] = static_cast<double>(capture_->GetFailedFrames() - start_failed_);
+        result.counters["damaged_pixels_per_capture"] = frames > 0 ? damaged / frames : 0.0;
+        result.counters["damaged_fraction"] = frames > 0 && output_pixels > 0 ? damaged / (frames * output_pixels) : 0.0;
+    }
+
+    void Teardown(BenchHarness& harness) override {
+        capture_ = nullptr;
+        Scenario::Teardown(harness);
+    }
+
+protected:
+    SyntheticCapture* capture_ = nullptr;
+    uint64_t start_frames_ = 0;
+    uint64_t start_failed_ = 0;
+    uint64_t start_damaged_ = 0;
+};
+
+class CaptureIdle : public CaptureScenario {
+public:
+    const char* GetName() const override { return "capture-idle"; }
+    const char* GetDescription() const override { return "capture the output every frame while 10 windows sit still"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        return OpenSpread(harness, 10, 10, "bench-capture-idle") && CaptureScenario::Setup(harness);
+    }
+};
+
+class CaptureBusy : public CaptureScenario {
+public:
+    const char* GetName() const override { return "capture-busy"; }
+    const char* GetDescription() const override { return "capture the output every frame during the damage-commits workload"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        return workload_.Setup(harness) && CaptureScenario::Setup(harness);
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        workload_.Step(harness, iteration);
+        CaptureScenario::Step(harness, iteration);
+    }
+
+private:
+    DamageCommits workload_;
+};
+
+/**
+ * Windows opening and closing continuously
+ */
+class MapCloseChurn : public Scenario {
+public:
+    const char* GetName() const override { return "map-close-churn"; }
+    const char* GetDescription() const override { return "open two windows and close the two oldest every frame, 20 live"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        client_ = harness.ConnectClient();
+        return client_ && harness.OpenWindows(client_, 20, "bench-churn");
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        for (int i = 0; i < 2; i++) {
+            client_->CreateWindow("bench-churn");
+            client_->CloseWindow(client_->GetWindows().front().get());
+        }
+    }
+
+private:
+    SyntheticClient* client_ = nullptr;
+};
+
+/**
+ * Typing into the launcher with a query that keeps changing
+ */
+class LauncherTyping : public Scenario {
+public:
+    const char* GetName() const override { return "launcher-typing"; }
+    const char* GetDescription() const override { return "type and erase a query in the launcher, one key per frame"; }
+
+    bool Setup(BenchHarness& harness) override {
+        auto* output = harness.GetOutput();
+        if (!output) {
+            return false;
+        }
+        UI::MenuBarManager::Instance().ShowOnOutput(output->wlr_output);
+        harness.Settle();
+        return UI::MenuBarManager::Instance().IsAnyMenuBarVisible();
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        static const std::string query = "terminal";
+        int position = iteration % (static_cast<int>(query.size()) * 2);
+        if (position < static_cast<int>(query.size())) {
+            UI::MenuBarManager::Instance().HandleTextInput(query.substr(position, 1));
+        } else {
+            UI::MenuBarManager::Instance().HandleBackspace();
+        }
+    }
+
+    void Teardown(BenchHarness& harness) override {
+        UI::MenuBarManager::Instance().HideAll();
+        Scenario::Teardown(harness);
+    }
+};
+
+/**
+ * A status bar polling the compositor over IPC
+ */
+class IPCPolling : public Scenario {
+public:
+    const char* GetName() const override { return "ipc-polling"; }
+    const char* GetDescription() const override { return "serve get_tags/get_clients/get_outputs/get_layout every frame with 40 windows open"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        return OpenSpread(harness, 40, 20, "bench-ipc");
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        static const char* commands[] = {
+            "{\"command\":\"get_tags\"}",
+            "{\"command\":\"get_clients\"}",
+            "{\"command\":\"get_outputs\"}",
+            "{\"command\":\"get_layout\"}",
+        };
+        // Include serialization: that is what a real poller pays for too
+        for (const char* command : commands) {
+            IPC::Response response = harness.GetServer()->ProcessIPCCommand(command);
+            std::string json = IPC::SerializeResponse(response);
+            (void)json;
+        }
+    }
+};
+
+/**
+ * Launching programs: the spawn helper against fork() + sh -c from the
+ * compositor, which is what every launcher did before. Alternate steps use
+ * either path; both launch /bin/true with 40 windows mapped.
+ */
+class SpawnLatency : public Scenario {
+public:
+    const char* GetName() const override { return "spawn-latency"; }
+    const char* GetDescription() const override { return "launch a program every frame, alternating spawn helper and fork + sh -c"; }
+
+    bool Setup(BenchHarness& harness) override {
+        harness.GetServer()->SwitchToTag(0);
+        start_ = Core::SpawnHelper::Instance().GetStats();
+        return OpenSpread(harness, 40, 20, "bench-spawn");
+    }
+
+    void Step(BenchHarness& harness, int iteration) override {
+        if (iteration % 2 == 0) {
+            Core::SpawnHelper::Instance().Spawn({"true"}, "bench");
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if (pid == 0) {
+            setsid();
+            execl("/bin/sh", "sh", "-c", "true", nullptr);
+            _exit(1);
+        }
+        uint64_t stall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        if (pid > 0) {
+            fork_children_.push_back(pid);
+            fork_count_++;
+            fork_total_ns_ += stall;
+            fork_max_ns_ = std::max(fork_max_ns_, stall);
+        }
+        fork_children_.erase(std::remove_if(fork_children_.begin(), fork_children_.end(),
+                                            [](pid_t child) { return waitpid(child, nullptr, WNOHANG) != 0; }),
+                             fork_children_.end());
+    }
+
+    void Report(ScenarioResult& result) const override {
+        auto& helper = Core::SpawnHelper::Instance();
+
+        // Collect the replies still in flight so latency covers every launch
+        for (int i = 0; i < 100 && helper.IsRunning(); i++) {
+            Core::SpawnHelper::Stats stats = helper.GetStats();
+            if (stats.spawned + stats.failed >= stats.requests) {
+                break;
+            }
+            struct pollfd pfd = {helper.GetFd(), POLLIN, 0};
+            poll(&pfd, 1, 10);
+            helper.DispatchReplies();
+        }
+
+        Core::SpawnHelper::Stats stats = helper.GetStats();
+        double requests = static_cast<double>(stats.requests - start_.requests);
+        double spawned = static_cast<double>(stats.spawned - start_.spawned);
+        result.counters["spawned"] = spawned;
+        result.counters["failed"] = static_cast<double>(stats.failed - start_.failed);
+        result.counters["in_process"] = static_cast<double>(stats.in_process - start_.in_process);
+        result.counters["helper_stall_us_mean"] = requests > 0 ? (stats.total_stall_ns - start_.total_stall_ns) / requests / 1000.0 : 0.0;
+        result.counters["helper_stall_us_max"] = stats.max_stall_ns / 1000.0;
+        result.counters["helper_latency_us_mean"] = spawned > 0 ? (stats.total_latency_ns - start_.total_latency_ns) / spawned / 1000.0 : 0.0;
+        result.counters["helper_latency_us_max"] = stats.max_latency_ns / 1000.0;
+        result.counters["fork_stall_us_mean"] = fork_count_ > 0 ? static_cast<double>(fork_total_ns_) / fork_count_ / 1000.0 : 0.0;
+        result.counters["fork_stall_us_max"] = fork_max_ns_ / 1000.0;
+    }
+
+    void Teardown(BenchHarness& harness) override {
+        for (pid_t child : fork_children_) {
+            waitpid(child, nullptr, 0);
+        }
+        fork_children_.clear();
+        Scenario::Teardown(harness);
+    }
+
+private:
+    Core::SpawnHelper::Stats start_;
+    std::vector<pid_t> fork_children_;
+    uint64_t fork_count_ = 0;
+    uint64_t fork_total_ns_ = 0;
+    uint64_t fork_max_ns_ = 0;
+};
+
+} // namespace
+
+void Scenario::Teardown(BenchHarness& harness) {
+    harness.DisconnectAll();
+}
+
+std::vector<std::unique_ptr<Scenario>> CreateScenarios() {
+    std::vector<std::unique_ptr<Scenario>> scenarios;
+    scenarios.push_back(std::make_unique<TagSwitchStorm>());
+    scenarios.push_back(std::make_unique<Relayout500>());
+    scenarios.push_back(std::make_unique<TitleSpam>());
+    scenarios.push_back(std::make_unique<DamageCommits>());
+    scenarios.push_back(std::make_unique<BufferImport>());
+    scenarios.push_back(std::make_unique<SyncPolicy>());
+    scenarios.push_back(std::make_unique<CaptureIdle>());
+    scenarios.push_back(std::make_unique<CaptureBusy>());
+    scenarios.push_back(std::make_unique<MapCloseChurn>());
+    scenarios.push_back(std::make_unique<LauncherTyping>());
+    scenarios.push_back(std::make_unique<IPCPolling>());
+    scenarios.push_back(std::make_unique<SpawnLatency>());
+    return scenarios;
+}
+
+} // namespace Bench
+} // namespace Leviathan
@@ -0,0 +1,39 @@
+#ifndef BENCH_SCENARIOS_HPP
+#define BENCH_SCENARIOS_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Leviathan {
+namespace Bench {
+
+class BenchHarness;
+struct ScenarioResult;
+
+/**
+ * A scripted workload. Setup and Teardown are not measured; each Step is
+ * followed by one output frame and is what the results describe.
+ */
+class Scenario {
+public:
+    virtual ~Scenario() = default;
+
+    virtual const char* GetName() const = 0;
+    virtual const char* GetDescription() const = 0;
+
+    virtual bool Setup(BenchHarness& harness) = 0;
+    virtual void Step(BenchHarness& harness, int iteration) = 0;
+    virtual void Teardown(BenchHarness& harness);
+
+    // Add scenario-specific counters for the measured steps (before Teardown)
+    virtual void Report(ScenarioResult& result) const {}
+};
+
+// All scenarios, in the order they run by default
+std::vector<std::unique_ptr<Scenario>> CreateScenarios();
+
+} // namespace Bench
+} // namespace Leviathan
+
+#endif // BENCH_SCENARIOS_HPP
@@ -0,0 +1,613 @@
+#include "SyntheticClient.hpp"
+#include "xdg-shell-client-protocol.h"
+#include "ext-image-capture-source-v1-client-protocol.h"
+#include "ext-image-copy-capture-v1-client-protocol.h"
+#include "linux-dmabuf-v1-client-protocol.h"
+#include "tearing-control-v1-client-protocol.h"
+
+#include <wayland-client.h>
+#include <wayland-server-core.h>
+
+#include <linux/udmabuf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace Leviathan {
+namespace Bench {
+
+namespace {
+
+constexpr int DEFAULT_WIDTH = 640;
+constexpr int DEFAULT_HEIGHT = 480;
+
+// drm_fourcc.h values, without pulling in libdrm for two constants
+constexpr uint32_t DRM_FORMAT_XRGB8888 = 0x34325258;  // 'XR24'
+constexpr uint64_t DRM_FORMAT_MOD_LINEAR = 0;
+
+// A few distinct colours so screenshots of a run are readable
+constexpr uint32_t PALETTE[] = {
+    0xff3b4252, 0xff5e81ac, 0xffa3be8c, 0xffebcb8b, 0xffbf616a, 0xffb48ead,
+};
+
+// SHM buffer filled with one 32-bit value; nullptr on failure
+struct wl_buffer* CreateShmBuffer(struct wl_shm* shm, int width, int height, uint32_t format, uint32_t fill) {
+    int stride = width * 4;
+    size_t size = static_cast<size_t>(stride) * height;
+
+    int fd = memfd_create("leviathan-bench", MFD_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    uint32_t* pixels = static_cast<uint32_t*>(data);
+    for (size_t i = 0; i < size / 4; i++) {
+        pixels[i] = fill;
+    }
+    munmap(data, size);
+
+    struct wl_shm_pool* pool = wl_shm_create_pool(shm, fd, static_cast<int32_t>(size));
+    struct wl_buffer* buffer = wl_shm_pool_create_buffer(pool, 0, width, height, stride, format);
+    wl_shm_pool_destroy(pool);
+    close(fd);
+    return buffer;
+}
+
+// Linear XRGB8888 DMA-BUF over memfd pages (udmabuf), filled like the SHM
+// ones; the compositor imports it like a GPU client's buffer. nullptr on failure
+struct wl_buffer* CreateDmabufBuffer(struct zwp_linux_dmabuf_v1* linux_dmabuf, int width, int height, uint32_t fill) {
+    int stride = width * 4;
+    size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t size = (static_cast<size_t>(stride) * height + page_size - 1) / page_size * page_size;
+
+    int device = open("/dev/udmabuf", O_RDWR | O_CLOEXEC);
+    if (device < 0) {
+        return nullptr;
+    }
+    int memfd = memfd_create("leviathan-bench-dmabuf", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memfd < 0 || ftruncate(memfd, static_cast<off_t>(size)) < 0) {
+        if (memfd >= 0) {
+            close(memfd);
+        }
+        close(device);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (data != MAP_FAILED) {
+        uint32_t* pixels = static_cast<uint32_t*>(data);
+        for (size_t i = 0; i < size / 4; i++) {
+            pixels[i] = fill;
+        }
+        munmap(data, size);
+    }
+
+    // udmabuf refuses memfds that could still shrink under it
+    struct udmabuf_create create = {};
+    create.memfd = static_cast<uint32_t>(memfd);
+    create.flags = UDMABUF_FLAGS_CLOEXEC;
+    create.offset = 0;
+    create.size = size;
+    int dmabuf = -1;
+    if (fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK) == 0) {
+        dmabuf = ioctl(device, UDMABUF_CREATE, &create);
+    }
+    close(memfd);
+    close(device);
+    if (dmabuf < 0) {
+        return nullptr;
+    }
+
+    struct zwp_linux_buffer_params_v1* params = zwp_linux_dmabuf_v1_create_params(linux_dmabuf);
+    zwp_linux_buffer_params_v1_add(params, dmabuf, 0, 0, static_cast<uint32_t>(stride),
+                                   static_cast<uint32_t>(DRM_FORMAT_MOD_LINEAR >> 32),
+                                   static_cast<uint32_t>(DRM_FORMAT_MOD_LINEAR & 0xffffffff));
+    struct wl_buffer* buffer = zwp_linux_buffer_params_v1_create_immed(params, width, height, DRM_FORMAT_XRGB8888, 0);
+    zwp_linux_buffer_params_v1_destroy(params);
+    close(dmabuf);
+    return buffer;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// SyntheticWindow
+// ---------------------------------------------------------------------------
+
+SyntheticWindow::SyntheticWindow(SyntheticClient* client, const std::string& app_id)
+    : client_(client) {
+    static const struct xdg_surface_listener surface_listener = {
+        HandleXdgSurfaceConfigure,
+    };
+    static const struct xdg_toplevel_listener toplevel_listener = {
+        HandleToplevelConfigure,
+        HandleToplevelClose,
+    };
+
+    color_ = PALETTE[client_->next_color_++ % (sizeof(PALETTE) / sizeof(PALETTE[0]))];
+
+    surface_ = wl_compositor_create_surface(client_->compositor_);
+    xdg_surface_ = xdg_wm_base_get_xdg_surface(client_->wm_base_, surface_);
+    xdg_surface_add_listener(xdg_surface_, &surface_listener, this);
+    toplevel_ = xdg_surface_get_toplevel(xdg_surface_);
+    xdg_toplevel_add_listener(toplevel_, &toplevel_listener, this);
+    xdg_toplevel_set_app_id(toplevel_, app_id.c_str());
+    xdg_toplevel_set_title(toplevel_, app_id.c_str());
+
+    // Initial commit without a buffer asks for the first configure
+    wl_surface_commit(surface_);
+}
+
+SyntheticWindow::~SyntheticWindow() {
+    DestroyBuffer();
+    if (tearing_control_) {
+        wp_tearing_control_v1_destroy(tearing_control_);
+    }
+    if (toplevel_) {
+        xdg_toplevel_destroy(toplevel_);
+    }
+    if (xdg_surface_) {
+        xdg_surface_destroy(xdg_surface_);
+    }
+    if (surface_) {
+        wl_surface_destroy(surface_);
+    }
+}
+
+void SyntheticWindow::SetTitle(const std::string& title) {
+    xdg_toplevel_set_title(toplevel_, title.c_str());
+}
+
+bool SyntheticWindow::SetBufferType(BufferType type) {
+    if (type == BufferType::Dmabuf && !client_->CanCreateDmabuf()) {
+        return false;
+    }
+    buffer_type_ = type;
+    if (!mapped_) {
+        return true;  // The first configure allocates it
+    }
+
+    int width = width_;
+    int height = height_;
+    DestroyBuffer();
+    if (!EnsureBuffer(width, height)) {
+        return false;
+    }
+    wl_surface_attach(surface_, buffer_, 0, 0);
+    wl_surface_damage_buffer(surface_, 0, 0, width_, height_);
+    wl_surface_commit(surface_);
+    return true;
+}
+
+void SyntheticWindow::SetFullscreen(bool fullscreen) {
+    if (fullscreen) {
+        xdg_toplevel_set_fullscreen(toplevel_, nullptr);
+    } else {
+        xdg_toplevel_unset_fullscreen(toplevel_);
+    }
+}
+
+bool SyntheticWindow::SetTearingHint(bool async) {
+    if (!client_->tearing_control_manager_) {
+        return false;
+    }
+    if (!tearing_control_) {
+        tearing_control_ = wp_tearing_control_manager_v1_get_tearing_control(client_->tearing_control_manager_, surface_);
+    }
+    wp_tearing_control_v1_set_presentation_hint(tearing_control_, async ? WP_TEARING_CONTROL_V1_PRESENTATION_HINT_ASYNC
+                                                                        : WP_TEARING_CONTROL_V1_PRESENTATION_HINT_VSYNC);
+    return true;
+}
+
+void SyntheticWindow::CommitDamage(int x, int y, int width, int height) {
+    if (!mapped_ || !buffer_) {
+        return;
+    }
+    wl_surface_attach(surface_, buffer_, 0, 0);
+    wl_surface_damage_buffer(surface_, x, y, width, height);
+    wl_surface_commit(surface_);
+}
+
+void SyntheticWindow::OnConfigure(uint32_t serial) {
+    xdg_surface_ack_configure(xdg_surface_, serial);
+
+    int width = pending_width_ > 0 ? pending_width_ : (width_ > 0 ? width_ : DEFAULT_WIDTH);
+    int height = pending_height_ > 0 ? pending_height_ : (height_ > 0 ? height_ : DEFAULT_HEIGHT);
+    if (!EnsureBuffer(width, height)) {
+        return;
+    }
+
+    wl_surface_attach(surface_, buffer_, 0, 0);
+    wl_surface_damage_buffer(surface_, 0, 0, width_, height_);
+    wl_surface_commit(surface_);
+    mapped_ = true;
+}
+
+bool SyntheticWindow::EnsureBuffer(int width, int height) {
+    if (buffer_ && width == width_ && height == height_) {
+        return true;
+    }
+    DestroyBuffer();
+
+    if (buffer_type_ == BufferType::Dmabuf) {
+        buffer_ = CreateDmabufBuffer(client_->linux_dmabuf_, width, height, color_);
+    } else {
+        buffer_ = CreateShmBuffer(client_->shm_, width, height, WL_SHM_FORMAT_ARGB8888, color_);
+    }
+    if (!buffer_) {
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    return true;
+}
+
+void SyntheticWindow::DestroyBuffer() {
+    if (buffer_) {
+        wl_buffer_destroy(buffer_);
+        buffer_ = nullptr;
+    }
+}
+
+void SyntheticWindow::HandleXdgSurfaceConfigure(void* data, struct xdg_surface* surface, uint32_t serial) {
+    static_cast<SyntheticWindow*>(data)->OnConfigure(serial);
+}
+
+void SyntheticWindow::HandleToplevelConfigure(void* data, struct xdg_toplevel* toplevel,
+                                              int32_t width, int32_t height, struct wl_array* states) {
+    auto* window = static_cast<SyntheticWindow*>(data);
+    window->pending_width_ = width;
+    window->pending_height_ = height;
+}
+
+void SyntheticWindow::HandleToplevelClose(void* data, struct xdg_toplevel* toplevel) {
+    // Scenarios decide when windows go away
+}
+
+// ---------------------------------------------------------------------------
+// SyntheticCapture
+// ---------------------------------------------------------------------------
+
+SyntheticCapture::SyntheticCapture(SyntheticClient* client)
+    : client_(client) {
+    static const struct ext_image_copy_capture_session_v1_listener session_listener = {
+        HandleBufferSize,
+        HandleShmFormat,
+        HandleDmabufDevice,
+        HandleDmabufFormat,
+        HandleSessionDone,
+        HandleSessionStopped,
+    };
+
+    source_ = ext_output_image_capture_source_manager_v1_create_source(client_->capture_source_manager_, client_->output_);
+    session_ = ext_image_copy_capture_manager_v1_create_session(client_->copy_capture_manager_, source_, 0);
+    ext_image_copy_capture_session_v1_add_listener(session_, &session_listener, this);
+}
+
+SyntheticCapture::~SyntheticCapture() {
+    if (frame_) {
+        ext_image_copy_capture_frame_v1_destroy(frame_);
+    }
+    if (buffer_) {
+        wl_buffer_destroy(buffer_);
+    }
+    if (session_) {
+        ext_image_copy_capture_session_v1_destroy(session_);
+    }
+    if (source_) {
+        ext_image_capture_source_v1_destroy(source_);
+    }
+}
+
+void SyntheticCapture::RequestFrame() {
+    static const struct ext_image_copy_capture_frame_v1_listener frame_listener = {
+        HandleFrameTransform,
+        HandleFrameDamage,
+        HandleFramePresentationTime,
+        HandleFrameReady,
+        HandleFrameFailed,
+    };
+
+    if (!buffer_ || frame_ || stopped_) {
+        return;
+    }
+
+    frame_ = ext_image_copy_capture_session_v1_create_frame(session_);
+    ext_image_copy_capture_frame_v1_add_listener(frame_, &frame_listener, this);
+    ext_image_copy_capture_frame_v1_attach_buffer(frame_, buffer_);
+    // Our copy of the previous frame is intact, so after the first frame
+    // there is no buffer damage and only new output damage gets copied
+    if (buffer_damaged_) {
+        ext_image_copy_capture_frame_v1_damage_buffer(frame_, 0, 0, width_, height_);
+    }
+    ext_image_copy_capture_frame_v1_capture(frame_);
+}
+
+void SyntheticCapture::FinishFrame() {
+    ext_image_copy_capture_frame_v1_destroy(frame_);
+    frame_ = nullptr;
+}
+
+void SyntheticCapture::HandleBufferSize(void* data, struct ext_image_copy_capture_session_v1* session,
+                                        uint32_t width, uint32_t height) {
+    auto* capture = static_cast<SyntheticCapture*>(data);
+    capture->width_ = static_cast<int>(width);
+    capture->height_ = static_cast<int>(height);
+}
+
+void SyntheticCapture::HandleShmFormat(void* data, struct ext_image_copy_capture_session_v1* session, uint32_t format) {
+    auto* capture = static_cast<SyntheticCapture*>(data);
+    if (!capture->has_shm_format_ || format == WL_SHM_FORMAT_XRGB8888) {
+        capture->shm_format_ = format;
+        capture->has_shm_format_ = true;
+    }
+}
+
+void SyntheticCapture::HandleDmabufDevice(void* data, struct ext_image_copy_capture_session_v1* session,
+                                          struct wl_array* device) {
+}
+
+void SyntheticCapture::HandleDmabufFormat(void* data, struct ext_image_copy_capture_session_v1* session,
+                                          uint32_t format, struct wl_array* modifiers) {
+}
+
+void SyntheticCapture::HandleSessionDone(void* data, struct ext_image_copy_capture_session_v1* session) {
+    auto* capture = static_cast<SyntheticCapture*>(data);
+    if (!capture->has_shm_format_ || capture->width_ <= 0 || capture->height_ <= 0) {
+        return;
+    }
+    if (capture->buffer_) {
+        // Constraints changed (output resized): start over with a new buffer
+        wl_buffer_destroy(capture->buffer_);
+    }
+    capture->buffer_ = CreateShmBuffer(capture->client_->shm_, capture->width_, capture->height_,
+                                       capture->shm_format_, 0);
+    capture->buffer_damaged_ = true;
+}
+
+void SyntheticCapture::HandleSessionStopped(void* data, struct ext_image_copy_capture_session_v1* session) {
+    static_cast<SyntheticCapture*>(data)->stopped_ = true;
+}
+
+void SyntheticCapture::HandleFrameTransform(void* data, struct ext_image_copy_capture_frame_v1* frame, uint32_t transform) {
+}
+
+void SyntheticCapture::HandleFrameDamage(void* data, struct ext_image_copy_capture_frame_v1* frame,
+                                         int32_t x, int32_t y, int32_t width, int32_t height) {
+    auto* capture = static_cast<SyntheticCapture*>(data);
+    capture->damaged_pixels_ += static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+}
+
+void SyntheticCapture::HandleFramePresentationTime(void* data, struct ext_image_copy_capture_frame_v1* frame,
+                                                   uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec) {
+}
+
+void SyntheticCapture::HandleFrameReady(void* data, struct ext_image_copy_capture_frame_v1* frame) {
+    auto* capture = static_cast<SyntheticCapture*>(data);
+    capture->frames_++;
+    capture->buffer_damaged_ = false;
+    capture->FinishFrame();
+}
+
+void SyntheticCapture::HandleFrameFailed(void* data, struct ext_image_copy_capture_frame_v1* frame, uint32_t reason) {
+    auto* capture = static_cast<SyntheticCapture*>(data);
+    capture->failed_frames_++;
+    if (reason == EXT_IMAGE_COPY_CAPTURE_FRAME_V1_FAILURE_REASON_STOPPED) {
+        capture->stopped_ = true;
+    }
+    capture->FinishFrame();
+}
+
+// ---------------------------------------------------------------------------
+// SyntheticClient
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<SyntheticClient> SyntheticClient::Connect(struct wl_display* server_display) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0) {
+        return nullptr;
+    }
+
+    // The server end becomes an ordinary client of the compositor
+    if (!wl_client_create(server_display, fds[0])) {
+        close(fds[0]);
+        close(fds[1]);
+        return nullptr;
+    }
+
+    std::unique_ptr<SyntheticClient> client(new SyntheticClient());
+    client->display_ = wl_display_connect_to_fd(fds[1]);
+    if (!client->display_) {
+        close(fds[1]);
+        return nullptr;
+    }
+
+    static const struct wl_registry_listener registry_listener = {
+        HandleGlobal,
+        HandleGlobalRemove,
+    };
+    client->registry_ = wl_display_get_registry(client->display_);
+    wl_registry_add_listener(client->registry_, &registry_listener, client.get());
+    client->Flush();
+    return client;
+}
+
+SyntheticClient::~SyntheticClient() {
+    windows_.clear();
+    capture_.reset();
+    if (linux_dmabuf_) {
+        zwp_linux_dmabuf_v1_destroy(linux_dmabuf_);
+    }
+    if (tearing_control_manager_) {
+        wp_tearing_control_manager_v1_destroy(tearing_control_manager_);
+    }
+    if (copy_capture_manager_) {
+        ext_image_copy_capture_manager_v1_destroy(copy_capture_manager_);
+    }
+    if (capture_source_manager_) {
+        ext_output_image_capture_source_manager_v1_destroy(capture_source_manager_);
+    }
+    if (output_) {
+        wl_output_destroy(output_);
+    }
+    if (wm_base_) {
+        xdg_wm_base_destroy(wm_base_);
+    }
+    if (shm_) {
+        wl_shm_destroy(shm_);
+    }
+    if (compositor_) {
+        wl_compositor_destroy(compositor_);
+    }
+    if (registry_) {
+        wl_registry_destroy(registry_);
+    }
+    if (display_) {
+        wl_display_flush(display_);
+        wl_display_disconnect(display_);
+    }
+}
+
+SyntheticWindow* SyntheticClient::CreateWindow(const std::string& app_id) {
+    if (!IsReady()) {
+        return nullptr;
+    }
+    windows_.push_back(std::unique_ptr<SyntheticWindow>(new SyntheticWindow(this, app_id)));
+    return windows_.back().get();
+}
+
+bool SyntheticClient::CanCreateDmabuf() const {
+    return linux_dmabuf_ && dmabuf_linear_xrgb_ && access("/dev/udmabuf", R_OK | W_OK) == 0;
+}
+
+SyntheticCapture* SyntheticClient::StartCapture() {
+    if (!output_ || !capture_source_manager_ || !copy_capture_manager_) {
+        return nullptr;
+    }
+    if (!capture_) {
+        capture_.reset(new SyntheticCapture(this));
+    }
+    return capture_.get();
+}
+
+void SyntheticClient::CloseWindow(SyntheticWindow* window) {
+    for (auto it = windows_.begin(); it != windows_.end(); ++it) {
+        if (it->get() == window) {
+            windows_.erase(it);
+            return;
+        }
+    }
+}
+
+void SyntheticClient::Flush() {
+    if (!connected_) {
+        return;
+    }
+    if (wl_display_flush(display_) < 0 && errno != EAGAIN) {
+        connected_ = false;
+    }
+}
+
+void SyntheticClient::Dispatch() {
+    if (!connected_) {
+        return;
+    }
+
+    while (wl_display_prepare_read(display_) != 0) {
+        if (wl_display_dispatch_pending(display_) < 0) {
+            connected_ = false;
+            return;
+        }
+    }
+
+    struct pollfd pfd = {wl_display_get_fd(display_), POLLIN, 0};
+    if (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN)) {
+        if (wl_display_read_events(display_) < 0) {
+            connected_ = false;
+            return;
+        }
+    } else {
+        wl_display_cancel_read(display_);
+    }
+
+    if (wl_display_dispatch_pending(display_) < 0) {
+        connected_ = false;
+    }
+}
+
+void SyntheticClient::HandleGlobal(void* data, struct wl_registry* registry, uint32_t name,
+                                   const char* interface, uint32_t version) {
+    static const struct xdg_wm_base_listener wm_base_listener = {
+        HandlePing,
+    };
+    static const struct zwp_linux_dmabuf_v1_listener dmabuf_listener = {
+        HandleDmabufFormat,
+        HandleDmabufModifier,
+    };
+
+    auto* client = static_cast<SyntheticClient*>(data);
+    if (strcmp(interface, wl_compositor_interface.name) == 0) {
+        client->compositor_ = static_cast<struct wl_compositor*>(
+            wl_registry_bind(registry, name, &wl_compositor_interface, 4));
+    } else if (strcmp(interface, wl_shm_interface.name) == 0) {
+        client->shm_ = static_cast<struct wl_shm*>(
+            wl_registry_bind(registry, name, &wl_shm_interface, 1));
+    } else if (strcmp(interface, xdg_wm_base_interface.name) == 0) {
+        client->wm_base_ = static_cast<struct xdg_wm_base*>(
+            wl_registry_bind(registry, name, &xdg_wm_base_interface, 1));
+        xdg_wm_base_add_listener(client->wm_base_, &wm_base_listener, client);
+    } else if (strcmp(interface, wl_output_interface.name) == 0 && !client->output_) {
+        client->output_ = static_cast<struct wl_output*>(
+            wl_registry_bind(registry, name, &wl_output_interface, 1));
+    } else if (strcmp(interface, ext_output_image_capture_source_manager_v1_interface.name) == 0) {
+        client->capture_source_manager_ = static_cast<struct ext_output_image_capture_source_manager_v1*>(
+            wl_registry_bind(registry, name, &ext_output_image_capture_source_manager_v1_interface, 1));
+    } else if (strcmp(interface, ext_image_copy_capture_manager_v1_interface.name) == 0) {
+        client->copy_capture_manager_ = static_cast<struct ext_image_copy_capture_manager_v1*>(
+            wl_registry_bind(registry, name, &ext_image_copy_capture_manager_v1_interface, 1));
+    } else if (strcmp(interface, zwp_linux_dmabuf_v1_interface.name) == 0 && version >= 3) {
+        // Version 3 still announces format/modifier pairs without feedback objects
+        client->linux_dmabuf_ = static_cast<struct zwp_linux_dmabuf_v1*>(
+            wl_registry_bind(registry, name, &zwp_linux_dmabuf_v1_interface, 3));
+        zwp_linux_dmabuf_v1_add_listener(client->linux_dmabuf_, &dmabuf_listener, client);
+    } else if (strcmp(interface, wp_tearing_control_manager_v1_interface.name) == 0) {
+        client->tearing_control_manager_ = static_cast<struct wp_tearing_control_manager_v1*>(
+            wl_registry_bind(registry, name, &wp_tearing_control_manager_v1_interface, 1));
+    }
+}
+
+void SyntheticClient::HandleGlobalRemove(void* data, struct wl_registry* registry, uint32_t name) {
+}
+
+void SyntheticClient::HandlePing(void* data, struct xdg_wm_base* wm_base, uint32_t serial) {
+    xdg_wm_base_pong(wm_base, serial);
+}
+
+void SyntheticClient::HandleDmabufFormat(void* data, struct zwp_linux_dmabuf_v1* linux_dmabuf, uint32_t format) {
+}
+
+void SyntheticClient::HandleDmabufModifier(void* data, struct zwp_linux_dmabuf_v1* linux_dmabuf,
+                                           uint32_t format, uint32_t modifier_hi, uint32_t modifier_lo) {
+    uint64_t modifier = (static_cast<uint64_t>(modifier_hi) << 32) | modifier_lo;
+    if (format == DRM_FORMAT_XRGB8888 && modifier == DRM_FORMAT_MOD_LINEAR) {
+        static_cast<SyntheticClient*>(data)->dmabuf_linear_xrgb_ = true;
+    }
+}
+
+} // namespace Bench
+} // namespace Leviathan
@@ -0,0 +1,237 @@
+#ifndef BENCH_SYNTHETIC_CLIENT_HPP
+#define BENCH_SYNTHETIC_CLIENT_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct wl_display;
+struct wl_registry;
+struct wl_compositor;
+struct wl_shm;
+struct wl_surface;
+struct wl_buffer;
+struct wl_array;
+struct wl_output;
+struct xdg_wm_base;
+struct xdg_surface;
+struct xdg_toplevel;
+struct ext_output_image_capture_source_manager_v1;
+struct ext_image_copy_capture_manager_v1;
+struct ext_image_capture_source_v1;
+struct ext_image_copy_capture_session_v1;
+struct ext_image_copy_capture_frame_v1;
+struct zwp_linux_dmabuf_v1;
+struct wp_tearing_control_manager_v1;
+struct wp_tearing_control_v1;
+
+namespace Leviathan {
+namespace Bench {
+
+class SyntheticClient;
+
+enum class BufferType {
+    Shm,
+    Dmabuf,   // Linear XRGB8888 backed by udmabuf (see SyntheticClient::CanCreateDmabuf)
+};
+
+/**
+ * One xdg-shell toplevel owned by a SyntheticClient.
+ *
+ * The window maps with a solid-colour SHM buffer at whatever size the
+ * compositor configures, and re-allocates it when a configure changes the
+ * size (that is how relayouts turn into client resizes).
+ */
+class SyntheticWindow {
+public:
+    ~SyntheticWindow();
+
+    bool IsMapped() const { return mapped_; }
+    int GetWidth() const { return width_; }
+    int GetHeight() const { return height_; }
+
+    void SetTitle(const std::string& title);
+
+    // Switch to a buffer of this type and commit it; false if it can't be created
+    bool SetBufferType(BufferType type);
+    BufferType GetBufferType() const { return buffer_type_; }
+
+    // Ask for (or leave) fullscreen; the compositor answers with a configure
+    void SetFullscreen(bool fullscreen);
+
+    // wp_tearing_control_v1 presentation hint, applied with the next commit;
+    // false if the compositor has no tearing-control global
+    bool SetTearingHint(bool async);
+
+    // Re-attach the buffer with a damaged rectangle and commit
+    void CommitDamage(int x, int y, int width, int height);
+
+private:
+    friend class SyntheticClient;
+
+    SyntheticWindow(SyntheticClient* client, const std::string& app_id);
+
+    void OnConfigure(uint32_t serial);
+    bool EnsureBuffer(int width, int height);
+    void DestroyBuffer();
+
+    static void HandleXdgSurfaceConfigure(void* data, struct xdg_surface* surface, uint32_t serial);
+    static void HandleToplevelConfigure(void* data, struct xdg_toplevel* toplevel,
+                                        int32_t width, int32_t height, struct wl_array* states);
+    static void HandleToplevelClose(void* data, struct xdg_toplevel* toplevel);
+
+    SyntheticClient* client_;
+    struct wl_surface* surface_ = nullptr;
+    struct xdg_surface* xdg_surface_ = nullptr;
+    struct xdg_toplevel* toplevel_ = nullptr;
+    struct wl_buffer* buffer_ = nullptr;
+    struct wp_tearing_control_v1* tearing_control_ = nullptr;
+
+    int pending_width_ = 0;
+    int pending_height_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    uint32_t color_ = 0;
+    BufferType buffer_type_ = BufferType::Shm;
+    bool mapped_ = false;
+};
+
+/**
+ * ext-image-copy-capture session on the client's first output.
+ *
+ * Every frame is copied into the same SHM buffer, so after the first one the
+ * compositor only has to copy (and report) the regions that changed.
+ */
+class SyntheticCapture {
+public:
+    ~SyntheticCapture();
+
+    // True once the session constraints arrived and the buffer exists
+    bool IsReady() const { return buffer_ != nullptr; }
+    bool IsStopped() const { return stopped_; }
+    bool IsFrameInFlight() const { return frame_ != nullptr; }
+
+    // Capture the next frame unless one is still in flight
+    void RequestFrame();
+
+    uint64_t GetFrames() const { return frames_; }
+    uint64_t GetFailedFrames() const { return failed_frames_; }
+    uint64_t GetDamagedPixels() const { return damaged_pixels_; }
+    int GetWidth() const { return width_; }
+    int GetHeight() const { return height_; }
+
+private:
+    friend class SyntheticClient;
+
+    explicit SyntheticCapture(SyntheticClient* client);
+
+    static void HandleBufferSize(void* data, struct ext_image_copy_capture_session_v1* session,
+                                 uint32_t width, uint32_t height);
+    static void HandleShmFormat(void* data, struct ext_image_copy_capture_session_v1* session, uint32_t format);
+    static void HandleDmabufDevice(void* data, struct ext_image_copy_capture_session_v1* session,
+                                   struct wl_array* device);
+    static void HandleDmabufFormat(void* data, struct ext_image_copy_capture_session_v1* session,
+                                   uint32_t format, struct wl_array* modifiers);
+    static void HandleSessionDone(void* data, struct ext_image_copy_capture_session_v1* session);
+    static void HandleSessionStopped(void* data, struct ext_image_copy_capture_session_v1* session);
+
+    static void HandleFrameTransform(void* data, struct ext_image_copy_capture_frame_v1* frame, uint32_t transform);
+    static void HandleFrameDamage(void* data, struct ext_image_copy_capture_frame_v1* frame,
+                                  int32_t x, int32_t y, int32_t width, int32_t height);
+    static void HandleFramePresentationTime(void* data, struct ext_image_copy_capture_frame_v1* frame,
+                                            uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec);
+    static void HandleFrameReady(void* data, struct ext_image_copy_capture_frame_v1* frame);
+    static void HandleFrameFailed(void* data, struct ext_image_copy_capture_frame_v1* frame, uint32_t reason);
+
+    void FinishFrame();
+
+    SyntheticClient* client_;
+    struct ext_image_capture_source_v1* source_ = nullptr;
+    struct ext_image_copy_capture_session_v1* session_ = nullptr;
+    struct ext_image_copy_capture_frame_v1* frame_ = nullptr;
+    struct wl_buffer* buffer_ = nullptr;
+
+    int width_ = 0;
+    int height_ = 0;
+    uint32_t shm_format_ = 0;
+    bool has_shm_format_ = false;
+    bool buffer_damaged_ = true;   // Whole buffer is stale until the first copy
+    bool stopped_ = false;
+
+    uint64_t frames_ = 0;
+    uint64_t failed_frames_ = 0;
+    uint64_t damaged_pixels_ = 0;
+};
+
+/**
+ * In-process Wayland client connected to the compositor over a socketpair.
+ *
+ * Nothing here blocks: the harness pumps the server and every client in turn
+ * from one thread, so runs are deterministic and need no WAYLAND_DISPLAY.
+ */
+class SyntheticClient {
+public:
+    // Connect to the compositor's display; nullptr on failure
+    static std::unique_ptr<SyntheticClient> Connect(struct wl_display* server_display);
+    ~SyntheticClient();
+
+    // True once the registry globals have been bound
+    bool IsReady() const { return compositor_ && shm_ && wm_base_; }
+
+    // Screen capture of the first output; nullptr if the compositor lacks the globals
+    SyntheticCapture* StartCapture();
+    SyntheticCapture* GetCapture() const { return capture_.get(); }
+
+    // linux-dmabuf offers linear XRGB8888 and /dev/udmabuf can back it
+    bool CanCreateDmabuf() const;
+
+    SyntheticWindow* CreateWindow(const std::string& app_id);
+    void CloseWindow(SyntheticWindow* window);
+    const std::vector<std::unique_ptr<SyntheticWindow>>& GetWindows() const { return windows_; }
+
+    // Send queued requests to the server
+    void Flush();
+
+    // Read and dispatch whatever the server has sent, without blocking
+    void Dispatch();
+
+    // False once the connection has failed (protocol error, server gone)
+    bool IsConnected() const { return connected_; }
+
+private:
+    friend class SyntheticWindow;
+    friend class SyntheticCapture;
+
+    SyntheticClient() = default;
+
+    static void HandleGlobal(void* data, struct wl_registry* registry, uint32_t name,
+                             const char* interface, uint32_t version);
+    static void HandleGlobalRemove(void* data, struct wl_registry* registry, uint32_t name);
+    static void HandlePing(void* data, struct xdg_wm_base* wm_base, uint32_t serial);
+    static void HandleDmabufFormat(void* data, struct zwp_linux_dmabuf_v1* linux_dmabuf, uint32_t format);
+    static void HandleDmabufModifier(void* data, struct zwp_linux_dmabuf_v1* linux_dmabuf,
+                                     uint32_t format, uint32_t modifier_hi, uint32_t modifier_lo);
+
+    struct wl_display* display_ = nullptr;
+    struct wl_registry* registry_ = nullptr;
+    struct wl_compositor* compositor_ = nullptr;
+    struct wl_shm* shm_ = nullptr;
+    struct xdg_wm_base* wm_base_ = nullptr;
+    struct wl_output* output_ = nullptr;
+    struct ext_output_image_capture_source_manager_v1* capture_source_manager_ = nullptr;
+    struct ext_image_copy_capture_manager_v1* copy_capture_manager_ = nullptr;
+    struct zwp_linux_dmabuf_v1* linux_dmabuf_ = nullptr;
+    struct wp_tearing_control_manager_v1* tearing_control_manager_ = nullptr;
+    bool dmabuf_linear_xrgb_ = false;   // Advertised modifier for the udmabuf layout
+    bool connected_ = true;
+
+    std::vector<std::unique_ptr<SyntheticWindow>> windows_;
+    std::unique_ptr<SyntheticCapture> capture_;
+    uint32_t next_color_ = 0;
+};
+
+} // namespace Bench
+} // namespace Leviathan
+
+#endif // BENCH_SYNTHETIC_CLIENT_HPP
@@ -0,0 +1,185 @@
+#include "BenchHarness.hpp"
+#include "Scenarios.hpp"
+
+#include "Logger.hpp"
+#include "core/SpawnHelper.hpp"
+#include "version.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+
+using namespace Leviathan::Bench;
+
+namespace {
+
+void PrintHelp(const char* prog_name) {
+    std::cout << "Usage: " << prog_name << " [OPTIONS]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Runs the compositor on the headless backend with synthetic clients" << std::endl;
+    std::cout << "and prints per-scenario results as JSON." << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  -s, --scenario NAME    Run only this scenario (repeatable)" << std::endl;
+    std::cout << "  -n, --iterations N     Measured steps per scenario (default: 300)" << std::endl;
+    std::cout << "  -o, --output FILE      Write JSON to FILE instead of stdout" << std::endl;
+    std::cout << "  -l, --list             List scenarios and exit" << std::endl;
+    std::cout << "  -h, --help             Show this help message" << std::endl;
+}
+
+nlohmann::json ResultToJson(const ScenarioResult& result) {
+    nlohmann::json j;
+    j["name"] = result.name;
+    j["iterations"] = result.iterations;
+    j["frames"] = result.frames;
+    j["frame_time_ms"] = {
+        {"p50", result.frame_p50_ms},
+        {"p99", result.frame_p99_ms},
+        {"max", result.frame_max_ms},
+        {"mean", result.frame_mean_ms},
+    };
+    j["wall_ms"] = result.wall_ms;
+    j["cpu_ms"] = result.cpu_ms;
+    j["rss_kb"] = result.rss_kb;
+    j["peak_rss_kb"] = result.peak_rss_kb;
+    j["allocations"] = result.allocations;
+    j["allocated_bytes"] = result.allocated_bytes;
+    if (!result.counters.empty()) {
+        j["counters"] = result.counters;
+    }
+    if (!result.error.empty()) {
+        j["error"] = result.error;
+    }
+    return j;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::set<std::string> selected;
+    int iterations = 300;
+    std::string output_path;
+    bool list_only = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if ((strcmp(arg, "-s") == 0 || strcmp(arg, "--scenario") == 0) && has_value) {
+            selected.insert(argv[++i]);
+        } else if ((strcmp(arg, "-n") == 0 || strcmp(arg, "--iterations") == 0) && has_value) {
+            iterations = std::max(1, atoi(argv[++i]));
+        } else if ((strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0) && has_value) {
+            output_path = argv[++i];
+        } else if (strcmp(arg, "-l") == 0 || strcmp(arg, "--list") == 0) {
+            list_only = true;
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            PrintHelp(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            PrintHelp(argv[0]);
+            return 1;
+        }
+    }
+
+    auto scenarios = CreateScenarios();
+
+    if (list_only) {
+        for (const auto& scenario : scenarios) {
+            std::cout << scenario->GetName() << "\t" << scenario->GetDescription() << std::endl;
+        }
+        return 0;
+    }
+
+    for (const auto& name : selected) {
+        bool known = false;
+        for (const auto& scenario : scenarios) {
+            known = known || name == scenario->GetName();
+        }
+        if (!known) {
+            std::cerr << "Unknown scenario: " << name << " (see --list)" << std::endl;
+            return 1;
+        }
+    }
+
+    // Before the harness maps anything, as the compositor does (spawn-latency)
+    Leviathan::Core::SpawnHelper::Instance().Start();
+
+    // Compositor logging goes to a file only; stdout carries the results
+    Leviathan::SimpleLogger::Instance().Init("leviathan-bench.log", Leviathan::LogLevel::WARN, false);
+
+    nlohmann::json report;
+    report["version"] = LEVIATHAN_VERSION;
+    report["backend"] = "headless";
+    report["renderer"] = getenv("WLR_RENDERER") ? getenv("WLR_RENDERER") : "pixman";
+    report["output"] = {{"width", BenchHarness::OUTPUT_WIDTH}, {"height", BenchHarness::OUTPUT_HEIGHT}};
+    report["scenarios"] = nlohmann::json::array();
+
+    int exit_code = EXIT_SUCCESS;
+    {
+        BenchHarness harness;
+        if (!harness.Initialize()) {
+            Leviathan::SimpleLogger::Instance().Shutdown();
+            return EXIT_FAILURE;
+        }
+
+        for (const auto& scenario : scenarios) {
+            if (!selected.empty() && !selected.count(scenario->GetName())) {
+                continue;
+            }
+
+            std::cerr << "running " << scenario->GetName() << "..." << std::endl;
+            if (!scenario->Setup(harness)) {
+                std::cerr << "  setup failed, skipping" << std::endl;
+                nlohmann::json failed;
+                failed["name"] = scenario->GetName();
+                failed["error"] = "setup failed";
+                report["scenarios"].push_back(failed);
+                scenario->Teardown(harness);
+                exit_code = EXIT_FAILURE;
+                continue;
+            }
+
+            harness.BeginMeasure();
+            for (int i = 0; i < iterations; i++) {
+                scenario->Step(harness, i);
+                harness.PumpFrame();
+            }
+            ScenarioResult result = harness.EndMeasure(scenario->GetName(), iterations);
+            scenario->Report(result);
+
+            scenario->Teardown(harness);
+
+            std::cerr << "  p50 " << result.frame_p50_ms << " ms, p99 " << result.frame_p99_ms
+                      << " ms, cpu " << result.cpu_ms << " ms, " << result.allocations << " allocations" << std::endl;
+            if (!result.error.empty()) {
+                std::cerr << "  check failed: " << result.error << std::endl;
+                exit_code = EXIT_FAILURE;
+            }
+            report["scenarios"].push_back(ResultToJson(result));
+        }
+    }
+
+    std::string json = report.dump(2);
+    if (output_path.empty()) {
+        std::cout << json << std::endl;
+    } else {
+        std::ofstream out(output_path);
+        if (!out) {
+            std::cerr << "Failed to write " << output_path << std::endl;
+            exit_code = EXIT_FAILURE;
+        } else {
+            out << json << std::endl;
+        }
+    }
+
+    Leviathan::Core::SpawnHelper::Instance().Stop();
+    Leviathan::SimpleLogger::Instance().Shutdown();
+    return exit_code;
+}
@@ -70,6 +70,50 @@ struct NightLightConfig {
     bool smooth_transition = true;       // Gradual transition vs instant
 };
 
+// Notification popup configuration
+struct NotificationsConfig {
+    bool enabled = false;                // Own org.freedesktop.Notifications (off: leave it to mako, dunst, ...)
+    int default_timeout = 5000;          // Milliseconds, used when a client passes -1
+    int history_size = 50;               // Max notifications kept (active + closed history)
+    int max_visible = 5;                 // Cards on screen at once, the rest are summarised
+    int max_updates_per_second = 10;     // Rate limit for re-laying out the card stack
+    int group_window = 1000;             // Notifications from one app within this many ms share a card
+    int width = 400;                     // Card width in pixels
+    int margin = 10;                     // Distance from the screen edge (below reserved space)
+    int spacing = 10;                    // Gap between stacked cards
+    std::string font_family = "Sans";
+    int font_size = 12;
+    std::string background_color = "#2E3440";
+    std::string foreground_color = "#D8DEE9";
+    std::string critical_color = "#BF616A";
+};
+
+// Output rendering and frame pacing
+struct RenderingConfig {
+    bool frame_pacing = false;           // Render (and release frame callbacks) just before vblank
+    int max_render_time = 0;             // Milliseconds reserved before vblank; 0 = derive from measured render time
+};
+
+// X11 compatibility server
+struct XwaylandConfig {
+    bool enabled = true;
+    bool lazy = true;                    // Create the sockets now, start Xwayland on the first X11 connection
+    int idle_timeout = 10;               // Seconds without X11 clients before a lazy server exits; 0 = keep running
+};
+
+struct IdleConfig {
+    int timeout = 300;                   // Seconds without input before bars/widgets/wallpaper pause; 0 = never
+    int dpms_timeout = 600;              // Seconds without input before outputs power off; 0 = never
+};
+
+struct FrameGovernorConfig {
+    bool enabled = true;
+    int unfocused_fps = 0;               // Frame callback cap for unfocused windows; 0 = every output frame
+    int battery_unfocused_fps = 30;      // Same, while running on battery
+    int storm_factor = 3;                // Commits/s above this many times the refresh rate is a commit storm; 0 = off
+    int storm_fps = 30;                  // Frame callbacks and applied commits per second for a client in a commit storm
+};
+
 // Forward declaration for recursive structure
 struct WidgetConfig;
 
@@ -123,6 +167,13 @@ struct StatusBarConfig {
     ContainerConfig right;   // Right section (for horizontal bars) or bottom (for vertical bars)
 };
 
+// Variable refresh rate policy for a monitor
+enum class AdaptiveSyncMode {
+    OFF,
+    ON,
+    AUTO   // Only while a fullscreen client is focused on the monitor
+};
+
 // Monitor configuration within a group
 struct MonitorConfig {
     // Identifier can be:
@@ -151,6 +202,13 @@ struct MonitorConfig {
     
     // Optional transform (0, 90, 180, 270)
     std::optional<int> transform;
+    
+    // Variable refresh rate: "off", "on" or "auto"
+    AdaptiveSyncMode adaptive_sync = AdaptiveSyncMode::OFF;
+    
+    // Let a focused fullscreen client that asks for tearing (wp_tearing_control_v1)
+    // use async page flips
+    bool allow_tearing = false;
 };
 
 // Monitor group - a complete multi-monitor layout
@@ -186,7 +244,8 @@ struct PluginsConfig {
 // Wallpaper type enumeration
 enum class WallpaperType {
     StaticImage,       // Static image files (PNG, JPEG, etc.)
-    WallpaperEngine    // Wallpaper Engine animated wallpapers
+    WallpaperEngine,   // Wallpaper Engine animated wallpapers
+    SolidColor         // Single color, drawn as a scene rect (no buffer)
 };
 
 // Wallpaper configuration
@@ -195,6 +254,7 @@ struct WallpaperConfig {
     WallpaperType type;                  // Type of wallpaper (static or wallpaper engine)
     std::vector<std::string> wallpapers; // Path(s) to wallpaper file(s) or folder
     int change_interval_seconds;         // How often to rotate wallpapers (0 = no rotation)
+    std::string color;                   // Hex color for SolidColor, or fallback if images fail to load
     
     WallpaperConfig() 
         : name("default")
@@ -267,6 +327,7 @@ struct WindowRuleConfig {
     bool force_tiled = false;                 // Force window to tile
     std::optional<int> opacity_override;      // Override opacity (0-100)
     std::optional<int> tag;                   // Move to specific tag
+    std::optional<int> max_fps;               // Frame callback cap; 0 = never capped by the frame governor
     
     WindowRuleConfig() = default;
     
@@ -300,6 +361,11 @@ struct ConfigParser {
     LibInputConfig libinput;
     GeneralConfig general;
     NightLightConfig night_light;
+    NotificationsConfig notifications;
+    RenderingConfig rendering;
+    XwaylandConfig xwayland;
+    IdleConfig idle;
+    FrameGovernorConfig frame_governor;
     PluginsConfig plugins;
     StatusBarsConfig status_bars;
     MonitorGroupsConfig monitor_groups;
@@ -323,6 +389,11 @@ private:
     void ParseLibInput(const YAML::Node& node);
     void ParseGeneral(const YAML::Node& node);
     void ParseNightLight(const YAML::Node& node);
+    void ParseNotifications(const YAML::Node& node);
+    void ParseRendering(const YAML::Node& node);
+    void ParseXwayland(const YAML::Node& node);
+    void ParseIdle(const YAML::Node& node);
+    void ParseFrameGovernor(const YAML::Node& node);
     void ParsePlugins(const YAML::Node& node);
     void ParseStatusBars(const YAML::Node& node);
     void ParseMonitorGroups(const YAML::Node& node);
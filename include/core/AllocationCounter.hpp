@@ -0,0 +1,29 @@
+#ifndef CORE_ALLOCATION_COUNTER_HPP
+#define CORE_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Leviathan {
+namespace Core {
+
+/**
+ * Process-wide heap allocation totals
+ *
+ * Counted by the replacement operator new in AllocationHooks.cpp, which is
+ * only linked in when the build sets ENABLE_ALLOCATION_STATS (and always
+ * into leviathan-bench). Without it the totals stay at zero.
+ */
+uint64_t GetAllocationCount();
+uint64_t GetAllocatedBytes();
+
+// True when the operator new hooks are linked in
+bool IsAllocationCountingEnabled();
+
+// Called by the hooks for every allocation
+void RecordAllocation(size_t bytes);
+
+} // namespace Core
+} // namespace Leviathan
+
+#endif // CORE_ALLOCATION_COUNTER_HPP
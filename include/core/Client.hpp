@@ -2,50 +2,144 @@
 #define CORE_CLIENT_HPP
 
 #include "wayland/View.hpp"
+#include "core/ClientData.hpp"
 #include <string>
 
 namespace Leviathan {
 namespace Core {
 
+/**
+ * Per-client state of the frame-rate governor (Wayland::FrameGovernor)
+ */
+struct FrameGovernorState {
+    uint64_t last_frame_done_ns = 0;   // Last frame callback sent while capped
+    uint64_t throttle_events = 0;      // Times a commit storm got the client throttled
+    int rule_cap = -1;                 // max_fps from a window rule, -1 if none
+    bool throttled = false;            // Committing far faster than the outputs refresh
+    
+    // While throttled, each toplevel commit is held back with its own
+    // wlr_surface_lock_pending and applied one per storm_fps tick
+    static constexpr int MAX_HELD_COMMITS = 3;
+    uint32_t held_commits[MAX_HELD_COMMITS] = {};  // Lock seqs, oldest first
+    int held_count = 0;
+    uint64_t last_release_ns = 0;      // Last held commit applied
+};
+
+/**
+ * Per-client resource accounting, for leviathanctl top
+ * Fixed size and updated on the commit path, so recording never allocates.
+ * Rates cover the last full second of commits; latencies are moving averages
+ */
+struct ClientStats {
+    static constexpr uint64_t WINDOW_NS = 1000000000ULL;
+    
+    uint64_t commits = 0;                  // Toplevel commits since the window mapped
+    uint64_t damage_pixels = 0;            // Buffer pixels damaged since the window mapped
+    uint32_t commit_rate = 0;              // Commits per second
+    uint64_t damage_rate = 0;              // Damaged pixels per second
+    uint64_t window_start_ns = 0;          // Current rate window
+    uint32_t window_commits = 0;
+    uint64_t window_damage = 0;
+    
+    uint64_t shm_bytes = 0;                // Attached buffer, by type (one of them is 0)
+    uint64_t dmabuf_bytes = 0;
+    uint64_t shm_commits = 0;              // Buffer attaches by type (DMA-BUF skips the texture upload)
+    uint64_t dmabuf_commits = 0;
+    
+    uint64_t frame_sent_ns = 0;            // Oldest unanswered frame callback, 0 if none
+    uint64_t frame_latency_ns = 0;         // Frame callback -> next commit
+    uint64_t max_frame_latency_ns = 0;
+    
+    uint32_t configure_serial = 0;         // Last configure sent
+    uint64_t configure_sent_ns = 0;        // 0 once acked
+    uint64_t configure_rtt_ns = 0;         // Configure -> ack_configure
+    uint64_t max_configure_rtt_ns = 0;
+    
+    // No commit for a whole window: the last rates are stale
+    bool RatesCurrent(uint64_t now_ns) const { return now_ns - window_start_ns < 2 * WINDOW_NS; }
+};
+
 /**
  * Client represents a window/application
  * - Wraps a Wayland View
  * - Belongs to one or more tags
  * - Has properties like title, floating state, etc.
+ * - Owned by the ClientStore; geometry and state flags are stored in its
+ *   ClientColumns at GetId().index
  */
 class Client {
 public:
-    Client(Wayland::View* view);
+    Client(Wayland::View* view, ClientColumns* columns, ClientId id);
     ~Client();
     
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+    
+    // Stable window ID
+    ClientId GetId() const { return id_; }
+    
     // Client properties
     const std::string& GetTitle() const { return title_; }
     const std::string& GetAppId() const { return app_id_; }
     
     // State
-    bool IsFloating() const { return is_floating_; }
-    void SetFloating(bool floating);
+    bool IsFloating() const { return HasFlag(CLIENT_FLOATING); }
+    void SetFloating(bool floating) { SetFlag(CLIENT_FLOATING, floating); }
     
-    bool IsFullscreen() const { return is_fullscreen_; }
+    bool IsFullscreen() const { return HasFlag(CLIENT_FULLSCREEN); }
     void SetFullscreen(bool fullscreen);
+    void StoreFullscreen(bool fullscreen) { SetFlag(CLIENT_FULLSCREEN, fullscreen); }
+    
+    bool IsMapped() const { return HasFlag(CLIENT_MAPPED); }
+    void SetMapped(bool mapped) { SetFlag(CLIENT_MAPPED, mapped); }
     
-    bool IsMapped() const;
-    bool IsFocused() const { return is_focused_; }
-    void SetFocused(bool focused) { is_focused_ = focused; }
+    bool IsFocused() const { return HasFlag(CLIENT_FOCUSED); }
+    void SetFocused(bool focused) { SetFlag(CLIENT_FOCUSED, focused); }
     
-    bool IsVisible() const { return is_visible_; }
+    bool IsVisible() const { return HasFlag(CLIENT_VISIBLE); }
     void SetVisible(bool visible);
     
+    // Hidden or fully covered; tells xdg clients to stop animating
+    bool IsSuspended() const { return HasFlag(CLIENT_SUSPENDED); }
+    void SetSuspended(bool suspended);
+    
+    // When the window was last found hidden, 0 while it is shown
+    uint64_t GetHiddenSince() const { return hidden_since_ms_; }
+    void SetHiddenSince(uint64_t ms) { hidden_since_ms_ = ms; }
+    
     // Geometry
-    int GetX() const;
-    int GetY() const;
-    int GetWidth() const;
-    int GetHeight() const;
+    int GetX() const { return columns_->x[id_.index]; }
+    int GetY() const { return columns_->y[id_.index]; }
+    int GetWidth() const { return columns_->width[id_.index]; }
+    int GetHeight() const { return columns_->height[id_.index]; }
     
+    // Move/resize the window
     void SetPosition(int x, int y);
     void SetSize(int width, int height);
     void SetGeometry(int x, int y, int width, int height);
     
+    // Record geometry without touching the surface (e.g. after a client commit)
+    void StorePosition(int x, int y);
+    void StoreSize(int width, int height);
+    void StoreGeometry(int x, int y, int width, int height);
+    
+    // Tag membership, maintained by Tag::AddClient/RemoveClient (-1 if none)
+    int GetTagIndex() const { return columns_->tag_index[id_.index]; }
+    int GetOutputIndex() const { return columns_->output_index[id_.index]; }
+    void SetTagMembership(int tag_index, int output_index);
+    
+    // Resource accounting (see ClientStats)
+    void RecordCommit(uint64_t now_ns, uint64_t damage_pixels);
+    void RecordFrameCallback(uint64_t now_ns);
+    void RecordConfigure(uint32_t serial, uint64_t now_ns);
+    void RecordAckConfigure(uint32_t serial, uint64_t now_ns);
+    void RecordBuffer(uint64_t shm_bytes, uint64_t dmabuf_bytes);
+    const ClientStats& GetStats() const { return stats_; }
+    
+    // Frame-rate governor bookkeeping
+    FrameGovernorState& GetGovernorState() { return governor_; }
+    const FrameGovernorState& GetGovernorState() const { return governor_; }
+    
     // Wayland view access
     Wayland::View* GetView() const { return view_; }
     
@@ -58,14 +152,18 @@ private:
     void UpdateTitle();
     void UpdateAppId();
     
+    bool HasFlag(uint8_t flag) const { return (columns_->flags[id_.index] & flag) != 0; }
+    void SetFlag(uint8_t flag, bool value);
+
 private:
     Wayland::View* view_;
+    ClientColumns* columns_;
+    ClientId id_;
     std::string title_;
     std::string app_id_;
-    bool is_floating_;
-    bool is_fullscreen_;
-    bool is_focused_;
-    bool is_visible_;
+    uint64_t hidden_since_ms_ = 0;
+    FrameGovernorState governor_;
+    ClientStats stats_;
 };
 
 } // namespace Core
@@ -0,0 +1,63 @@
+#ifndef CORE_CLIENT_DATA_HPP
+#define CORE_CLIENT_DATA_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace Leviathan {
+namespace Core {
+
+/**
+ * ClientId - generational handle to a client in the ClientStore
+ * The index names a slot; the generation changes every time the slot is
+ * reused, so a handle to a closed window never resolves to a new one.
+ * Generation 0 is never issued and marks an invalid handle.
+ */
+struct ClientId {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+    
+    bool IsValid() const { return generation != 0; }
+    
+    // Stable window ID exposed over IPC
+    uint64_t ToU64() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+    static ClientId FromU64(uint64_t value) {
+        return ClientId{static_cast<uint32_t>(value & 0xffffffffu), static_cast<uint32_t>(value >> 32)};
+    }
+    
+    bool operator==(const ClientId& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const ClientId& other) const { return !(*this == other); }
+};
+
+/**
+ * Per-client state bits (ClientColumns::flags)
+ */
+enum ClientFlag : uint8_t {
+    CLIENT_MAPPED     = 1 << 0,
+    CLIENT_FLOATING   = 1 << 1,
+    CLIENT_FULLSCREEN = 1 << 2,
+    CLIENT_VISIBLE    = 1 << 3,
+    CLIENT_FOCUSED    = 1 << 4,
+    CLIENT_SUSPENDED  = 1 << 5,  // xdg_toplevel suspended state sent
+};
+
+/**
+ * ClientColumns - hot layout data of every client, one entry per store
+ * slot and one array per field, so layout and IPC passes walk contiguous
+ * memory instead of chasing Client and View pointers.
+ */
+struct ClientColumns {
+    std::vector<int32_t> x;
+    std::vector<int32_t> y;
+    std::vector<int32_t> width;
+    std::vector<int32_t> height;
+    std::vector<uint8_t> flags;
+    std::vector<int32_t> tag_index;     // Tag within its output, -1 if none
+    std::vector<int32_t> output_index;  // LayerManager::GetIndex() of the tag's output, -1 if none
+    uint64_t revision = 0;              // Bumped by every write, so readers can tell something changed
+};
+
+} // namespace Core
+} // namespace Leviathan
+
+#endif // CORE_CLIENT_DATA_HPP
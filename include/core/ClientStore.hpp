@@ -0,0 +1,63 @@
+#ifndef CORE_CLIENT_STORE_HPP
+#define CORE_CLIENT_STORE_HPP
+
+#include "core/Client.hpp"
+#include "core/ClientData.hpp"
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace Leviathan {
+namespace Core {
+
+/**
+ * ClientStore - owns every Client
+ * 
+ * A slot map: clients live in chunked slot storage (stable addresses, no
+ * allocation per window) and are named by generational ClientIds, so a
+ * stale ID looks up as nullptr instead of dangling. Layout state is kept
+ * alongside in ClientColumns.
+ */
+class ClientStore {
+public:
+    ClientStore() = default;
+    ~ClientStore();
+    
+    ClientStore(const ClientStore&) = delete;
+    ClientStore& operator=(const ClientStore&) = delete;
+    
+    // Create the client for a view (and link the view back to it)
+    Client* Create(Wayland::View* view);
+    
+    // Destroy a client; its ID stops resolving
+    void Destroy(ClientId id);
+    
+    // Destroy all clients
+    void Clear();
+    
+    // nullptr if the client is gone
+    Client* Get(ClientId id);
+    
+    // Live clients in creation order
+    const std::vector<Client*>& GetClients() const { return live_; }
+    size_t Size() const { return live_.size(); }
+    
+    ClientColumns& GetColumns() { return columns_; }
+    const ClientColumns& GetColumns() const { return columns_; }
+
+private:
+    struct Slot {
+        uint32_t generation = 1;
+        std::optional<Client> client;
+    };
+    
+    std::deque<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    std::vector<Client*> live_;
+    ClientColumns columns_;
+};
+
+} // namespace Core
+} // namespace Leviathan
+
+#endif // CORE_CLIENT_STORE_HPP
@@ -1,12 +1,15 @@
 #ifndef CORE_EVENTS_HPP
 #define CORE_EVENTS_HPP
 
-#include <functional>
-#include <vector>
-#include <memory>
-#include <mutex>
-#include <queue>
+#include "core/InplaceFunction.hpp"
+
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <thread>
+#include <tuple>
+#include <variant>
+#include <vector>
 
 // Forward declare IPC::Server
 namespace Leviathan {
@@ -39,21 +42,18 @@ enum class EventType {
 };
 
 /**
- * Base event data - all events inherit from this
+ * Event payloads
+ * Plain copyable structs; TYPE ties each one to its EventType
  */
-struct Event {
-    EventType type;
-    virtual ~Event() = default;
-};
 
 /**
  * Tag switch event - fired when active tag changes
  */
-struct TagSwitchedEvent : public Event {
+struct TagSwitchedEvent {
+    static constexpr EventType TYPE = EventType::TagSwitched;
+    
     TagSwitchedEvent(Tag* old_tag, Tag* new_tag, Screen* screen)
-        : old_tag(old_tag), new_tag(new_tag), screen(screen) {
-        type = EventType::TagSwitched;
-    }
+        : old_tag(old_tag), new_tag(new_tag), screen(screen) {}
     
     Tag* old_tag;      // Previously active tag (may be nullptr)
     Tag* new_tag;      // Newly active tag
@@ -63,11 +63,11 @@ struct TagSwitchedEvent : public Event {
 /**
  * Tag visibility event - fired when tag becomes visible/hidden
  */
-struct TagVisibilityChangedEvent : public Event {
+struct TagVisibilityChangedEvent {
+    static constexpr EventType TYPE = EventType::TagVisibilityChanged;
+    
     TagVisibilityChangedEvent(Tag* tag, bool visible)
-        : tag(tag), visible(visible) {
-        type = EventType::TagVisibilityChanged;
-    }
+        : tag(tag), visible(visible) {}
     
     Tag* tag;
     bool visible;
@@ -76,11 +76,11 @@ struct TagVisibilityChangedEvent : public Event {
 /**
  * Client added event
  */
-struct ClientAddedEvent : public Event {
+struct ClientAddedEvent {
+    static constexpr EventType TYPE = EventType::ClientAdded;
+    
     ClientAddedEvent(Client* client, Tag* tag)
-        : client(client), tag(tag) {
-        type = EventType::ClientAdded;
-    }
+        : client(client), tag(tag) {}
     
     Client* client;
     Tag* tag;
@@ -89,11 +89,11 @@ struct ClientAddedEvent : public Event {
 /**
  * Client removed event
  */
-struct ClientRemovedEvent : public Event {
+struct ClientRemovedEvent {
+    static constexpr EventType TYPE = EventType::ClientRemoved;
+    
     ClientRemovedEvent(Client* client, Tag* tag)
-        : client(client), tag(tag) {
-        type = EventType::ClientRemoved;
-    }
+        : client(client), tag(tag) {}
     
     Client* client;
     Tag* tag;
@@ -102,11 +102,11 @@ struct ClientRemovedEvent : public Event {
 /**
  * Client tag changed event
  */
-struct ClientTagChangedEvent : public Event {
+struct ClientTagChangedEvent {
+    static constexpr EventType TYPE = EventType::ClientTagChanged;
+    
     ClientTagChangedEvent(Client* client, Tag* old_tag, Tag* new_tag)
-        : client(client), old_tag(old_tag), new_tag(new_tag) {
-        type = EventType::ClientTagChanged;
-    }
+        : client(client), old_tag(old_tag), new_tag(new_tag) {}
     
     Client* client;
     Tag* old_tag;
@@ -116,11 +116,11 @@ struct ClientTagChangedEvent : public Event {
 /**
  * Client focused event
  */
-struct ClientFocusedEvent : public Event {
+struct ClientFocusedEvent {
+    static constexpr EventType TYPE = EventType::ClientFocused;
+    
     ClientFocusedEvent(Client* client)
-        : client(client) {
-        type = EventType::ClientFocused;
-    }
+        : client(client) {}
     
     Client* client;  // May be nullptr if focus cleared
 };
@@ -128,26 +128,43 @@ struct ClientFocusedEvent : public Event {
 /**
  * Layout changed event
  */
-struct LayoutChangedEvent : public Event {
+struct LayoutChangedEvent {
+    static constexpr EventType TYPE = EventType::LayoutChanged;
+    
     LayoutChangedEvent(Tag* tag)
-        : tag(tag) {
-        type = EventType::LayoutChanged;
-    }
+        : tag(tag) {}
     
     Tag* tag;
 };
 
 /**
  * Event listener callback type
+ * Inline storage only: capture pointers, not containers
  */
-using EventListener = std::function<void(const Event&)>;
+template<typename E>
+using EventListener = InplaceFunction<void(const E&)>;
 
 /**
  * EventBus - central event dispatcher
- * Allows components to subscribe to events and receive notifications
+ *
+ * Listeners are kept per event type and called synchronously on the
+ * compositor thread, followed by the IPC broadcast, so both see every
+ * event with its full payload. Publishing from inside a listener queues
+ * the event (fixed capacity) until the current dispatch finishes, which
+ * keeps delivery ordered without re-entering listeners.
+ *
+ * Other threads cannot publish directly: Publish() forwards them to
+ * Post(), a lock-free bounded inbox that the compositor drains once per
+ * event loop iteration (DrainInbox).
+ *
+ * Subscribing allocates; publishing and dispatching do not (apart from
+ * the IPC message when someone is subscribed to events).
  */
 class EventBus {
 public:
+    static constexpr size_t PENDING_CAPACITY = 64;   // Events published during dispatch
+    static constexpr size_t INBOX_CAPACITY = 256;    // Events posted from other threads
+    
     static EventBus& Instance() {
         static EventBus instance;
         return instance;
@@ -156,20 +173,54 @@ public:
     /**
      * Subscribe to an event type
      * Returns subscription ID that can be used to unsubscribe
+     * Compositor thread only
      */
-    int Subscribe(EventType type, EventListener listener);
+    template<typename E>
+    int Subscribe(EventListener<E> listener) {
+        int id = next_id_++;
+        
+        // From a listener: the list being walked must not reallocate under the
+        // running closure, so join it once the dispatch is over
+        if (dispatch_depth_ > 0) {
+            std::get<SubscriptionList<E>>(added_).push_back({id, std::move(listener)});
+            has_added_ = true;
+        } else {
+            ListenersFor<E>().push_back({id, std::move(listener)});
+        }
+        return id;
+    }
     
     /**
      * Unsubscribe from events using subscription ID
+     * Safe to call from a listener, including for itself
      */
     void Unsubscribe(int subscription_id);
     
     /**
-     * Publish an event to all subscribers
-     * Events are queued and processed serially to prevent re-entry
-     * Can be called from any thread
+     * Publish an event to all subscribers and IPC
+     * On the compositor thread this dispatches before returning (or after
+     * the current dispatch, when called from a listener). From any other
+     * thread it is equivalent to Post().
      */
-    void Publish(const Event& event);
+    template<typename E>
+    void Publish(const E& event) {
+        Publish(AnyEvent(event));
+    }
+    
+    /**
+     * Queue an event from any thread for the compositor to dispatch
+     * Returns false (and drops the event) if the inbox is full
+     */
+    template<typename E>
+    bool Post(const E& event) {
+        return Post(AnyEvent(event));
+    }
+    
+    /**
+     * Dispatch events posted from other threads
+     * Called by the compositor once per event loop iteration
+     */
+    void DrainInbox();
     
     /**
      * Clear all subscriptions (useful for cleanup)
@@ -178,37 +229,79 @@ public:
     
     /**
      * Set IPC server for broadcasting events
-     * When set, events will be broadcast via IPC instead of calling listeners directly
+     * Events reach IPC subscribers in addition to in-process listeners
      */
     void SetIPCServer(IPC::Server* server) { ipc_server_ = server; }
 
 private:
-    /**
-     * Process queued events one at a time
-     * Called internally by Publish
-     */
-    void ProcessEventQueue();
+    using AnyEvent = std::variant<std::monostate,
+                                  TagSwitchedEvent,
+                                  TagVisibilityChangedEvent,
+                                  ClientAddedEvent,
+                                  ClientRemovedEvent,
+                                  ClientTagChangedEvent,
+                                  ClientFocusedEvent,
+                                  LayoutChangedEvent>;
+    
+    template<typename E>
+    struct Subscription {
+        int id;  // 0 once unsubscribed during a dispatch, removed afterwards
+        EventListener<E> listener;
+    };
+    
+    template<typename E>
+    using SubscriptionList = std::vector<Subscription<E>>;
+    
+    using SubscriptionLists = std::tuple<SubscriptionList<TagSwitchedEvent>,
+                                         SubscriptionList<TagVisibilityChangedEvent>,
+                                         SubscriptionList<ClientAddedEvent>,
+                                         SubscriptionList<ClientRemovedEvent>,
+                                         SubscriptionList<ClientTagChangedEvent>,
+                                         SubscriptionList<ClientFocusedEvent>,
+                                         SubscriptionList<LayoutChangedEvent>>;
+    
+    template<typename E>
+    SubscriptionList<E>& ListenersFor() {
+        return std::get<SubscriptionList<E>>(subscriptions_);
+    }
     
-    EventBus() : next_id_(1), processing_queue_(false) {}
+    EventBus();
     ~EventBus() = default;
     
     // Delete copy/move constructors
     EventBus(const EventBus&) = delete;
     EventBus& operator=(const EventBus&) = delete;
     
-    struct Subscription {
-        int id;
-        EventType type;
-        EventListener listener;
-    };
+    void Publish(const AnyEvent& event);
+    bool Post(const AnyEvent& event);
+    void Dispatch(const AnyEvent& event);
+    template<typename E>
+    void Deliver(const E& event);
+    void Broadcast(const AnyEvent& event);
+    void CompactSubscriptions();
     
-    std::vector<Subscription> subscriptions_;
-    std::mutex mutex_;
-    int next_id_;
+    SubscriptionLists subscriptions_;
+    SubscriptionLists added_;  // Subscribed during a dispatch, appended afterwards
+    int next_id_ = 1;
+    bool has_unsubscribed_ = false;
+    bool has_added_ = false;
+    std::thread::id owner_thread_;
     
-    // Event queue for serialized processing
-    std::queue<std::shared_ptr<Event>> event_queue_;
-    std::atomic<bool> processing_queue_;
+    // Re-entrant publishes, drained by the outermost dispatch
+    int dispatch_depth_ = 0;
+    std::array<AnyEvent, PENDING_CAPACITY> pending_;
+    size_t pending_head_ = 0;
+    size_t pending_count_ = 0;
+    
+    // Bounded MPSC ring (Vyukov): a slot is writable when its sequence
+    // equals the producer's ticket and readable at ticket + 1
+    struct InboxSlot {
+        std::atomic<size_t> sequence;
+        AnyEvent event;
+    };
+    std::array<InboxSlot, INBOX_CAPACITY> inbox_;
+    std::atomic<size_t> inbox_tail_{0};
+    size_t inbox_head_ = 0;
     
     // IPC server for broadcasting events (optional)
     IPC::Server* ipc_server_ = nullptr;
@@ -0,0 +1,84 @@
+#ifndef CORE_FRAME_ARENA_HPP
+#define CORE_FRAME_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace Leviathan {
+namespace Core {
+
+/**
+ * FrameArena - bump allocator for per-frame scratch containers
+ * 
+ * Allocating is a pointer bump and deallocating does nothing; the whole
+ * arena is released by Reset(), which the output frame handler calls after
+ * every frame and the server calls after every event loop dispatch, so it
+ * stays bounded when no output renders. A frame that outgrows the block
+ * takes the overflow from the heap, and the next Reset() grows the block to
+ * fit, so a steady workload stops touching the heap after its first few
+ * frames.
+ * 
+ * Main thread only, and nothing allocated here may be kept past the
+ * current frame or event handler. Use it through FrameVector:
+ * 
+ *   FrameVector<View*> views = MakeFrameVector<View*>();
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    struct Stats {
+        size_t capacity = 0;      // Size of the bump block
+        size_t used = 0;          // Bytes handed out since the last reset
+        size_t high_water = 0;    // Most bytes used by a single frame
+        uint64_t overflows = 0;   // Heap allocations taken because the block was full
+        uint64_t resets = 0;
+    };
+    
+    static FrameArena& Instance();
+    
+    /**
+     * Release everything allocated since the last reset
+     * Grows the block first if this frame overflowed it
+     */
+    void Reset();
+    
+    Stats GetStats() const;
+
+private:
+    FrameArena();
+    ~FrameArena() override;
+    
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    
+    struct Overflow {
+        void* ptr;
+        size_t bytes;
+        size_t alignment;
+    };
+    
+    std::byte* block_ = nullptr;
+    size_t capacity_ = 0;
+    size_t offset_ = 0;
+    size_t overflow_bytes_ = 0;
+    std::vector<Overflow> overflow_;
+    Stats stats_;
+};
+
+template<typename T>
+using FrameVector = std::pmr::vector<T>;
+
+template<typename T>
+FrameVector<T> MakeFrameVector() {
+    return FrameVector<T>(&FrameArena::Instance());
+}
+
+} // namespace Core
+} // namespace Leviathan
+
+#endif // CORE_FRAME_ARENA_HPP
@@ -0,0 +1,106 @@
+#ifndef CORE_INPLACE_FUNCTION_HPP
+#define CORE_INPLACE_FUNCTION_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Leviathan {
+namespace Core {
+
+/**
+ * InplaceFunction - move-only std::function that never allocates
+ * 
+ * The callable lives in a fixed inline buffer. One that does not fit is a
+ * compile error instead of a heap allocation: capture a pointer to the
+ * state rather than the state itself.
+ */
+template<typename Signature, size_t Capacity = 48>
+class InplaceFunction;
+
+template<typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+public:
+    InplaceFunction() = default;
+    
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+    InplaceFunction(F&& f) {
+        using Callable = std::decay_t<F>;
+        static_assert(sizeof(Callable) <= Capacity,
+                      "Callable does not fit in InplaceFunction; capture less or raise Capacity");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                      "Over-aligned callables are not supported");
+        static_assert(std::is_nothrow_move_constructible_v<Callable>,
+                      "Callable must be nothrow move constructible");
+        
+        new (&storage_) Callable(std::forward<F>(f));
+        invoke_ = [](void* storage, Args... args) -> R {
+            return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...);
+        };
+        manage_ = [](void* dst, void* src) {
+            // Move into dst (if given), then destroy src
+            if (dst) {
+                new (dst) Callable(std::move(*static_cast<Callable*>(src)));
+            }
+            static_cast<Callable*>(src)->~Callable();
+        };
+    }
+    
+    InplaceFunction(InplaceFunction&& other) noexcept {
+        MoveFrom(other);
+    }
+    
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+    
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+    
+    ~InplaceFunction() {
+        Reset();
+    }
+    
+    R operator()(Args... args) const {
+        return invoke_(&storage_, std::forward<Args>(args)...);
+    }
+    
+    explicit operator bool() const { return invoke_ != nullptr; }
+    
+    void Reset() {
+        if (manage_) {
+            manage_(nullptr, &storage_);
+            invoke_ = nullptr;
+            manage_ = nullptr;
+        }
+    }
+
+private:
+    void MoveFrom(InplaceFunction& other) {
+        if (other.manage_) {
+            other.manage_(&storage_, &other.storage_);
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+            other.invoke_ = nullptr;
+            other.manage_ = nullptr;
+        }
+    }
+    
+    using Invoker = R (*)(void* storage, Args... args);
+    using Manager = void (*)(void* dst, void* src);
+    
+    mutable std::aligned_storage_t<Capacity, alignof(std::max_align_t)> storage_;
+    Invoker invoke_ = nullptr;
+    Manager manage_ = nullptr;
+};
+
+} // namespace Core
+} // namespace Leviathan
+
+#endif // CORE_INPLACE_FUNCTION_HPP
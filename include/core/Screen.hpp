@@ -38,6 +38,8 @@ public:
     // Position on global layout
     void SetPosition(int x, int y);
     void SetScale(float scale);
+    // Re-read mode size and scale after an output commit that changed them
+    void SyncFromOutput();
     
     // Tag displayed on this screen
     void ShowTag(Tag* tag);
@@ -0,0 +1,110 @@
+#ifndef CORE_SPAWN_HELPER_HPP
+#define CORE_SPAWN_HELPER_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Leviathan {
+namespace Core {
+
+/**
+ * SpawnHelper - launches programs from a small pre-forked helper process
+ * 
+ * Forking the compositor copies the page tables of every GPU and SHM mapping
+ * and stalls the main thread while it happens. Instead, Start() forks a
+ * helper once, at the top of main() while the process is still small. The
+ * compositor sends it argv plus the current environment over a socketpair;
+ * the helper posix_spawn()s the program in its own session and reaps it, so
+ * launched programs never become compositor children.
+ * 
+ * Spawn() only writes one message. The helper answers with the PID (or an
+ * errno) and its own timing; the compositor reads replies from GetFd() when
+ * it becomes readable, or on the next Spawn(). If the helper is not running,
+ * Spawn() falls back to posix_spawn() from the compositor itself.
+ * 
+ * Main thread only.
+ */
+class SpawnHelper {
+public:
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t spawned = 0;
+        uint64_t failed = 0;
+        uint64_t in_process = 0;          // Spawned without the helper
+        uint64_t total_stall_ns = 0;      // Main thread time inside Spawn()
+        uint64_t max_stall_ns = 0;
+        uint64_t total_latency_ns = 0;    // Request sent -> child created
+        uint64_t max_latency_ns = 0;
+    };
+    
+    static SpawnHelper& Instance();
+    
+    // Fork the helper (no-op if it runs). Call before threads and GPU setup
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return fd_ >= 0; }
+    
+    /**
+     * Launch argv[0] (searched in PATH) with argv
+     * label names the launch in the log; defaults to argv[0]
+     */
+    bool Spawn(const std::vector<std::string>& argv, const std::string& label = "");
+    
+    /**
+     * Launch a command line from the config or a menu entry. Plain words and
+     * double quotes are split and executed directly; anything that needs a
+     * shell (pipes, redirections, variables, globs, ...) goes to /bin/sh -c
+     */
+    bool SpawnCommand(const std::string& command, const std::string& label = "");
+    
+    // Reply socket; call DispatchReplies() when it is readable
+    int GetFd() const { return fd_; }
+    void DispatchReplies();
+    
+    Stats GetStats() const { return stats_; }
+
+private:
+    SpawnHelper() = default;
+    ~SpawnHelper();
+    
+    SpawnHelper(const SpawnHelper&) = delete;
+    SpawnHelper& operator=(const SpawnHelper&) = delete;
+    
+    bool SpawnInProcess(const std::vector<std::string>& argv, const std::string& label);
+    void ReapInProcess();
+    
+    struct Pending {
+        std::string label;
+        uint64_t sent_ns;
+    };
+    
+    int fd_ = -1;
+    int helper_pid_ = -1;
+    uint32_t next_request_ = 1;
+    std::unordered_map<uint32_t, Pending> pending_;
+    std::vector<int> in_process_children_;  // Fallback spawns still to be reaped
+    Stats stats_;
+};
+
+/**
+ * Split a desktop entry Exec= value into argv (Desktop Entry Specification,
+ * "The Exec key"): string escapes, double-quoted arguments, and field codes.
+ * %i expands to "--icon <icon>", %c to the name, %% to %; file and URL codes
+ * (%f %F %u %U) and deprecated ones are dropped since nothing is passed.
+ * Returns false for a malformed value (e.g. an unterminated quote).
+ */
+bool ParseDesktopExec(const std::string& exec, std::vector<std::string>& argv,
+                      const std::string& name = "", const std::string& icon = "");
+
+/**
+ * Split a command line into argv without a shell
+ * Returns false if the command uses shell syntax and has to go through sh -c
+ */
+bool SplitCommand(const std::string& command, std::vector<std::string>& argv);
+
+} // namespace Core
+} // namespace Leviathan
+
+#endif // CORE_SPAWN_HELPER_HPP
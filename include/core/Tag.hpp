@@ -20,11 +20,14 @@ class Client;
  */
 class Tag {
 public:
-    Tag(const std::string& name);
+    // index/output_index locate the tag on its screen (see LayerManager::GetIndex)
+    Tag(const std::string& name, int index = -1, int output_index = -1);
     ~Tag();
     
     // Tag properties
     const std::string& GetName() const { return name_; }
+    int GetIndex() const { return index_; }
+    int GetOutputIndex() const { return output_index_; }
     bool IsVisible() const { return visible_; }
     void SetVisible(bool visible);
     
@@ -45,6 +48,8 @@ public:
     
 private:
     std::string name_;
+    int index_;
+    int output_index_;
     bool visible_;
     std::vector<Client*> clients_;
     Client* focused_client_;
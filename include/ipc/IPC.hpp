@@ -5,6 +5,7 @@
 #include <map>
 #include <optional>
 #include <functional>
+#include <cstdint>
 
 namespace Leviathan {
 namespace IPC {
@@ -22,6 +23,11 @@ enum class CommandType {
     GET_VERSION,        // Get compositor version
     GET_PLUGIN_STATS,   // Get plugin memory statistics
     GET_WIDGET_TREE,    // Get status bar widget tree for debugging
+    GET_ICON_ATLAS,     // Get icon atlas occupancy
+    GET_FRAME_STATS,    // Get per-output frame time, allocations and frame arena usage
+    GET_XWAYLAND,       // Get Xwayland state, start count and memory
+    GET_CLIENT_STATS,   // Get per-client commit, damage, buffer memory and latency stats
+    GET_STATE_FD,       // Get the shared-memory state snapshot (ipc/StateSnapshot.h) as an fd
     PING,              // Simple ping/pong for testing
     SHUTDOWN,          // Gracefully shutdown the compositor (requires UID match)
     EXECUTE_ACTION,    // Execute an action by name
@@ -31,9 +37,13 @@ enum class CommandType {
 
 enum class EventType {
     TAG_SWITCHED,
+    TAG_VISIBILITY_CHANGED,
     CLIENT_ADDED,
     CLIENT_REMOVED,
+    CLIENT_TAG_CHANGED,
+    CLIENT_FOCUSED,
     TILING_MODE_CHANGED,
+    STATE_CHANGED,      // New state snapshot published (data: sequence)
     UNKNOWN
 };
 
@@ -49,13 +59,21 @@ struct TagInfo {
 };
 
 struct ClientInfo {
+    uint64_t id = 0;  // Stable window ID (Core::ClientId), never reused
     std::string title;
     std::string app_id;
     int x, y;
     int width, height;
     bool floating;
     bool fullscreen;
+    bool suspended = false;  // Hidden long enough to get the xdg suspended state
     std::string tag;
+    uint64_t shm_commits = 0;
+    uint64_t dmabuf_commits = 0;
+    uint32_t commit_rate = 0;      // Commits per second (ClientStats, as in get_client_stats)
+    int frame_cap = 0;             // Frame callbacks per second, 0 = uncapped
+    bool throttled = false;        // In a commit storm: callbacks capped, commits deferred
+    uint64_t throttle_events = 0;
 };
 
 struct OutputInfo {
@@ -70,6 +88,11 @@ struct OutputInfo {
     int phys_height_mm;       // Physical height in millimeters
     float scale;
     bool enabled;
+    std::string adaptive_sync = "off";  // Configured VRR mode: off, on, auto
+    bool adaptive_sync_wanted = false;  // VRR requested by the policy right now
+    bool adaptive_sync_active = false;  // VRR enabled on the output
+    bool tearing_allowed = false;
+    bool tearing_active = false;        // Last frame was an async page flip
 };
 
 struct PluginStats {
@@ -79,6 +102,22 @@ struct PluginStats {
     int instance_count;
 };
 
+struct ClientStatsInfo {
+    uint64_t id = 0;
+    std::string app_id;
+    std::string title;
+    bool xwayland = false;
+    uint64_t commits = 0;
+    uint32_t commit_rate = 0;           // Commits per second
+    uint64_t damage_rate = 0;           // Damaged buffer pixels per second
+    uint64_t shm_bytes = 0;             // Attached buffer memory
+    uint64_t dmabuf_bytes = 0;
+    uint64_t frame_latency_us = 0;      // Frame callback -> next commit (moving average)
+    uint64_t max_frame_latency_us = 0;
+    uint64_t configure_rtt_us = 0;      // Configure -> ack_configure (moving average)
+    uint64_t max_configure_rtt_us = 0;
+};
+
 struct Response {
     bool success;
     std::string error;
@@ -87,6 +126,8 @@ struct Response {
     std::vector<ClientInfo> clients;
     std::vector<OutputInfo> outputs;
     std::vector<PluginStats> plugin_stats;
+    std::vector<ClientStatsInfo> client_stats;
+    int fd = -1;  // Passed along with the reply (SCM_RIGHTS); not owned by the response
 };
 
 // IPC Server - runs in compositor
@@ -110,6 +151,7 @@ public:
     
     // Broadcast an event to all subscribed clients
     void BroadcastEvent(const EventMessage& event);
+    bool HasEventSubscribers() const { return !event_subscriber_fds.empty(); }
     
 private:
     int socket_fd;
@@ -121,6 +163,7 @@ private:
     
     void AcceptClient();
     void HandleClient(int client_fd);
+    void SendWithFd(int client_fd, const std::string& message, int fd);
     Response ProcessCommand(const std::string& command_str);
     bool GetPeerUid(int client_fd, uid_t& uid);
 };
@@ -134,6 +177,10 @@ public:
     bool Connect();
     std::optional<Response> SendCommand(CommandType type, const std::map<std::string, std::string>& args = {});
     
+    // Turn this connection into an event subscription; events arrive on GetFd()
+    bool Subscribe();
+    int GetFd() const { return socket_fd; }
+    
 private:
     int socket_fd;
     std::string socket_path;
@@ -0,0 +1,146 @@
+/*
+ * LeviathanDM shared-memory state snapshot
+ *
+ * The compositor publishes tags, outputs, clients and focus into a sealed,
+ * read-only memfd. Get the fd once with the get_state_fd IPC command (it
+ * arrives as SCM_RIGHTS ancillary data next to the JSON reply), mmap() it
+ * PROT_READ/MAP_SHARED and read it without further syscalls.
+ *
+ * The snapshot is guarded by a seqlock: sequence is odd while the compositor
+ * writes and advances by 2 per publish. Copy what you need between
+ * leviathan_state_read_begin() and leviathan_state_read_retry(), and start
+ * over if the latter returns true; leviathan_state_copy() does exactly that.
+ * A state_changed event on the IPC event subscription announces every new
+ * sequence, for readers that would rather not poll.
+ *
+ * Plain C (GCC/Clang atomics), no dependencies beyond libc.
+ */
+#ifndef LEVIATHAN_STATE_SNAPSHOT_H
+#define LEVIATHAN_STATE_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define LEVIATHAN_STATE_MAGIC       0x5453564cu  /* "LVST" */
+#define LEVIATHAN_STATE_VERSION     1u
+
+#define LEVIATHAN_STATE_MAX_OUTPUTS 16
+#define LEVIATHAN_STATE_MAX_TAGS    128
+#define LEVIATHAN_STATE_MAX_CLIENTS 256
+#define LEVIATHAN_STATE_NAME_LEN    32
+#define LEVIATHAN_STATE_APP_ID_LEN  64
+#define LEVIATHAN_STATE_TITLE_LEN   128
+
+/* Tag layouts */
+enum leviathan_state_layout {
+    LEVIATHAN_LAYOUT_MASTER_STACK = 0,
+    LEVIATHAN_LAYOUT_MONOCLE = 1,
+    LEVIATHAN_LAYOUT_FLOATING = 2,
+    LEVIATHAN_LAYOUT_GRID = 3,
+};
+
+/* leviathan_state_client.flags */
+#define LEVIATHAN_CLIENT_MAPPED     (1u << 0)
+#define LEVIATHAN_CLIENT_FLOATING   (1u << 1)
+#define LEVIATHAN_CLIENT_FULLSCREEN (1u << 2)
+#define LEVIATHAN_CLIENT_VISIBLE    (1u << 3)
+#define LEVIATHAN_CLIENT_FOCUSED    (1u << 4)
+#define LEVIATHAN_CLIENT_SUSPENDED  (1u << 5)
+#define LEVIATHAN_CLIENT_XWAYLAND   (1u << 8)
+
+/* Strings are NUL-terminated and cut at the field size */
+
+struct leviathan_state_output {
+    char name[LEVIATHAN_STATE_NAME_LEN];
+    int32_t id;                 /* Referenced by tags and clients */
+    int32_t x, y;               /* Layout coordinates */
+    int32_t width, height;
+    int32_t refresh_mhz;
+    int32_t current_tag;        /* Index among this output's tags, -1 if none */
+    uint32_t layout;            /* enum leviathan_state_layout of the current tag */
+    float scale;
+    uint32_t enabled;
+};
+
+struct leviathan_state_tag {
+    char name[LEVIATHAN_STATE_NAME_LEN];
+    int32_t output_id;
+    int32_t index;              /* Position on its output */
+    uint32_t client_count;
+    uint32_t layout;            /* enum leviathan_state_layout */
+    uint32_t visible;
+    uint32_t reserved;
+};
+
+struct leviathan_state_client {
+    uint64_t id;                /* Stable window ID, as in the IPC replies */
+    int32_t x, y;
+    int32_t width, height;
+    uint32_t flags;             /* LEVIATHAN_CLIENT_* */
+    int32_t output_id;          /* -1 if the client has no tag */
+    int32_t tag_index;          /* Index among that output's tags, -1 if none */
+    uint32_t reserved;
+    char app_id[LEVIATHAN_STATE_APP_ID_LEN];
+    char title[LEVIATHAN_STATE_TITLE_LEN];
+};
+
+struct leviathan_state {
+    uint32_t magic;             /* LEVIATHAN_STATE_MAGIC */
+    uint32_t version;           /* LEVIATHAN_STATE_VERSION */
+    uint32_t size;              /* sizeof(struct leviathan_state) */
+    uint32_t sequence;          /* Seqlock, odd while being written */
+    uint64_t published_ns;      /* CLOCK_MONOTONIC time of the last publish */
+    uint64_t focused_client;    /* Client id, 0 if nothing has focus */
+    int32_t focused_output;     /* Output id, -1 if none */
+    uint32_t output_count;
+    uint32_t tag_count;
+    uint32_t client_count;
+    uint32_t truncated;         /* Non-zero if a list hit its LEVIATHAN_STATE_MAX_* */
+    uint32_t reserved;
+    struct leviathan_state_output outputs[LEVIATHAN_STATE_MAX_OUTPUTS];
+    struct leviathan_state_tag tags[LEVIATHAN_STATE_MAX_TAGS];
+    struct leviathan_state_client clients[LEVIATHAN_STATE_MAX_CLIENTS];
+};
+
+/* Start a read; an odd value means a write is in progress */
+static inline uint32_t leviathan_state_read_begin(const struct leviathan_state* state) {
+    return __atomic_load_n(&state->sequence, __ATOMIC_ACQUIRE);
+}
+
+/* Non-zero if what was read since read_begin() may be torn */
+static inline int leviathan_state_read_retry(const struct leviathan_state* state, uint32_t sequence) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return (sequence & 1u) || __atomic_load_n(&state->sequence, __ATOMIC_RELAXED) != sequence;
+}
+
+/*
+ * Copy a consistent snapshot of the header and the used list entries
+ * Returns 0 on success, -1 if the compositor kept writing for max_attempts
+ */
+static inline int leviathan_state_copy(const struct leviathan_state* state, struct leviathan_state* out,
+                                       int max_attempts) {
+    for (int attempt = 0; attempt < max_attempts; attempt++) {
+        uint32_t sequence = leviathan_state_read_begin(state);
+        if (sequence & 1u) {
+            continue;
+        }
+
+        memcpy(out, state, offsetof(struct leviathan_state, outputs));
+
+        /* Counts of a torn read can be anything; stay inside the arrays */
+        if (out->output_count > LEVIATHAN_STATE_MAX_OUTPUTS) out->output_count = LEVIATHAN_STATE_MAX_OUTPUTS;
+        if (out->tag_count > LEVIATHAN_STATE_MAX_TAGS) out->tag_count = LEVIATHAN_STATE_MAX_TAGS;
+        if (out->client_count > LEVIATHAN_STATE_MAX_CLIENTS) out->client_count = LEVIATHAN_STATE_MAX_CLIENTS;
+        memcpy(out->outputs, state->outputs, out->output_count * sizeof(out->outputs[0]));
+        memcpy(out->tags, state->tags, out->tag_count * sizeof(out->tags[0]));
+        memcpy(out->clients, state->clients, out->client_count * sizeof(out->clients[0]));
+
+        if (!leviathan_state_read_retry(state, sequence)) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+#endif /* LEVIATHAN_STATE_SNAPSHOT_H */
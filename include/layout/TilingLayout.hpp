@@ -3,6 +3,7 @@
 
 #include "Types.hpp"
 #include <wlr/util/box.h>
+#include <memory_resource>
 #include <vector>
 
 namespace Leviathan {
@@ -11,16 +12,16 @@ class TilingLayout {
 public:
     TilingLayout();
     
-    // Apply different layouts
-    void ApplyMasterStack(std::vector<Wayland::View*>& views,
+    // Apply different layouts (views is per-frame scratch, see Core::FrameArena)
+    void ApplyMasterStack(std::pmr::vector<Wayland::View*>& views,
                          int master_count, float master_ratio,
                          int screen_width, int screen_height,
                          int gap_size);
     
-    void ApplyMonocle(std::vector<Wayland::View*>& views,
+    void ApplyMonocle(std::pmr::vector<Wayland::View*>& views,
                      int screen_width, int screen_height);
     
-    void ApplyGrid(std::vector<Wayland::View*>& views,
+    void ApplyGrid(std::pmr::vector<Wayland::View*>& views,
                   int screen_width, int screen_height,
                   int gap_size);
     
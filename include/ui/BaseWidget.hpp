@@ -35,6 +35,10 @@ public:
     // This only DRAWS using pre-calculated data
     virtual void Render(cairo_t* cr) = 0;
     
+    // Cached 1x1 context for text measurement in CalculateSize(), one per
+    // thread. Wrap font changes in cairo_save()/cairo_restore().
+    static cairo_t* GetMeasureContext();
+    
     // Position and size (set by parent container during layout)
     // These are only modified on main thread during layout, so no locking needed
     void SetPosition(int x, int y) { 
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <chrono>
 
 namespace Leviathan {
 
@@ -26,7 +28,9 @@ public:
     virtual ~CompositorState() = default;
     
     // Screen queries
-    virtual std::vector<Core::Screen*> GetScreens() const = 0;
+    // List getters returning references hand out the compositor's own
+    // storage: copy the list if it has to survive a frame
+    virtual const std::vector<Core::Screen*>& GetScreens() const = 0;
     virtual Core::Screen* GetFocusedScreen() const = 0;
     
     // Tag queries
@@ -37,8 +41,8 @@ public:
     virtual void SwitchToTag(int tag_index) = 0;
     
     // Client queries
-    virtual std::vector<Core::Client*> GetAllClients() const = 0;
-    virtual std::vector<Core::Client*> GetClientsOnTag(Core::Tag* tag) const = 0;
+    virtual const std::vector<Core::Client*>& GetAllClients() const = 0;
+    virtual const std::vector<Core::Client*>& GetClientsOnTag(Core::Tag* tag) const = 0;
     virtual std::vector<Core::Client*> GetClientsOnScreen(Core::Screen* screen) const = 0;
     virtual Core::Client* GetFocusedClient() const = 0;
 };
@@ -50,6 +54,16 @@ public:
 CompositorState* GetCompositorState();
 void SetCompositorState(CompositorState* state);
 
+/**
+ * Widget polling pause, set by the compositor while the session is idle
+ * Polling widgets wait through WaitForWidgetUpdate() instead of sleeping:
+ * it returns after `interval`, or right away when updates resume, and
+ * blocks for as long as updates are paused (until `running` drops).
+ */
+void SetWidgetUpdatesPaused(bool paused);
+bool AreWidgetUpdatesPaused();
+void WaitForWidgetUpdate(std::chrono::milliseconds interval, const std::atomic<bool>& running);
+
 } // namespace UI
 } // namespace Leviathan
 
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cairo.h>
+
+namespace Leviathan {
+namespace UI {
+
+/**
+ * @brief Packs same-sized icons into shared ARGB32 pages
+ * 
+ * Each page is one image surface with one cached source pattern, so painting
+ * an icon is a pattern translate + rectangle fill instead of creating a new
+ * source for a separately allocated surface.
+ * 
+ * Space is handed out by a shelf allocator: a page is split into horizontal
+ * shelves, an icon goes into the tightest shelf that still has room (or a gap
+ * left by a removed icon), and a new shelf is opened below the last one when
+ * nothing fits. Removing icons leaves gaps; once less than half of the shelf
+ * area is live the atlas is compacted by repacking every icon into fresh
+ * pages. Handles stay valid across compaction.
+ */
+class IconAtlas {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle INVALID_HANDLE = 0;
+    
+    struct Stats {
+        size_t pages = 0;
+        size_t page_bytes = 0;     // Pixel memory held by pages
+        size_t icons = 0;
+        size_t icon_bytes = 0;     // Pixel memory covered by live icons
+        size_t shelf_bytes = 0;    // Pixel memory claimed by shelves
+        uint64_t compactions = 0;
+    };
+    
+    // icon_size picks the page size (enough for a few dozen icons per page)
+    explicit IconAtlas(int icon_size);
+    ~IconAtlas();
+    
+    IconAtlas(const IconAtlas&) = delete;
+    IconAtlas& operator=(const IconAtlas&) = delete;
+    
+    /**
+     * @brief Copy an ARGB32 image surface into the atlas
+     * @return Handle, or INVALID_HANDLE if the image is too large for a page
+     */
+    Handle Insert(cairo_surface_t* image);
+    
+    // Release an icon's space (may compact the atlas)
+    void Remove(Handle handle);
+    
+    // Paint an icon with its top-left corner at (x, y) in user space
+    void Paint(cairo_t* cr, Handle handle, double x, double y) const;
+    
+    int GetWidth(Handle handle) const;
+    int GetHeight(Handle handle) const;
+    size_t GetBytes(Handle handle) const;
+    
+    Stats GetStats() const;
+
+private:
+    struct Gap {
+        int x;
+        int width;
+    };
+    
+    struct Shelf {
+        int y;
+        int height;
+        int cursor = 0;        // Start of the unused tail
+        std::vector<Gap> gaps; // Space released by removed icons
+    };
+    
+    struct Page {
+        cairo_surface_t* surface = nullptr;
+        cairo_pattern_t* pattern = nullptr;
+        std::vector<Shelf> shelves;
+        int next_shelf_y = 0;
+        size_t live_area = 0;
+    };
+    
+    struct Slot {
+        int page = -1;  // -1 = free slot
+        int shelf = 0;
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        uint32_t next_free = 0;  // Free list link (index + 1, 0 = end)
+    };
+    
+    bool Allocate(int width, int height, Slot& slot);
+    bool AllocateInPage(int page_index, int width, int height, Slot& slot);
+    void Release(const Slot& slot);
+    int AddPage();
+    void DestroyPage(Page& page);
+    void MaybeCompact();
+    void Compact();
+    
+    static void Blit(cairo_surface_t* src, int src_x, int src_y,
+                     cairo_surface_t* dst, int dst_x, int dst_y, int width, int height);
+    
+    int icon_size_;
+    int page_size_;
+    std::vector<std::unique_ptr<Page>> pages_;
+    
+    // Handle = slot index + 1
+    std::vector<Slot> slots_;
+    uint32_t free_slots_ = 0;
+    size_t live_count_ = 0;
+    size_t live_area_ = 0;
+    uint64_t compactions_ = 0;
+    
+    // Shelves are reused for icons at most this much shorter than the shelf
+    static constexpr double SHELF_SLACK = 1.25;
+};
+
+} // namespace UI
+} // namespace Leviathan
@@ -1,12 +1,25 @@
 #pragma once
 
+#include "ui/IconThemeIndex.hpp"
+#include "ui/IconAtlas.hpp"
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <list>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
 #include <cairo.h>
 #include <gdk-pixbuf/gdk-pixbuf.h>
 
+struct wl_event_loop;
+struct wl_event_source;
+
 namespace Leviathan {
 namespace UI {
 
@@ -15,31 +28,65 @@ namespace UI {
  * 
  * Supports loading icons from:
  * - Absolute paths
- * - Icon names (searches icon theme directories)
+ * - Icon names (looked up in the icon theme, its Inherits chain, hicolor,
+ *   then unthemed directories like /usr/share/pixmaps)
  * - Supports PNG, SVG, and other formats via gdk-pixbuf
+ * 
+ * Theme directories are indexed once (see IconThemeIndex) instead of being
+ * probed with stat() per candidate path.
+ * 
+ * When constructed with an event loop, decoding happens on a worker thread:
+ * LoadIcon() returns a placeholder while the icon is being decoded and the
+ * ready callback fires on the main loop once it is available. Without an
+ * event loop icons are decoded synchronously.
+ * 
+ * Decoded icons are packed into one IconAtlas per icon size and painted
+ * through the atlas page's cached pattern. The cache is LRU, bounded by the
+ * bytes of live icons; evicted icons free their atlas space.
  */
 class IconLoader {
 public:
-    IconLoader();
+    explicit IconLoader(struct wl_event_loop* event_loop = nullptr);
     ~IconLoader();
     
     /**
-     * @brief Load an icon and return a Cairo surface
+     * @brief Load an icon (if needed) and paint it
      * 
+     * @param cr Cairo context to paint into
      * @param icon_name Icon name or path
      * @param size Desired icon size in pixels
-     * @return Cairo surface with the icon, or nullptr if not found
-     * 
-     * The returned surface is owned by the IconLoader and cached.
-     * Do not destroy it manually.
+     * @param x, y Top-left corner of the icon in user space
+     * @return true if the icon, or a placeholder while it is still being
+     *         decoded, was painted; false if the icon was not found
+     */
+    bool DrawIcon(cairo_t* cr, const std::string& icon_name, int size, double x, double y);
+    
+    /**
+     * @brief Called on the main loop after one or more pending icons were decoded
+     */
+    void SetOnIconReady(std::function<void()> callback) { on_icon_ready_ = std::move(callback); }
+    
+    /**
+     * @brief Set the icon theme (default: gtk-icon-theme-name from GTK settings, else hicolor)
+     */
+    void SetTheme(const std::string& theme);
+    
+    /**
+     * @brief Limit the decoded surface cache (bytes of pixel data)
+     */
+    void SetCacheBudget(size_t bytes);
+    size_t GetCacheBytes() const { return cache_bytes_; }
+    
+    /**
+     * @brief Occupancy of the icon atlases, by icon size
      */
-    cairo_surface_t* LoadIcon(const std::string& icon_name, int size);
+    std::map<int, IconAtlas::Stats> GetAtlasStats() const;
     
     /**
      * @brief Clear the icon cache
      */
     void ClearCache();
-    
+
 private:
     struct IconCacheKey {
         std::string name;
@@ -56,21 +103,89 @@ private:
         }
     };
     
-    // Cache: icon_name+size -> cairo_surface
-    std::unordered_map<IconCacheKey, cairo_surface_t*, IconCacheKeyHash> cache_;
+    struct CacheEntry {
+        IconAtlas::Handle handle;
+        size_t bytes;
+        std::list<IconCacheKey>::iterator lru;  // Position in lru_ (front = most recent)
+    };
+    
+    struct DecodeJob {
+        IconCacheKey key;
+        std::string path;
+    };
+    
+    struct DecodeResult {
+        IconCacheKey key;
+        cairo_surface_t* surface;  // nullptr if decoding failed
+    };
+    
+    // Cache: icon_name+size -> atlas slot, LRU-evicted by bytes
+    std::unordered_map<IconCacheKey, CacheEntry, IconCacheKeyHash> cache_;
+    std::list<IconCacheKey> lru_;
+    size_t cache_bytes_ = 0;
+    size_t cache_budget_ = 8 * 1024 * 1024;
+    
+    // Icons known to be missing (or undecodable)
+    std::unordered_set<IconCacheKey, IconCacheKeyHash> missing_;
+    
+    // Icons queued for or being decoded
+    std::unordered_set<IconCacheKey, IconCacheKeyHash> pending_;
+    
+    // One atlas per icon size
+    std::unordered_map<int, std::unique_ptr<IconAtlas>> atlases_;
+    
+    // Placeholder per size (kept in that size's atlas, never evicted),
+    // shown while an icon is decoding
+    std::unordered_map<int, IconAtlas::Handle> placeholders_;
     
     // Icon theme search paths
     std::vector<std::string> icon_theme_paths_;
+    std::string theme_;
+    std::string index_cache_dir_;
+    
+    // Theme name -> one index per search path that has that theme
+    std::unordered_map<std::string, std::vector<std::unique_ptr<IconThemeIndex>>> themes_;
+    
+    // Unthemed icons (files directly in a search path, e.g. /usr/share/pixmaps)
+    std::unordered_map<std::string, std::string> unthemed_;
+    bool unthemed_scanned_ = false;
+    
+    // Async decoding
+    struct wl_event_loop* event_loop_;
+    struct wl_event_source* wake_source_ = nullptr;
+    int wake_fd_ = -1;
+    std::thread worker_;
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<DecodeJob> jobs_;
+    std::vector<DecodeResult> results_;
+    bool stop_worker_ = false;
+    std::function<void()> on_icon_ready_;
     
     /**
-     * @brief Find icon file in theme directories
+     * @brief Find icon file via the theme indexes
      */
     std::string FindIconFile(const std::string& icon_name, int size);
+    const std::vector<std::unique_ptr<IconThemeIndex>>& GetTheme(const std::string& theme);
+    std::string LookupInTheme(const std::string& theme, const std::string& icon_name, int size,
+                              std::unordered_set<std::string>& visited);
+    void ScanUnthemed();
     
     /**
-     * @brief Load icon from file using gdk-pixbuf
+     * @brief Load icon from file using gdk-pixbuf (thread safe)
      */
-    cairo_surface_t* LoadIconFromFile(const std::string& filepath, int size);
+    static cairo_surface_t* LoadIconFromFile(const std::string& filepath, int size);
+    
+    // Cache helpers (Insert takes ownership of the surface)
+    bool Insert(const IconCacheKey& key, cairo_surface_t* surface);
+    void EvictToBudget();
+    IconAtlas& GetAtlas(int size);
+    IconAtlas::Handle GetPlaceholder(int size);
+    
+    // Worker thread
+    bool StartWorker();
+    void WorkerLoop();
+    static int OnDecodeReady(int fd, uint32_t mask, void* data);
 };
 
 } // namespace UI
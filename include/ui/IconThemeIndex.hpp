@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Leviathan {
+namespace UI {
+
+/**
+ * @brief Index of one icon theme directory (e.g. /usr/share/icons/hicolor)
+ * 
+ * Built by parsing index.theme and listing each icon directory exactly once,
+ * producing a hash map of icon name -> the directories that contain it.
+ * Lookups after that are pure in-memory work, no stat() per candidate.
+ * 
+ * The index is persisted under the cache directory and reused as long as
+ * the mtimes of index.theme, the theme root and every icon directory are
+ * unchanged (a directory's mtime moves whenever a file is added or removed),
+ * so a cold start costs one stat per directory instead of a full rescan.
+ * 
+ * Themes without an index.theme (common for ~/.local/share/icons/<theme>)
+ * are indexed by discovering "<size>x<size>[@scale]/<context>" and
+ * "scalable/<context>" directories.
+ */
+class IconThemeIndex {
+public:
+    enum class DirType : uint8_t { Fixed, Scalable, Threshold };
+    
+    struct Directory {
+        std::string path;  // Relative to the theme root
+        int size = 0;
+        int scale = 1;
+        int min_size = 0;
+        int max_size = 0;
+        int threshold = 2;
+        DirType type = DirType::Threshold;
+        int64_t mtime = 0;
+    };
+    
+    // Open an index for a theme root, from the on-disk cache if still valid
+    // (cache_dir may be empty to disable persistence)
+    static std::unique_ptr<IconThemeIndex> Open(const std::string& theme_root, const std::string& cache_dir);
+    
+    const std::string& GetRoot() const { return root_; }
+    const std::vector<std::string>& GetInherits() const { return inherits_; }
+    size_t GetIconCount() const { return icons_.size(); }
+    
+    /**
+     * @brief Find the best file for an icon at a given size
+     * 
+     * @param distance Set to 0 for an exact size match, otherwise the size
+     *                 distance per the icon theme spec (lower is better)
+     * @return Full path, or an empty string if this theme has no such icon
+     */
+    std::string Lookup(const std::string& name, int size, int scale, int& distance) const;
+
+private:
+    struct Entry {
+        uint16_t dir;  // Index into directories_
+        uint8_t ext;   // Index into the extension table
+    };
+    
+    IconThemeIndex() = default;
+    
+    bool ParseIndexTheme(const std::string& path);
+    void DiscoverDirectories();
+    void Scan();
+    bool LoadCache(const std::string& cache_path);
+    void SaveCache(const std::string& cache_path) const;
+    
+    static bool MatchesSize(const Directory& dir, int size, int scale);
+    static int SizeDistance(const Directory& dir, int size, int scale);
+    static int64_t GetMtime(const std::string& path);
+    
+    std::string root_;
+    int64_t root_mtime_ = 0;
+    int64_t index_theme_mtime_ = 0;  // 0 = no index.theme
+    std::vector<std::string> inherits_;
+    std::vector<Directory> directories_;
+    std::unordered_map<std::string, std::vector<Entry>> icons_;
+};
+
+} // namespace UI
+} // namespace Leviathan
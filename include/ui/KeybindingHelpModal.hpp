@@ -32,9 +32,21 @@ public:
     void PopulateKeybindings();
     
 private:
+    // Row kinds in the virtualized keybinding list (also the recycle pool key)
+    enum class RowType {
+        Header = 0,     // Column titles (index 0)
+        Category = 1,   // Category heading (entry with empty keys)
+        Binding = 2     // Key / action / description
+    };
+    
     // Build the widget tree for displaying keybindings
     void BuildWidgetContent();
     
+    // Item builder for the virtualized ScrollView - only called for rows
+    // that scroll into view, reusing rows of the same type when possible
+    RowType GetRowType(size_t index) const;
+    std::shared_ptr<Widget> BuildRow(size_t index, std::shared_ptr<Widget> recycled);
+    
     std::vector<KeybindingEntry> keybindings_;
 };
 
@@ -5,6 +5,8 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <deque>
+#include <queue>
 #include <mutex>
 #include <functional>
 #include <cstdint>
@@ -13,6 +15,7 @@
 typedef struct _GDBusMethodInvocation GDBusMethodInvocation;
 typedef struct _GVariant GVariant;
 typedef unsigned int guint;
+struct wl_event_source;
 
 namespace Leviathan {
 
@@ -35,14 +38,29 @@ struct NotificationData {
     int32_t expire_timeout;  // Milliseconds, -1 = default, 0 = never
     
     // Display state
-    uint64_t created_time;
-    uint64_t expire_time;
-    bool is_resident;  // From hints["resident"]
-    uint8_t urgency;   // 0=low, 1=normal, 2=critical
+    uint64_t created_time = 0;
+    uint64_t expire_time = 0;  // steady_clock ms, 0 = never
+    bool is_resident = false;  // From hints["resident"]
+    uint8_t urgency = 1;       // 0=low, 1=normal, 2=critical
+    uint32_t revision = 0;     // Bumped when replaced (invalidates cached card layout)
     
     ~NotificationData();
 };
 
+/**
+ * @brief A closed notification kept for the history (no hints/actions)
+ */
+struct NotificationHistoryEntry {
+    uint32_t id;
+    std::string app_name;
+    std::string summary;
+    std::string body;
+    uint64_t created_time;
+    uint32_t close_reason;
+};
+
+class NotificationPresenter;
+
 /**
  * @brief Notification daemon implementing org.freedesktop.Notifications spec
  * 
@@ -100,8 +118,9 @@ public:
     void Shutdown();
     
     /**
-     * @brief Update notifications (check for expired, trigger renders)
-     * Call this from the main loop periodically
+     * @brief Dispatch pending DBus calls without blocking
+     * Call this from the main loop. Expiry and rendering are driven by
+     * timers on the Wayland event loop, so this does no per-notification work.
      */
     void Update();
     
@@ -115,6 +134,12 @@ public:
      */
     void CloseNotification(uint32_t id, CloseReason reason);
     
+    /**
+     * @brief Get recently closed notifications, oldest first
+     * Bounded by NotificationsConfig::history_size
+     */
+    std::vector<NotificationHistoryEntry> GetHistory() const;
+    
     /**
      * @brief Set callback for when notifications change (for status bar widgets)
      */
@@ -152,10 +177,16 @@ private:
     // Notification management
     uint32_t GenerateNotificationId();
     NotificationData* FindNotification(uint32_t id);
-    void RemoveNotification(uint32_t id);
+    void RemoveNotification(uint32_t id, CloseReason reason);  // Caller holds notifications_mutex_
+    void EnforceHistoryLimit();
     void ProcessExpiredNotifications();
     
-    // Rendering (will be called to create Wayland surfaces)
+    // Expiry deadlines: one timer armed for the earliest deadline
+    void ScheduleExpiry(const NotificationData* notification);
+    void ArmExpiryTimer(uint64_t now);
+    static int OnExpiryTimer(void* data);
+    
+    // Rendering (cards are drawn by the presenter)
     void RenderNotification(NotificationData* notification);
     void UpdateNotificationPositions();
     
@@ -169,6 +200,20 @@ private:
     // Notification storage
     std::map<uint32_t, std::unique_ptr<NotificationData>> notifications_;
     uint32_t next_id_;
+    std::deque<NotificationHistoryEntry> history_;
+    
+    // Min-heap of (expire_time, id). Entries are not removed when a
+    // notification is closed or replaced; stale ones are skipped on pop.
+    struct ExpiryEntry {
+        uint64_t expire_time;
+        uint32_t id;
+        bool operator>(const ExpiryEntry& other) const { return expire_time > other.expire_time; }
+    };
+    std::priority_queue<ExpiryEntry, std::vector<ExpiryEntry>, std::greater<ExpiryEntry>> expiry_queue_;
+    struct wl_event_source* expiry_timer_ = nullptr;
+    uint64_t armed_deadline_ = 0;  // Deadline the timer is currently armed for (0 = disarmed)
+    
+    std::unique_ptr<NotificationPresenter> presenter_;
     
     // Callback for notification changes
     std::function<void()> notification_callback_;
@@ -176,12 +221,9 @@ private:
     // Thread safety (use DBusHelper's mutex via GetMutex())
     mutable std::mutex notifications_mutex_;
     
-    // Configuration (can be made configurable later)
-    static constexpr int32_t DEFAULT_TIMEOUT_MS = 5000;  // 5 seconds
-    static constexpr int NOTIFICATION_WIDTH = 400;
-    static constexpr int NOTIFICATION_HEIGHT = 100;
-    static constexpr int NOTIFICATION_SPACING = 10;
-    static constexpr int NOTIFICATION_MARGIN = 10;
+    // Configuration (notifications section of the config file)
+    int32_t default_timeout_ms_;
+    size_t history_size_;
 };
 
 } // namespace UI
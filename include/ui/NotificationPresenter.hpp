@@ -0,0 +1,154 @@
+#pragma once
+
+#include "config/ConfigParser.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations
+struct wl_event_loop;
+struct wl_event_source;
+struct wlr_scene_tree;
+struct wlr_scene_buffer;
+typedef struct _cairo cairo_t;
+typedef struct _cairo_surface cairo_surface_t;
+
+namespace Leviathan {
+
+class ShmBuffer;
+
+namespace Wayland {
+    class Server;
+    class LayerManager;
+}
+
+namespace UI {
+
+struct NotificationData;
+
+/**
+ * @brief Draws notification cards into the Top layer of the focused output
+ * 
+ * The daemon only tells the presenter that something changed; the presenter
+ * pulls the active notifications when it next relays out. Relayouts are rate
+ * limited (NotificationsConfig::max_updates_per_second), so a burst of
+ * notifications costs at most a handful of repaints per second.
+ * 
+ * Notifications from the same app that arrive within the group window are
+ * drawn as a single card with a counter. Anything beyond max_visible cards is
+ * folded into a trailing "N more" card.
+ * 
+ * Card surfaces (ShmBuffer + wlr_scene_buffer) come from a small pool that is
+ * reused across relayouts. Buffer heights are rounded up to a bucket so a
+ * card whose text changed can usually keep its surface. Text layout (line
+ * wrapping) is cached per notification and only redone when the
+ * notification is replaced.
+ */
+class NotificationPresenter {
+public:
+    // Returns the active notifications (any order)
+    using SourceFn = std::function<std::vector<NotificationData*>()>;
+    
+    NotificationPresenter(Wayland::Server* server,
+                          struct wl_event_loop* event_loop,
+                          const NotificationsConfig& config);
+    ~NotificationPresenter();
+    
+    void SetSource(SourceFn source) { source_ = std::move(source); }
+    
+    // Request a relayout. Cheap: arms the rate-limited update timer once
+    void ScheduleUpdate();
+    
+    // Drop cached layout for a notification that was closed
+    void Forget(uint32_t id);
+    
+    // Stats
+    size_t GetPooledSurfaceCount() const { return surfaces_.size(); }
+    uint64_t GetRelayoutCount() const { return relayout_count_; }
+
+private:
+    // One visible card: a single notification, a group from one app, or the overflow summary
+    struct Card {
+        const NotificationData* lead = nullptr;  // Newest notification of the group (nullptr = overflow card)
+        size_t count = 1;                        // Notifications folded into this card
+    };
+    
+    // Wrapped text for a card, keyed by the lead notification id
+    struct CardLayout {
+        uint32_t revision = 0;
+        size_t count = 0;
+        std::string header;
+        std::vector<std::string> summary_lines;
+        std::vector<std::string> body_lines;
+        int height = 0;
+    };
+    
+    // Pooled card surface
+    struct CardSurface {
+        ShmBuffer* buffer = nullptr;
+        struct wlr_scene_buffer* node = nullptr;
+        int width = 0;
+        int height = 0;        // Bucketed buffer height
+        uint32_t bound_id = 0; // Lead notification id of the painted card (0 = overflow / none)
+        uint32_t bound_revision = 0;
+        size_t bound_count = 0;
+        bool painted = false;
+        bool in_use = false;
+    };
+    
+    static int OnUpdateTimer(void* data);
+    void Relayout();
+    
+    // Card building / layout
+    std::vector<Card> BuildCards(std::vector<NotificationData*>& notifications, size_t& overflow) const;
+    const CardLayout& GetLayout(const Card& card);
+    std::vector<std::string> WrapText(const std::string& text, double max_width, size_t max_lines, bool bold);
+    int GetLineHeight(int font_size) const;
+    static std::string StripMarkup(const std::string& text);
+    
+    // Surface pool
+    CardSurface* AcquireSurface(const Card& card, int height);
+    CardSurface* CreateSurface(int height);
+    void DestroySurface(CardSurface& surface);
+    void PaintCard(CardSurface& surface, const Card& card, const CardLayout& layout);
+    bool EnsureRoot(Wayland::LayerManager* layer_manager);
+    
+    Wayland::Server* server_;
+    struct wl_event_loop* event_loop_;
+    NotificationsConfig config_;
+    SourceFn source_;
+    
+    // Rate-limited update timer
+    struct wl_event_source* update_timer_ = nullptr;
+    bool update_pending_ = false;
+    uint64_t last_relayout_ms_ = 0;
+    uint64_t relayout_count_ = 0;
+    
+    // Scene: our own tree, reparented into the focused output's Top layer
+    struct wlr_scene_tree* root_ = nullptr;
+    struct wlr_scene_tree* root_parent_ = nullptr;
+    
+    std::vector<std::unique_ptr<CardSurface>> surfaces_;
+    std::unordered_map<uint32_t, CardLayout> layouts_;
+    CardLayout overflow_layout_;
+    
+    // 1x1 surface used only for text measurement
+    cairo_surface_t* measure_surface_ = nullptr;
+    cairo_t* measure_cr_ = nullptr;
+    
+    float background_[4];
+    float foreground_[4];
+    float critical_[4];
+    
+    static constexpr int CARD_PADDING = 12;
+    static constexpr int HEIGHT_BUCKET = 16;
+    static constexpr size_t MAX_SUMMARY_LINES = 2;
+    static constexpr size_t MAX_BODY_LINES = 4;
+};
+
+} // namespace UI
+} // namespace Leviathan
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "WidgetPlugin.hpp"
+#include "CompositorState.hpp"
 #include <thread>
 #include <atomic>
 #include <chrono>
@@ -126,12 +127,12 @@ protected:
     
     /**
      * @brief Measure text size with current font settings
-     * Creates a temporary Cairo surface to measure text.
+     * Uses the per-thread measurement context (Widget::GetMeasureContext).
      * Thread-safe - can be called from CalculateSize().
      */
     void MeasureText(const std::string& text, int& width, int& height, int padding = 8) {
-        cairo_surface_t* temp_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-        cairo_t* temp_cr = cairo_create(temp_surface);
+        cairo_t* temp_cr = GetMeasureContext();
+        cairo_save(temp_cr);
         
         cairo_select_font_face(temp_cr, font_family_.c_str(),
                               CAIRO_FONT_SLANT_NORMAL,
@@ -144,8 +145,7 @@ protected:
         width = static_cast<int>(extents.width) + padding;
         height = static_cast<int>(extents.height) + padding;
         
-        cairo_destroy(temp_cr);
-        cairo_surface_destroy(temp_surface);
+        cairo_restore(temp_cr);
     }
     
     /**
@@ -222,8 +222,8 @@ private:
                 UpdateData();
             }
             
-            // Sleep for configured interval
-            std::this_thread::sleep_for(std::chrono::seconds(update_interval_));
+            // Wait for the configured interval (parked while the session is idle)
+            WaitForWidgetUpdate(std::chrono::seconds(update_interval_), running_);
         }
     }
     
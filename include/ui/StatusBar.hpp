@@ -36,9 +36,18 @@ public:
     void Render();
     void Update();
     
+    // Output scale; the bar is laid out in logical pixels and drawn at this scale
+    void SetScale(float scale);
+    
+    // Logical output size changed (mode, transform or scale): resize and move the bar
+    void SetOutputSize(uint32_t output_width, uint32_t output_height);
+    
     // Check if any widgets need re-rendering
     void CheckDirtyWidgets();
     
+    // Stop dirty checks while the session is idle; resuming repaints what changed
+    void SetSuspended(bool suspended);
+    
     // Get the reserved space this bar needs
     int GetReservedSize() const;
     StatusBarConfig::Position GetPosition() const { return config_.position; }
@@ -63,10 +72,12 @@ public:
     std::string GetWidgetTreeString() const;
 
 private:
+    void UpdateGeometry();
     void CreateSceneNodes();
     void CreateWidgets();
     void RenderToBuffer();
     void UploadToTexture();
+    void DestroyBuffer();
     void SetupDirtyCheckTimer();
     
     // Static callback for timer
@@ -96,6 +107,8 @@ private:
     uint32_t output_height_;
     int bar_width_;   // Actual bar width
     int bar_height_;  // Actual bar height
+    float scale_ = 1.0f;  // Buffer pixels per logical pixel
+    bool suspended_ = false;  // Dirty check timer disarmed
     
     // Layout system - use Container/HBox containers for automatic layout
     std::shared_ptr<UI::Container> root_container_;  // Root container (can be HBox or VBox)
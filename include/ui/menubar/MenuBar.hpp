@@ -18,6 +18,7 @@ namespace Leviathan {
 // Forward declarations
 namespace Wayland {
     class LayerManager;
+    class OverlaySurface;
 }
 
 namespace UI {
@@ -187,12 +188,17 @@ public:
         x = pos_x_; y = pos_y_;
         width = bar_width_; height = bar_height_;
     }
+    
+    // Icon cache (for stats)
+    const IconLoader* GetIconLoader() const { return icon_loader_.get(); }
 
 private:
     void CreateSceneNodes();
+    void ScheduleSearch();
+    void RunSearch();
+    static int OnSearchTimer(void* data);
     void UpdateFilteredItems();
     void RenderToBuffer();
-    void UploadToTexture();
     void ExecuteSelectedItem();
     void EnsureSelectionVisible();
     
@@ -206,25 +212,28 @@ private:
     
     // Scene graph nodes
     struct wlr_scene_rect* scene_rect_;      // Background
-    struct wlr_scene_buffer* scene_buffer_;  // Content
-    struct wlr_texture* texture_;
-    struct wlr_renderer* renderer_;
-    ShmBuffer* shm_buffer_;
-    bool buffer_attached_;
+    Wayland::OverlaySurface* overlay_;       // Content (pooled buffer, owned by the LayerManager)
     
     // Position and dimensions
     int pos_x_, pos_y_;
     int bar_width_, bar_height_;
     uint32_t output_width_, output_height_;
     
-    // Cairo rendering
-    cairo_surface_t* cairo_surface_;
+    // Cairo rendering (only valid while a frame is being drawn)
     cairo_t* cairo_;
-    uint32_t* buffer_data_;
     
     // Menu state
     bool is_visible_;
     std::string search_query_;
+    
+    // Keystrokes are coalesced: filtering + rendering runs at most once per frame
+    struct wl_event_source* search_timer_ = nullptr;
+    bool search_pending_ = false;
+    uint64_t last_search_ms_ = 0;
+    
+    // Query that produced filtered_items_ (a longer query only narrows it)
+    std::string filtered_query_;
+    bool filtered_valid_ = false;
     int selected_index_;
     int scroll_offset_;
     
@@ -77,6 +77,9 @@ public:
     void ClearProviders();
     void RefreshAllItems();
     
+    // Icon atlas occupancy by icon size, summed over all menubars
+    std::map<int, IconAtlas::Stats> GetIconAtlasStats() const;
+    
     // Cleanup
     void Shutdown();
     
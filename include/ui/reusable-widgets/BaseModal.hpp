@@ -90,6 +90,9 @@ public:
     // Check if point is inside modal content area
     bool IsPointInContent(int x, int y) const;
     
+    // Screen area covered by the content box, including its border
+    void GetContentBounds(int& x, int& y, int& width, int& height) const;
+    
     // Widget-based content (recommended approach)
     void SetContent(std::shared_ptr<Widget> widget) { content_widget_ = widget; }
     std::shared_ptr<Widget> GetContent() const { return content_widget_; }
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "ui/BaseWidget.hpp"
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace Leviathan {
 namespace UI {
@@ -11,21 +15,48 @@ namespace UI {
  * 
  * ScrollView wraps a single child widget and allows vertical scrolling
  * when the child's height exceeds the viewport height.
+ * 
+ * It also has a virtualized list mode (like Flutter's ListView.builder):
+ * instead of a child, it is given an item count and an item builder, and
+ * only the rows intersecting the viewport are built, measured and painted.
+ * Rows that scroll out of view go back to a recycle pool and are handed to
+ * the builder again for the next row of the same item type. The painted
+ * viewport is retained between frames, so scrolling shifts the old pixels
+ * and paints only the newly exposed rows.
  */
 class ScrollView : public Widget {
 public:
+    // Builds (or rebinds) the row widget for `index`. `recycled` is a row of
+    // the same item type that scrolled out of view, or nullptr if the pool
+    // is empty. Return it (updated) or a freshly created widget.
+    using ItemBuilder = std::function<std::shared_ptr<Widget>(size_t index, std::shared_ptr<Widget> recycled)>;
+    
+    // Optional: rows only get recycled between items of the same type
+    using ItemTypeFn = std::function<int(size_t index)>;
+    
     ScrollView();
-    virtual ~ScrollView() = default;
+    virtual ~ScrollView();
     
     // Set the child widget to be scrolled
     void SetChild(std::shared_ptr<Widget> child);
     std::shared_ptr<Widget> GetChild() const { return child_; }
     
+    // Virtualized list mode (replaces the child)
+    void SetItemBuilder(size_t item_count, ItemBuilder builder, ItemTypeFn type_fn = nullptr);
+    void SetFixedItemHeight(int height);      // Every row is exactly this tall, rows are never measured
+    void SetEstimatedItemHeight(int height);  // Rows are measured once when first built
+    void SetItemSpacing(int spacing);
+    void NotifyItemsChanged(size_t item_count);  // Rebind all visible rows
+    void NotifyItemChanged(size_t index);        // Rebind and repaint a single row
+    bool IsVirtualized() const { return static_cast<bool>(item_builder_); }
+    size_t GetBuiltRowCount() const { return active_rows_.size(); }
+    
     // Scrolling
     void ScrollBy(int delta_y);  // Scroll by delta pixels
     void ScrollTo(int y);         // Scroll to absolute position
     void ScrollToTop();
     void ScrollToBottom();
+    void ScrollToItem(size_t index);  // Virtualized mode: bring a row into view
     
     // Get scroll info
     int GetScrollOffset() const { return scroll_offset_; }
@@ -37,7 +68,9 @@ public:
     void Render(cairo_t* cr) override;
     void CalculateSize(int available_width, int available_height) override;
     bool HandleClick(int x, int y) override;
+    bool HandleHover(int x, int y) override;
     bool HandleScroll(int x, int y, double delta_x, double delta_y) override;
+    void MarkNeedsPaint() override;
     
     // Scrollbar styling
     void SetScrollbarWidth(int width) { scrollbar_width_ = width; }
@@ -46,8 +79,14 @@ public:
         scrollbar_color_[2] = b; scrollbar_color_[3] = a;
     }
     void ShowScrollbar(bool show) { show_scrollbar_ = show; }
-    
+
 private:
+    struct ActiveRow {
+        size_t index;
+        int type;
+        std::shared_ptr<Widget> widget;
+    };
+    
     std::shared_ptr<Widget> child_;
     int scroll_offset_ = 0;  // Current scroll position (pixels from top)
     
@@ -56,8 +95,45 @@ private:
     double scrollbar_color_[4] = {0.5, 0.5, 0.5, 0.5};
     bool show_scrollbar_ = true;
     
+    // Virtualized list state
+    ItemBuilder item_builder_;
+    ItemTypeFn item_type_fn_;
+    size_t item_count_ = 0;
+    int fixed_item_height_ = 0;       // > 0 means fixed-height rows
+    int estimated_item_height_ = 24;
+    int item_spacing_ = 0;
+    std::vector<int> item_heights_;   // Measured (or estimated) height per item
+    std::vector<int> item_offsets_;   // Prefix sums of item_heights_ + spacing (size = count + 1)
+    int row_layout_width_ = -1;       // Width the active rows were last laid out at
+    std::vector<ActiveRow> active_rows_;  // Sorted by index
+    std::unordered_map<int, std::vector<std::shared_ptr<Widget>>> recycle_pool_;
+    
+    // Retained viewport (virtualized mode): front holds the last painted
+    // frame, back is scratch space for the scrolled copy
+    cairo_surface_t* viewport_front_ = nullptr;
+    cairo_surface_t* viewport_back_ = nullptr;
+    int viewport_scroll_offset_ = 0;  // scroll_offset_ the front surface was painted at
+    bool viewport_valid_ = false;
+    
     // Helper to clamp scroll offset to valid range
     void ClampScrollOffset();
+    int GetContentHeight() const;
+    
+    // Virtualized list helpers
+    void ResetItemHeights();
+    void RebuildOffsets();
+    int GetItemOffset(size_t index) const;
+    int GetItemHeight(size_t index) const;
+    size_t FindItemAt(int content_y) const;
+    bool MeasureRow(ActiveRow& row);
+    void UpdateVisibleRows();
+    void RecycleAllRows();
+    ActiveRow* FindRowAtViewportY(int local_y);
+    void RenderVirtualized(cairo_t* cr);
+    void PaintRows(cairo_t* cr, int top, int bottom);
+    void EnsureViewportSurfaces();
+    void DestroyViewportSurfaces();
+    void DrawScrollbar(cairo_t* cr);
 };
 
 } // namespace UI
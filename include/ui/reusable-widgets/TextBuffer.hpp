@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Leviathan {
+namespace UI {
+
+/**
+ * @brief Gap buffer holding UTF-8 text for editing widgets
+ * 
+ * Text lives in one array with a gap at the last edit position, so typing or
+ * deleting at the cursor only touches the gap (no shifting of the tail).
+ * Moving the edit position costs a memmove of the distance moved.
+ * 
+ * Positions are byte offsets into the logical text. The UTF-8 helpers step
+ * over whole code points so callers never split a multi-byte sequence.
+ */
+class TextBuffer {
+public:
+    TextBuffer();
+    
+    size_t Length() const { return buffer_.size() - GapSize(); }
+    bool Empty() const { return Length() == 0; }
+    
+    char At(size_t pos) const {
+        return pos < gap_start_ ? buffer_[pos] : buffer_[pos + GapSize()];
+    }
+    
+    void Insert(size_t pos, const std::string& text);
+    void Erase(size_t pos, size_t count);
+    void Assign(const std::string& text);
+    void Clear();
+    
+    // Logical text (rebuilt only after an edit)
+    const std::string& Str() const;
+    std::string Substr(size_t pos, size_t count) const;
+    
+    // UTF-8 code point boundaries around a byte offset
+    bool IsBoundary(size_t pos) const {
+        return pos == 0 || pos >= Length() || !IsContinuation(At(pos));
+    }
+    size_t NextBoundary(size_t pos) const;
+    size_t PrevBoundary(size_t pos) const;
+    
+    // Code point starting at pos (U+FFFD for malformed input)
+    uint32_t DecodeAt(size_t pos, size_t* length = nullptr) const;
+    
+    // Bumped on every edit
+    uint64_t GetRevision() const { return revision_; }
+    
+    // Text with control characters and malformed UTF-8 sequences dropped
+    static std::string FilterPrintable(const std::string& text);
+
+private:
+    size_t GapSize() const { return gap_end_ - gap_start_; }
+    void MoveGap(size_t pos);
+    void Reserve(size_t extra);
+    
+    static bool IsContinuation(char c) { return (static_cast<unsigned char>(c) & 0xC0) == 0x80; }
+    
+    std::vector<char> buffer_;
+    size_t gap_start_ = 0;
+    size_t gap_end_ = 0;
+    uint64_t revision_ = 0;
+    
+    mutable std::string text_cache_;
+    mutable uint64_t text_cache_revision_ = UINT64_MAX;
+    
+    static constexpr size_t MIN_GAP = 64;
+};
+
+} // namespace UI
+} // namespace Leviathan
@@ -1,13 +1,22 @@
 #pragma once
 
 #include "ui/BaseWidget.hpp"
+#include "ui/reusable-widgets/TextBuffer.hpp"
 #include <string>
+#include <vector>
+#include <unordered_map>
 #include <functional>
 
 namespace Leviathan {
 namespace UI {
 
 // TextField - text input widget with standard and outlined variants
+//
+// Text is edited in a gap buffer (TextBuffer); the cursor always sits on a
+// UTF-8 code point boundary. Caret and selection placement read a cached
+// prefix-width table, so they cost O(1) instead of re-measuring the text.
+// An edit only invalidates the table from the edit position on, and only
+// code points that have not been seen before are measured with cairo.
 class TextField : public Widget {
 public:
     enum class Variant {
@@ -17,7 +26,6 @@ public:
     
     TextField(const std::string& placeholder = "", Variant variant = Variant::Standard)
         : variant_(variant),
-          text_(""),
           placeholder_(placeholder),
           font_size_(12),
           font_family_("JetBrainsMono Nerd Font"),
@@ -41,22 +49,13 @@ public:
           max_width_(-1)  // -1 means no max width
     {}
     
+    ~TextField() override;
+    
     // Text manipulation
-    void SetText(const std::string& text) {
-        if (text_ != text) {
-            text_ = text;
-            cursor_pos_ = text_.length();
-            ClearSelection();
-            dirty_ = true;
-            
-            if (on_text_changed_) {
-                on_text_changed_(text_);
-            }
-        }
-    }
+    void SetText(const std::string& text);
     
-    std::string GetText() const {
-        return text_;
+    const std::string& GetText() const {
+        return text_.Str();
     }
     
     void SetPlaceholder(const std::string& placeholder) {
@@ -72,11 +71,13 @@ public:
     
     void SetFontSize(int size) {
         font_size_ = size;
+        InvalidateFont();
         dirty_ = true;
     }
     
     void SetFontFamily(const std::string& family) {
         font_family_ = family;
+        InvalidateFont();
         dirty_ = true;
     }
     
@@ -200,10 +201,11 @@ public:
     void UpdateCursorBlink(uint32_t current_time);
 
 private:
-    // Helper methods
-    void InsertChar(char c);
-    void DeleteChar();
+    // Helper methods (edits don't notify; callers call NotifyTextChanged once)
+    void InsertText(const std::string& text);
+    void EraseRange(size_t start, size_t end);
     void DeleteSelection();
+    void NotifyTextChanged();
     void MoveCursor(int delta);
     void MoveCursorToPosition(int x);
     void SelectAll();
@@ -213,9 +215,17 @@ private:
     void PasteFromClipboard();
     int GetCursorXPosition() const;
     
+    // Width cache
+    void InvalidateFont();
+    void InvalidateWidthsFrom(size_t pos);
+    void EnsureWidths() const;
+    double GetAdvance(uint32_t codepoint, size_t pos, size_t length) const;
+    double GetWidthAt(size_t pos) const;
+    cairo_t* GetMeasureContext() const;
+    
     // Widget properties
     Variant variant_;
-    std::string text_;
+    TextBuffer text_;
     std::string placeholder_;
     int font_size_;
     std::string font_family_;
@@ -244,6 +254,17 @@ private:
     int min_width_;
     int max_width_;
     
+    // prefix_widths_[i] = advance of the text before byte i (bytes inside a
+    // code point repeat the value of its first byte); valid up to widths_valid_.
+    // cairo's toy text API does no kerning, so summing per-glyph advances
+    // matches what cairo_show_text draws.
+    mutable std::vector<double> prefix_widths_{0.0};
+    mutable size_t widths_valid_ = 0;
+    mutable std::unordered_map<uint32_t, double> advance_cache_;
+    mutable cairo_surface_t* measure_surface_ = nullptr;
+    mutable cairo_t* measure_cr_ = nullptr;
+    mutable bool measure_font_dirty_ = true;
+    
     // Callbacks
     std::function<void(const std::string&)> on_text_changed_;
     std::function<void(const std::string&)> on_submit_;
@@ -0,0 +1,109 @@
+#ifndef FRAME_GOVERNOR_HPP
+#define FRAME_GOVERNOR_HPP
+
+#include "wayland/WaylandTypes.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Leviathan {
+namespace Core {
+class Client;
+}
+
+namespace Wayland {
+
+class Server;
+struct Output;
+
+/**
+ * Per-client frame-rate governor.
+ * 
+ * Clients draw when they get a frame callback, so capping callbacks caps the
+ * rate at which well-behaved clients commit. OutputManager sends frame
+ * callbacks through SendFrameDone() instead of the scene:
+ *   - unfocused windows get frame_governor.unfocused_fps (battery_unfocused_fps
+ *     while discharging)
+ *   - a client committing more than storm_factor times the refresh rate is
+ *     throttled to storm_fps until its rate drops back to the refresh rate.
+ *     Its commits are deferred too: each one is locked as the client makes it
+ *     and applied one per storm_fps tick, so a client that ignores frame
+ *     callbacks waits on its buffer releases instead. At most
+ *     MAX_HELD_COMMITS wait; past that the oldest applies early
+ *   - a window rule's max_fps overrides both (0 exempts the window)
+ * Callbacks that are not due yet are held; a timer schedules a frame on the
+ * output when the earliest one is, so a capped client never starves on an
+ * otherwise idle output.
+ * 
+ * Storm detection reads the commit rate of ClientStats once a second, and only
+ * while clients commit.
+ * X11 windows are not governed.
+ * 
+ * Sending callbacks also starts the frame-callback latency of ClientStats.
+ */
+class FrameGovernor {
+public:
+    FrameGovernor(Server* server, struct wl_event_loop* event_loop);
+    ~FrameGovernor();
+    
+    // Called for every toplevel commit (view_handle_commit)
+    void RecordCommit(Core::Client* client);
+    
+    // Called for every wl_surface.commit of a toplevel before wlroots applies
+    // it (view_handle_client_commit); holds it back while the client storms
+    void HoldCommit(Core::Client* client);
+    
+    // Applies every held-back commit. The toplevel's destroy handler calls
+    // this once its commit listeners are gone, as the wl_surface may outlive it
+    void ReleaseClient(Core::Client* client);
+    
+    // Replaces wlr_scene_output_send_frame_done() after each output frame
+    void SendFrameDone(Output* output, const struct timespec& now);
+    
+    // Frame callbacks per second the client gets right now, 0 = every frame
+    int GetCap(const Core::Client* client) const;
+    
+    bool IsOnBattery() const { return on_battery_; }
+
+private:
+    // State of one SendFrameDone() pass, for the buffer iterator
+    struct FramePass {
+        FrameGovernor* governor;
+        struct wlr_scene_output* scene_output;
+        struct wlr_scene_frame_done_event event;
+        uint64_t now_ns;
+        uint64_t refresh_ns;
+        uint64_t next_due_ns;  // Earliest held callback, 0 if none
+    };
+    
+    static void SendBufferFrameDone(struct wlr_scene_buffer* buffer, int sx, int sy, void* data);
+    static int HandleSampleTimer(void* data);
+    static int HandleReleaseTimer(void* data);
+    static int HandleCommitTimer(void* data);
+    
+    Core::Client* ClientForSurface(struct wlr_surface* surface) const;
+    void HoldOutput(struct wlr_output* wlr_output, uint64_t due_ns, uint64_t now_ns);
+    void ReleaseOldestCommit(Core::Client* client, uint64_t now_ns);
+    void ArmCommitTimer(uint64_t due_ns, uint64_t now_ns);
+    void Sample();
+    void UpdatePowerSource();
+    
+    Server* server_;
+    struct wl_event_source* sample_timer_ = nullptr;
+    struct wl_event_source* release_timer_ = nullptr;
+    struct wl_event_source* commit_timer_ = nullptr;
+    
+    bool sampling_ = false;            // sample_timer_ is armed
+    uint64_t last_power_check_ns_ = 0;
+    bool on_battery_ = false;
+    int refresh_hz_ = 60;              // Fastest output seen, for storm detection
+    
+    std::vector<struct wlr_output*> held_outputs_;  // Outputs with callbacks waiting on release_timer_
+    uint64_t release_at_ns_ = 0;
+    uint64_t commit_release_at_ns_ = 0;             // commit_timer_ deadline, 0 if disarmed
+};
+
+} // namespace Wayland
+} // namespace Leviathan
+
+#endif // FRAME_GOVERNOR_HPP
@@ -0,0 +1,81 @@
+#ifndef IDLE_MANAGER_HPP
+#define IDLE_MANAGER_HPP
+
+#include "wayland/WaylandTypes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Leviathan {
+namespace Wayland {
+
+class Server;
+
+/**
+ * Session idle tracking.
+ * 
+ * InputManager reports every input event through NotifyActivity(). The manager
+ * serves ext-idle-notify-v1 to clients (lockers, idle daemons) and honours
+ * idle-inhibit-unstable-v1 inhibitors (video players). On its own timeouts it:
+ *   - idle: suspends status bar repaints, widget polling and wallpaper rotation
+ *   - dpms: additionally powers the outputs down
+ * Any input undoes both.
+ * 
+ * Activity only records a timestamp; a single timer re-checks the deadline,
+ * so pointer motion does not re-arm a timerfd per event.
+ */
+class IdleManager {
+public:
+    enum class State {
+        Active,
+        Idle,        // UI work suspended, outputs still on
+        PoweredOff,  // Outputs off as well
+    };
+    
+    IdleManager(Server* server, struct wl_display* display, struct wl_event_loop* event_loop, struct wlr_seat* seat);
+    ~IdleManager();
+    
+    // Called for every key, button, motion and scroll event
+    void NotifyActivity();
+    
+    State GetState() const { return state_; }
+    bool IsInhibited() const { return !inhibitors_.empty(); }
+    
+    // Timeouts in seconds (0 disables that stage)
+    void SetTimeouts(int idle_seconds, int dpms_seconds);
+
+private:
+    struct Inhibitor {
+        IdleManager* manager;
+        struct wlr_idle_inhibitor_v1* wlr_inhibitor;
+        struct wl_listener destroy;
+    };
+    
+    void SetState(State state);
+    void ArmTimer();
+    void OnTimer();
+    void RemoveInhibitor(Inhibitor* inhibitor);
+    
+    static int HandleTimer(void* data);
+    static void HandleNewInhibitor(struct wl_listener* listener, void* data);
+    static void HandleInhibitorDestroy(struct wl_listener* listener, void* data);
+    
+    Server* server_;
+    struct wlr_seat* seat_;
+    struct wlr_idle_notifier_v1* notifier_ = nullptr;
+    struct wlr_idle_inhibit_manager_v1* inhibit_manager_ = nullptr;
+    struct wl_listener new_inhibitor_;
+    struct wl_event_source* timer_ = nullptr;
+    
+    std::vector<std::unique_ptr<Inhibitor>> inhibitors_;
+    State state_ = State::Active;
+    uint64_t last_activity_ms_ = 0;
+    int idle_timeout_ms_ = 0;
+    int dpms_timeout_ms_ = 0;
+};
+
+} // namespace Wayland
+} // namespace Leviathan
+
+#endif // IDLE_MANAGER_HPP
@@ -38,6 +38,7 @@ public:
     static void HandleCursorFrame(struct wl_listener* listener, void* data);
     
     static void HandleRequestCursor(struct wl_listener* listener, void* data);
+    static void HandleRequestCursorShape(struct wl_listener* listener, void* data);
     static void HandleRequestSetSelection(struct wl_listener* listener, void* data);
 };
 
@@ -6,6 +6,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include "config/ConfigParser.hpp"
 #include "wayland/WaylandTypes.hpp"  // Include full wlroots types
@@ -47,6 +48,7 @@ namespace Wayland {
 
 // Forward declaration
 class Server;
+class OverlaySurfaceManager;
 
 /**
  * Layer ordering (bottom to top):
@@ -96,6 +98,7 @@ public:
     
     // Set monitor configuration (includes wallpaper config)
     void SetMonitorConfig(const MonitorConfig& config);
+    const MonitorConfig* GetMonitorConfig() const { return monitor_config_; }
     
     // Get scene tree for a specific layer
     struct wlr_scene_tree* GetLayer(Layer layer);
@@ -118,9 +121,25 @@ public:
     // Get the output this manager belongs to
     struct wlr_output* GetOutput() const { return output_; }
     
+    // Unique per LayerManager; recorded as the output index of its clients
+    int GetIndex() const { return index_; }
+    
+    // Reusable Top-layer buffers for overlays drawn by the compositor
+    OverlaySurfaceManager* GetOverlays() { return overlays_.get(); }
+    
+    // Output size in layout coordinates (pixel size divided by scale and transformed)
+    void GetLogicalSize(int& width, int& height) const;
+    
+    // Redraw bars and overlays at the output's (possibly fractional) scale and
+    // fit everything to the logical size, after a scale, mode or transform change
+    void SetScale(float scale);
+    
+    // Pause bar repaints and wallpaper rotation while the session is idle
+    void SetSuspended(bool suspended);
+    
     // Tile windows in this output's working area
     // Takes a list of views that should be tiled according to the tag's layout
-    void TileViews(std::vector<class View*>& views,
+    void TileViews(std::pmr::vector<class View*>& views,
                    Core::Tag* tag,
                    TilingLayout* layout_engine);
     
@@ -182,21 +201,12 @@ private:
     // Active modals (owned by LayerManager)
     std::unordered_map<std::string, std::unique_ptr<UI::Modal>> active_modals_;
     
-    // Modal rendering resources
-    wlr_scene_buffer* modal_scene_buffer_ = nullptr;
-    class ShmBuffer* modal_shm_buffer_ = nullptr;
-    
-    // Popover rendering resources (similar to modal)
-    wlr_scene_buffer* popover_scene_buffer_ = nullptr;
-    class ShmBuffer* popover_shm_buffer_ = nullptr;
-    cairo_surface_t* popover_cairo_surface_ = nullptr;
-    cairo_t* popover_cairo_ = nullptr;
-    uint32_t* popover_buffer_data_ = nullptr;
-    bool popover_buffer_attached_ = false;
+    // Pooled Top-layer buffers for modals, popovers and the launcher
+    std::unique_ptr<OverlaySurfaceManager> overlays_;
     bool is_rendering_popover_ = false;
     
-    // Helper to render modals to top layer
-    void RenderModals();
+    // Helper to render modals to top layer (content_only: only the modal box changed)
+    void RenderModals(bool content_only = false);
     
     // Server pointer for accessing global state
     Server* server_ = nullptr;
@@ -204,6 +214,7 @@ private:
     // Per-screen tags (workspaces)
     std::vector<std::unique_ptr<Core::Tag>> tags_;
     int current_tag_index_ = 0;
+    int index_;
     
     // Layout engine for tiling
     TilingLayout* layout_engine_ = nullptr;
@@ -218,6 +229,8 @@ private:
     size_t wallpaper_index_ = 0;
     std::vector<std::string> wallpaper_paths_;
     struct wl_event_source* wallpaper_timer_ = nullptr;
+    int wallpaper_interval_ms_ = 0;  // Rotation interval, 0 if not rotating
+    bool suspended_ = false;
     
     // Night light (warm color overlay for night hours)
     std::unique_ptr<NightLight> night_light_;
@@ -225,6 +238,7 @@ private:
     // Wallpaper helpers (private)
     class ShmBuffer* LoadWallpaperImage(const std::string& path, int width, int height);
     void InitializeWallpaper();
+    void SetSolidWallpaper(const std::string& color);
     void ClearWallpaper();
     void NextWallpaper();
     static int WallpaperRotationCallback(void* data);
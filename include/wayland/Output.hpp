@@ -3,6 +3,9 @@
 
 #include "wayland/WaylandTypes.hpp"
 #include "wayland/LayerManager.hpp"
+#include "config/ConfigParser.hpp"
+#include <cstdint>
+#include <functional>
 
 // Forward declarations to avoid circular dependencies
 namespace Leviathan {
@@ -17,17 +20,63 @@ namespace Wayland {
 // Forward declarations
 class Server;
 class LayerManager;
+struct View;
+
+// Per-output frame statistics, updated by OutputManager::HandleFrame
+struct FrameStats {
+    uint64_t frames = 0;
+    uint64_t last_render_ns = 0;       // Render + commit time of the last frame
+    uint64_t max_render_ns = 0;
+    // Heap allocations between the previous frame and this one (all threads);
+    // zero unless allocation counting is built in (ENABLE_ALLOCATION_STATS)
+    uint64_t last_allocations = 0;
+    uint64_t last_allocated_bytes = 0;
+    uint64_t allocation_mark = 0;
+    uint64_t allocated_bytes_mark = 0;
+    uint64_t last_delay_ns = 0;        // Time the frame was held back by frame pacing
+    uint64_t presented = 0;            // Frames reported presented by the backend
+    // Cursor drawn into the frame instead of on the hardware cursor plane; then
+    // every pointer move damages the scene under the old and new cursor position
+    uint64_t software_cursor_frames = 0;
+    uint64_t software_cursor_fallbacks = 0;  // Hardware -> software transitions
+    bool software_cursor = false;
+};
+
+// Presentation timing used to schedule frames just before vblank
+struct FramePacing {
+    uint64_t last_present_ns = 0;      // CLOCK_MONOTONIC time of the last vblank, 0 if unknown
+    uint64_t refresh_ns = 0;           // Refresh period, 0 if unknown or variable
+    uint64_t render_estimate_ns = 0;   // Decaying maximum of recent render times
+    uint64_t frame_requested_ns = 0;   // When the pending delayed frame was requested
+    bool frame_pending = false;        // repaint_timer is armed
+};
+
+// Adaptive sync and tearing policy and state
+struct OutputSync {
+    AdaptiveSyncMode adaptive_sync = AdaptiveSyncMode::OFF;  // From the monitor config
+    bool allow_tearing = false;        // From the monitor config
+    bool adaptive_sync_wanted = false; // What the policy asked for on the last frame
+    bool tearing_active = false;       // Last frame was an async page flip
+    int rejected_adaptive_sync = -1;   // VRR state the backend refused (not retried), -1 if none
+};
 
 // Output (monitor) information structure  
 struct Output {
     struct wlr_output* wlr_output;
     struct wlr_scene_output* scene_output;  // Store scene output for wlr_scene_output_commit
     struct wl_listener frame;
+    struct wl_listener present;
+    struct wl_listener commit;
     struct wl_listener destroy;
+    struct wl_event_source* repaint_timer;  // Delayed frame for frame pacing
     struct wl_list link;
     Leviathan::Core::Screen* core_screen;  // Core screen object with EDID info
     Leviathan::Wayland::Server* server;  // Reference to compositor server
     Leviathan::Wayland::LayerManager* layer_manager;  // Per-output layer management
+    FrameStats frame_stats;
+    FramePacing pacing;
+    OutputSync sync;
+    bool idle_powered_off = false;  // Disabled by the idle manager, enabled again on wake
     
     Output(struct wlr_output* output, Leviathan::Wayland::Server* srv);
     ~Output();
@@ -35,9 +84,42 @@ struct Output {
 
 class OutputManager {
 public:
+    // Called after every output frame with the time spent rendering and committing it
+    using FrameObserver = std::function<void(Output* output, uint64_t render_ns)>;
+
     static void HandleNewOutput(struct wl_listener* listener, void* data);
     static void HandleFrame(struct wl_listener* listener, void* data);
+    static void HandlePresent(struct wl_listener* listener, void* data);
+    static void HandleCommit(struct wl_listener* listener, void* data);
+    static int HandleRepaintTimer(void* data);
     static void HandleDestroy(struct wl_listener* listener, void* data);
+
+    static void SetFrameObserver(FrameObserver observer);
+
+    // A visible cursor on this output is not on the hardware cursor plane
+    static bool UsesSoftwareCursor(struct wlr_output* wlr_output);
+
+    // Focused fullscreen view on this output, or nullptr
+    static View* GetFullscreenView(Output* output);
+
+    // Adaptive sync / tearing policy for the next frame
+    static bool WantsAdaptiveSync(Output* output);
+    static bool WantsTearing(Output* output);
+
+    // Schedule a frame if the adaptive sync policy no longer matches the output
+    static void UpdateSyncState(Output* output);
+
+private:
+    // Render, commit and send frame callbacks
+    static void RenderFrame(Output* output);
+
+    // Build and commit the scene state, with the adaptive sync / tearing policy applied
+    static bool CommitScene(Output* output);
+
+    // How long to hold the frame back so it finishes just before vblank (0 = now)
+    static uint64_t ComputeFrameDelay(Output* output, uint64_t now_ns);
+
+    static FrameObserver frame_observer_;
 };
 
 } // namespace Wayland
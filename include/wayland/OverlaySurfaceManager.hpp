@@ -0,0 +1,152 @@
+#ifndef OVERLAY_SURFACE_MANAGER_HPP
+#define OVERLAY_SURFACE_MANAGER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// Forward declarations
+struct wlr_scene_tree;
+struct wlr_scene_buffer;
+struct wl_event_loop;
+struct wl_event_source;
+typedef struct _cairo cairo_t;
+typedef struct _cairo_surface cairo_surface_t;
+
+namespace Leviathan {
+
+class ShmBuffer;
+
+namespace Wayland {
+
+class OverlaySurfaceManager;
+
+/**
+ * Rectangle in surface-local coordinates
+ */
+struct OverlayRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+/**
+ * One named overlay (modal, popover, launcher) drawn into the Top layer.
+ * 
+ * Usage per repaint:
+ *   cairo_t* cr = surface->BeginFrame(width, height, &damage);
+ *   ... draw the whole overlay; cairo skips everything outside the damage ...
+ *   surface->EndFrame(x, y);
+ * 
+ * The buffer is borrowed from the manager's pool while the overlay is shown
+ * and handed back by Hide(), so showing it again only costs a repaint.
+ */
+class OverlaySurface {
+public:
+    ~OverlaySurface();
+    
+    /**
+     * Start a frame. The returned context is clipped to the damaged area,
+     * which has been cleared to transparent. The first frame on a new buffer
+     * (or after a size change) is always fully damaged.
+     * 
+     * @param damage Area that changed, nullptr for the whole surface
+     * @return Cairo context, or nullptr if no buffer could be allocated
+     */
+    cairo_t* BeginFrame(int width, int height, const OverlayRect* damage = nullptr);
+    
+    // Present the frame with its top-left corner at (x, y) in the parent tree
+    void EndFrame(int x, int y);
+    
+    // Hide the overlay and return its buffer to the pool
+    void Hide();
+    
+    bool IsVisible() const { return visible_; }
+
+private:
+    friend class OverlaySurfaceManager;
+    struct PooledBuffer;
+    
+    OverlaySurface(OverlaySurfaceManager* manager, struct wlr_scene_tree* parent);
+    
+    OverlaySurfaceManager* manager_;
+    struct wlr_scene_buffer* node_ = nullptr;
+    PooledBuffer* buffer_ = nullptr;
+    int width_ = 0;
+    int height_ = 0;
+    OverlayRect damage_;
+    bool full_damage_ = true;
+    bool in_frame_ = false;
+    bool visible_ = false;
+};
+
+/**
+ * Per-output pool of SHM buffers for overlays.
+ * 
+ * Buffers are bucketed by pixel size (rounded up to BUCKET pixels) so overlays of
+ * similar size share them, and a buffer larger than needed is shown through a
+ * source box. Buffers nobody uses are released after an idle timeout instead
+ * of being kept mapped for the lifetime of the output.
+ */
+class OverlaySurfaceManager {
+public:
+    struct Stats {
+        size_t buffers = 0;       // Allocated buffers
+        size_t idle_buffers = 0;  // Of those, not attached to a visible overlay
+        size_t bytes = 0;         // Memory held by all buffers
+        uint64_t allocations = 0; // Buffers created
+        uint64_t reuses = 0;      // Frames served from the pool
+        uint64_t releases = 0;    // Buffers freed by the idle timeout
+    };
+    
+    OverlaySurfaceManager(struct wlr_scene_tree* parent, struct wl_event_loop* event_loop);
+    ~OverlaySurfaceManager();
+    
+    // Get (or create) the overlay with this name
+    OverlaySurface* GetSurface(const std::string& name);
+    
+    // How long an unused buffer is kept (milliseconds)
+    void SetIdleTimeout(int ms) { idle_timeout_ms_ = ms; }
+    
+    // Output scale: overlays are drawn in logical coordinates into buffers of
+    // this many pixels per unit, so they stay sharp on fractional scales
+    void SetScale(float scale);
+    float GetScale() const { return scale_; }
+    
+    Stats GetStats() const;
+
+private:
+    friend class OverlaySurface;
+    using PooledBuffer = OverlaySurface::PooledBuffer;
+    
+    PooledBuffer* Acquire(int width, int height);
+    void Release(PooledBuffer* buffer);
+    void DestroyBuffer(PooledBuffer& buffer);
+    void ArmIdleTimer();
+    void ReleaseIdleBuffers();
+    static int OnIdleTimer(void* data);
+    
+    struct wlr_scene_tree* parent_;
+    struct wl_event_loop* event_loop_;
+    struct wl_event_source* idle_timer_ = nullptr;
+    int idle_timeout_ms_ = 10000;
+    float scale_ = 1.0f;
+    
+    std::unordered_map<std::string, std::unique_ptr<OverlaySurface>> surfaces_;
+    std::vector<std::unique_ptr<PooledBuffer>> buffers_;
+    
+    uint64_t allocations_ = 0;
+    uint64_t reuses_ = 0;
+    uint64_t releases_ = 0;
+    
+    static constexpr int BUCKET = 64;
+};
+
+} // namespace Wayland
+} // namespace Leviathan
+
+#endif // OVERLAY_SURFACE_MANAGER_HPP
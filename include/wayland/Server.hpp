@@ -8,7 +8,11 @@
 #include "ipc/IPC.hpp"
 #include "core/Seat.hpp"
 #include "core/Client.hpp"
+#include "core/ClientStore.hpp"
 #include "wayland/LayerManager.hpp"
+#include "wayland/IdleManager.hpp"
+#include "wayland/FrameGovernor.hpp"
+#include "wayland/StatePublisher.hpp"
 #include "wayland/WaylandTypes.hpp"
 #include "wayland/XwaylandCompat.hpp"
 #include "ui/CompositorState.hpp"
@@ -31,7 +35,9 @@ extern "C" {
 }
 #undef namespace
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace Leviathan {
@@ -45,6 +51,10 @@ public:
     void Run();
     void Shutdown();  // Graceful shutdown sequence
     
+    // Run() split in two, for embedders that drive the loop themselves (leviathan-bench)
+    bool Start();  // Add the socket and start the backend
+    bool DispatchOnce(int timeout_ms);  // One loop iteration; false once shutdown was requested
+    
     // View operations
     void FocusView(View* view);
     void CloseView(View* view);
@@ -58,22 +68,33 @@ public:
     
     // Getters
     struct wl_display* GetDisplay() { return wl_display; }
+    struct wlr_backend* GetBackend() { return backend; }
     struct wlr_scene* GetScene() { return scene; }
     struct wlr_seat* GetSeat() { return seat; }
     struct wlr_output_layout* GetOutputLayout() { return output_layout; }
     Core::Seat* GetCoreSeat() { return core_seat_.get(); }
     const std::vector<View*>& GetViews() const { return views; }
-    const std::vector<Core::Client*>& GetClients() const { return clients_; }
+    const std::vector<Core::Client*>& GetClients() const { return client_store_.GetClients(); }
+    Core::ClientStore& GetClientStore() { return client_store_; }
     TilingLayout* GetLayoutEngine() { return layout_engine_.get(); }
     KeyBindings* GetKeyBindings() { return keybindings_.get(); }
     View* GetFocusedView() const { return focused_view_; }
+    struct wlr_tearing_control_manager_v1* GetTearingControl() { return tearing_control; }
     UI::NotificationDaemon* GetNotificationDaemon() { return notification_daemon_.get(); }
+    IdleManager* GetIdleManager() { return idle_manager_.get(); }
+    FrameGovernor* GetFrameGovernor() { return frame_governor_.get(); }
+    StatePublisher* GetStatePublisher() { return state_publisher_.get(); }
     UI::MenuBarManager* GetMenuBarManager();  // Returns singleton instance
     Output* GetFirstOutput();  // Get first output in the list
     
     // Find Output struct by wlr_output
     Output* FindOutput(struct wlr_output* wlr_output);
     
+    // Pointer image: a named xcursor shape ("default", "text", ...) or a client
+    // surface. Setting the shape that is already shown is free
+    void SetCursorShape(const char* name);
+    void SetCursorSurface(struct wlr_surface* surface, int32_t hotspot_x, int32_t hotspot_y);
+    
     // Check if cursor is over a status bar and handle hover
     // Returns true if hover was handled by a status bar
     bool CheckStatusBarHover(int x, int y);
@@ -87,13 +108,13 @@ public:
     bool CheckModalScroll(int x, int y, double delta_x, double delta_y);
     
     // CompositorState interface implementation
-    std::vector<Core::Screen*> GetScreens() const override;
+    const std::vector<Core::Screen*>& GetScreens() const override;
     Core::Screen* GetFocusedScreen() const override;
     std::vector<Core::Tag*> GetTags() const override;
     Core::Tag* GetActiveTag() const override;
     void SwitchToTag(int tag_index) override;  // Also used for keybindings (line 51)
-    std::vector<Core::Client*> GetAllClients() const override;
-    std::vector<Core::Client*> GetClientsOnTag(Core::Tag* tag) const override;
+    const std::vector<Core::Client*>& GetAllClients() const override;
+    const std::vector<Core::Client*>& GetClientsOnTag(Core::Tag* tag) const override;
     std::vector<Core::Client*> GetClientsOnScreen(Core::Screen* screen) const override;
     Core::Client* GetFocusedClient() const override;
     
@@ -125,9 +146,17 @@ public:
     struct wl_listener cursor_button;
     struct wl_listener cursor_axis;
     struct wl_listener cursor_frame;
+    struct wl_listener request_cursor;
+    struct wl_listener request_cursor_shape;
+    
+    // Output management listeners
+    struct wl_listener output_manager_apply;
+    struct wl_listener output_manager_test;
+    struct wl_listener output_layout_change;
     
     // Xwayland listeners
     struct wl_listener xwayland_ready;
+    struct wl_listener xwayland_start;
     struct wl_listener new_xwayland_surface;
     
     // Callbacks (must be public for C callbacks)
@@ -137,6 +166,12 @@ public:
     void OnNewXdgDecoration(struct wlr_xdg_toplevel_decoration_v1* decoration);
     void OnNewInput(struct wlr_input_device* device);
     void OnSessionActive(bool active);
+    void OnOutputManagerApply(struct wlr_output_configuration_v1* config, bool test_only);
+    void OnOutputLayoutChange();
+    void OnMonitorConfigIdle();
+    void OnOutputManagerIdle();
+    void OnSpawnReplies(uint32_t mask);
+    void OnXwaylandStart();
     void OnXwaylandReady();
     void OnNewXwaylandSurface(struct ::wlr_xwayland_surface* xwayland_surface);  // Use global namespace for C types
     
@@ -145,7 +180,18 @@ public:
     
     // Monitor group configuration
     void ApplyMonitorGroupConfiguration();
+    void ScheduleMonitorGroupConfiguration();  // Once per event loop iteration, e.g. after a dock's hotplug burst
+    
+    // Idle handling (driven by IdleManager)
+    void SetUISuspended(bool suspended);  // Bars, widget polling, wallpaper rotation
+    void SetOutputsPowered(bool powered);
     
+    // xdg_toplevel suspended state for windows nobody can see
+    void ScheduleVisibilityUpdate();  // After tag switches, relayouts, focus and fullscreen changes
+    void OnVisibilityIdle();
+    void OnSuspendTimer();
+    size_t GetSuspendedClientCount() const;
+
 private:
     Server();
     bool Initialize();
@@ -153,6 +199,17 @@ private:
     View* FindView(struct wlr_surface* surface);
     void UpdateViewList();
     
+    // Test and commit several outputs as one backend transaction (one modeset)
+    bool CommitOutputStates(struct wlr_backend_output_state* states, size_t states_len, bool test_only);
+    // Add/move an output in the layout, or take it out when disabled
+    void PlaceOutput(Output* output, bool enabled, std::optional<std::pair<int, int>> position);
+    // Retile every output once after a reconfiguration
+    void ArrangeOutputs();
+    // Suspend windows hidden for SUSPEND_DELAY_MS, resume visible ones at once
+    void UpdateSuspendedClients();
+    // Publish the current output state to wlr-output-management clients
+    void UpdateOutputManagerConfig();
+    
 private:
     // Wayland/wlroots core
     struct wl_display* wl_display;
@@ -166,6 +223,32 @@ private:
     struct wlr_data_device_manager* data_device_manager;
     struct wlr_primary_selection_v1_device_manager* primary_selection_mgr;
     struct wlr_data_control_manager_v1* data_control_mgr;
+    struct wlr_linux_dmabuf_v1* linux_dmabuf;  // NULL if the renderer can't import DMA-BUFs
+    struct wlr_presentation* presentation;
+    struct wlr_tearing_control_manager_v1* tearing_control;
+    struct wlr_viewporter* viewporter;
+    struct wlr_fractional_scale_manager_v1* fractional_scale_mgr;
+    struct wlr_single_pixel_buffer_manager_v1* single_pixel_buffer_mgr;
+    
+    // Screen capture
+    struct wlr_xdg_output_manager_v1* xdg_output_mgr;
+    struct wlr_screencopy_manager_v1* screencopy_mgr;
+    struct wlr_export_dmabuf_manager_v1* export_dmabuf_mgr;
+    struct wlr_ext_image_copy_capture_manager_v1* image_copy_capture_mgr;
+    struct wlr_ext_output_image_capture_source_manager_v1* output_capture_source_mgr;
+    
+    // Output management (wlr-output-management; kanshi, wdisplays)
+    struct wlr_output_manager_v1* output_manager;
+    struct wl_event_source* monitor_config_idle_ = nullptr;   // Pending ApplyMonitorGroupConfiguration
+    struct wl_event_source* output_manager_idle_ = nullptr;   // Pending UpdateOutputManagerConfig
+    bool tearing_down_ = false;   // Shutdown/destructor: outputs going away are not an undock
+    
+    // Window suspension (UpdateSuspendedClients)
+    struct wl_event_source* visibility_idle_ = nullptr;
+    struct wl_event_source* suspend_timer_ = nullptr;
+    
+    // Replies from the launcher helper (Core::SpawnHelper)
+    struct wl_event_source* spawn_replies_ = nullptr;
     
     // Scene graph
     struct wlr_scene* scene;
@@ -183,18 +266,22 @@ private:
     
     // Xwayland
     struct ::wlr_xwayland* xwayland;  // Use global namespace for C types
+    uint32_t xwayland_starts_ = 0;    // Server spawns; a lazy server is respawned after idling out
+    std::chrono::steady_clock::time_point xwayland_started_at_;
+    std::chrono::milliseconds xwayland_startup_time_{0};  // Spawn to ready, last start
     
     // Layer shell
     struct wlr_layer_shell_v1* layer_shell;
     
     // Input
-    struct wlr_xcursor_manager* cursor_mgr;
-    struct wl_listener request_cursor;
+    struct wlr_xcursor_manager* cursor_mgr;  // Themes loaded per output scale, images shared by all outputs at that scale
+    struct wlr_cursor_shape_manager_v1* cursor_shape_mgr;
+    std::string cursor_shape_;  // Current named shape, empty while a client surface is the cursor
     struct wl_listener request_set_selection;
     
     // Core architecture
     std::unique_ptr<Core::Seat> core_seat_;
-    std::vector<Core::Client*> clients_;  // Owned clients
+    Core::ClientStore client_store_;  // Owns all clients
     View* focused_view_;  // Current wayland-level focus
     
     std::unique_ptr<TilingLayout> layout_engine_;
@@ -213,6 +300,15 @@ private:
     // Watchdog timer to prevent compositor freezes
     std::unique_ptr<Core::WatchdogTimer> watchdog_;
     
+    // Idle notify/inhibit, DPMS
+    std::unique_ptr<IdleManager> idle_manager_;
+    
+    // Per-client frame callback caps and commit storm throttling
+    std::unique_ptr<FrameGovernor> frame_governor_;
+    
+    // Shared-memory state snapshot for bars and monitoring tools
+    std::unique_ptr<StatePublisher> state_publisher_;
+    
     
     // Colors (RGBA format for wlroots)
     float border_focused_[4];
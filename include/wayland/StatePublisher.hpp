@@ -0,0 +1,76 @@
+#ifndef STATE_PUBLISHER_HPP
+#define STATE_PUBLISHER_HPP
+
+#include "wayland/WaylandTypes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct leviathan_state;
+
+namespace Leviathan {
+namespace IPC {
+class Server;
+}
+
+namespace Wayland {
+
+class Server;
+
+/**
+ * Publishes compositor state into shared memory (ipc/StateSnapshot.h).
+ * 
+ * Bars and monitoring tools poll tags, focus and clients all the time; a
+ * socket round trip and JSON per poll adds up. The snapshot lives in a sealed
+ * memfd that readers map read-only once (IPC get_state_fd) and read under a
+ * seqlock, with no syscalls.
+ * 
+ * Publishing is coalesced into one idle callback. It is triggered by EventBus
+ * events, output layout changes, and CheckForChanges() after each output
+ * frame, which compares the ClientColumns revision so window moves and
+ * resizes are caught without hooking every caller. Each publish is announced
+ * to IPC event subscribers as state_changed.
+ */
+class StatePublisher {
+public:
+    StatePublisher(Server* server, struct wl_event_loop* event_loop, IPC::Server* ipc_server);
+    ~StatePublisher();
+    
+    StatePublisher(const StatePublisher&) = delete;
+    StatePublisher& operator=(const StatePublisher&) = delete;
+    
+    // Read-only snapshot fd for get_state_fd, -1 if shared memory is unavailable
+    int GetFd() const { return fd_; }
+    size_t GetSize() const;
+    uint32_t GetSequence() const;
+    
+    // Publish once the event loop is idle
+    void MarkDirty();
+    
+    // After each output frame: republish if any client changed
+    void CheckForChanges();
+
+private:
+    static void HandleIdle(void* data);
+    
+    bool CreateMemfd();
+    void Publish();
+    void Fill(struct leviathan_state* state);
+    
+    Server* server_;
+    struct wl_event_loop* event_loop_;
+    IPC::Server* ipc_server_;
+    struct wl_event_source* idle_ = nullptr;
+    
+    int fd_ = -1;
+    struct leviathan_state* state_ = nullptr;  // Writable mapping of fd_
+    uint64_t published_revision_ = 0;
+    
+    std::vector<int> subscriptions_;  // EventBus subscription IDs
+};
+
+} // namespace Wayland
+} // namespace Leviathan
+
+#endif // STATE_PUBLISHER_HPP
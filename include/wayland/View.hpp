@@ -6,6 +6,10 @@
 #include "config/ConfigParser.hpp"  // For WindowDecorationConfig
 
 namespace Leviathan {
+namespace Core {
+class Client;
+}
+
 namespace Wayland {
 
 // Forward declarations
@@ -36,11 +40,8 @@ struct View {
     struct wlr_scene_rect* shadow_bottom;
     struct wlr_scene_rect* shadow_left;
     
-    int x, y;
-    int width, height;
-    bool is_floating;
-    bool is_fullscreen;
-    bool mapped;
+    // Geometry and state flags live in the client's ClientStore columns
+    Core::Client* client;
     float opacity;  // Current window opacity (0.0 - 1.0)
     int border_radius;  // Border radius in pixels
     
@@ -55,12 +56,29 @@ struct View {
     struct wl_listener request_fullscreen;
     struct wl_listener decoration_request_mode;  // Decoration mode request
     struct wl_listener associate;  // XWayland surface association (when wl_surface becomes available)
+    struct wl_listener configure;       // XDG only: configure sent, for ClientStats
+    struct wl_listener ack_configure;   // XDG only: configure acked
+    struct wl_listener client_commit;   // XDG only: wl_surface.commit before it applies, for the frame governor
     
     // Constructors for different surface types
     View(struct wlr_xdg_toplevel* toplevel, Server* server);
     View(struct ::wlr_xwayland_surface* xwayland_surface, Server* server);  // Use global namespace for C types
     ~View();
     
+    // Layout state, forwarded to the client (defaults until it exists)
+    int GetX() const;
+    int GetY() const;
+    int GetWidth() const;
+    int GetHeight() const;
+    bool IsMapped() const;
+    bool IsFloating() const;
+    bool IsFullscreen() const;
+    void SetMapped(bool mapped);
+    void SetFloating(bool floating);
+    void SetFullscreen(bool fullscreen);
+    void StoreSize(int width, int height);
+    void StoreGeometry(int x, int y, int width, int height);
+    
     // Border management
     void CreateBorders(int border_width, const float color[4]);
     void UpdateBorderColor(const float color[4]);
@@ -46,6 +46,16 @@ extern "C" {
     const char* xwayland_get_display_name(struct wlr_xwayland* xwayland);
     struct wl_signal* xwayland_get_ready_signal(struct wlr_xwayland* xwayland);
     struct wl_signal* xwayland_get_new_surface_signal(struct wlr_xwayland* xwayland);
+
+    // Xwayland server process (pid is 0 while a lazy server is not running)
+    struct wl_signal* xwayland_get_server_start_signal(struct wlr_xwayland* xwayland);
+    pid_t xwayland_get_server_pid(struct wlr_xwayland* xwayland);
+
+    // wlr_xwayland_create() with a configurable idle timeout (seconds, lazy only).
+    // The timeout is dropped unless the Xwayland build supports -terminate delays
+    bool xwayland_has_terminate_delay(void);
+    struct wlr_xwayland* xwayland_create_with_options(struct wl_display* display, struct wlr_compositor* compositor,
+                                                      bool lazy, int terminate_delay);
 }
 
 // These wlroots functions are already declared in wlroots library with C linkage
@@ -2,8 +2,7 @@
 #include "wayland/Server.hpp"
 #include "Logger.hpp"
 #include "ui/menubar/MenuBarManager.hpp"
-#include <unistd.h>
-#include <sys/wait.h>
+#include "core/SpawnHelper.hpp"
 
 namespace Leviathan {
 
@@ -180,6 +179,7 @@ void ActionRegistry::ExecuteBuiltinAction(const Action& action) {
             auto* client = server_->GetFocusedClient();
             if (client) {
                 client->SetFullscreen(!client->IsFullscreen());
+                server_->ScheduleVisibilityUpdate();
             }
             break;
         }
@@ -226,17 +226,7 @@ void ActionRegistry::ExecuteBuiltinAction(const Action& action) {
             }
             
             if (!command.empty()) {
-                pid_t pid = fork();
-                if (pid == 0) {
-                    // Child process
-                    setsid();
-                    execl("/bin/sh", "/bin/sh", "-c", command.c_str(), nullptr);
-                    _exit(1);
-                } else if (pid > 0) {
-                    Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Spawned command: {} (PID: {})", command, pid);
-                } else {
-                    Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to fork for command: {}", command);
-                }
+                Core::SpawnHelper::Instance().SpawnCommand(command);
             }
             break;
         }
@@ -27,6 +27,26 @@ bool ConfigParser::Load(const std::string& config_path) {
             ParseNightLight(config["night_light"]);
         }
         
+        if (config["notifications"]) {
+            ParseNotifications(config["notifications"]);
+        }
+        
+        if (config["rendering"]) {
+            ParseRendering(config["rendering"]);
+        }
+        
+        if (config["xwayland"]) {
+            ParseXwayland(config["xwayland"]);
+        }
+        
+        if (config["idle"]) {
+            ParseIdle(config["idle"]);
+        }
+        
+        if (config["frame-governor"]) {
+            ParseFrameGovernor(config["frame-governor"]);
+        }
+        
         if (config["plugins"]) {
             ParsePlugins(config["plugins"]);
         }
@@ -97,6 +117,26 @@ bool ConfigParser::LoadWithIncludes(const std::string& main_config) {
             ParseNightLight(config["night_light"]);
         }
         
+        if (config["notifications"]) {
+            ParseNotifications(config["notifications"]);
+        }
+        
+        if (config["rendering"]) {
+            ParseRendering(config["rendering"]);
+        }
+        
+        if (config["xwayland"]) {
+            ParseXwayland(config["xwayland"]);
+        }
+        
+        if (config["idle"]) {
+            ParseIdle(config["idle"]);
+        }
+        
+        if (config["frame-governor"]) {
+            ParseFrameGovernor(config["frame-governor"]);
+        }
+        
         if (config["plugins"]) {
             ParsePlugins(config["plugins"]);
         }
@@ -362,6 +402,138 @@ void ConfigParser::ParseNightLight(const YAML::Node& node) {
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "=== ParseNightLight complete ===");
 }
 
+void ConfigParser::ParseNotifications(const YAML::Node& node) {
+    if (node["enabled"]) {
+        notifications.enabled = node["enabled"].as<bool>();
+    }
+    
+    if (node["default_timeout"]) {
+        notifications.default_timeout = std::max(0, node["default_timeout"].as<int>());
+    }
+    
+    if (node["history_size"]) {
+        // At least one slot so a burst can never grow the daemon unbounded
+        notifications.history_size = std::max(1, std::min(10000, node["history_size"].as<int>()));
+    }
+    
+    if (node["max_visible"]) {
+        notifications.max_visible = std::max(1, std::min(20, node["max_visible"].as<int>()));
+    }
+    
+    if (node["max_updates_per_second"]) {
+        notifications.max_updates_per_second = std::max(1, std::min(120, node["max_updates_per_second"].as<int>()));
+    }
+    
+    if (node["group_window"]) {
+        notifications.group_window = std::max(0, node["group_window"].as<int>());
+    }
+    
+    if (node["width"]) {
+        notifications.width = std::max(100, node["width"].as<int>());
+    }
+    
+    if (node["margin"]) {
+        notifications.margin = std::max(0, node["margin"].as<int>());
+    }
+    
+    if (node["spacing"]) {
+        notifications.spacing = std::max(0, node["spacing"].as<int>());
+    }
+    
+    if (node["font_family"]) {
+        notifications.font_family = node["font_family"].as<std::string>();
+    }
+    
+    if (node["font_size"]) {
+        notifications.font_size = std::max(6, node["font_size"].as<int>());
+    }
+    
+    if (node["background_color"]) {
+        notifications.background_color = node["background_color"].as<std::string>();
+    }
+    
+    if (node["foreground_color"]) {
+        notifications.foreground_color = node["foreground_color"].as<std::string>();
+    }
+    
+    if (node["critical_color"]) {
+        notifications.critical_color = node["critical_color"].as<std::string>();
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Notifications: enabled={}, history_size={}, max_visible={}, max_updates_per_second={}",
+                 notifications.enabled, notifications.history_size, notifications.max_visible,
+                 notifications.max_updates_per_second);
+}
+
+void ConfigParser::ParseRendering(const YAML::Node& node) {
+    if (node["frame_pacing"]) {
+        rendering.frame_pacing = node["frame_pacing"].as<bool>();
+    }
+    
+    if (node["max_render_time"]) {
+        rendering.max_render_time = std::max(0, std::min(100, node["max_render_time"].as<int>()));
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Rendering: frame_pacing={}, max_render_time={}ms",
+                 rendering.frame_pacing, rendering.max_render_time);
+}
+
+void ConfigParser::ParseXwayland(const YAML::Node& node) {
+    if (node["enabled"]) {
+        xwayland.enabled = node["enabled"].as<bool>();
+    }
+    
+    if (node["lazy"]) {
+        xwayland.lazy = node["lazy"].as<bool>();
+    }
+    
+    if (node["idle_timeout"]) {
+        xwayland.idle_timeout = std::max(0, node["idle_timeout"].as<int>());
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Xwayland: enabled={}, lazy={}, idle_timeout={}s",
+                 xwayland.enabled, xwayland.lazy, xwayland.idle_timeout);
+}
+
+void ConfigParser::ParseIdle(const YAML::Node& node) {
+    if (node["timeout"]) {
+        idle.timeout = std::max(0, node["timeout"].as<int>());
+    }
+    
+    if (node["dpms_timeout"]) {
+        idle.dpms_timeout = std::max(0, node["dpms_timeout"].as<int>());
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Idle: timeout={}s, dpms_timeout={}s",
+                 idle.timeout, idle.dpms_timeout);
+}
+
+void ConfigParser::ParseFrameGovernor(const YAML::Node& node) {
+    if (node["enabled"]) {
+        frame_governor.enabled = node["enabled"].as<bool>();
+    }
+    
+    if (node["unfocused_fps"]) {
+        frame_governor.unfocused_fps = std::max(0, node["unfocused_fps"].as<int>());
+    }
+    
+    if (node["battery_unfocused_fps"]) {
+        frame_governor.battery_unfocused_fps = std::max(0, node["battery_unfocused_fps"].as<int>());
+    }
+    
+    if (node["storm_factor"]) {
+        frame_governor.storm_factor = std::max(0, node["storm_factor"].as<int>());
+    }
+    
+    if (node["storm_fps"]) {
+        frame_governor.storm_fps = std::max(0, node["storm_fps"].as<int>());
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Frame governor: enabled={}, unfocused={} fps, on battery={} fps, storm above {}x refresh -> {} fps",
+                 frame_governor.enabled, frame_governor.unfocused_fps, frame_governor.battery_unfocused_fps,
+                 frame_governor.storm_factor, frame_governor.storm_fps);
+}
+
 void ConfigParser::ParsePlugins(const YAML::Node& node) {
     // Set default plugin paths if none configured
     if (!node["plugin_paths"] || 
@@ -762,6 +934,23 @@ void ConfigParser::ParseMonitorGroups(const YAML::Node& node) {
                         mon_node["rotation"].as<int>();
                 }
                 
+                // Parse adaptive sync (VRR)
+                if (mon_node["adaptive_sync"]) {
+                    std::string mode = mon_node["adaptive_sync"].as<std::string>();
+                    std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+                    if (mode == "on" || mode == "true" || mode == "yes") {
+                        mon.adaptive_sync = AdaptiveSyncMode::ON;
+                    } else if (mode == "auto") {
+                        mon.adaptive_sync = AdaptiveSyncMode::AUTO;
+                    } else {
+                        mon.adaptive_sync = AdaptiveSyncMode::OFF;
+                    }
+                }
+                
+                if (mon_node["allow_tearing"]) {
+                    mon.allow_tearing = mon_node["allow_tearing"].as<bool>();
+                }
+                
                 group.monitors.push_back(mon);
             }
         }
@@ -882,6 +1071,8 @@ void ConfigParser::ParseWallpapers(const YAML::Node& node) {
                 // WallpaperEngine support disabled for now
                 Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "WallpaperEngine support is currently disabled, using static image instead");
                 wp.type = WallpaperType::StaticImage;
+            } else if (type_str == "color" || type_str == "solid" || type_str == "solid_color") {
+                wp.type = WallpaperType::SolidColor;
             } else {
                 Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Unknown wallpaper type '{}', defaulting to static image", type_str);
                 wp.type = WallpaperType::StaticImage;
@@ -891,6 +1082,19 @@ void ConfigParser::ParseWallpapers(const YAML::Node& node) {
             wp.type = WallpaperType::StaticImage;
         }
         
+        if (wp_node["color"]) {
+            wp.color = wp_node["color"].as<std::string>();
+        }
+        if (wp.type == WallpaperType::SolidColor) {
+            if (wp.color.empty()) {
+                Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Solid color wallpaper '{}' has no 'color', using black", wp.name);
+                wp.color = "#000000";
+            }
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Loaded wallpaper config '{}' (type: color) with color {}", wp.name, wp.color);
+            wallpapers.wallpapers.push_back(wp);
+            continue;
+        }
+        
         // Parse wallpaper paths - can be a single string or sequence
         if (wp_node["wallpaper"]) {
             const auto& path_node = wp_node["wallpaper"];
@@ -1116,6 +1320,9 @@ void ConfigParser::ParseWindowRules(const YAML::Node& node) {
         if (rule_node["tag"]) {
             rule.tag = rule_node["tag"].as<int>();
         }
+        if (rule_node["max_fps"]) {
+            rule.max_fps = std::max(0, rule_node["max_fps"].as<int>());
+        }
         
         std::string rule_desc = rule.name.empty() ? "unnamed" : rule.name;
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Loaded window rule '{}': app_id='{}', title='{}', decoration_group='{}'",
@@ -0,0 +1,36 @@
+#include "core/AllocationCounter.hpp"
+
+#include <atomic>
+
+namespace Leviathan {
+namespace Core {
+
+namespace {
+
+// Relaxed: icon decoding and the logger allocate from other threads, and
+// only the totals matter
+std::atomic<uint64_t> allocation_count{0};
+std::atomic<uint64_t> allocated_bytes{0};
+
+} // namespace
+
+uint64_t GetAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+uint64_t GetAllocatedBytes() {
+    return allocated_bytes.load(std::memory_order_relaxed);
+}
+
+bool IsAllocationCountingEnabled() {
+    // Static initialisers allocate long before anyone asks
+    return GetAllocationCount() != 0;
+}
+
+void RecordAllocation(size_t bytes) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+} // namespace Core
+} // namespace Leviathan
@@ -0,0 +1,60 @@
+// Replacement global operator new/delete that feed the allocation counter.
+// Linked into leviathan only with ENABLE_ALLOCATION_STATS, always into
+// leviathan-bench.
+
+#include "core/AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void* CountedAlloc(std::size_t size) {
+    Leviathan::Core::RecordAllocation(size);
+    if (size == 0) {
+        size = 1;
+    }
+    return std::malloc(size);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* ptr = CountedAlloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    void* ptr = CountedAlloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
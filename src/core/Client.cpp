@@ -1,5 +1,7 @@
 #include "core/Client.hpp"
 
+#include <algorithm>
+
 extern "C" {
 #include <wlr/types/wlr_xdg_shell.h>
 #include <wlr/types/wlr_scene.h>
@@ -8,12 +10,10 @@ extern "C" {
 namespace Leviathan {
 namespace Core {
 
-Client::Client(Wayland::View* view)
+Client::Client(Wayland::View* view, ClientColumns* columns, ClientId id)
     : view_(view)
-    , is_floating_(false)
-    , is_fullscreen_(false)
-    , is_focused_(false)
-    , is_visible_(true) {
+    , columns_(columns)
+    , id_(id) {
     
     UpdateTitle();
     UpdateAppId();
@@ -23,53 +23,40 @@ Client::~Client() {
     // View is owned and destroyed by Wayland layer
 }
 
-void Client::SetFloating(bool floating) {
-    is_floating_ = floating;
-    if (view_) {
-        view_->is_floating = floating;
+void Client::SetFlag(uint8_t flag, bool value) {
+    uint8_t& flags = columns_->flags[id_.index];
+    uint8_t updated = value ? (flags | flag) : (flags & ~flag);
+    if (updated != flags) {
+        flags = updated;
+        columns_->revision++;
     }
 }
 
 void Client::SetFullscreen(bool fullscreen) {
-    is_fullscreen_ = fullscreen;
+    StoreFullscreen(fullscreen);
     if (view_ && view_->xdg_toplevel) {
         wlr_xdg_toplevel_set_fullscreen(view_->xdg_toplevel, fullscreen);
-        view_->is_fullscreen = fullscreen;
     }
 }
 
-bool Client::IsMapped() const {
-    return view_ && view_->mapped;
-}
-
 void Client::SetVisible(bool visible) {
-    is_visible_ = visible;
+    SetFlag(CLIENT_VISIBLE, visible);
     if (view_ && view_->scene_tree) {
         wlr_scene_node_set_enabled(&view_->scene_tree->node, visible);
     }
 }
 
-int Client::GetX() const {
-    return view_ ? view_->x : 0;
-}
-
-int Client::GetY() const {
-    return view_ ? view_->y : 0;
-}
-
-int Client::GetWidth() const {
-    return view_ ? view_->width : 0;
-}
-
-int Client::GetHeight() const {
-    return view_ ? view_->height : 0;
+void Client::SetSuspended(bool suspended) {
+    SetFlag(CLIENT_SUSPENDED, suspended);
+    if (view_ && view_->xdg_toplevel) {
+        wlr_xdg_toplevel_set_suspended(view_->xdg_toplevel, suspended);
+    }
 }
 
 void Client::SetPosition(int x, int y) {
     if (!view_) return;
     
-    view_->x = x;
-    view_->y = y;
+    StorePosition(x, y);
     
     if (view_->scene_tree) {
         wlr_scene_node_set_position(&view_->scene_tree->node, x, y);
@@ -79,8 +66,7 @@ void Client::SetPosition(int x, int y) {
 void Client::SetSize(int width, int height) {
     if (!view_) return;
     
-    view_->width = width;
-    view_->height = height;
+    StoreSize(width, height);
     
     if (view_->xdg_toplevel) {
         wlr_xdg_toplevel_set_size(view_->xdg_toplevel, width, height);
@@ -92,6 +78,100 @@ void Client::SetGeometry(int x, int y, int width, int height) {
     SetSize(width, height);
 }
 
+void Client::StorePosition(int x, int y) {
+    if (columns_->x[id_.index] != x || columns_->y[id_.index] != y) {
+        columns_->x[id_.index] = x;
+        columns_->y[id_.index] = y;
+        columns_->revision++;
+    }
+}
+
+void Client::StoreSize(int width, int height) {
+    if (columns_->width[id_.index] != width || columns_->height[id_.index] != height) {
+        columns_->width[id_.index] = width;
+        columns_->height[id_.index] = height;
+        columns_->revision++;
+    }
+}
+
+void Client::StoreGeometry(int x, int y, int width, int height) {
+    StorePosition(x, y);
+    StoreSize(width, height);
+}
+
+void Client::SetTagMembership(int tag_index, int output_index) {
+    columns_->tag_index[id_.index] = tag_index;
+    columns_->output_index[id_.index] = output_index;
+    columns_->revision++;
+}
+
+namespace {
+
+// Moving average over roughly the last 8 samples
+void AddSample(uint64_t& average, uint64_t& max, uint64_t sample) {
+    average = average ? average - average / 8 + sample / 8 : sample;
+    max = std::max(max, sample);
+}
+
+} // namespace
+
+void Client::RecordCommit(uint64_t now_ns, uint64_t damage_pixels) {
+    stats_.commits++;
+    stats_.damage_pixels += damage_pixels;
+    stats_.window_commits++;
+    stats_.window_damage += damage_pixels;
+
+    if (stats_.frame_sent_ns) {
+        AddSample(stats_.frame_latency_ns, stats_.max_frame_latency_ns, now_ns - stats_.frame_sent_ns);
+        stats_.frame_sent_ns = 0;
+    }
+
+    uint64_t elapsed = now_ns - stats_.window_start_ns;
+    if (elapsed < ClientStats::WINDOW_NS) {
+        return;
+    }
+    if (stats_.window_start_ns) {
+        stats_.commit_rate = static_cast<uint32_t>(stats_.window_commits * 1000000000ULL / elapsed);
+        stats_.damage_rate = stats_.window_damage * 1000000000ULL / elapsed;
+    }
+    stats_.window_start_ns = now_ns;
+    stats_.window_commits = 0;
+    stats_.window_damage = 0;
+}
+
+void Client::RecordFrameCallback(uint64_t now_ns) {
+    // A client that skips a callback is slow from the first one on
+    if (!stats_.frame_sent_ns) {
+        stats_.frame_sent_ns = now_ns;
+    }
+}
+
+void Client::RecordConfigure(uint32_t serial, uint64_t now_ns) {
+    // Timed from the oldest unacked configure until the client acks the newest
+    stats_.configure_serial = serial;
+    if (!stats_.configure_sent_ns) {
+        stats_.configure_sent_ns = now_ns;
+    }
+}
+
+void Client::RecordAckConfigure(uint32_t serial, uint64_t now_ns) {
+    if (!stats_.configure_sent_ns || serial != stats_.configure_serial) {
+        return;
+    }
+    AddSample(stats_.configure_rtt_ns, stats_.max_configure_rtt_ns, now_ns - stats_.configure_sent_ns);
+    stats_.configure_sent_ns = 0;
+}
+
+void Client::RecordBuffer(uint64_t shm_bytes, uint64_t dmabuf_bytes) {
+    stats_.shm_bytes = shm_bytes;
+    stats_.dmabuf_bytes = dmabuf_bytes;
+    if (shm_bytes) {
+        stats_.shm_commits++;
+    } else if (dmabuf_bytes) {
+        stats_.dmabuf_commits++;
+    }
+}
+
 void Client::Close() {
     if (view_ && view_->xdg_toplevel) {
         wlr_xdg_toplevel_send_close(view_->xdg_toplevel);
@@ -99,9 +179,9 @@ void Client::Close() {
 }
 
 void Client::Focus() {
-    if (!view_ || !view_->mapped) return;
+    if (!view_ || !IsMapped()) return;
     
-    is_focused_ = true;
+    SetFocused(true);
     
     if (view_->scene_tree) {
         wlr_scene_node_raise_to_top(&view_->scene_tree->node);
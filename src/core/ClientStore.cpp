@@ -0,0 +1,94 @@
+#include "core/ClientStore.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+
+namespace Leviathan {
+namespace Core {
+
+ClientStore::~ClientStore() {
+    Clear();
+}
+
+Client* ClientStore::Create(Wayland::View* view) {
+    uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+        columns_.x.push_back(0);
+        columns_.y.push_back(0);
+        columns_.width.push_back(0);
+        columns_.height.push_back(0);
+        columns_.flags.push_back(0);
+        columns_.tag_index.push_back(-1);
+        columns_.output_index.push_back(-1);
+    }
+    
+    columns_.x[index] = 0;
+    columns_.y[index] = 0;
+    columns_.width[index] = 0;
+    columns_.height[index] = 0;
+    columns_.flags[index] = CLIENT_VISIBLE;
+    columns_.tag_index[index] = -1;
+    columns_.output_index[index] = -1;
+    columns_.revision++;
+    
+    Slot& slot = slots_[index];
+    ClientId id{index, slot.generation};
+    Client* client = &slot.client.emplace(view, &columns_, id);
+    live_.push_back(client);
+    
+    if (view) {
+        view->client = client;
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "ClientStore: created client {} (slot {}, generation {})",
+                  id.ToU64(), index, id.generation);
+    return client;
+}
+
+void ClientStore::Destroy(ClientId id) {
+    Client* client = Get(id);
+    if (!client) {
+        return;
+    }
+    
+    if (auto* view = client->GetView()) {
+        view->client = nullptr;
+    }
+    
+    live_.erase(std::find(live_.begin(), live_.end(), client));
+    
+    Slot& slot = slots_[id.index];
+    slot.client.reset();
+    
+    // Skip 0 on wrap-around: it marks invalid IDs
+    if (++slot.generation == 0) {
+        slot.generation = 1;
+    }
+    columns_.flags[id.index] = 0;
+    columns_.revision++;
+    free_slots_.push_back(id.index);
+}
+
+void ClientStore::Clear() {
+    while (!live_.empty()) {
+        Destroy(live_.back()->GetId());
+    }
+}
+
+Client* ClientStore::Get(ClientId id) {
+    if (!id.IsValid() || id.index >= slots_.size()) {
+        return nullptr;
+    }
+    Slot& slot = slots_[id.index];
+    if (slot.generation != id.generation || !slot.client) {
+        return nullptr;
+    }
+    return &*slot.client;
+}
+
+} // namespace Core
+} // namespace Leviathan
@@ -1,164 +1,291 @@
 #include "core/Events.hpp"
+#include "core/Tag.hpp"
+#include "core/Client.hpp"
+#include "core/Screen.hpp"
 #include "ipc/IPC.hpp"
 #include "Logger.hpp"
+#include "Types.hpp"
 #include <algorithm>
+#include <exception>
 
 namespace Leviathan {
 namespace Core {
 
-int EventBus::Subscribe(EventType type, EventListener listener) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    int id = next_id_++;
-    subscriptions_.push_back({id, type, listener});
-    
-    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "EventBus: Subscription {} added for event type {}", 
-                  id, static_cast<int>(type));
-    
-    return id;
+namespace {
+
+void AddTag(IPC::EventMessage& message, const char* key, const Tag* tag) {
+    if (tag) {
+        message.data[key] = tag->GetName();
+    }
+}
+
+void AddClient(IPC::EventMessage& message, const Client* client) {
+    if (client) {
+        message.data["id"] = std::to_string(client->GetId().ToU64());
+        message.data["title"] = client->GetTitle();
+        message.data["app_id"] = client->GetAppId();
+    }
+}
+
+const char* LayoutName(LayoutType layout) {
+    switch (layout) {
+        case LayoutType::MASTER_STACK: return "master_stack";
+        case LayoutType::MONOCLE: return "monocle";
+        case LayoutType::GRID: return "grid";
+        default: return "unknown";
+    }
+}
+
+IPC::EventMessage ToIPC(const TagSwitchedEvent& e) {
+    IPC::EventMessage message;
+    message.type = IPC::EventType::TAG_SWITCHED;
+    AddTag(message, "old_tag", e.old_tag);
+    AddTag(message, "tag", e.new_tag);
+    if (e.screen) {
+        message.data["output"] = e.screen->GetName();
+    }
+    return message;
+}
+
+IPC::EventMessage ToIPC(const TagVisibilityChangedEvent& e) {
+    IPC::EventMessage message;
+    message.type = IPC::EventType::TAG_VISIBILITY_CHANGED;
+    AddTag(message, "tag", e.tag);
+    message.data["visible"] = e.visible ? "true" : "false";
+    return message;
+}
+
+IPC::EventMessage ToIPC(const ClientAddedEvent& e) {
+    IPC::EventMessage message;
+    message.type = IPC::EventType::CLIENT_ADDED;
+    AddClient(message, e.client);
+    AddTag(message, "tag", e.tag);
+    return message;
+}
+
+IPC::EventMessage ToIPC(const ClientRemovedEvent& e) {
+    IPC::EventMessage message;
+    message.type = IPC::EventType::CLIENT_REMOVED;
+    AddClient(message, e.client);
+    AddTag(message, "tag", e.tag);
+    return message;
+}
+
+IPC::EventMessage ToIPC(const ClientTagChangedEvent& e) {
+    IPC::EventMessage message;
+    message.type = IPC::EventType::CLIENT_TAG_CHANGED;
+    AddClient(message, e.client);
+    AddTag(message, "old_tag", e.old_tag);
+    AddTag(message, "tag", e.new_tag);
+    return message;
+}
+
+IPC::EventMessage ToIPC(const ClientFocusedEvent& e) {
+    IPC::EventMessage message;
+    message.type = IPC::EventType::CLIENT_FOCUSED;
+    AddClient(message, e.client);
+    return message;
+}
+
+IPC::EventMessage ToIPC(const LayoutChangedEvent& e) {
+    IPC::EventMessage message;
+    message.type = IPC::EventType::TILING_MODE_CHANGED;
+    AddTag(message, "tag", e.tag);
+    if (e.tag) {
+        message.data["layout"] = LayoutName(e.tag->GetLayout());
+    }
+    return message;
+}
+
+} // namespace
+
+EventBus::EventBus() : owner_thread_(std::this_thread::get_id()) {
+    for (size_t i = 0; i < INBOX_CAPACITY; i++) {
+        inbox_[i].sequence.store(i, std::memory_order_relaxed);
+    }
 }
 
 void EventBus::Unsubscribe(int subscription_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    auto it = std::find_if(subscriptions_.begin(), subscriptions_.end(),
-                          [subscription_id](const Subscription& sub) {
-                              return sub.id == subscription_id;
-                          });
+    bool found = false;
+    auto mark_all = [&](auto&... lists) {
+        auto mark = [&](auto& list) {
+            for (auto& sub : list) {
+                if (sub.id == subscription_id) {
+                    sub.id = 0;
+                    found = true;
+                }
+            }
+        };
+        (mark(lists), ...);
+    };
+    std::apply(mark_all, subscriptions_);
+    std::apply(mark_all, added_);
     
-    if (it != subscriptions_.end()) {
+    if (found) {
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "EventBus: Subscription {} removed", subscription_id);
-        subscriptions_.erase(it);
+        has_unsubscribed_ = true;
+        if (dispatch_depth_ == 0) {
+            CompactSubscriptions();
+        }
     }
 }
 
-void EventBus::Publish(const Event& event) {
-    // If IPC broadcasting is enabled, broadcast via IPC instead
-    if (ipc_server_) {
-        IPC::EventMessage ipc_event;
-        
-        // Convert Core::EventType to IPC::EventType
-        switch (event.type) {
-            case EventType::TagSwitched:
-                ipc_event.type = IPC::EventType::TAG_SWITCHED;
-                // Add event-specific data if needed
-                break;
-            case EventType::ClientAdded:
-                ipc_event.type = IPC::EventType::CLIENT_ADDED;
-                break;
-            case EventType::ClientRemoved:
-                ipc_event.type = IPC::EventType::CLIENT_REMOVED;
-                break;
-            case EventType::LayoutChanged:
-                ipc_event.type = IPC::EventType::TILING_MODE_CHANGED;
-                break;
-            default:
-                ipc_event.type = IPC::EventType::UNKNOWN;
-                break;
-        }
-        
-        // Broadcast via IPC (asynchronous, non-blocking)
-        ipc_server_->BroadcastEvent(ipc_event);
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "EventBus: Event broadcast via IPC (type {})", static_cast<int>(event.type));
+void EventBus::Publish(const AnyEvent& event) {
+    if (std::this_thread::get_id() != owner_thread_) {
+        Post(event);
         return;
     }
     
-    // Otherwise use the old queue-based system (for backwards compatibility)
-    // Queue the event (make a copy since event may be temporary)
-    std::shared_ptr<Event> event_copy;
-    
-    // Clone the event based on its type
-    switch (event.type) {
-        case EventType::TagSwitched: {
-            auto& e = static_cast<const TagSwitchedEvent&>(event);
-            event_copy = std::make_shared<TagSwitchedEvent>(e.old_tag, e.new_tag, e.screen);
-            break;
-        }
-        case EventType::TagVisibilityChanged: {
-            auto& e = static_cast<const TagVisibilityChangedEvent&>(event);
-            event_copy = std::make_shared<TagVisibilityChangedEvent>(e.tag, e.visible);
-            break;
+    // Called from a listener: finish the current event first
+    if (dispatch_depth_ > 0) {
+        if (pending_count_ == PENDING_CAPACITY) {
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "EventBus: Pending queue full, dispatching nested event immediately");
+            Dispatch(event);
+            return;
         }
-        case EventType::ClientAdded: {
-            auto& e = static_cast<const ClientAddedEvent&>(event);
-            event_copy = std::make_shared<ClientAddedEvent>(e.client, e.tag);
-            break;
-        }
-        default:
-            // For other event types, just copy the base (extend as needed)
-            event_copy = std::make_shared<Event>();
-            event_copy->type = event.type;
-            break;
+        pending_[(pending_head_ + pending_count_) % PENDING_CAPACITY] = event;
+        pending_count_++;
+        return;
     }
     
-    // Add to queue
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        event_queue_.push(event_copy);
+    Dispatch(event);
+    
+    while (pending_count_ > 0) {
+        AnyEvent next = pending_[pending_head_];
+        pending_head_ = (pending_head_ + 1) % PENDING_CAPACITY;
+        pending_count_--;
+        Dispatch(next);
     }
     
-    // Try to start processing if not already running
-    bool expected = false;
-    if (processing_queue_.compare_exchange_strong(expected, true)) {
-        // We acquired the processing lock, drain the queue
-        ProcessEventQueue();
-        // Release the lock
-        processing_queue_.store(false);
+    if (has_unsubscribed_ || has_added_) {
+        CompactSubscriptions();
     }
-    // else: another thread is already processing, our event is queued
 }
 
-void EventBus::ProcessEventQueue() {
+bool EventBus::Post(const AnyEvent& event) {
+    size_t ticket = inbox_tail_.load(std::memory_order_relaxed);
+    InboxSlot* slot;
     while (true) {
-        // Get next event from queue
-        std::shared_ptr<Event> event;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            if (event_queue_.empty()) {
-                break;  // Queue is empty, done
+        slot = &inbox_[ticket % INBOX_CAPACITY];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(ticket);
+        if (diff == 0) {
+            if (inbox_tail_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) {
+                break;
             }
-            event = event_queue_.front();
-            event_queue_.pop();
+        } else if (diff < 0) {
+            // The compositor has not caught up with the last INBOX_CAPACITY events
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "EventBus: Inbox full, dropping event");
+            return false;
+        } else {
+            ticket = inbox_tail_.load(std::memory_order_relaxed);
         }
-        
-        // Process this event
-        std::vector<EventListener> listeners_to_call;
-        
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            
-            // Collect all listeners for this event type
-            for (const auto& sub : subscriptions_) {
-                if (sub.type == event->type) {
-                    listeners_to_call.push_back(sub.listener);
-                }
-            }
-        } // Release mutex before calling listeners
-        
-        // Now call all listeners without holding the mutex
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "EventBus: Calling {} listener(s) for event type {}", 
-                      listeners_to_call.size(), static_cast<int>(event->type));
-        
-        size_t listener_index = 0;
-        for (const auto& listener : listeners_to_call) {
-            Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "  -> Calling listener #{}", listener_index);
-            try {
-                listener(*event);
-                Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "  <- Listener #{} completed", listener_index);
-            } catch (const std::exception& e) {
-                Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "EventBus: Exception in event listener #{}: {}", listener_index, e.what());
-            } catch (...) {
-                Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "EventBus: Unknown exception in event listener #{}", listener_index);
-            }
-            listener_index++;
+    }
+    
+    slot->event = event;
+    slot->sequence.store(ticket + 1, std::memory_order_release);
+    return true;
+}
+
+void EventBus::DrainInbox() {
+    while (true) {
+        InboxSlot& slot = inbox_[inbox_head_ % INBOX_CAPACITY];
+        if (slot.sequence.load(std::memory_order_acquire) != inbox_head_ + 1) {
+            break;  // Empty, or the producer has not finished writing
         }
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "EventBus: All listeners completed for event");
+        AnyEvent event = slot.event;
+        slot.sequence.store(inbox_head_ + INBOX_CAPACITY, std::memory_order_release);
+        inbox_head_++;
+        Publish(event);
     }
 }
 
+void EventBus::Dispatch(const AnyEvent& event) {
+    dispatch_depth_++;
+    std::visit([this](const auto& e) {
+        using E = std::decay_t<decltype(e)>;
+        if constexpr (!std::is_same_v<E, std::monostate>) {
+            Deliver(e);
+        }
+    }, event);
+    Broadcast(event);
+    dispatch_depth_--;
+}
+
+template<typename E>
+void EventBus::Deliver(const E& event) {
+    auto& list = ListenersFor<E>();
+    
+    // Listeners subscribed from inside a listener wait in added_, so the list
+    // neither grows nor moves until the dispatch is over
+    for (size_t i = 0; i < list.size(); i++) {
+        auto& sub = list[i];
+        if (sub.id == 0) {
+            continue;
+        }
+        try {
+            sub.listener(event);
+        } catch (const std::exception& e) {
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "EventBus: Exception in listener {} for event type {}: {}",
+                          sub.id, static_cast<int>(E::TYPE), e.what());
+        } catch (...) {
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "EventBus: Unknown exception in listener {} for event type {}",
+                          sub.id, static_cast<int>(E::TYPE));
+        }
+    }
+}
+
+void EventBus::Broadcast(const AnyEvent& event) {
+    // Building the message allocates, so only do it for an audience
+    if (!ipc_server_ || !ipc_server_->HasEventSubscribers()) {
+        return;
+    }
+    
+    std::visit([this](const auto& e) {
+        using E = std::decay_t<decltype(e)>;
+        if constexpr (!std::is_same_v<E, std::monostate>) {
+            ipc_server_->BroadcastEvent(ToIPC(e));
+        }
+    }, event);
+}
+
+void EventBus::CompactSubscriptions() {
+    std::apply([this](auto&... lists) {
+        auto compact = [this](auto& list) {
+            // Same type's list in added_: listeners subscribed during the dispatch
+            auto& added = std::get<std::decay_t<decltype(list)>>(added_);
+            for (auto& sub : added) {
+                list.push_back(std::move(sub));
+            }
+            added.clear();
+            list.erase(std::remove_if(list.begin(), list.end(),
+                                      [](const auto& sub) { return sub.id == 0; }),
+                       list.end());
+        };
+        (compact(lists), ...);
+    }, subscriptions_);
+    has_unsubscribed_ = false;
+    has_added_ = false;
+}
+
 void EventBus::Clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    subscriptions_.clear();
+    std::apply([](auto&... lists) {
+        (lists.clear(), ...);
+    }, added_);
+    has_added_ = false;
+    std::apply([this](auto&... lists) {
+        auto clear = [this](auto& list) {
+            if (dispatch_depth_ > 0) {
+                for (auto& sub : list) {
+                    sub.id = 0;
+                }
+                has_unsubscribed_ = true;
+            } else {
+                list.clear();
+            }
+        };
+        (clear(lists), ...);
+    }, subscriptions_);
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "EventBus: All subscriptions cleared");
 }
 
@@ -0,0 +1,94 @@
+#include "core/FrameArena.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace Leviathan {
+namespace Core {
+
+namespace {
+
+constexpr size_t INITIAL_CAPACITY = 64 * 1024;
+constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+FrameArena& FrameArena::Instance() {
+    static FrameArena instance;
+    return instance;
+}
+
+FrameArena::FrameArena() {
+    capacity_ = INITIAL_CAPACITY;
+    block_ = static_cast<std::byte*>(::operator new(capacity_));
+    overflow_.reserve(16);
+    stats_.capacity = capacity_;
+}
+
+FrameArena::~FrameArena() {
+    for (const auto& overflow : overflow_) {
+        ::operator delete(overflow.ptr, overflow.bytes, std::align_val_t(overflow.alignment));
+    }
+    ::operator delete(block_);
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    size_t start = AlignUp(offset_, alignment);
+    if (alignment <= BLOCK_ALIGNMENT && start + bytes <= capacity_) {
+        offset_ = start + bytes;
+        return block_ + start;
+    }
+    
+    // Block full (or an unusual alignment): fall back to the heap until the
+    // next reset, which sizes the block to cover this frame
+    void* ptr = ::operator new(bytes, std::align_val_t(alignment));
+    overflow_.push_back({ptr, bytes, alignment});
+    overflow_bytes_ += bytes;
+    stats_.overflows++;
+    return ptr;
+}
+
+void FrameArena::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    // Released in bulk by Reset()
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void FrameArena::Reset() {
+    size_t used = offset_ + overflow_bytes_;
+    stats_.high_water = std::max(stats_.high_water, used);
+    stats_.resets++;
+    
+    if (!overflow_.empty()) {
+        for (const auto& overflow : overflow_) {
+            ::operator delete(overflow.ptr, overflow.bytes, std::align_val_t(overflow.alignment));
+        }
+        overflow_.clear();
+        
+        size_t new_capacity = std::max(capacity_ * 2, AlignUp(used, INITIAL_CAPACITY));
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "FrameArena: growing from {} to {} bytes", capacity_, new_capacity);
+        ::operator delete(block_);
+        block_ = static_cast<std::byte*>(::operator new(new_capacity));
+        capacity_ = new_capacity;
+        stats_.capacity = capacity_;
+    }
+    
+    offset_ = 0;
+    overflow_bytes_ = 0;
+}
+
+FrameArena::Stats FrameArena::GetStats() const {
+    Stats stats = stats_;
+    stats.used = offset_ + overflow_bytes_;
+    return stats;
+}
+
+} // namespace Core
+} // namespace Leviathan
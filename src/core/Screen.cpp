@@ -78,13 +78,28 @@ void Screen::SetPosition(int x, int y) {
 }
 
 void Screen::SetScale(float scale) {
-    scale_ = scale;
+    if (!wlr_output_) {
+        scale_ = scale;
+        return;
+    }
+    
+    // The output commit handler propagates the new scale to bars, overlays
+    // and fractional-scale clients
+    struct wlr_output_state state;
+    wlr_output_state_init(&state);
+    wlr_output_state_set_scale(&state, scale);
+    if (!wlr_output_commit_state(wlr_output_, &state)) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to set scale {:.2f} on '{}'", scale, name_);
+    }
+    wlr_output_state_finish(&state);
+    SyncFromOutput();
+}
+
+void Screen::SyncFromOutput() {
     if (wlr_output_) {
-        struct wlr_output_state state;
-        wlr_output_state_init(&state);
-        wlr_output_state_set_scale(&state, scale);
-        wlr_output_commit_state(wlr_output_, &state);
-        wlr_output_state_finish(&state);
+        width_ = wlr_output_->width;
+        height_ = wlr_output_->height;
+        scale_ = wlr_output_->scale;
     }
 }
 
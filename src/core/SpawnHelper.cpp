@@ -0,0 +1,472 @@
+#include "core/SpawnHelper.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace Leviathan {
+namespace Core {
+
+namespace {
+
+// One request per SOCK_SEQPACKET message: header, then argc + envc
+// NUL-terminated strings. The environment travels with every request, so
+// variables set after the helper was forked (WAYLAND_DISPLAY, DISPLAY) apply
+constexpr size_t MAX_REQUEST = 128 * 1024;
+
+struct RequestHeader {
+    uint32_t id;
+    uint32_t argc;
+    uint32_t envc;
+};
+
+struct Reply {
+    uint32_t id;
+    int32_t pid;          // > 0 on success
+    int32_t error;        // errno from posix_spawn, 0 on success
+    uint64_t spawned_ns;  // CLOCK_MONOTONIC when the child existed
+};
+
+uint64_t NowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+// Children start with default signal handling, nothing blocked, in their own session
+int SpawnProcess(pid_t* pid, char* const argv[], char* const envp[]) {
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    
+    sigset_t signals;
+    sigemptyset(&signals);
+    posix_spawnattr_setsigmask(&attr, &signals);
+    sigfillset(&signals);
+    posix_spawnattr_setsigdefault(&attr, &signals);
+    
+    short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+#ifdef POSIX_SPAWN_SETSID
+    flags |= POSIX_SPAWN_SETSID;
+#endif
+    posix_spawnattr_setflags(&attr, flags);
+    
+    int error = posix_spawnp(pid, argv[0], nullptr, &attr, argv, envp);
+    posix_spawnattr_destroy(&attr);
+    return error;
+}
+
+Reply HandleRequest(char* data, size_t size) {
+    Reply reply{};
+    reply.error = EINVAL;
+    if (size < sizeof(RequestHeader)) {
+        return reply;
+    }
+    
+    RequestHeader header;
+    memcpy(&header, data, sizeof(header));
+    reply.id = header.id;
+    
+    // Point into the message; every string must be terminated inside it
+    std::vector<char*> strings;
+    strings.reserve(header.argc + header.envc + 2);
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.argc + header.envc; i++) {
+        if (offset >= size) {
+            return reply;
+        }
+        char* string = data + offset;
+        char* end = static_cast<char*>(memchr(string, '\0', size - offset));
+        if (!end) {
+            return reply;
+        }
+        strings.push_back(string);
+        offset = end - data + 1;
+        if (i + 1 == header.argc) {
+            strings.push_back(nullptr);
+        }
+    }
+    strings.push_back(nullptr);
+    if (header.argc == 0) {
+        return reply;
+    }
+    
+    pid_t pid = -1;
+    reply.error = SpawnProcess(&pid, strings.data(), strings.data() + header.argc + 1);
+    reply.pid = reply.error == 0 ? pid : -1;
+    reply.spawned_ns = NowNs();
+    return reply;
+}
+
+void HandleChild(int) {}
+
+// Helper process main loop; exits when the compositor closes its end
+[[noreturn]] void RunHelper(int fd) {
+    setsid();
+    
+    // SIGCHLD is only let through inside ppoll, so an exit between the reap
+    // and the wait still wakes us up
+    struct sigaction action {};
+    action.sa_handler = HandleChild;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGCHLD, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+    
+    sigset_t blocked, wait_mask;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &blocked, &wait_mask);
+    sigdelset(&wait_mask, SIGCHLD);
+    
+    std::vector<char> buffer(MAX_REQUEST);
+    for (;;) {
+        while (waitpid(-1, nullptr, WNOHANG) > 0) {
+        }
+        
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (ppoll(&pfd, 1, nullptr, &wait_mask) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            _exit(1);
+        }
+        
+        ssize_t size = recv(fd, buffer.data(), buffer.size(), 0);
+        if (size == 0) {
+            _exit(0);
+        }
+        if (size < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            _exit(1);
+        }
+        
+        Reply reply = HandleRequest(buffer.data(), static_cast<size_t>(size));
+        send(fd, &reply, sizeof(reply), MSG_NOSIGNAL);
+    }
+}
+
+// Value-level escapes of desktop entry strings
+std::string UnescapeValue(const std::string& value) {
+    std::string result;
+    result.reserve(value.size());
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] != '\\' || i + 1 == value.size()) {
+            result += value[i];
+            continue;
+        }
+        switch (value[++i]) {
+            case 's': result += ' '; break;
+            case 'n': result += '\n'; break;
+            case 't': result += '\t'; break;
+            case 'r': result += '\r'; break;
+            case '\\': result += '\\'; break;
+            default: result += '\\'; result += value[i]; break;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+SpawnHelper& SpawnHelper::Instance() {
+    static SpawnHelper instance;
+    return instance;
+}
+
+SpawnHelper::~SpawnHelper() {
+    Stop();
+}
+
+bool SpawnHelper::Start() {
+    if (fd_ >= 0) {
+        return true;
+    }
+    
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) < 0) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Spawn helper: socketpair failed: {}", strerror(errno));
+        return false;
+    }
+    
+    pid_t pid = fork();
+    if (pid < 0) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Spawn helper: fork failed: {}", strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        RunHelper(fds[1]);
+    }
+    
+    close(fds[1]);
+    fd_ = fds[0];
+    helper_pid_ = pid;
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Spawn helper started (PID: {})", pid);
+    return true;
+}
+
+void SpawnHelper::Stop() {
+    if (fd_ < 0) {
+        return;
+    }
+    
+    // The helper exits on EOF; programs it launched keep running
+    close(fd_);
+    fd_ = -1;
+    if (helper_pid_ > 0) {
+        waitpid(helper_pid_, nullptr, 0);
+        helper_pid_ = -1;
+    }
+    pending_.clear();
+}
+
+bool SpawnHelper::Spawn(const std::vector<std::string>& argv, const std::string& label) {
+    if (argv.empty() || argv[0].empty()) {
+        return false;
+    }
+    
+    uint64_t start = NowNs();
+    const std::string& name = label.empty() ? argv[0] : label;
+    stats_.requests++;
+    
+    DispatchReplies();
+    ReapInProcess();
+    
+    bool sent = false;
+    if (fd_ >= 0) {
+        size_t envc = 0;
+        for (char** env = environ; env && *env; env++) {
+            envc++;
+        }
+        
+        RequestHeader header = {next_request_++, static_cast<uint32_t>(argv.size()), static_cast<uint32_t>(envc)};
+        std::string message(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& arg : argv) {
+            message.append(arg.c_str(), arg.size() + 1);
+        }
+        for (size_t i = 0; i < envc; i++) {
+            message.append(environ[i], strlen(environ[i]) + 1);
+        }
+        
+        if (message.size() <= MAX_REQUEST) {
+            ssize_t written = send(fd_, message.data(), message.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (written == static_cast<ssize_t>(message.size())) {
+                pending_[header.id] = {name, start};
+                sent = true;
+            } else if (written < 0 && errno != EAGAIN) {
+                Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Spawn helper unreachable ({}), launching in-process", strerror(errno));
+                Stop();
+            }
+        }
+    }
+    
+    bool ok = sent || SpawnInProcess(argv, name);
+    
+    uint64_t stall = NowNs() - start;
+    stats_.total_stall_ns += stall;
+    stats_.max_stall_ns = std::max(stats_.max_stall_ns, stall);
+    return ok;
+}
+
+bool SpawnHelper::SpawnCommand(const std::string& command, const std::string& label) {
+    std::vector<std::string> argv;
+    if (SplitCommand(command, argv)) {
+        return Spawn(argv, label);
+    }
+    return Spawn({"/bin/sh", "-c", command}, label.empty() ? command : label);
+}
+
+void SpawnHelper::DispatchReplies() {
+    while (fd_ >= 0) {
+        Reply reply;
+        ssize_t size = recv(fd_, &reply, sizeof(reply), MSG_DONTWAIT);
+        if (size == 0) {
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Spawn helper exited, launching in-process from now on");
+            Stop();
+            return;
+        }
+        if (size != static_cast<ssize_t>(sizeof(reply))) {
+            return;  // EAGAIN: nothing pending
+        }
+        
+        auto it = pending_.find(reply.id);
+        if (it == pending_.end()) {
+            continue;
+        }
+        
+        if (reply.pid > 0) {
+            uint64_t latency = reply.spawned_ns > it->second.sent_ns ? reply.spawned_ns - it->second.sent_ns : 0;
+            stats_.spawned++;
+            stats_.total_latency_ns += latency;
+            stats_.max_latency_ns = std::max(stats_.max_latency_ns, latency);
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Launched {} (PID: {})", it->second.label, reply.pid);
+        } else {
+            stats_.failed++;
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to launch {}: {}", it->second.label, strerror(reply.error));
+        }
+        pending_.erase(it);
+    }
+}
+
+bool SpawnHelper::SpawnInProcess(const std::vector<std::string>& argv, const std::string& label) {
+    std::vector<char*> args;
+    args.reserve(argv.size() + 1);
+    for (const auto& arg : argv) {
+        args.push_back(const_cast<char*>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+    
+    // posix_spawn uses vfork semantics, so this does not copy the page tables either
+    uint64_t start = NowNs();
+    pid_t pid = -1;
+    int error = SpawnProcess(&pid, args.data(), environ);
+    if (error != 0) {
+        stats_.failed++;
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to launch {}: {}", label, strerror(error));
+        return false;
+    }
+    
+    uint64_t latency = NowNs() - start;
+    stats_.spawned++;
+    stats_.in_process++;
+    stats_.total_latency_ns += latency;
+    stats_.max_latency_ns = std::max(stats_.max_latency_ns, latency);
+    in_process_children_.push_back(pid);
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Launched {} (PID: {})", label, pid);
+    return true;
+}
+
+void SpawnHelper::ReapInProcess() {
+    // Only our own children: waitpid(-1) would steal exits wlroots waits for
+    in_process_children_.erase(
+        std::remove_if(in_process_children_.begin(), in_process_children_.end(),
+                       [](int pid) { return waitpid(pid, nullptr, WNOHANG) != 0; }),
+        in_process_children_.end());
+}
+
+bool ParseDesktopExec(const std::string& exec, std::vector<std::string>& argv,
+                      const std::string& name, const std::string& icon) {
+    std::string value = UnescapeValue(exec);
+    argv.clear();
+    
+    std::string current;
+    bool in_arg = false;
+    bool quoted = false;
+    for (size_t i = 0; i < value.size(); i++) {
+        char c = value[i];
+        
+        if (quoted) {
+            // Inside quotes only ", `, $ and \ are escaped; field codes are not allowed
+            if (c == '\\' && i + 1 < value.size() && strchr("\"`$\\", value[i + 1])) {
+                current += value[++i];
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                current += c;
+            }
+            continue;
+        }
+        
+        if (c == ' ' || c == '\t' || c == '\n') {
+            if (in_arg) {
+                argv.push_back(current);
+                current.clear();
+                in_arg = false;
+            }
+            continue;
+        }
+        
+        if (c == '"') {
+            quoted = true;
+            in_arg = true;
+            continue;
+        }
+        
+        if (c == '%' && i + 1 < value.size()) {
+            char code = value[++i];
+            bool standalone = !in_arg && (i + 1 == value.size() || value[i + 1] == ' ' || value[i + 1] == '\t');
+            switch (code) {
+                case '%':
+                    current += '%';
+                    in_arg = true;
+                    break;
+                case 'c':
+                    current += name;
+                    in_arg = true;
+                    break;
+                case 'i':
+                    if (standalone && !icon.empty()) {
+                        argv.push_back("--icon");
+                        argv.push_back(icon);
+                    }
+                    break;
+                default:
+                    // %f %F %u %U (no files to pass), %k and deprecated codes
+                    break;
+            }
+            continue;
+        }
+        
+        current += c;
+        in_arg = true;
+    }
+    
+    if (quoted) {
+        return false;
+    }
+    if (in_arg) {
+        argv.push_back(current);
+    }
+    return !argv.empty();
+}
+
+bool SplitCommand(const std::string& command, std::vector<std::string>& argv) {
+    argv.clear();
+    if (command.find_first_of("|&;<>()$`\\*?[]~#'{}!\n") != std::string::npos) {
+        return false;
+    }
+    
+    std::string current;
+    bool in_arg = false;
+    bool quoted = false;
+    for (char c : command) {
+        if (c == '"') {
+            quoted = !quoted;
+            in_arg = true;
+        } else if (!quoted && (c == ' ' || c == '\t')) {
+            if (in_arg) {
+                argv.push_back(current);
+                current.clear();
+                in_arg = false;
+            }
+        } else {
+            current += c;
+            in_arg = true;
+        }
+    }
+    if (quoted) {
+        return false;
+    }
+    if (in_arg) {
+        argv.push_back(current);
+    }
+    
+    // FOO=bar program needs the shell's assignment handling
+    return !argv.empty() && argv[0].find('=') == std::string::npos;
+}
+
+} // namespace Core
+} // namespace Leviathan
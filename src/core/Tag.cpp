@@ -12,8 +12,10 @@ extern "C" {
 namespace Leviathan {
 namespace Core {
 
-Tag::Tag(const std::string& name)
+Tag::Tag(const std::string& name, int index, int output_index)
     : name_(name)
+    , index_(index)
+    , output_index_(output_index)
     , visible_(false)
     , focused_client_(nullptr)
     , layout_(LayoutType::MASTER_STACK)
@@ -53,6 +55,7 @@ void Tag::AddClient(Client* client) {
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Tag::AddClient - Adding client {:p} to tag '{}'", static_cast<void*>(client), name_);
     
     clients_.push_back(client);
+    client->SetTagMembership(index_, output_index_);
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Added client to tag '{}' (total clients: {})", name_, clients_.size());
     
     // If tag is visible, make sure the new client is visible too
@@ -85,6 +88,9 @@ void Tag::RemoveClient(Client* client) {
     auto it = std::find(clients_.begin(), clients_.end(), client);
     if (it != clients_.end()) {
         clients_.erase(it);
+        if (client->GetTagIndex() == index_ && client->GetOutputIndex() == output_index_) {
+            client->SetTagMembership(-1, -1);
+        }
         if (focused_client_ == client) {
             focused_client_ = clients_.empty() ? nullptr : clients_[0];
         }
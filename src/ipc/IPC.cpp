@@ -24,6 +24,11 @@ std::string CommandTypeToString(CommandType type) {
         case CommandType::GET_VERSION: return "get_version";
         case CommandType::GET_PLUGIN_STATS: return "get_plugin_stats";
         case CommandType::GET_WIDGET_TREE: return "get_widget_tree";
+        case CommandType::GET_ICON_ATLAS: return "get_icon_atlas";
+        case CommandType::GET_FRAME_STATS: return "get_frame_stats";
+        case CommandType::GET_XWAYLAND: return "get_xwayland";
+        case CommandType::GET_CLIENT_STATS: return "get_client_stats";
+        case CommandType::GET_STATE_FD: return "get_state_fd";
         case CommandType::PING: return "ping";
         case CommandType::SHUTDOWN: return "shutdown";
         case CommandType::EXECUTE_ACTION: return "execute_action";
@@ -42,6 +47,11 @@ CommandType StringToCommandType(const std::string& str) {
     if (str == "get_version") return CommandType::GET_VERSION;
     if (str == "get_plugin_stats") return CommandType::GET_PLUGIN_STATS;
     if (str == "get_widget_tree") return CommandType::GET_WIDGET_TREE;
+    if (str == "get_icon_atlas") return CommandType::GET_ICON_ATLAS;
+    if (str == "get_frame_stats") return CommandType::GET_FRAME_STATS;
+    if (str == "get_xwayland") return CommandType::GET_XWAYLAND;
+    if (str == "get_client_stats") return CommandType::GET_CLIENT_STATS;
+    if (str == "get_state_fd") return CommandType::GET_STATE_FD;
     if (str == "ping") return CommandType::PING;
     if (str == "shutdown") return CommandType::SHUTDOWN;
     if (str == "execute_action") return CommandType::EXECUTE_ACTION;
@@ -52,18 +62,26 @@ CommandType StringToCommandType(const std::string& str) {
 std::string EventTypeToString(EventType type) {
     switch (type) {
         case EventType::TAG_SWITCHED: return "tag_switched";
+        case EventType::TAG_VISIBILITY_CHANGED: return "tag_visibility_changed";
         case EventType::CLIENT_ADDED: return "client_added";
         case EventType::CLIENT_REMOVED: return "client_removed";
+        case EventType::CLIENT_TAG_CHANGED: return "client_tag_changed";
+        case EventType::CLIENT_FOCUSED: return "client_focused";
         case EventType::TILING_MODE_CHANGED: return "tiling_mode_changed";
+        case EventType::STATE_CHANGED: return "state_changed";
         default: return "unknown";
     }
 }
 
 EventType StringToEventType(const std::string& str) {
     if (str == "tag_switched") return EventType::TAG_SWITCHED;
+    if (str == "tag_visibility_changed") return EventType::TAG_VISIBILITY_CHANGED;
     if (str == "client_added") return EventType::CLIENT_ADDED;
     if (str == "client_removed") return EventType::CLIENT_REMOVED;
+    if (str == "client_tag_changed") return EventType::CLIENT_TAG_CHANGED;
+    if (str == "client_focused") return EventType::CLIENT_FOCUSED;
     if (str == "tiling_mode_changed") return EventType::TILING_MODE_CHANGED;
+    if (str == "state_changed") return EventType::STATE_CHANGED;
     return EventType::UNKNOWN;
 }
 
@@ -100,6 +118,7 @@ std::string SerializeResponse(const Response& response) {
         json clients_arr = json::array();
         for (const auto& client : response.clients) {
             clients_arr.push_back({
+                {"id", client.id},
                 {"title", client.title},
                 {"app_id", client.app_id},
                 {"x", client.x},
@@ -108,7 +127,14 @@ std::string SerializeResponse(const Response& response) {
                 {"height", client.height},
                 {"floating", client.floating},
                 {"fullscreen", client.fullscreen},
-                {"tag", client.tag}
+                {"suspended", client.suspended},
+                {"tag", client.tag},
+                {"shm_commits", client.shm_commits},
+                {"dmabuf_commits", client.dmabuf_commits},
+                {"commit_rate", client.commit_rate},
+                {"frame_cap", client.frame_cap},
+                {"throttled", client.throttled},
+                {"throttle_events", client.throttle_events}
             });
         }
         j["clients"] = clients_arr;
@@ -123,7 +149,12 @@ std::string SerializeResponse(const Response& response) {
                 {"height", output.height},
                 {"refresh_mhz", output.refresh_mhz},
                 {"enabled", output.enabled},
-                {"scale", output.scale}
+                {"scale", output.scale},
+                {"adaptive_sync", output.adaptive_sync},
+                {"adaptive_sync_wanted", output.adaptive_sync_wanted},
+                {"adaptive_sync_active", output.adaptive_sync_active},
+                {"tearing_allowed", output.tearing_allowed},
+                {"tearing_active", output.tearing_active}
             };
             
             // Add optional fields if they exist
@@ -164,6 +195,28 @@ std::string SerializeResponse(const Response& response) {
         j["plugin_stats"] = stats_arr;
     }
     
+    if (!response.client_stats.empty()) {
+        json stats_arr = json::array();
+        for (const auto& stats : response.client_stats) {
+            stats_arr.push_back({
+                {"id", stats.id},
+                {"app_id", stats.app_id},
+                {"title", stats.title},
+                {"xwayland", stats.xwayland},
+                {"commits", stats.commits},
+                {"commit_rate", stats.commit_rate},
+                {"damage_rate", stats.damage_rate},
+                {"shm_bytes", stats.shm_bytes},
+                {"dmabuf_bytes", stats.dmabuf_bytes},
+                {"frame_latency_us", stats.frame_latency_us},
+                {"max_frame_latency_us", stats.max_frame_latency_us},
+                {"configure_rtt_us", stats.configure_rtt_us},
+                {"max_configure_rtt_us", stats.max_configure_rtt_us}
+            });
+        }
+        j["client_stats"] = stats_arr;
+    }
+    
     return j.dump() + "\n";
 }
 
@@ -291,7 +344,11 @@ void Server::HandleClient(int client_fd) {
     Response response = ProcessCommand(command);
     std::string response_str = SerializeResponse(response);
     
-    write(client_fd, response_str.c_str(), response_str.length());
+    if (response.fd >= 0) {
+        SendWithFd(client_fd, response_str, response.fd);
+    } else {
+        write(client_fd, response_str.c_str(), response_str.length());
+    }
     
     // Clear client UID
     current_client_uid_ = -1;
@@ -301,6 +358,32 @@ void Server::HandleClient(int client_fd) {
     client_fds.erase(std::remove(client_fds.begin(), client_fds.end(), client_fd), client_fds.end());
 }
 
+void Server::SendWithFd(int client_fd, const std::string& message, int fd) {
+    struct iovec iov;
+    iov.iov_base = const_cast<char*>(message.data());
+    iov.iov_len = message.length();
+    
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    memset(control, 0, sizeof(control));
+    
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    
+    if (sendmsg(client_fd, &msg, MSG_NOSIGNAL) < 0) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "IPC: Failed to pass fd to client (fd={}): {}", client_fd, strerror(errno));
+    }
+}
+
 void Server::HandleEvents() {
     if (socket_fd < 0) return;
     
@@ -481,20 +564,47 @@ std::optional<Response> Client::SendCommand(CommandType type, const std::map<std
         return std::nullopt;
     }
     
-    // Read response
-    char buffer[8192];
-    ssize_t n = read(socket_fd, buffer, sizeof(buffer) - 1);
-    if (n <= 0) {
+    // Read response; the server closes the connection after it, and
+    // per-client lists can outgrow a single read. A passed fd comes with
+    // the first bytes
+    std::string buffer;
+    char chunk[8192];
+    int received_fd = -1;
+    ssize_t n;
+    do {
+        struct iovec iov = {chunk, sizeof(chunk)};
+        alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        
+        n = recvmsg(socket_fd, &msg, MSG_CMSG_CLOEXEC);
+        if (n <= 0) {
+            break;
+        }
+        for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS && received_fd < 0) {
+                memcpy(&received_fd, CMSG_DATA(cmsg), sizeof(int));
+            }
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    } while (buffer.back() != '\n');
+    if (buffer.empty()) {
+        if (received_fd >= 0) {
+            close(received_fd);
+        }
         return std::nullopt;
     }
     
-    buffer[n] = '\0';
-    
     // Parse JSON response
     try {
         json resp = json::parse(buffer);
         
         Response response;
+        response.fd = received_fd;
         response.success = resp.value("success", false);
         response.error = resp.value("error", "");
         
@@ -517,6 +627,7 @@ std::optional<Response> Client::SendCommand(CommandType type, const std::map<std
         if (resp.contains("clients")) {
             for (const auto& client_json : resp["clients"]) {
                 ClientInfo client;
+                client.id = client_json.value("id", uint64_t{0});
                 client.title = client_json.value("title", "");
                 client.app_id = client_json.value("app_id", "");
                 client.x = client_json.value("x", 0);
@@ -525,7 +636,14 @@ std::optional<Response> Client::SendCommand(CommandType type, const std::map<std
                 client.height = client_json.value("height", 0);
                 client.floating = client_json.value("floating", false);
                 client.fullscreen = client_json.value("fullscreen", false);
+                client.suspended = client_json.value("suspended", false);
                 client.tag = client_json.value("tag", "");
+                client.shm_commits = client_json.value("shm_commits", uint64_t{0});
+                client.dmabuf_commits = client_json.value("dmabuf_commits", uint64_t{0});
+                client.commit_rate = client_json.value("commit_rate", uint32_t{0});
+                client.frame_cap = client_json.value("frame_cap", 0);
+                client.throttled = client_json.value("throttled", false);
+                client.throttle_events = client_json.value("throttle_events", uint64_t{0});
                 response.clients.push_back(client);
             }
         }
@@ -546,6 +664,11 @@ std::optional<Response> Client::SendCommand(CommandType type, const std::map<std
                 output.phys_height_mm = output_json.value("phys_height_mm", 0);
                 output.scale = output_json.value("scale", 1.0f);
                 output.enabled = output_json.value("enabled", false);
+                output.adaptive_sync = output_json.value("adaptive_sync", "off");
+                output.adaptive_sync_wanted = output_json.value("adaptive_sync_wanted", false);
+                output.adaptive_sync_active = output_json.value("adaptive_sync_active", false);
+                output.tearing_allowed = output_json.value("tearing_allowed", false);
+                output.tearing_active = output_json.value("tearing_active", false);
                 response.outputs.push_back(output);
             }
         }
@@ -562,14 +685,56 @@ std::optional<Response> Client::SendCommand(CommandType type, const std::map<std
             }
         }
         
+        // Parse client_stats array
+        if (resp.contains("client_stats")) {
+            for (const auto& stats_json : resp["client_stats"]) {
+                ClientStatsInfo stats;
+                stats.id = stats_json.value("id", uint64_t{0});
+                stats.app_id = stats_json.value("app_id", "");
+                stats.title = stats_json.value("title", "");
+                stats.xwayland = stats_json.value("xwayland", false);
+                stats.commits = stats_json.value("commits", uint64_t{0});
+                stats.commit_rate = stats_json.value("commit_rate", uint32_t{0});
+                stats.damage_rate = stats_json.value("damage_rate", uint64_t{0});
+                stats.shm_bytes = stats_json.value("shm_bytes", uint64_t{0});
+                stats.dmabuf_bytes = stats_json.value("dmabuf_bytes", uint64_t{0});
+                stats.frame_latency_us = stats_json.value("frame_latency_us", uint64_t{0});
+                stats.max_frame_latency_us = stats_json.value("max_frame_latency_us", uint64_t{0});
+                stats.configure_rtt_us = stats_json.value("configure_rtt_us", uint64_t{0});
+                stats.max_configure_rtt_us = stats_json.value("max_configure_rtt_us", uint64_t{0});
+                response.client_stats.push_back(stats);
+            }
+        }
+        
         // Store raw response for debugging
-        response.data["raw"] = std::string(buffer);
+        response.data["raw"] = buffer;
         
         return response;
     } catch (const json::exception& e) {
+        if (received_fd >= 0) {
+            close(received_fd);
+        }
         return std::nullopt;
     }
 }
 
+bool Client::Subscribe() {
+    if (socket_fd < 0 && !Connect()) {
+        return false;
+    }
+    
+    json j;
+    j["command"] = CommandTypeToString(CommandType::SUBSCRIBE_EVENTS);
+    std::string command = j.dump() + "\n";
+    if (write(socket_fd, command.c_str(), command.length()) < 0) {
+        return false;
+    }
+    
+    // Confirmation; events may already follow it in the same read
+    char buffer[4096];
+    ssize_t n = read(socket_fd, buffer, sizeof(buffer));
+    return n > 0;
+}
+
 } // namespace IPC
 } // namespace Leviathan
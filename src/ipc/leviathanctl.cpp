@@ -1,8 +1,17 @@
 #include "ipc/IPC.hpp"
+#include "ipc/StateSnapshot.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <sstream>
 #include <cstring>
 #include <cmath>
+#include <thread>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using namespace Leviathan::IPC;
 
@@ -19,16 +28,253 @@ void print_usage(const char* prog) {
     std::cout << "  get-layout              - Get current layout mode\n";
     std::cout << "  get-plugin-stats        - Show memory usage per plugin\n";
     std::cout << "  get-widget-tree [output] - Show status bar widget tree\n";
+    std::cout << "  get-icon-atlas          - Show icon atlas occupancy\n";
+    std::cout << "  get-frame-stats         - Show frame times and per-frame allocations\n";
+    std::cout << "  get-xwayland            - Show Xwayland state, restarts and memory\n";
+    std::cout << "  top [column] [--once]   - Per-client resource usage, refreshed every second\n";
+    std::cout << "                            column: commits, damage, shm, dmabuf, mem, frame,\n";
+    std::cout << "                            configure or app (default: commits)\n";
+    std::cout << "  state [--watch]         - Read the shared-memory state snapshot\n";
     std::cout << "  action <name>           - Execute an action by name\n";
     std::cout << "  shutdown                - Gracefully shutdown the compositor\n";
     std::cout << "\nExamples:\n";
     std::cout << "  " << prog << " ping\n";
     std::cout << "  " << prog << " get-clients\n";
     std::cout << "  " << prog << " set-active-tag 2\n";
+    std::cout << "  " << prog << " top mem\n";
+    std::cout << "  " << prog << " state --watch\n";
     std::cout << "  " << prog << " action show-help\n";
     std::cout << "  " << prog << " shutdown\n";
 }
 
+// Sort for top: largest first, except app which sorts by name
+bool sort_client_stats(std::vector<ClientStatsInfo>& stats, const std::string& column) {
+    if (column == "app") {
+        std::stable_sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) {
+            return a.app_id < b.app_id;
+        });
+        return true;
+    }
+    
+    uint64_t (*key)(const ClientStatsInfo&) = nullptr;
+    if (column == "commits") {
+        key = [](const ClientStatsInfo& s) -> uint64_t { return s.commit_rate; };
+    } else if (column == "damage") {
+        key = [](const ClientStatsInfo& s) -> uint64_t { return s.damage_rate; };
+    } else if (column == "shm") {
+        key = [](const ClientStatsInfo& s) -> uint64_t { return s.shm_bytes; };
+    } else if (column == "dmabuf") {
+        key = [](const ClientStatsInfo& s) -> uint64_t { return s.dmabuf_bytes; };
+    } else if (column == "mem") {
+        key = [](const ClientStatsInfo& s) -> uint64_t { return s.shm_bytes + s.dmabuf_bytes; };
+    } else if (column == "frame") {
+        key = [](const ClientStatsInfo& s) -> uint64_t { return s.frame_latency_us; };
+    } else if (column == "configure") {
+        key = [](const ClientStatsInfo& s) -> uint64_t { return s.configure_rtt_us; };
+    } else {
+        return false;
+    }
+    
+    std::stable_sort(stats.begin(), stats.end(), [key](const auto& a, const auto& b) {
+        return key(a) > key(b);
+    });
+    return true;
+}
+
+std::string format_quantity(uint64_t value, const char* unit, uint64_t step) {
+    const char* prefixes[] = {"", "K", "M", "G"};
+    int prefix = 0;
+    double scaled = static_cast<double>(value);
+    while (scaled >= step && prefix < 3) {
+        scaled /= step;
+        prefix++;
+    }
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(prefix ? 1 : 0) << scaled << prefixes[prefix] << unit;
+    return out.str();
+}
+
+std::string format_latency(uint64_t us, uint64_t max_us) {
+    if (max_us == 0) {
+        return "-";
+    }
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << us / 1000.0 << "/" << max_us / 1000.0;
+    return out.str();
+}
+
+// leviathanctl top: the server closes the connection after each response,
+// so every refresh connects again
+int run_top(const std::string& column, bool once) {
+    while (true) {
+        Client client;
+        auto response = client.SendCommand(CommandType::GET_CLIENT_STATS);
+        if (!response) {
+            std::cerr << "Error: Could not get client stats from the compositor\n";
+            return 1;
+        }
+        if (!response->success) {
+            std::cerr << "Error: " << response->error << "\n";
+            return 1;
+        }
+        
+        auto& stats = response->client_stats;
+        sort_client_stats(stats, column);
+        
+        if (!once) {
+            std::cout << "\033[H\033[2J";
+        }
+        std::cout << "Clients: " << stats.size() << " (" << response->data["xwayland_clients"]
+                  << " X11), sorted by " << column << "\n\n";
+        std::cout << std::left << std::setw(24) << "APP" << std::setw(6) << "TYPE"
+                  << std::right << std::setw(9) << "COMMIT/S" << std::setw(11) << "DAMAGE/S"
+                  << std::setw(9) << "SHM" << std::setw(9) << "DMABUF"
+                  << std::setw(14) << "FRAME ms" << std::setw(14) << "CONFIGURE ms" << "\n";
+        for (const auto& s : stats) {
+            std::string app = s.app_id.size() > 23 ? s.app_id.substr(0, 22) + "~" : s.app_id;
+            std::cout << std::left << std::setw(24) << app << std::setw(6) << (s.xwayland ? "X11" : "wl")
+                      << std::right << std::setw(9) << s.commit_rate
+                      << std::setw(11) << format_quantity(s.damage_rate, "px", 1000)
+                      << std::setw(9) << format_quantity(s.shm_bytes, "B", 1024)
+                      << std::setw(9) << format_quantity(s.dmabuf_bytes, "B", 1024)
+                      << std::setw(14) << format_latency(s.frame_latency_us, s.max_frame_latency_us)
+                      << std::setw(14) << (s.xwayland ? "-" : format_latency(s.configure_rtt_us, s.max_configure_rtt_us))
+                      << "\n";
+        }
+        if (once) {
+            return 0;
+        }
+        std::cout << "\nLatencies are average/max. Ctrl-C to quit\n" << std::flush;
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+}
+
+void print_state(const leviathan_state& state) {
+    static const char* layouts[] = {"master-stack", "monocle", "floating", "grid"};
+    auto layout_name = [](uint32_t layout) { return layout < 4 ? layouts[layout] : "unknown"; };
+    auto output_name = [&state](int32_t id) -> std::string {
+        for (uint32_t i = 0; i < state.output_count; i++) {
+            if (state.outputs[i].id == id) {
+                return state.outputs[i].name;
+            }
+        }
+        return "-";
+    };
+    auto tag_name = [&state](int32_t output_id, int32_t index) -> std::string {
+        for (uint32_t i = 0; i < state.tag_count; i++) {
+            if (state.tags[i].output_id == output_id && state.tags[i].index == index) {
+                return state.tags[i].name;
+            }
+        }
+        return "-";
+    };
+    
+    std::cout << "Snapshot " << state.sequence / 2 << ": " << state.output_count << " outputs, "
+              << state.tag_count << " tags, " << state.client_count << " clients"
+              << (state.truncated ? " (truncated)" : "") << "\n";
+    
+    std::cout << "\nOutputs:\n";
+    for (uint32_t i = 0; i < state.output_count; i++) {
+        const auto& out = state.outputs[i];
+        std::cout << (out.id == state.focused_output ? "* " : "  ") << out.name << ": "
+                  << out.width << "x" << out.height << " at " << out.x << "," << out.y
+                  << " @ " << std::fixed << std::setprecision(2) << out.refresh_mhz / 1000.0 << " Hz"
+                  << ", scale " << out.scale << (out.enabled ? "" : ", disabled") << "\n";
+        std::cout << "    Tags:";
+        for (uint32_t t = 0; t < state.tag_count; t++) {
+            const auto& tag = state.tags[t];
+            if (tag.output_id != out.id) {
+                continue;
+            }
+            std::cout << " " << (tag.index == out.current_tag ? "[" : "") << tag.name;
+            if (tag.client_count) {
+                std::cout << "(" << tag.client_count << ")";
+            }
+            std::cout << (tag.index == out.current_tag ? "]" : "");
+        }
+        std::cout << "\n    Layout: " << layout_name(out.layout) << "\n";
+    }
+    
+    std::cout << "\nClients:\n";
+    for (uint32_t i = 0; i < state.client_count; i++) {
+        const auto& client = state.clients[i];
+        std::cout << (client.id == state.focused_client ? "* " : "  ") << client.app_id << ": " << client.title << "\n";
+        std::cout << "    " << client.width << "x" << client.height << " at " << client.x << "," << client.y
+                  << " on " << output_name(client.output_id) << "/" << tag_name(client.output_id, client.tag_index);
+        if (client.flags & LEVIATHAN_CLIENT_XWAYLAND) std::cout << ", X11";
+        if (client.flags & LEVIATHAN_CLIENT_FLOATING) std::cout << ", floating";
+        if (client.flags & LEVIATHAN_CLIENT_FULLSCREEN) std::cout << ", fullscreen";
+        if (!(client.flags & LEVIATHAN_CLIENT_VISIBLE)) std::cout << ", hidden";
+        if (client.flags & LEVIATHAN_CLIENT_SUSPENDED) std::cout << ", suspended";
+        std::cout << "\n";
+    }
+}
+
+// leviathanctl state: map the snapshot once, then read it without the socket;
+// --watch re-reads it whenever a state_changed event arrives
+int run_state(bool watch) {
+    Client client;
+    auto response = client.SendCommand(CommandType::GET_STATE_FD);
+    if (!response) {
+        std::cerr << "Error: Failed to get response from compositor\n";
+        return 1;
+    }
+    if (!response->success || response->fd < 0) {
+        std::cerr << "Error: " << (response->success ? "No state fd received" : response->error) << "\n";
+        return 1;
+    }
+    
+    void* map = mmap(nullptr, sizeof(leviathan_state), PROT_READ, MAP_SHARED, response->fd, 0);
+    close(response->fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "Error: Could not map the state snapshot: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    const auto* shared = static_cast<const leviathan_state*>(map);
+    if (shared->magic != LEVIATHAN_STATE_MAGIC || shared->version != LEVIATHAN_STATE_VERSION ||
+        shared->size != sizeof(leviathan_state)) {
+        std::cerr << "Error: State snapshot version " << shared->version << " does not match leviathanctl ("
+                  << LEVIATHAN_STATE_VERSION << ")\n";
+        return 1;
+    }
+    
+    auto state = std::make_unique<leviathan_state>();
+    Client events;
+    if (watch && !events.Subscribe()) {
+        std::cerr << "Error: Could not subscribe to compositor events\n";
+        return 1;
+    }
+    
+    uint32_t shown = 1;  // Never a published sequence
+    while (true) {
+        if (leviathan_state_copy(shared, state.get(), 1000) < 0) {
+            std::cerr << "Error: State snapshot kept changing while being read\n";
+            return 1;
+        }
+        if (state->sequence != shown) {
+            if (watch) {
+                std::cout << "\033[H\033[2J";
+            }
+            print_state(*state);
+            std::cout << std::flush;
+            shown = state->sequence;
+        }
+        if (!watch) {
+            return 0;
+        }
+        
+        // Any event may come with a new snapshot; the content does not matter
+        struct pollfd pfd = {events.GetFd(), POLLIN, 0};
+        if (poll(&pfd, 1, -1) < 0) {
+            continue;
+        }
+        char buffer[4096];
+        if (read(events.GetFd(), buffer, sizeof(buffer)) <= 0) {
+            return 0;  // Compositor went away
+        }
+    }
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         print_usage(argv[0]);
@@ -42,6 +288,29 @@ int main(int argc, char* argv[]) {
         return 0;
     }
     
+    if (command == "top") {
+        std::string column = "commits";
+        bool once = false;
+        for (int i = 2; i < argc; i++) {
+            if (std::strcmp(argv[i], "--once") == 0) {
+                once = true;
+            } else {
+                column = argv[i];
+            }
+        }
+        // Reject an unknown column before connecting
+        std::vector<ClientStatsInfo> none;
+        if (!sort_client_stats(none, column)) {
+            std::cerr << "Error: Unknown column '" << column << "'\n";
+            return 1;
+        }
+        return run_top(column, once);
+    }
+    
+    if (command == "state") {
+        return run_state(argc >= 3 && std::strcmp(argv[2], "--watch") == 0);
+    }
+    
     Client client;
     if (!client.Connect()) {
         std::cerr << "Error: Could not connect to LeviathanDM compositor\n";
@@ -80,6 +349,12 @@ int main(int argc, char* argv[]) {
         if (argc >= 3) {
             args["output"] = argv[2];
         }
+    } else if (command == "get-icon-atlas") {
+        cmd_type = CommandType::GET_ICON_ATLAS;
+    } else if (command == "get-frame-stats") {
+        cmd_type = CommandType::GET_FRAME_STATS;
+    } else if (command == "get-xwayland") {
+        cmd_type = CommandType::GET_XWAYLAND;
     } else if (command == "action") {
         if (argc < 3) {
             std::cerr << "Error: action requires an action name\n";
@@ -165,6 +440,21 @@ int main(int argc, char* argv[]) {
             
             std::cout << "  Enabled:     " << (output.enabled ? "yes" : "no") << "\n";
         }
+    } else if (command == "get-clients" && response->data.count("suspended_clients")) {
+        std::cout << "Clients: " << response->clients.size()
+                  << " (" << response->data["suspended_clients"] << " suspended)\n";
+        for (const auto& client : response->clients) {
+            std::cout << "\n";
+            std::cout << "  " << client.app_id << ": " << client.title << "\n";
+            std::cout << "  Tag:         " << client.tag << "\n";
+            std::cout << "  Geometry:    " << client.width << "x" << client.height
+                      << " at " << client.x << "," << client.y << "\n";
+            std::cout << "  Suspended:   " << (client.suspended ? "yes" : "no") << "\n";
+            std::cout << "  Commits:     " << client.commit_rate << "/s\n";
+            std::cout << "  Frame cap:   " << (client.frame_cap > 0 ? std::to_string(client.frame_cap) + " fps" : "none")
+                      << (client.throttled ? " (throttled)" : "") << "\n";
+            std::cout << "  Throttled:   " << client.throttle_events << " times\n";
+        }
     } else if (command == "get-plugin-stats" && !response->plugin_stats.empty()) {
         std::cout << "Plugin Memory Statistics:\n\n";
         
@@ -211,6 +501,67 @@ int main(int argc, char* argv[]) {
             std::cout << "Output: " << response->data["output"] << "\n\n";
         }
         std::cout << response->data["widget_tree"];
+    } else if (command == "get-icon-atlas" && response->data.count("pages")) {
+        auto format_bytes = [](const std::string& value) -> std::string {
+            size_t bytes = std::stoull(value);
+            if (bytes < 1024) return std::to_string(bytes) + " B";
+            if (bytes < 1024 * 1024) return std::to_string(bytes / 1024) + " KB";
+            return std::to_string(bytes / (1024 * 1024)) + " MB";
+        };
+        
+        std::cout << "Icon Atlas:\n\n";
+        std::cout << "  Pages:       " << response->data["pages"]
+                  << " (" << format_bytes(response->data["page_bytes"]) << ")\n";
+        std::cout << "  Icons:       " << response->data["icons"]
+                  << " (" << format_bytes(response->data["icon_bytes"]) << ")\n";
+        std::cout << "  Occupancy:   " << response->data["occupancy"] << "%\n";
+        std::cout << "  Compactions: " << response->data["compactions"] << "\n";
+        
+        bool header = false;
+        for (const auto& [key, value] : response->data) {
+            if (key.compare(0, 5, "size_") != 0) {
+                continue;
+            }
+            if (!header) {
+                std::cout << "\nBy icon size:\n";
+                header = true;
+            }
+            std::cout << "  " << key.substr(5) << "px: " << value << "\n";
+        }
+    } else if (command == "get-frame-stats" && response->data.count("arena_capacity")) {
+        std::cout << "Frame Stats:\n\n";
+        for (const auto& [key, value] : response->data) {
+            if (key.compare(0, 7, "output_") == 0) {
+                std::cout << "  " << key.substr(7) << ": " << value << "\n";
+            }
+        }
+        std::cout << "\nFrame arena:\n";
+        std::cout << "  Capacity:   " << response->data["arena_capacity"] << " bytes\n";
+        std::cout << "  High water: " << response->data["arena_high_water"] << " bytes\n";
+        std::cout << "  Overflows:  " << response->data["arena_overflows"] << "\n";
+        if (response->data["allocation_counting"] != "true") {
+            std::cout << "\nAllocation counts need a build with ENABLE_ALLOCATION_STATS=ON\n";
+        }
+    } else if (command == "get-xwayland" && response->data.count("enabled")) {
+        std::cout << "Xwayland:\n\n";
+        if (response->data["enabled"] != "true") {
+            std::cout << "  Disabled\n";
+            return 0;
+        }
+        std::cout << "  Display:      " << response->data["display"] << "\n";
+        std::cout << "  Mode:         " << (response->data["lazy"] == "true" ? "lazy" : "eager");
+        if (response->data["lazy"] == "true" && response->data["idle_timeout"] != "0") {
+            std::cout << " (exits after " << response->data["idle_timeout"] << "s idle)";
+        }
+        std::cout << "\n";
+        std::cout << "  Running:      " << response->data["running"] << "\n";
+        if (response->data["running"] == "true") {
+            std::cout << "  PID:          " << response->data["pid"] << "\n";
+            std::cout << "  Uptime:       " << response->data["uptime_s"] << " s\n";
+            std::cout << "  RSS:          " << response->data["rss_kb"] << " KB\n";
+        }
+        std::cout << "  Starts:       " << response->data["starts"] << "\n";
+        std::cout << "  Startup time: " << response->data["startup_ms"] << " ms\n";
     } else if (response->data.count("raw")) {
         std::cout << response->data["raw"];
     } else {
@@ -19,7 +19,7 @@ using Wayland::View;
 TilingLayout::TilingLayout() {
 }
 
-void TilingLayout::ApplyMasterStack(std::vector<View*>& views,
+void TilingLayout::ApplyMasterStack(std::pmr::vector<View*>& views,
                                    int master_count, float master_ratio,
                                    int screen_width, int screen_height,
                                    int gap_size) {
@@ -85,7 +85,7 @@ void TilingLayout::ApplyMasterStack(std::vector<View*>& views,
     }
 }
 
-void TilingLayout::ApplyMonocle(std::vector<View*>& views,
+void TilingLayout::ApplyMonocle(std::pmr::vector<View*>& views,
                                int screen_width, int screen_height) {
     // All windows fullscreen in workspace area, stacked on top of each other
     for (auto* view : views) {
@@ -93,7 +93,7 @@ void TilingLayout::ApplyMonocle(std::vector<View*>& views,
     }
 }
 
-void TilingLayout::ApplyGrid(std::vector<View*>& views,
+void TilingLayout::ApplyGrid(std::pmr::vector<View*>& views,
                             int screen_width, int screen_height,
                             int gap_size) {
     if (views.empty()) {
@@ -126,10 +126,7 @@ void TilingLayout::MoveResizeView(View* view,
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "MoveResizeView: view={}, pos=({},{}), size=({},{})", 
               static_cast<void*>(view), x, y, width, height);
     
-    view->x = x;
-    view->y = y;
-    view->width = width;
-    view->height = height;
+    view->StoreGeometry(x, y, width, height);
     
     if (view->scene_tree) {
         wlr_scene_node_set_position(&view->scene_tree->node, x, y);
@@ -2,6 +2,7 @@
 #include "config/ConfigParser.hpp"
 #include "ui/WidgetPluginManager.hpp"
 #include "ui/CompositorState.hpp"
+#include "core/SpawnHelper.hpp"
 #include "Logger.hpp"
 #include "version.h"
 #include <iostream>
@@ -43,6 +44,10 @@ int main(int argc, char** argv) {
         }
     }
     
+    // Fork the launcher helper while the process is still small: no threads,
+    // no GPU or SHM mappings yet. Every later launch goes through it
+    Leviathan::Core::SpawnHelper::Instance().Start();
+    
     // Initialize logger with multi-sink architecture
     // Creates both console sink (with colors) and file sink
     Leviathan::SimpleLogger::Instance().Init(
@@ -164,6 +169,7 @@ int main(int argc, char** argv) {
     Leviathan::UI::SetCompositorState(nullptr);
     
     delete server;
+    Leviathan::Core::SpawnHelper::Instance().Stop();
     
     // Cleanup plugins
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Unloading plugins...");
@@ -4,6 +4,25 @@
 namespace Leviathan {
 namespace UI {
 
+namespace {
+
+struct MeasureContext {
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+    cairo_t* cr = cairo_create(surface);
+
+    ~MeasureContext() {
+        cairo_destroy(cr);
+        cairo_surface_destroy(surface);
+    }
+};
+
+} // namespace
+
+cairo_t* Widget::GetMeasureContext() {
+    thread_local MeasureContext context;
+    return context.cr;
+}
+
 int Widget::GetAbsoluteX() const {
     int abs_x = x_;
     Container* p = parent_;
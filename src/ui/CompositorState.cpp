@@ -1,5 +1,9 @@
 #include "ui/CompositorState.hpp"
 
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
 namespace Leviathan {
 namespace UI {
 
@@ -14,5 +18,43 @@ void SetCompositorState(CompositorState* state) {
     g_compositor_state = state;
 }
 
+// Widget polling pause (shared by every PeriodicWidget thread)
+static std::mutex g_widget_mutex;
+static std::condition_variable g_widget_cv;
+static bool g_widget_updates_paused = false;
+static uint64_t g_widget_resumes = 0;
+
+void SetWidgetUpdatesPaused(bool paused) {
+    {
+        std::lock_guard<std::mutex> lock(g_widget_mutex);
+        if (g_widget_updates_paused == paused) {
+            return;
+        }
+        g_widget_updates_paused = paused;
+        if (!paused) {
+            g_widget_resumes++;
+        }
+    }
+    g_widget_cv.notify_all();
+}
+
+bool AreWidgetUpdatesPaused() {
+    std::lock_guard<std::mutex> lock(g_widget_mutex);
+    return g_widget_updates_paused;
+}
+
+void WaitForWidgetUpdate(std::chrono::milliseconds interval, const std::atomic<bool>& running) {
+    std::unique_lock<std::mutex> lock(g_widget_mutex);
+    uint64_t resumes = g_widget_resumes;
+
+    // A resume cuts the wait short so widgets are fresh when the screen wakes
+    g_widget_cv.wait_for(lock, interval, [&] { return g_widget_resumes != resumes; });
+
+    // Paused: park here; wake up once a second so shutdown is not held up
+    while (g_widget_updates_paused && running) {
+        g_widget_cv.wait_for(lock, std::chrono::seconds(1));
+    }
+}
+
 } // namespace UI
 } // namespace Leviathan
@@ -0,0 +1,345 @@
+#include "ui/IconAtlas.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Leviathan {
+namespace UI {
+
+namespace {
+
+// Transparent column/row right of and below each icon, so filtering at an
+// icon's edge never picks up its neighbour
+constexpr int GUTTER = 1;
+
+} // namespace
+
+IconAtlas::IconAtlas(int icon_size)
+    : icon_size_(std::max(icon_size, 1)) {
+    // Room for roughly 8x8 icons, in a power of two between 256 and 2048
+    page_size_ = 256;
+    while (page_size_ < (icon_size_ + GUTTER) * 8 && page_size_ < 2048) {
+        page_size_ *= 2;
+    }
+    page_size_ = std::max(page_size_, icon_size_ + GUTTER);
+}
+
+IconAtlas::~IconAtlas() {
+    for (auto& page : pages_) {
+        DestroyPage(*page);
+    }
+}
+
+IconAtlas::Handle IconAtlas::Insert(cairo_surface_t* image) {
+    if (!image || cairo_surface_get_type(image) != CAIRO_SURFACE_TYPE_IMAGE ||
+        cairo_image_surface_get_format(image) != CAIRO_FORMAT_ARGB32) {
+        return INVALID_HANDLE;
+    }
+    
+    int width = cairo_image_surface_get_width(image);
+    int height = cairo_image_surface_get_height(image);
+    if (width <= 0 || height <= 0) {
+        return INVALID_HANDLE;
+    }
+    
+    Slot slot;
+    if (!Allocate(width, height, slot)) {
+        return INVALID_HANDLE;
+    }
+    
+    Blit(image, 0, 0, pages_[slot.page]->surface, slot.x, slot.y, width, height);
+    
+    uint32_t index;
+    if (free_slots_) {
+        index = free_slots_ - 1;
+        free_slots_ = slots_[index].next_free;
+        slots_[index] = slot;
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(slot);
+    }
+    
+    live_count_++;
+    live_area_ += static_cast<size_t>(width) * height;
+    return index + 1;
+}
+
+void IconAtlas::Remove(Handle handle) {
+    if (handle == INVALID_HANDLE || handle > slots_.size() || slots_[handle - 1].page < 0) {
+        return;
+    }
+    
+    Slot& slot = slots_[handle - 1];
+    Release(slot);
+    live_count_--;
+    live_area_ -= static_cast<size_t>(slot.width) * slot.height;
+    
+    slot.page = -1;
+    slot.next_free = free_slots_;
+    free_slots_ = handle;
+    
+    MaybeCompact();
+}
+
+void IconAtlas::Paint(cairo_t* cr, Handle handle, double x, double y) const {
+    if (handle == INVALID_HANDLE || handle > slots_.size() || slots_[handle - 1].page < 0) {
+        return;
+    }
+    
+    const Slot& slot = slots_[handle - 1];
+    cairo_pattern_t* pattern = pages_[slot.page]->pattern;
+    
+    // The pattern matrix maps user space to page space
+    cairo_matrix_t matrix;
+    cairo_matrix_init_translate(&matrix, slot.x - x, slot.y - y);
+    cairo_pattern_set_matrix(pattern, &matrix);
+    
+    cairo_set_source(cr, pattern);
+    cairo_rectangle(cr, x, y, slot.width, slot.height);
+    cairo_fill(cr);
+}
+
+int IconAtlas::GetWidth(Handle handle) const {
+    return (handle != INVALID_HANDLE && handle <= slots_.size()) ? slots_[handle - 1].width : 0;
+}
+
+int IconAtlas::GetHeight(Handle handle) const {
+    return (handle != INVALID_HANDLE && handle <= slots_.size()) ? slots_[handle - 1].height : 0;
+}
+
+size_t IconAtlas::GetBytes(Handle handle) const {
+    return static_cast<size_t>(GetWidth(handle)) * GetHeight(handle) * 4;
+}
+
+IconAtlas::Stats IconAtlas::GetStats() const {
+    Stats stats;
+    stats.pages = pages_.size();
+    stats.page_bytes = pages_.size() * static_cast<size_t>(page_size_) * page_size_ * 4;
+    stats.icons = live_count_;
+    stats.icon_bytes = live_area_ * 4;
+    for (const auto& page : pages_) {
+        for (const auto& shelf : page->shelves) {
+            stats.shelf_bytes += static_cast<size_t>(shelf.height) * page_size_ * 4;
+        }
+    }
+    stats.compactions = compactions_;
+    return stats;
+}
+
+bool IconAtlas::Allocate(int width, int height, Slot& slot) {
+    if (width + GUTTER > page_size_ || height + GUTTER > page_size_) {
+        return false;
+    }
+    
+    for (size_t i = 0; i < pages_.size(); i++) {
+        if (AllocateInPage(static_cast<int>(i), width, height, slot)) {
+            return true;
+        }
+    }
+    
+    return AllocateInPage(AddPage(), width, height, slot);
+}
+
+bool IconAtlas::AllocateInPage(int page_index, int width, int height, Slot& slot) {
+    Page& page = *pages_[page_index];
+    int alloc_width = width + GUTTER;
+    int alloc_height = height + GUTTER;
+    
+    // Tightest shelf that is tall enough; icons of the atlas size share one shelf height
+    int best = -1;
+    for (size_t i = 0; i < page.shelves.size(); i++) {
+        const Shelf& shelf = page.shelves[i];
+        if (shelf.height < alloc_height) {
+            continue;
+        }
+        if (shelf.height > alloc_height * SHELF_SLACK && shelf.height != icon_size_ + GUTTER) {
+            continue;
+        }
+        bool has_room = shelf.cursor + alloc_width <= page_size_;
+        for (size_t g = 0; !has_room && g < shelf.gaps.size(); g++) {
+            has_room = shelf.gaps[g].width >= alloc_width;
+        }
+        if (has_room && (best < 0 || shelf.height < page.shelves[best].height)) {
+            best = static_cast<int>(i);
+        }
+    }
+    
+    if (best < 0) {
+        // Open a new shelf below the last one
+        int shelf_height = std::max(alloc_height, icon_size_ + GUTTER);
+        if (alloc_height * SHELF_SLACK < shelf_height) {
+            shelf_height = alloc_height;
+        }
+        if (page.next_shelf_y + shelf_height > page_size_) {
+            return false;
+        }
+        page.shelves.push_back(Shelf{page.next_shelf_y, shelf_height});
+        page.next_shelf_y += shelf_height;
+        best = static_cast<int>(page.shelves.size()) - 1;
+    }
+    
+    Shelf& shelf = page.shelves[best];
+    int x = -1;
+    for (auto it = shelf.gaps.begin(); it != shelf.gaps.end(); ++it) {
+        if (it->width >= alloc_width) {
+            x = it->x;
+            it->x += alloc_width;
+            it->width -= alloc_width;
+            if (it->width == 0) {
+                shelf.gaps.erase(it);
+            }
+            break;
+        }
+    }
+    if (x < 0) {
+        x = shelf.cursor;
+        shelf.cursor += alloc_width;
+    }
+    
+    slot.page = page_index;
+    slot.shelf = best;
+    slot.x = x;
+    slot.y = shelf.y;
+    slot.width = width;
+    slot.height = height;
+    slot.next_free = 0;
+    page.live_area += static_cast<size_t>(width) * height;
+    return true;
+}
+
+void IconAtlas::Release(const Slot& slot) {
+    Page& page = *pages_[slot.page];
+    Shelf& shelf = page.shelves[slot.shelf];
+    page.live_area -= static_cast<size_t>(slot.width) * slot.height;
+    
+    // Keep gaps sorted and merged so neighbours coalesce into wider gaps
+    Gap gap{slot.x, slot.width + GUTTER};
+    auto it = std::lower_bound(shelf.gaps.begin(), shelf.gaps.end(), gap,
+                               [](const Gap& a, const Gap& b) { return a.x < b.x; });
+    it = shelf.gaps.insert(it, gap);
+    if (it + 1 != shelf.gaps.end() && it->x + it->width == (it + 1)->x) {
+        it->width += (it + 1)->width;
+        shelf.gaps.erase(it + 1);
+    }
+    if (it != shelf.gaps.begin() && (it - 1)->x + (it - 1)->width == it->x) {
+        (it - 1)->width += it->width;
+        it = shelf.gaps.erase(it) - 1;
+    }
+    
+    // A gap that reaches the unused tail gives its space back to the tail
+    if (it->x + it->width == shelf.cursor) {
+        shelf.cursor = it->x;
+        shelf.gaps.erase(it);
+    }
+    
+    // An empty page starts over with no shelves, so any icon height fits again
+    if (page.live_area == 0) {
+        page.shelves.clear();
+        page.next_shelf_y = 0;
+    }
+}
+
+int IconAtlas::AddPage() {
+    auto page = std::make_unique<Page>();
+    page->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, page_size_, page_size_);
+    page->pattern = cairo_pattern_create_for_surface(page->surface);
+    cairo_pattern_set_extend(page->pattern, CAIRO_EXTEND_NONE);
+    pages_.push_back(std::move(page));
+    return static_cast<int>(pages_.size()) - 1;
+}
+
+void IconAtlas::DestroyPage(Page& page) {
+    if (page.pattern) {
+        cairo_pattern_destroy(page.pattern);
+        page.pattern = nullptr;
+    }
+    if (page.surface) {
+        cairo_surface_destroy(page.surface);
+        page.surface = nullptr;
+    }
+}
+
+void IconAtlas::MaybeCompact() {
+    size_t shelf_area = 0;
+    for (const auto& page : pages_) {
+        for (const auto& shelf : page->shelves) {
+            shelf_area += static_cast<size_t>(shelf.height) * page_size_;
+        }
+    }
+    
+    // Worth repacking once less than half of the claimed space is live and
+    // either a page could be freed or the one page is at least half claimed
+    size_t page_area = static_cast<size_t>(page_size_) * page_size_;
+    if (live_area_ * 2 >= shelf_area) {
+        return;
+    }
+    if (pages_.size() > 1 || shelf_area * 2 >= page_area) {
+        Compact();
+    }
+}
+
+void IconAtlas::Compact() {
+    std::vector<std::unique_ptr<Page>> old_pages;
+    old_pages.swap(pages_);
+    
+    // Tallest first packs shelves tightest
+    std::vector<uint32_t> live;
+    live.reserve(live_count_);
+    for (uint32_t i = 0; i < slots_.size(); i++) {
+        if (slots_[i].page >= 0) {
+            live.push_back(i);
+        }
+    }
+    std::sort(live.begin(), live.end(), [this](uint32_t a, uint32_t b) {
+        if (slots_[a].height != slots_[b].height) {
+            return slots_[a].height > slots_[b].height;
+        }
+        return slots_[a].width > slots_[b].width;
+    });
+    
+    for (uint32_t index : live) {
+        Slot& slot = slots_[index];
+        Slot moved;
+        // Everything fitted before, so it fits in fresh pages
+        Allocate(slot.width, slot.height, moved);
+        Blit(old_pages[slot.page]->surface, slot.x, slot.y,
+             pages_[moved.page]->surface, moved.x, moved.y, slot.width, slot.height);
+        slot = moved;
+    }
+    
+    for (auto& page : old_pages) {
+        DestroyPage(*page);
+    }
+    compactions_++;
+}
+
+void IconAtlas::Blit(cairo_surface_t* src, int src_x, int src_y,
+                     cairo_surface_t* dst, int dst_x, int dst_y, int width, int height) {
+    cairo_surface_flush(src);
+    cairo_surface_flush(dst);
+    
+    const unsigned char* src_data = cairo_image_surface_get_data(src);
+    unsigned char* dst_data = cairo_image_surface_get_data(dst);
+    int src_stride = cairo_image_surface_get_stride(src);
+    int dst_stride = cairo_image_surface_get_stride(dst);
+    
+    // Clear the gutter too: a reused gap may still hold part of an older, wider icon
+    int dst_width = cairo_image_surface_get_width(dst);
+    int dst_height = cairo_image_surface_get_height(dst);
+    int clear_width = std::min(width + GUTTER, dst_width - dst_x);
+    int clear_height = std::min(height + GUTTER, dst_height - dst_y);
+    for (int row = 0; row < clear_height; row++) {
+        unsigned char* out = dst_data + static_cast<size_t>(dst_y + row) * dst_stride + dst_x * 4;
+        if (row < height) {
+            std::memcpy(out, src_data + static_cast<size_t>(src_y + row) * src_stride + src_x * 4,
+                        static_cast<size_t>(width) * 4);
+            std::memset(out + width * 4, 0, static_cast<size_t>(clear_width - width) * 4);
+        } else {
+            std::memset(out, 0, static_cast<size_t>(clear_width) * 4);
+        }
+    }
+    
+    cairo_surface_mark_dirty_rectangle(dst, dst_x, dst_y, clear_width, clear_height);
+}
+
+} // namespace UI
+} // namespace Leviathan
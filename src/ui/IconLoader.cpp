@@ -1,13 +1,55 @@
 #include "ui/IconLoader.hpp"
+#include "wayland/WaylandTypes.hpp"
 #include "Logger.hpp"
 #include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <cstdlib>
+#include <climits>
 #include <sstream>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace Leviathan {
 namespace UI {
 
-IconLoader::IconLoader() {
+namespace {
+
+// Icon theme from GTK settings, so the launcher matches GTK apps
+std::string DetectIconTheme() {
+    std::string config_home;
+    if (const char* xdg_config = getenv("XDG_CONFIG_HOME")) {
+        config_home = xdg_config;
+    } else if (const char* home = getenv("HOME")) {
+        config_home = std::string(home) + "/.config";
+    }
+    
+    if (!config_home.empty()) {
+        std::ifstream settings(config_home + "/gtk-3.0/settings.ini");
+        std::string line;
+        while (std::getline(settings, line)) {
+            if (line.compare(0, 19, "gtk-icon-theme-name") != 0) {
+                continue;
+            }
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) {
+                continue;
+            }
+            size_t start = line.find_first_not_of(" \t\"", eq + 1);
+            size_t end = line.find_last_not_of(" \t\r\"");
+            if (start != std::string::npos && end >= start) {
+                return line.substr(start, end - start + 1);
+            }
+        }
+    }
+    return "hicolor";
+}
+
+} // namespace
+
+IconLoader::IconLoader(struct wl_event_loop* event_loop)
+    : event_loop_(event_loop) {
     // Standard icon theme directories (following XDG spec)
     icon_theme_paths_.push_back("/usr/share/icons");
     icon_theme_paths_.push_back("/usr/share/pixmaps");
@@ -31,102 +73,413 @@ IconLoader::IconLoader() {
             }
         }
     }
+    
+    // XDG_DATA_DIRS usually repeats /usr/share; index each directory once
+    std::vector<std::string> unique_paths;
+    for (const auto& path : icon_theme_paths_) {
+        if (std::find(unique_paths.begin(), unique_paths.end(), path) == unique_paths.end()) {
+            unique_paths.push_back(path);
+        }
+    }
+    icon_theme_paths_.swap(unique_paths);
+    
+    theme_ = DetectIconTheme();
+    
+    // Theme indexes are persisted here (see IconThemeIndex)
+    if (const char* xdg_cache = getenv("XDG_CACHE_HOME")) {
+        index_cache_dir_ = std::string(xdg_cache) + "/leviathan/icon-index";
+    } else if (home) {
+        index_cache_dir_ = std::string(home) + "/.cache/leviathan/icon-index";
+    }
 }
 
 IconLoader::~IconLoader() {
+    // Stop the decoder before tearing down the caches it feeds
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            stop_worker_ = true;
+        }
+        queue_cv_.notify_all();
+        worker_.join();
+    }
+    for (auto& result : results_) {
+        if (result.surface) {
+            cairo_surface_destroy(result.surface);
+        }
+    }
+    results_.clear();
+    
+    if (wake_source_) {
+        wl_event_source_remove(wake_source_);
+        wake_source_ = nullptr;
+    }
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    
     ClearCache();
 }
 
 void IconLoader::ClearCache() {
-    for (auto& pair : cache_) {
-        if (pair.second) {
-            cairo_surface_destroy(pair.second);
-        }
-    }
+    // Dropping the atlases frees every icon (and placeholder) at once
     cache_.clear();
+    lru_.clear();
+    cache_bytes_ = 0;
+    missing_.clear();
+    placeholders_.clear();
+    atlases_.clear();
+}
+
+void IconLoader::SetTheme(const std::string& theme) {
+    if (theme == theme_) {
+        return;
+    }
+    theme_ = theme;
+    ClearCache();
+}
+
+void IconLoader::SetCacheBudget(size_t bytes) {
+    cache_budget_ = bytes;
+    EvictToBudget();
 }
 
-cairo_surface_t* IconLoader::LoadIcon(const std::string& icon_name, int size) {
+std::map<int, IconAtlas::Stats> IconLoader::GetAtlasStats() const {
+    std::map<int, IconAtlas::Stats> stats;
+    for (const auto& pair : atlases_) {
+        stats[pair.first] = pair.second->GetStats();
+    }
+    return stats;
+}
+
+bool IconLoader::DrawIcon(cairo_t* cr, const std::string& icon_name, int size, double x, double y) {
     if (icon_name.empty()) {
-        return nullptr;
+        return false;
     }
     
     // Check cache first
     IconCacheKey key{icon_name, size};
     auto it = cache_.find(key);
     if (it != cache_.end()) {
-        return it->second;
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+        GetAtlas(size).Paint(cr, it->second.handle, x, y);
+        return true;
+    }
+    
+    if (missing_.count(key)) {
+        return false;
+    }
+    
+    if (pending_.count(key)) {
+        GetAtlas(size).Paint(cr, GetPlaceholder(size), x, y);
+        return true;
     }
     
     // Find icon file
     std::string icon_path;
     
     // Check if it's an absolute path
-    if (icon_name[0] == '/' && std::filesystem::exists(icon_name)) {
-        icon_path = icon_name;
+    if (icon_name[0] == '/') {
+        std::error_code ec;
+        if (std::filesystem::exists(icon_name, ec)) {
+            icon_path = icon_name;
+        }
     } else {
-        // Search in icon theme directories
+        // Search the icon theme indexes
         icon_path = FindIconFile(icon_name, size);
     }
     
     if (icon_path.empty()) {
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Icon not found: {}", icon_name);
-        cache_[key] = nullptr;
-        return nullptr;
+        missing_.insert(key);
+        return false;
+    }
+    
+    // Decode in the background and show a placeholder until it's ready
+    if (StartWorker()) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            jobs_.push_back({key, icon_path});
+        }
+        queue_cv_.notify_one();
+        pending_.insert(key);
+        GetAtlas(size).Paint(cr, GetPlaceholder(size), x, y);
+        return true;
     }
     
-    // Load the icon
+    // No event loop to deliver results on: decode inline
     cairo_surface_t* surface = LoadIconFromFile(icon_path, size);
-    cache_[key] = surface;
+    if (!surface || !Insert(key, surface)) {
+        missing_.insert(key);
+        return false;
+    }
+    GetAtlas(size).Paint(cr, cache_[key].handle, x, y);
     
-    return surface;
+    return true;
 }
 
 std::string IconLoader::FindIconFile(const std::string& icon_name, int size) {
-    // Common extensions to try
-    std::vector<std::string> extensions = {".png", ".svg", ".xpm", ".jpg", ".jpeg"};
-    
-    // If icon_name already has extension, try it directly
+    // If icon_name already has extension, try it as a plain file first
     if (icon_name.find('.') != std::string::npos) {
-        for (const auto& base_path : icon_theme_paths_) {
-            std::string path = base_path + "/" + icon_name;
-            if (std::filesystem::exists(path)) {
+        ScanUnthemed();
+        auto it = unthemed_.find(icon_name);
+        if (it != unthemed_.end()) {
+            return it->second;
+        }
+    }
+    
+    // Configured theme and its Inherits chain, then hicolor (always the last resort per spec)
+    std::unordered_set<std::string> visited;
+    std::string path = LookupInTheme(theme_, icon_name, size, visited);
+    if (path.empty()) {
+        path = LookupInTheme("hicolor", icon_name, size, visited);
+    }
+    
+    // Try direct paths (common in /usr/share/pixmaps)
+    if (path.empty()) {
+        ScanUnthemed();
+        auto it = unthemed_.find(icon_name);
+        if (it != unthemed_.end()) {
+            path = it->second;
+        }
+    }
+    
+    return path;
+}
+
+const std::vector<std::unique_ptr<IconThemeIndex>>& IconLoader::GetTheme(const std::string& theme) {
+    auto it = themes_.find(theme);
+    if (it != themes_.end()) {
+        return it->second;
+    }
+    
+    // A theme can be spread over several search paths (e.g. system + ~/.local)
+    auto& indexes = themes_[theme];
+    for (const auto& base_path : icon_theme_paths_) {
+        std::string root = base_path + "/" + theme;
+        std::error_code ec;
+        if (std::filesystem::is_directory(root, ec)) {
+            indexes.push_back(IconThemeIndex::Open(root, index_cache_dir_));
+        }
+    }
+    return indexes;
+}
+
+std::string IconLoader::LookupInTheme(const std::string& theme, const std::string& icon_name, int size,
+                                      std::unordered_set<std::string>& visited) {
+    if (!visited.insert(theme).second) {
+        return "";  // Already searched (or an Inherits cycle)
+    }
+    
+    const auto& indexes = GetTheme(theme);
+    
+    // Exact size match anywhere in the theme wins, else the closest size in the theme
+    std::string best;
+    int best_distance = INT_MAX;
+    for (const auto& index : indexes) {
+        int distance = 0;
+        std::string path = index->Lookup(icon_name, size, 1, distance);
+        if (!path.empty() && distance < best_distance) {
+            best = std::move(path);
+            best_distance = distance;
+            if (distance == 0) {
+                break;
+            }
+        }
+    }
+    if (!best.empty()) {
+        return best;
+    }
+    
+    for (const auto& index : indexes) {
+        for (const auto& parent : index->GetInherits()) {
+            std::string path = LookupInTheme(parent, icon_name, size, visited);
+            if (!path.empty()) {
                 return path;
             }
         }
     }
     
-    // Search in theme directories
-    // Priority: hicolor theme with exact size match
-    std::vector<std::string> size_dirs = {
-        "hicolor/" + std::to_string(size) + "x" + std::to_string(size) + "/apps",
-        "hicolor/" + std::to_string(size) + "x" + std::to_string(size) + "/places",
-        "hicolor/" + std::to_string(size) + "x" + std::to_string(size) + "/categories",
-        "hicolor/scalable/apps",
-        "hicolor/scalable/places"
-    };
+    return "";
+}
+
+void IconLoader::ScanUnthemed() {
+    if (unthemed_scanned_) {
+        return;
+    }
+    unthemed_scanned_ = true;
+    
+    // Common extensions
+    static const char* const extensions[] = {".png", ".svg", ".xpm", ".jpg", ".jpeg"};
     
+    // One listing per search path; earlier paths win
     for (const auto& base_path : icon_theme_paths_) {
-        // Try size-specific directories
-        for (const auto& size_dir : size_dirs) {
-            for (const auto& ext : extensions) {
-                std::string path = base_path + "/" + size_dir + "/" + icon_name + ext;
-                if (std::filesystem::exists(path)) {
-                    return path;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(base_path, ec)) {
+            std::string filename = entry.path().filename().string();
+            size_t dot = filename.rfind('.');
+            if (dot == std::string::npos || dot == 0) {
+                continue;
+            }
+            std::string ext = filename.substr(dot);
+            for (const char* known : extensions) {
+                if (ext == known) {
+                    std::string path = entry.path().string();
+                    unthemed_.emplace(filename, path);
+                    unthemed_.emplace(filename.substr(0, dot), path);
+                    break;
                 }
             }
         }
-        
-        // Try direct paths (common in /usr/share/pixmaps)
-        for (const auto& ext : extensions) {
-            std::string path = base_path + "/" + icon_name + ext;
-            if (std::filesystem::exists(path)) {
-                return path;
+    }
+}
+
+bool IconLoader::Insert(const IconCacheKey& key, cairo_surface_t* surface) {
+    // The decoded surface is only a staging copy; the atlas keeps the pixels
+    IconAtlas& atlas = GetAtlas(key.size);
+    IconAtlas::Handle handle = atlas.Insert(surface);
+    cairo_surface_destroy(surface);
+    if (handle == IconAtlas::INVALID_HANDLE) {
+        return false;
+    }
+    
+    size_t bytes = atlas.GetBytes(handle);
+    lru_.push_front(key);
+    cache_[key] = CacheEntry{handle, bytes, lru_.begin()};
+    cache_bytes_ += bytes;
+    
+    EvictToBudget();
+    return true;
+}
+
+void IconLoader::EvictToBudget() {
+    // Never evict the most recently used icon, even if it alone exceeds the budget
+    while (cache_bytes_ > cache_budget_ && lru_.size() > 1) {
+        auto it = cache_.find(lru_.back());
+        if (it != cache_.end()) {
+            GetAtlas(it->first.size).Remove(it->second.handle);
+            cache_bytes_ -= it->second.bytes;
+            cache_.erase(it);
+        }
+        lru_.pop_back();
+    }
+}
+
+IconAtlas& IconLoader::GetAtlas(int size) {
+    auto& atlas = atlases_[size];
+    if (!atlas) {
+        atlas = std::make_unique<IconAtlas>(size);
+    }
+    return *atlas;
+}
+
+IconAtlas::Handle IconLoader::GetPlaceholder(int size) {
+    auto it = placeholders_.find(size);
+    if (it != placeholders_.end()) {
+        return it->second;
+    }
+    
+    // Faint rounded square, so rows don't jump when the real icon arrives
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size, size);
+    cairo_t* cr = cairo_create(surface);
+    double radius = size / 6.0;
+    cairo_new_sub_path(cr);
+    cairo_arc(cr, size - radius, radius, radius, -M_PI / 2, 0);
+    cairo_arc(cr, size - radius, size - radius, radius, 0, M_PI / 2);
+    cairo_arc(cr, radius, size - radius, radius, M_PI / 2, M_PI);
+    cairo_arc(cr, radius, radius, radius, M_PI, 3 * M_PI / 2);
+    cairo_close_path(cr);
+    cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.12);
+    cairo_fill(cr);
+    cairo_destroy(cr);
+    
+    IconAtlas::Handle handle = GetAtlas(size).Insert(surface);
+    cairo_surface_destroy(surface);
+    placeholders_[size] = handle;
+    return handle;
+}
+
+bool IconLoader::StartWorker() {
+    if (worker_.joinable()) {
+        return true;
+    }
+    if (!event_loop_) {
+        return false;
+    }
+    
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Icon loader: eventfd failed, decoding icons synchronously");
+        event_loop_ = nullptr;
+        return false;
+    }
+    
+    wake_source_ = wl_event_loop_add_fd(event_loop_, wake_fd_, WL_EVENT_READABLE, OnDecodeReady, this);
+    if (!wake_source_) {
+        close(wake_fd_);
+        wake_fd_ = -1;
+        event_loop_ = nullptr;
+        return false;
+    }
+    
+    worker_ = std::thread(&IconLoader::WorkerLoop, this);
+    return true;
+}
+
+void IconLoader::WorkerLoop() {
+    while (true) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this]() { return stop_worker_ || !jobs_.empty(); });
+            if (stop_worker_) {
+                return;
             }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        
+        cairo_surface_t* surface = LoadIconFromFile(job.path, job.key.size);
+        
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            wake = results_.empty();  // Otherwise the main loop has not drained the last wakeup yet
+            results_.push_back({std::move(job.key), surface});
+        }
+        if (wake) {
+            uint64_t one = 1;
+            ssize_t written = write(wake_fd_, &one, sizeof(one));
+            (void)written;
+        }
+    }
+}
+
+int IconLoader::OnDecodeReady(int fd, uint32_t mask, void* data) {
+    auto* loader = static_cast<IconLoader*>(data);
+    
+    uint64_t count = 0;
+    ssize_t got = read(fd, &count, sizeof(count));
+    (void)got;
+    
+    std::vector<DecodeResult> results;
+    {
+        std::lock_guard<std::mutex> lock(loader->queue_mutex_);
+        results.swap(loader->results_);
+    }
+    
+    for (auto& result : results) {
+        loader->pending_.erase(result.key);
+        if (!result.surface || !loader->Insert(result.key, result.surface)) {
+            loader->missing_.insert(result.key);
         }
     }
     
-    return "";
+    if (!results.empty() && loader->on_icon_ready_) {
+        loader->on_icon_ready_();
+    }
+    return 0;
 }
 
 cairo_surface_t* IconLoader::LoadIconFromFile(const std::string& filepath, int size) {
@@ -0,0 +1,435 @@
+#include "ui/IconThemeIndex.hpp"
+#include "Logger.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <sys/stat.h>
+
+namespace Leviathan {
+namespace UI {
+
+namespace {
+
+// Lookup preference order per the icon theme spec
+const char* const ICON_EXTENSIONS[] = {".png", ".svg", ".xpm"};
+constexpr size_t ICON_EXTENSION_COUNT = sizeof(ICON_EXTENSIONS) / sizeof(ICON_EXTENSIONS[0]);
+
+constexpr const char* CACHE_MAGIC = "LEVIATHAN_ICON_INDEX";
+constexpr int CACHE_VERSION = 1;
+
+std::string Trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t\r");
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(start, end - start + 1);
+}
+
+std::vector<std::string> SplitList(const std::string& value) {
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = Trim(item);
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+int ToInt(const std::string& value, int fallback) {
+    char* end = nullptr;
+    long parsed = std::strtol(value.c_str(), &end, 10);
+    return (end && end != value.c_str()) ? static_cast<int>(parsed) : fallback;
+}
+
+// "48x48", "48x48@2", "48" (context/size layouts) or "scalable"
+bool ParseSizeName(const std::string& name, int& size, int& scale, bool& scalable) {
+    scale = 1;
+    scalable = false;
+    if (name == "scalable") {
+        scalable = true;
+        size = 48;
+        return true;
+    }
+    
+    std::string base = name;
+    size_t at = name.find('@');
+    if (at != std::string::npos) {
+        base = name.substr(0, at);
+        scale = std::max(1, ToInt(name.substr(at + 1), 1));
+    }
+    
+    size_t x = base.find('x');
+    std::string width = x == std::string::npos ? base : base.substr(0, x);
+    if (width.empty() || !std::all_of(width.begin(), width.end(), ::isdigit)) {
+        return false;
+    }
+    size = ToInt(width, 0);
+    return size > 0;
+}
+
+} // namespace
+
+int64_t IconThemeIndex::GetMtime(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+}
+
+std::unique_ptr<IconThemeIndex> IconThemeIndex::Open(const std::string& theme_root, const std::string& cache_dir) {
+    std::unique_ptr<IconThemeIndex> index(new IconThemeIndex());
+    index->root_ = theme_root;
+    
+    std::string cache_path;
+    if (!cache_dir.empty()) {
+        std::stringstream name;
+        name << std::hex << std::hash<std::string>()(theme_root) << ".idx";
+        cache_path = cache_dir + "/" + name.str();
+        
+        if (index->LoadCache(cache_path)) {
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Icon theme index for {} loaded from cache ({} icons)",
+                         theme_root, index->icons_.size());
+            return index;
+        }
+        
+        // Stale or unreadable: start over from a clean index
+        index.reset(new IconThemeIndex());
+        index->root_ = theme_root;
+    }
+    
+    index->root_mtime_ = GetMtime(theme_root);
+    index->index_theme_mtime_ = GetMtime(theme_root + "/index.theme");
+    if (index->index_theme_mtime_ == 0 || !index->ParseIndexTheme(theme_root + "/index.theme")) {
+        index->index_theme_mtime_ = 0;
+        index->DiscoverDirectories();
+    }
+    index->Scan();
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Indexed icon theme {} ({} directories, {} icons)",
+                 theme_root, index->directories_.size(), index->icons_.size());
+    
+    if (!cache_path.empty()) {
+        index->SaveCache(cache_path);
+    }
+    return index;
+}
+
+bool IconThemeIndex::ParseIndexTheme(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    
+    std::map<std::string, std::map<std::string, std::string>> sections;
+    std::string section;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = Trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (line.front() == '[' && line.back() == ']') {
+            section = line.substr(1, line.size() - 2);
+            continue;
+        }
+        size_t eq = line.find('=');
+        if (eq != std::string::npos) {
+            sections[section][Trim(line.substr(0, eq))] = Trim(line.substr(eq + 1));
+        }
+    }
+    
+    auto theme = sections.find("Icon Theme");
+    if (theme == sections.end()) {
+        return false;
+    }
+    
+    inherits_ = SplitList(theme->second["Inherits"]);
+    
+    std::vector<std::string> dirs = SplitList(theme->second["Directories"]);
+    std::vector<std::string> scaled = SplitList(theme->second["ScaledDirectories"]);
+    dirs.insert(dirs.end(), scaled.begin(), scaled.end());
+    
+    for (const auto& dir_name : dirs) {
+        auto it = sections.find(dir_name);
+        if (it == sections.end()) {
+            continue;
+        }
+        auto& keys = it->second;
+        
+        Directory dir;
+        dir.path = dir_name;
+        dir.size = ToInt(keys["Size"], 0);
+        if (dir.size <= 0) {
+            continue;
+        }
+        dir.scale = std::max(1, ToInt(keys["Scale"], 1));
+        dir.min_size = ToInt(keys["MinSize"], dir.size);
+        dir.max_size = ToInt(keys["MaxSize"], dir.size);
+        dir.threshold = ToInt(keys["Threshold"], 2);
+        
+        const std::string& type = keys["Type"];
+        if (type == "Fixed") {
+            dir.type = DirType::Fixed;
+        } else if (type == "Scalable") {
+            dir.type = DirType::Scalable;
+        } else {
+            dir.type = DirType::Threshold;
+        }
+        directories_.push_back(std::move(dir));
+    }
+    
+    return true;
+}
+
+void IconThemeIndex::DiscoverDirectories() {
+    std::error_code ec;
+    for (const auto& level1 : std::filesystem::directory_iterator(root_, ec)) {
+        if (!level1.is_directory(ec)) {
+            continue;
+        }
+        std::string first = level1.path().filename().string();
+        for (const auto& level2 : std::filesystem::directory_iterator(level1.path(), ec)) {
+            if (!level2.is_directory(ec)) {
+                continue;
+            }
+            std::string second = level2.path().filename().string();
+            
+            // Both <size>/<context> and <context>/<size> layouts are in use
+            int size = 0;
+            int scale = 1;
+            bool scalable = false;
+            if (!ParseSizeName(first, size, scale, scalable) &&
+                !ParseSizeName(second, size, scale, scalable)) {
+                continue;
+            }
+            
+            Directory dir;
+            dir.path = first + "/" + second;
+            dir.size = size;
+            dir.scale = scale;
+            dir.type = scalable ? DirType::Scalable : DirType::Fixed;
+            dir.min_size = scalable ? 1 : size;
+            dir.max_size = scalable ? 512 : size;
+            directories_.push_back(std::move(dir));
+        }
+    }
+}
+
+void IconThemeIndex::Scan() {
+    icons_.clear();
+    for (size_t i = 0; i < directories_.size() && i <= UINT16_MAX; i++) {
+        Directory& dir = directories_[i];
+        std::string full = root_ + "/" + dir.path;
+        dir.mtime = GetMtime(full);
+        if (dir.mtime == 0) {
+            continue;  // Listed in index.theme but not installed
+        }
+        
+        // One listing per directory; file names are all we need
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(full, ec)) {
+            std::string filename = entry.path().filename().string();
+            size_t dot = filename.rfind('.');
+            if (dot == std::string::npos || dot == 0) {
+                continue;
+            }
+            std::string ext = filename.substr(dot);
+            for (size_t e = 0; e < ICON_EXTENSION_COUNT; e++) {
+                if (ext == ICON_EXTENSIONS[e]) {
+                    icons_[filename.substr(0, dot)].push_back({static_cast<uint16_t>(i), static_cast<uint8_t>(e)});
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool IconThemeIndex::MatchesSize(const Directory& dir, int size, int scale) {
+    if (dir.scale != scale) {
+        return false;
+    }
+    switch (dir.type) {
+    case DirType::Fixed:
+        return dir.size == size;
+    case DirType::Scalable:
+        return dir.min_size <= size && size <= dir.max_size;
+    case DirType::Threshold:
+    default:
+        return dir.size - dir.threshold <= size && size <= dir.size + dir.threshold;
+    }
+}
+
+int IconThemeIndex::SizeDistance(const Directory& dir, int size, int scale) {
+    int wanted = size * scale;
+    int low = 0;
+    int high = 0;
+    switch (dir.type) {
+    case DirType::Fixed:
+        return std::abs(dir.size * dir.scale - wanted);
+    case DirType::Scalable:
+        low = dir.min_size * dir.scale;
+        high = dir.max_size * dir.scale;
+        break;
+    case DirType::Threshold:
+    default:
+        low = (dir.size - dir.threshold) * dir.scale;
+        high = (dir.size + dir.threshold) * dir.scale;
+        break;
+    }
+    if (wanted < low) {
+        return low - wanted;
+    }
+    if (wanted > high) {
+        return wanted - high;
+    }
+    return 0;
+}
+
+std::string IconThemeIndex::Lookup(const std::string& name, int size, int scale, int& distance) const {
+    auto it = icons_.find(name);
+    if (it == icons_.end()) {
+        return "";
+    }
+    
+    const Entry* best = nullptr;
+    int best_distance = INT_MAX;
+    for (const auto& entry : it->second) {
+        const Directory& dir = directories_[entry.dir];
+        int d = MatchesSize(dir, size, scale) ? 0 : std::max(1, SizeDistance(dir, size, scale));
+        if (d < best_distance || (d == best_distance && best && entry.ext < best->ext)) {
+            best = &entry;
+            best_distance = d;
+        }
+    }
+    
+    if (!best) {
+        return "";
+    }
+    distance = best_distance;
+    return root_ + "/" + directories_[best->dir].path + "/" + name + ICON_EXTENSIONS[best->ext];
+}
+
+bool IconThemeIndex::LoadCache(const std::string& cache_path) {
+    std::ifstream file(cache_path);
+    if (!file) {
+        return false;
+    }
+    
+    std::string magic;
+    int version = 0;
+    file >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        return false;
+    }
+    
+    std::string line;
+    std::getline(file, line);  // Rest of the header line
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        std::string tag;
+        in >> tag;
+        
+        if (tag == "root") {
+            std::string path;
+            in >> root_mtime_ >> std::ws;
+            std::getline(in, path);
+            // Validate as we go: a stale root or index.theme means a rescan
+            if (path != root_ || root_mtime_ != GetMtime(root_)) {
+                return false;
+            }
+        } else if (tag == "index") {
+            in >> index_theme_mtime_;
+            if (index_theme_mtime_ != GetMtime(root_ + "/index.theme")) {
+                return false;
+            }
+        } else if (tag == "inherits") {
+            std::string list;
+            in >> std::ws;
+            std::getline(in, list);
+            inherits_ = SplitList(list);
+        } else if (tag == "dir") {
+            Directory dir;
+            int type = 0;
+            in >> dir.size >> dir.scale >> dir.min_size >> dir.max_size >> dir.threshold >> type >> dir.mtime >> std::ws;
+            std::getline(in, dir.path);
+            dir.type = static_cast<DirType>(type);
+            if (in.fail() || dir.mtime != GetMtime(root_ + "/" + dir.path)) {
+                return false;
+            }
+            directories_.push_back(std::move(dir));
+        } else if (tag == "icon") {
+            unsigned dir = 0;
+            unsigned ext = 0;
+            std::string name;
+            in >> dir >> ext >> std::ws;
+            std::getline(in, name);
+            if (in.fail() || dir >= directories_.size() || ext >= ICON_EXTENSION_COUNT || name.empty()) {
+                return false;
+            }
+            icons_[name].push_back({static_cast<uint16_t>(dir), static_cast<uint8_t>(ext)});
+        }
+    }
+    
+    if (directories_.empty()) {
+        return false;
+    }
+    return true;
+}
+
+void IconThemeIndex::SaveCache(const std::string& cache_path) const {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cache_path).parent_path(), ec);
+    
+    // Write to a temporary file and rename so readers never see a partial index
+    std::string tmp_path = cache_path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        if (!file) {
+            return;
+        }
+        
+        file << CACHE_MAGIC << " " << CACHE_VERSION << "\n";
+        file << "root " << root_mtime_ << " " << root_ << "\n";
+        file << "index " << index_theme_mtime_ << "\n";
+        
+        std::string inherits;
+        for (const auto& parent : inherits_) {
+            inherits += (inherits.empty() ? "" : ",") + parent;
+        }
+        file << "inherits " << inherits << "\n";
+        
+        for (const auto& dir : directories_) {
+            file << "dir " << dir.size << " " << dir.scale << " " << dir.min_size << " " << dir.max_size << " "
+                 << dir.threshold << " " << static_cast<int>(dir.type) << " " << dir.mtime << " " << dir.path << "\n";
+        }
+        for (const auto& [name, entries] : icons_) {
+            for (const auto& entry : entries) {
+                file << "icon " << entry.dir << " " << static_cast<int>(entry.ext) << " " << name << "\n";
+            }
+        }
+        
+        if (!file) {
+            std::filesystem::remove(tmp_path, ec);
+            return;
+        }
+    }
+    
+    std::filesystem::rename(tmp_path, cache_path, ec);
+    if (ec) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Could not write icon index cache {}: {}", cache_path, ec.message());
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
+} // namespace UI
+} // namespace Leviathan
@@ -23,82 +23,103 @@ KeybindingHelpModal::KeybindingHelpModal()
 }
 
 void KeybindingHelpModal::BuildWidgetContent() {
-    // Create main vertical container for all keybindings
-    auto main_vbox = std::make_shared<VBox>();
-    main_vbox->SetSpacing(5);
-    
-    // Create header row
-    auto header_hbox = std::make_shared<HBox>();
-    header_hbox->SetSpacing(10);
-    
-    auto key_header = std::make_shared<Label>("Key");
-    key_header->SetFontSize(14);
-    key_header->SetSize(200, 25);
-    
-    auto action_header = std::make_shared<Label>("Action");
-    action_header->SetFontSize(14);
-    action_header->SetSize(250, 25);
-    
-    auto desc_header = std::make_shared<Label>("Description");
-    desc_header->SetFontSize(14);
-    desc_header->SetSize(400, 25);
-    
-    header_hbox->AddChild(key_header);
-    header_hbox->AddChild(action_header);
-    header_hbox->AddChild(desc_header);
-    
-    main_vbox->AddChild(header_hbox);
-    
-    // Add keybinding rows
-    for (const auto& binding : keybindings_) {
-        // Check if this is a category header (empty keys field)
-        if (binding.keys.empty() && !binding.action_name.empty()) {
-            // Category header
-            auto category_label = std::make_shared<Label>(binding.action_name);
+    // Virtualized list: row 0 is the column header, the rest map onto
+    // keybindings_. Only the rows visible in the modal are ever built.
+    auto scroll_view = std::make_shared<ScrollView>();
+    scroll_view->SetEstimatedItemHeight(28);
+    scroll_view->SetItemSpacing(5);
+    scroll_view->SetItemBuilder(keybindings_.size() + 1,
+        [this](size_t index, std::shared_ptr<Widget> recycled) {
+            return BuildRow(index, recycled);
+        },
+        [this](size_t index) {
+            return static_cast<int>(GetRowType(index));
+        });
+    scroll_view->SetScrollbarColor(0.6, 0.6, 0.6, 0.7);
+    scroll_view->ShowScrollbar(true);
+    
+    // Set as modal content
+    SetContent(scroll_view);
+}
+
+KeybindingHelpModal::RowType KeybindingHelpModal::GetRowType(size_t index) const {
+    if (index == 0) return RowType::Header;
+    
+    // Category header entries have an empty keys field
+    const auto& binding = keybindings_[index - 1];
+    if (binding.keys.empty() && !binding.action_name.empty()) {
+        return RowType::Category;
+    }
+    return RowType::Binding;
+}
+
+std::shared_ptr<Widget> KeybindingHelpModal::BuildRow(size_t index, std::shared_ptr<Widget> recycled) {
+    RowType type = GetRowType(index);
+    
+    if (type == RowType::Category) {
+        auto category_label = std::static_pointer_cast<Label>(recycled);
+        if (!category_label) {
+            category_label = std::make_shared<Label>();
             category_label->SetFontSize(16);
             category_label->SetTextColor(1.0, 1.0, 1.0, 1.0);
             category_label->SetSize(850, 30);
-            main_vbox->AddChild(category_label);
-            continue;
         }
-        
-        // Regular keybinding row
-        auto row_hbox = std::make_shared<HBox>();
+        category_label->SetText(keybindings_[index - 1].action_name);
+        return category_label;
+    }
+    
+    // Header and binding rows share the three-column layout
+    auto row_hbox = std::static_pointer_cast<HBox>(recycled);
+    if (!row_hbox) {
+        row_hbox = std::make_shared<HBox>();
         row_hbox->SetSpacing(10);
         
+        const int font_size = type == RowType::Header ? 14 : 12;
+        const int row_height = type == RowType::Header ? 25 : 20;
+        
         // Key combination (light blue)
-        auto key_label = std::make_shared<Label>(binding.keys);
-        key_label->SetFontSize(12);
-        key_label->SetTextColor(0.7, 0.9, 1.0, 1.0);
-        key_label->SetSize(200, 20);
+        auto key_label = std::make_shared<Label>();
+        key_label->SetFontSize(font_size);
+        key_label->SetSize(200, row_height);
         
         // Action name (light yellow)
-        auto action_label = std::make_shared<Label>(binding.action_name);
-        action_label->SetFontSize(12);
-        action_label->SetTextColor(1.0, 1.0, 0.7, 1.0);
-        action_label->SetSize(250, 20);
+        auto action_label = std::make_shared<Label>();
+        action_label->SetFontSize(font_size);
+        action_label->SetSize(250, row_height);
         
         // Description (white)
-        auto desc_label = std::make_shared<Label>(binding.description);
-        desc_label->SetFontSize(12);
-        desc_label->SetTextColor(0.9, 0.9, 0.9, 0.8);
-        desc_label->SetSize(400, 20);
+        auto desc_label = std::make_shared<Label>();
+        desc_label->SetFontSize(font_size);
+        desc_label->SetSize(400, row_height);
+        
+        if (type == RowType::Binding) {
+            key_label->SetTextColor(0.7, 0.9, 1.0, 1.0);
+            action_label->SetTextColor(1.0, 1.0, 0.7, 1.0);
+            desc_label->SetTextColor(0.9, 0.9, 0.9, 0.8);
+        }
         
         row_hbox->AddChild(key_label);
         row_hbox->AddChild(action_label);
         row_hbox->AddChild(desc_label);
-        
-        main_vbox->AddChild(row_hbox);
     }
     
-    // Wrap the VBox in a ScrollView
-    auto scroll_view = std::make_shared<ScrollView>();
-    scroll_view->SetChild(main_vbox);
-    scroll_view->SetScrollbarColor(0.6, 0.6, 0.6, 0.7);
-    scroll_view->ShowScrollbar(true);
+    const auto& columns = row_hbox->GetChildren();
+    auto key_label = std::static_pointer_cast<Label>(columns[0]);
+    auto action_label = std::static_pointer_cast<Label>(columns[1]);
+    auto desc_label = std::static_pointer_cast<Label>(columns[2]);
+    
+    if (type == RowType::Header) {
+        key_label->SetText("Key");
+        action_label->SetText("Action");
+        desc_label->SetText("Description");
+    } else {
+        const auto& binding = keybindings_[index - 1];
+        key_label->SetText(binding.keys);
+        action_label->SetText(binding.action_name);
+        desc_label->SetText(binding.description);
+    }
     
-    // Set as modal content
-    SetContent(scroll_view);
+    return row_hbox;
 }
 
 void KeybindingHelpModal::PopulateKeybindings() {
@@ -1,5 +1,7 @@
 #include "ui/NotificationDaemon.hpp"
+#include "ui/NotificationPresenter.hpp"
 #include "wayland/Server.hpp"
+#include "config/ConfigParser.hpp"
 #include "Logger.hpp"
 
 #include <gio/gio.h>
@@ -9,6 +11,11 @@
 namespace Leviathan {
 namespace UI {
 
+static uint64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 // DBus introspection XML for org.freedesktop.Notifications
 static const char* NOTIFICATIONS_INTROSPECTION =
     "<node>"
@@ -63,7 +70,9 @@ NotificationDaemon::NotificationDaemon(Wayland::Server* server)
       server_(server),
       bus_name_id_(0),
       registration_id_(0),
-      next_id_(1) {
+      next_id_(1),
+      default_timeout_ms_(Config().notifications.default_timeout),
+      history_size_(static_cast<size_t>(std::max(1, Config().notifications.history_size))) {
 }
 
 // Destructor
@@ -75,6 +84,16 @@ NotificationDaemon::~NotificationDaemon() {
 bool NotificationDaemon::Initialize() {
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Initializing notification daemon");
     
+    // Expiry and card rendering both run off the compositor's event loop
+    struct wl_event_loop* event_loop = server_ ? wl_display_get_event_loop(server_->GetDisplay()) : nullptr;
+    if (event_loop) {
+        expiry_timer_ = wl_event_loop_add_timer(event_loop, OnExpiryTimer, this);
+        presenter_ = std::make_unique<NotificationPresenter>(server_, event_loop, Config().notifications);
+        presenter_->SetSource([this]() { return GetActiveNotifications(); });
+    } else {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "No event loop - notifications will not expire or be drawn");
+    }
+    
     // Connect to session bus using DBusHelper
     if (!ConnectToSessionBus()) {
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to connect to session bus");
@@ -139,6 +158,14 @@ void NotificationDaemon::Shutdown() {
         EmitNotificationClosed(id, UNDEFINED);
     }
     notifications_.clear();
+    expiry_queue_ = {};
+    
+    if (expiry_timer_) {
+        wl_event_source_remove(expiry_timer_);
+        expiry_timer_ = nullptr;
+        armed_deadline_ = 0;
+    }
+    presenter_.reset();
     
     // Release DBus resources
     ReleaseDBusName();
@@ -298,6 +325,17 @@ GVariant* NotificationDaemon::HandleNotify(GVariant* parameters) {
         notifications_[notification_id] = std::make_unique<NotificationData>();
         notification = notifications_[notification_id].get();
         notification->id = notification_id;
+    } else {
+        // Start from a clean slate so hints from the old notification don't leak or linger
+        for (auto& [key, variant] : notification->hints) {
+            if (variant) {
+                g_variant_unref(variant);
+            }
+        }
+        notification->hints.clear();
+        notification->urgency = 1;
+        notification->is_resident = false;
+        notification->revision++;
     }
     
     // Fill notification data
@@ -326,13 +364,12 @@ GVariant* NotificationDaemon::HandleNotify(GVariant* parameters) {
     }
     
     // Calculate expire time
-    auto now = std::chrono::steady_clock::now();
-    notification->created_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()).count();
+    uint64_t now = NowMs();
+    notification->created_time = now;
     
     int32_t timeout = expire_timeout;
     if (timeout < 0) {
-        timeout = DEFAULT_TIMEOUT_MS;
+        timeout = default_timeout_ms_;
     }
     
     if (timeout == 0 || notification->is_resident) {
@@ -344,6 +381,10 @@ GVariant* NotificationDaemon::HandleNotify(GVariant* parameters) {
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Notification {}: '{}' from {}", 
                  notification_id, notification->summary, notification->app_name);
     
+    ScheduleExpiry(notification);
+    ArmExpiryTimer(now);
+    EnforceHistoryLimit();
+    
     // Render notification
     RenderNotification(notification);
     
@@ -376,17 +417,16 @@ GVariant* NotificationDaemon::HandleGetServerInformation() {
 void NotificationDaemon::CloseNotification(uint32_t id, CloseReason reason) {
     std::lock_guard<std::mutex> lock(notifications_mutex_);
     
-    auto it = notifications_.find(id);
-    if (it == notifications_.end()) {
+    if (!FindNotification(id)) {
         return;
     }
     
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Closing notification {} (reason: {})", id, static_cast<int>(reason));
     
-    // TODO: Animate out / destroy Wayland surface
+    RemoveNotification(id, reason);
     
-    EmitNotificationClosed(id, reason);
-    notifications_.erase(it);
+    // The expiry heap entry (if any) goes stale and is skipped; just move the timer along
+    ArmExpiryTimer(NowMs());
     
     if (notification_callback_) {
         notification_callback_();
@@ -452,6 +492,102 @@ NotificationData* NotificationDaemon::FindNotification(uint32_t id) {
     return (it != notifications_.end()) ? it->second.get() : nullptr;
 }
 
+// Remove a notification, keeping a trimmed copy in the history
+void NotificationDaemon::RemoveNotification(uint32_t id, CloseReason reason) {
+    auto it = notifications_.find(id);
+    if (it == notifications_.end()) {
+        return;
+    }
+    
+    const NotificationData& notification = *it->second;
+    history_.push_back({notification.id, notification.app_name, notification.summary, notification.body,
+                        notification.created_time, static_cast<uint32_t>(reason)});
+    while (history_.size() > history_size_) {
+        history_.pop_front();
+    }
+    
+    EmitNotificationClosed(id, reason);
+    if (presenter_) {
+        presenter_->Forget(id);
+    }
+    notifications_.erase(it);
+}
+
+// Keep the number of live notifications within the history size
+void NotificationDaemon::EnforceHistoryLimit() {
+    while (notifications_.size() > history_size_) {
+        auto oldest = std::min_element(notifications_.begin(), notifications_.end(),
+                                       [](const auto& a, const auto& b) {
+                                           return a.second->created_time < b.second->created_time;
+                                       });
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Notification limit ({}) reached, dropping {}",
+                     history_size_, oldest->first);
+        RemoveNotification(oldest->first, UNDEFINED);
+    }
+}
+
+// Queue the notification's deadline (no-op for notifications that never expire)
+void NotificationDaemon::ScheduleExpiry(const NotificationData* notification) {
+    if (notification->expire_time == 0) {
+        return;
+    }
+    
+    // Replacing a notification over and over leaves stale entries behind;
+    // rebuild the heap from live deadlines once they clearly dominate it
+    if (expiry_queue_.size() > 4 * notifications_.size() + 64) {
+        std::vector<ExpiryEntry> live;
+        live.reserve(notifications_.size());
+        for (const auto& [id, data] : notifications_) {
+            if (data->expire_time > 0 && data.get() != notification) {
+                live.push_back({data->expire_time, id});
+            }
+        }
+        expiry_queue_ = decltype(expiry_queue_)(std::greater<ExpiryEntry>(), std::move(live));
+    }
+    
+    expiry_queue_.push({notification->expire_time, notification->id});
+}
+
+// Arm the timer for the earliest live deadline (disarm if there is none)
+void NotificationDaemon::ArmExpiryTimer(uint64_t now) {
+    // Skip entries for notifications that were closed or replaced since they were queued
+    while (!expiry_queue_.empty()) {
+        const ExpiryEntry& top = expiry_queue_.top();
+        NotificationData* notification = FindNotification(top.id);
+        if (notification && notification->expire_time == top.expire_time) {
+            break;
+        }
+        expiry_queue_.pop();
+    }
+    
+    if (!expiry_timer_) {
+        return;
+    }
+    
+    if (expiry_queue_.empty()) {
+        if (armed_deadline_ != 0) {
+            wl_event_source_timer_update(expiry_timer_, 0);
+            armed_deadline_ = 0;
+        }
+        return;
+    }
+    
+    uint64_t deadline = expiry_queue_.top().expire_time;
+    if (deadline == armed_deadline_) {
+        return;
+    }
+    
+    uint64_t delay = deadline > now ? deadline - now : 1;  // 0 would disarm
+    wl_event_source_timer_update(expiry_timer_, static_cast<int>(delay));
+    armed_deadline_ = deadline;
+}
+
+int NotificationDaemon::OnExpiryTimer(void* data) {
+    auto* daemon = static_cast<NotificationDaemon*>(data);
+    daemon->ProcessExpiredNotifications();
+    return 0;
+}
+
 // Parse hints from GVariant
 void NotificationDaemon::ParseHints(NotificationData* notification, GVariant* hints_variant) {
     GVariantIter iter;
@@ -473,37 +609,36 @@ void NotificationDaemon::ParseHints(NotificationData* notification, GVariant* hi
     }
 }
 
-// Update - process expired notifications
+// Update - dispatch pending DBus method calls (registered on the default GLib context)
 void NotificationDaemon::Update() {
-    ProcessExpiredNotifications();
+    g_main_context_iteration(nullptr, FALSE);
 }
 
-// Process expired notifications
+// Process expired notifications (expiry timer callback)
 void NotificationDaemon::ProcessExpiredNotifications() {
     std::lock_guard<std::mutex> lock(notifications_mutex_);
     
-    auto now = std::chrono::steady_clock::now();
-    uint64_t current_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()).count();
-    
-    std::vector<uint32_t> expired_ids;
+    uint64_t now = NowMs();
+    armed_deadline_ = 0;  // The timer just fired
     
-    for (const auto& [id, notification] : notifications_) {
-        if (notification->expire_time > 0 && current_time >= notification->expire_time) {
-            expired_ids.push_back(id);
+    size_t expired = 0;
+    while (!expiry_queue_.empty() && expiry_queue_.top().expire_time <= now) {
+        ExpiryEntry entry = expiry_queue_.top();
+        expiry_queue_.pop();
+        
+        NotificationData* notification = FindNotification(entry.id);
+        if (!notification || notification->expire_time != entry.expire_time) {
+            continue;  // Closed or replaced since this deadline was queued
         }
+        
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Notification {} expired", entry.id);
+        RemoveNotification(entry.id, EXPIRED);
+        expired++;
     }
     
-    for (uint32_t id : expired_ids) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Notification {} expired", id);
-        auto it = notifications_.find(id);
-        if (it != notifications_.end()) {
-            EmitNotificationClosed(id, EXPIRED);
-            notifications_.erase(it);
-        }
-    }
+    ArmExpiryTimer(now);
     
-    if (!expired_ids.empty()) {
+    if (expired > 0) {
         if (notification_callback_) {
             notification_callback_();
         }
@@ -525,25 +660,32 @@ std::vector<NotificationData*> NotificationDaemon::GetActiveNotifications() cons
     return result;
 }
 
+// Get notification history
+std::vector<NotificationHistoryEntry> NotificationDaemon::GetHistory() const {
+    std::lock_guard<std::mutex> lock(notifications_mutex_);
+    return std::vector<NotificationHistoryEntry>(history_.begin(), history_.end());
+}
+
 // Set notification callback
 void NotificationDaemon::SetNotificationCallback(std::function<void()> callback) {
     notification_callback_ = callback;
 }
 
-// Render notification (stub - will be implemented with Wayland layer surface)
+// Render notification - the presenter draws it on its next (rate limited) relayout
 void NotificationDaemon::RenderNotification(NotificationData* notification) {
-    // TODO: Create Wayland layer shell surface for notification
-    // TODO: Render notification content using Cairo
-    // TODO: Position based on screen size and existing notifications
-    
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Rendering notification {}: {}", 
                   notification->id, notification->summary);
+    
+    if (presenter_) {
+        presenter_->ScheduleUpdate();
+    }
 }
 
 // Update notification positions
 void NotificationDaemon::UpdateNotificationPositions() {
-    // TODO: Re-position all notification surfaces
-    // Stack them vertically with spacing
+    if (presenter_) {
+        presenter_->ScheduleUpdate();
+    }
 }
 
 // OnConnected override - called by DBusHelper after connection established
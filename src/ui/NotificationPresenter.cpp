@@ -0,0 +1,580 @@
+#include "ui/NotificationPresenter.hpp"
+#include "ui/NotificationDaemon.hpp"
+#include "ui/ShmBuffer.hpp"
+#include "wayland/Server.hpp"
+#include "wayland/Output.hpp"
+#include "wayland/LayerManager.hpp"
+#include "wayland/WaylandTypes.hpp"
+#include "Logger.hpp"
+
+#include <wlr/types/wlr_scene.h>
+#include <cairo/cairo.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Leviathan {
+namespace UI {
+
+namespace {
+
+uint64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Drop a trailing partial UTF-8 sequence so ellipsizing never splits a code point
+void PopUtf8Char(std::string& text) {
+    while (!text.empty()) {
+        unsigned char c = static_cast<unsigned char>(text.back());
+        text.pop_back();
+        if ((c & 0xC0) != 0x80) {
+            break;
+        }
+    }
+}
+
+void RoundedRectangle(cairo_t* cr, double x, double y, double w, double h, double r) {
+    cairo_new_sub_path(cr);
+    cairo_arc(cr, x + w - r, y + r, r, -M_PI / 2, 0);
+    cairo_arc(cr, x + w - r, y + h - r, r, 0, M_PI / 2);
+    cairo_arc(cr, x + r, y + h - r, r, M_PI / 2, M_PI);
+    cairo_arc(cr, x + r, y + r, r, M_PI, 3 * M_PI / 2);
+    cairo_close_path(cr);
+}
+
+} // namespace
+
+NotificationPresenter::NotificationPresenter(Wayland::Server* server,
+                                             struct wl_event_loop* event_loop,
+                                             const NotificationsConfig& config)
+    : server_(server),
+      event_loop_(event_loop),
+      config_(config) {
+    ConfigParser::HexToRGBA(config_.background_color, background_);
+    ConfigParser::HexToRGBA(config_.foreground_color, foreground_);
+    ConfigParser::HexToRGBA(config_.critical_color, critical_);
+    
+    measure_surface_ = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+    measure_cr_ = cairo_create(measure_surface_);
+    
+    if (event_loop_) {
+        update_timer_ = wl_event_loop_add_timer(event_loop_, OnUpdateTimer, this);
+    }
+    if (!update_timer_) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Notification presenter has no update timer - notifications will not be drawn");
+    }
+}
+
+NotificationPresenter::~NotificationPresenter() {
+    if (update_timer_) {
+        wl_event_source_remove(update_timer_);
+        update_timer_ = nullptr;
+    }
+    
+    for (auto& surface : surfaces_) {
+        DestroySurface(*surface);
+    }
+    surfaces_.clear();
+    
+    if (root_) {
+        wlr_scene_node_destroy(&root_->node);
+        root_ = nullptr;
+    }
+    
+    if (measure_cr_) {
+        cairo_destroy(measure_cr_);
+    }
+    if (measure_surface_) {
+        cairo_surface_destroy(measure_surface_);
+    }
+}
+
+void NotificationPresenter::ScheduleUpdate() {
+    if (update_pending_ || !update_timer_) {
+        return;
+    }
+    update_pending_ = true;
+    
+    // Everything that arrives before the timer fires is folded into one relayout
+    uint64_t interval = 1000 / static_cast<uint64_t>(std::max(1, config_.max_updates_per_second));
+    uint64_t elapsed = NowMs() - last_relayout_ms_;
+    uint64_t delay = elapsed >= interval ? 1 : interval - elapsed;  // 0 would disarm the timer
+    wl_event_source_timer_update(update_timer_, static_cast<int>(delay));
+}
+
+void NotificationPresenter::Forget(uint32_t id) {
+    layouts_.erase(id);
+}
+
+int NotificationPresenter::OnUpdateTimer(void* data) {
+    auto* presenter = static_cast<NotificationPresenter*>(data);
+    presenter->Relayout();
+    return 0;
+}
+
+void NotificationPresenter::Relayout() {
+    update_pending_ = false;
+    last_relayout_ms_ = NowMs();
+    relayout_count_++;
+    
+    std::vector<NotificationData*> notifications;
+    if (source_) {
+        notifications = source_();
+    }
+    
+    // Every surface is free until a card claims it back
+    for (auto& surface : surfaces_) {
+        surface->in_use = false;
+    }
+    
+    // Cards go on the focused output, falling back to the first one
+    Wayland::LayerManager* layer_manager = nullptr;
+    if (auto* screen = server_->GetFocusedScreen()) {
+        layer_manager = server_->GetLayerManagerForScreen(screen);
+    }
+    if (!layer_manager) {
+        if (auto* output = server_->GetFirstOutput()) {
+            layer_manager = output->layer_manager;
+        }
+    }
+    
+    if (!notifications.empty() && EnsureRoot(layer_manager)) {
+        size_t overflow = 0;
+        std::vector<Card> cards = BuildCards(notifications, overflow);
+        if (overflow > 0) {
+            Card more;
+            more.lead = nullptr;
+            more.count = overflow;
+            cards.push_back(more);
+        }
+        
+        struct wlr_output* output = layer_manager->GetOutput();
+        struct wlr_box box = {};
+        wlr_output_layout_get_box(server_->GetOutputLayout(), output, &box);
+        if (wlr_box_empty(&box)) {
+            box.x = 0;
+            box.y = 0;
+            layer_manager->GetLogicalSize(box.width, box.height);
+        }
+        
+        int x = box.x + box.width - config_.width - config_.margin;
+        int y = box.y + static_cast<int>(layer_manager->GetReservedSpace().top) + config_.margin;
+        
+        for (const auto& card : cards) {
+            const CardLayout& layout = GetLayout(card);
+            if (y + layout.height > box.y + box.height) {
+                break;  // Off the bottom of the screen
+            }
+            
+            CardSurface* surface = AcquireSurface(card, layout.height);
+            if (!surface) {
+                break;
+            }
+            
+            uint32_t id = card.lead ? card.lead->id : 0;
+            uint32_t revision = card.lead ? card.lead->revision : 0;
+            if (!surface->painted || surface->bound_id != id ||
+                surface->bound_revision != revision || surface->bound_count != card.count) {
+                PaintCard(*surface, card, layout);
+            }
+            
+            wlr_scene_node_set_position(&surface->node->node, x, y);
+            wlr_scene_node_set_enabled(&surface->node->node, true);
+            y += layout.height + config_.spacing;
+        }
+    }
+    
+    // Hide what is left over, keeping at most one stack's worth of surfaces around
+    size_t pool_limit = static_cast<size_t>(config_.max_visible) + 1;
+    for (auto it = surfaces_.begin(); it != surfaces_.end();) {
+        if (!(*it)->in_use) {
+            if (surfaces_.size() > pool_limit) {
+                DestroySurface(**it);
+                it = surfaces_.erase(it);
+                continue;
+            }
+            wlr_scene_node_set_enabled(&(*it)->node->node, false);
+        }
+        ++it;
+    }
+}
+
+std::vector<NotificationPresenter::Card> NotificationPresenter::BuildCards(
+    std::vector<NotificationData*>& notifications, size_t& overflow) const {
+    // Newest first
+    std::sort(notifications.begin(), notifications.end(),
+              [](const NotificationData* a, const NotificationData* b) {
+                  if (a->created_time != b->created_time) {
+                      return a->created_time > b->created_time;
+                  }
+                  return a->id > b->id;
+              });
+    
+    std::vector<Card> cards;
+    std::vector<uint64_t> oldest;  // Oldest created_time folded into each card
+    std::unordered_map<std::string, size_t> open_groups;  // app_name -> card index
+    uint64_t window = static_cast<uint64_t>(config_.group_window);
+    
+    for (const auto* notification : notifications) {
+        // Critical notifications always get their own card
+        bool groupable = window > 0 && notification->urgency < 2 && !notification->app_name.empty();
+        if (groupable) {
+            auto it = open_groups.find(notification->app_name);
+            if (it != open_groups.end() && oldest[it->second] - notification->created_time <= window) {
+                cards[it->second].count++;
+                oldest[it->second] = notification->created_time;
+                continue;
+            }
+        }
+        
+        Card card;
+        card.lead = notification;
+        card.count = 1;
+        cards.push_back(card);
+        oldest.push_back(notification->created_time);
+        if (groupable) {
+            open_groups[notification->app_name] = cards.size() - 1;
+        }
+    }
+    
+    overflow = 0;
+    size_t max_visible = static_cast<size_t>(config_.max_visible);
+    if (cards.size() > max_visible) {
+        for (size_t i = max_visible; i < cards.size(); i++) {
+            overflow += cards[i].count;
+        }
+        cards.resize(max_visible);
+    }
+    
+    return cards;
+}
+
+int NotificationPresenter::GetLineHeight(int font_size) const {
+    return static_cast<int>(std::ceil(font_size * 1.4));
+}
+
+const NotificationPresenter::CardLayout& NotificationPresenter::GetLayout(const Card& card) {
+    int header_size = std::max(6, config_.font_size - 2);
+    
+    if (!card.lead) {
+        if (overflow_layout_.count != card.count || overflow_layout_.height == 0) {
+            overflow_layout_.count = card.count;
+            overflow_layout_.header = std::to_string(card.count) + " more notification" + (card.count == 1 ? "" : "s");
+            overflow_layout_.summary_lines.clear();
+            overflow_layout_.body_lines.clear();
+            overflow_layout_.height = CARD_PADDING * 2 + GetLineHeight(header_size);
+        }
+        return overflow_layout_;
+    }
+    
+    CardLayout& layout = layouts_[card.lead->id];
+    if (layout.height > 0 && layout.revision == card.lead->revision && layout.count == card.count) {
+        return layout;
+    }
+    
+    double inner_width = config_.width - CARD_PADDING * 2;
+    
+    layout.revision = card.lead->revision;
+    layout.count = card.count;
+    layout.header = card.lead->app_name.empty() ? "Notification" : card.lead->app_name;
+    if (card.count > 1) {
+        layout.header += " (" + std::to_string(card.count) + ")";
+    }
+    layout.summary_lines = WrapText(card.lead->summary, inner_width, MAX_SUMMARY_LINES, true);
+    layout.body_lines = WrapText(StripMarkup(card.lead->body), inner_width, MAX_BODY_LINES, false);
+    
+    int line_height = GetLineHeight(config_.font_size);
+    layout.height = CARD_PADDING * 2 + GetLineHeight(header_size) +
+                    static_cast<int>(layout.summary_lines.size() + layout.body_lines.size()) * line_height;
+    
+    return layout;
+}
+
+std::vector<std::string> NotificationPresenter::WrapText(const std::string& text, double max_width,
+                                                         size_t max_lines, bool bold) {
+    std::vector<std::string> lines;
+    if (text.empty() || max_lines == 0) {
+        return lines;
+    }
+    
+    cairo_select_font_face(measure_cr_, config_.font_family.c_str(),
+                          CAIRO_FONT_SLANT_NORMAL,
+                          bold ? CAIRO_FONT_WEIGHT_BOLD : CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(measure_cr_, config_.font_size);
+    
+    auto measure = [this](const std::string& s) {
+        cairo_text_extents_t extents;
+        cairo_text_extents(measure_cr_, s.c_str(), &extents);
+        return extents.x_advance;
+    };
+    
+    bool truncated = false;
+    size_t paragraph_start = 0;
+    while (paragraph_start <= text.size() && !truncated) {
+        size_t paragraph_end = text.find('\n', paragraph_start);
+        if (paragraph_end == std::string::npos) {
+            paragraph_end = text.size();
+        }
+        
+        // Greedy word wrap; words wider than the card are left to the clip
+        std::string line;
+        size_t pos = paragraph_start;
+        while (pos < paragraph_end) {
+            size_t word_end = text.find(' ', pos);
+            if (word_end == std::string::npos || word_end > paragraph_end) {
+                word_end = paragraph_end;
+            }
+            std::string word = text.substr(pos, word_end - pos);
+            pos = word_end + 1;
+            if (word.empty()) {
+                continue;
+            }
+            
+            std::string candidate = line.empty() ? word : line + " " + word;
+            if (line.empty() || measure(candidate) <= max_width) {
+                line = std::move(candidate);
+                continue;
+            }
+            
+            lines.push_back(std::move(line));
+            line = word;
+            if (lines.size() == max_lines) {
+                truncated = true;
+                break;
+            }
+        }
+        
+        if (truncated) {
+            break;
+        }
+        if (!line.empty()) {
+            lines.push_back(std::move(line));
+            if (lines.size() == max_lines && paragraph_end < text.size()) {
+                truncated = true;
+            }
+        }
+        if (lines.size() == max_lines) {
+            break;
+        }
+        paragraph_start = paragraph_end + 1;
+    }
+    
+    if (truncated && !lines.empty()) {
+        std::string& last = lines.back();
+        while (!last.empty() && measure(last + "…") > max_width) {
+            PopUtf8Char(last);
+        }
+        last += "…";
+    }
+    
+    return lines;
+}
+
+std::string NotificationPresenter::StripMarkup(const std::string& text) {
+    // body-markup is a tiny subset (b, i, u, a, img); drop tags and decode the common entities
+    std::string result;
+    result.reserve(text.size());
+    bool in_tag = false;
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (in_tag) {
+            in_tag = c != '>';
+            continue;
+        }
+        if (c == '<') {
+            in_tag = true;
+            continue;
+        }
+        if (c == '&') {
+            static const std::pair<const char*, char> entities[] = {
+                {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}
+            };
+            bool decoded = false;
+            for (const auto& [entity, replacement] : entities) {
+                size_t length = std::char_traits<char>::length(entity);
+                if (text.compare(i, length, entity) == 0) {
+                    result += replacement;
+                    i += length - 1;
+                    decoded = true;
+                    break;
+                }
+            }
+            if (decoded) {
+                continue;
+            }
+        }
+        result += c;
+    }
+    return result;
+}
+
+NotificationPresenter::CardSurface* NotificationPresenter::AcquireSurface(const Card& card, int height) {
+    int bucket = ((height + HEIGHT_BUCKET - 1) / HEIGHT_BUCKET) * HEIGHT_BUCKET;
+    uint32_t id = card.lead ? card.lead->id : 0;
+    
+    // Prefer the surface that already shows this card, then any free one of the right size
+    CardSurface* fallback = nullptr;
+    for (auto& surface : surfaces_) {
+        if (surface->in_use || surface->height != bucket || surface->width != config_.width) {
+            continue;
+        }
+        if (surface->painted && surface->bound_id == id) {
+            surface->in_use = true;
+            return surface.get();
+        }
+        if (!fallback) {
+            fallback = surface.get();
+        }
+    }
+    
+    if (!fallback) {
+        fallback = CreateSurface(bucket);
+        if (!fallback) {
+            return nullptr;
+        }
+    }
+    
+    fallback->in_use = true;
+    fallback->painted = false;
+    return fallback;
+}
+
+NotificationPresenter::CardSurface* NotificationPresenter::CreateSurface(int height) {
+    ShmBuffer* buffer = ShmBuffer::Create(config_.width, height);
+    if (!buffer) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create SHM buffer for notification card");
+        return nullptr;
+    }
+    
+    auto surface = std::make_unique<CardSurface>();
+    surface->buffer = buffer;
+    surface->node = wlr_scene_buffer_create(root_, buffer->GetWlrBuffer());
+    surface->width = config_.width;
+    surface->height = height;
+    if (!surface->node) {
+        wlr_buffer_drop(buffer->GetWlrBuffer());
+        return nullptr;
+    }
+    wlr_scene_node_set_enabled(&surface->node->node, false);
+    
+    surfaces_.push_back(std::move(surface));
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Notification surface pool grew to {} ({}x{})",
+                 surfaces_.size(), config_.width, height);
+    return surfaces_.back().get();
+}
+
+void NotificationPresenter::DestroySurface(CardSurface& surface) {
+    if (surface.node) {
+        wlr_scene_node_destroy(&surface.node->node);
+        surface.node = nullptr;
+    }
+    if (surface.buffer) {
+        // ShmBuffer is deleted by wlr_buffer_drop calling BufferDestroy
+        wlr_buffer_drop(surface.buffer->GetWlrBuffer());
+        surface.buffer = nullptr;
+    }
+}
+
+void NotificationPresenter::PaintCard(CardSurface& surface, const Card& card, const CardLayout& layout) {
+    cairo_surface_t* target = cairo_image_surface_create_for_data(
+        static_cast<unsigned char*>(surface.buffer->GetData()),
+        CAIRO_FORMAT_ARGB32,
+        surface.width,
+        surface.height,
+        surface.buffer->GetStride()
+    );
+    cairo_t* cr = cairo_create(target);
+    
+    // Clear (the bucket may be taller than the card)
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+    
+    bool critical = card.lead && card.lead->urgency >= 2;
+    
+    RoundedRectangle(cr, 0.5, 0.5, surface.width - 1, layout.height - 1, 8);
+    cairo_set_source_rgba(cr, background_[0], background_[1], background_[2], background_[3]);
+    cairo_fill_preserve(cr);
+    if (critical) {
+        cairo_set_source_rgba(cr, critical_[0], critical_[1], critical_[2], critical_[3]);
+    } else {
+        cairo_set_source_rgba(cr, foreground_[0], foreground_[1], foreground_[2], 0.2);
+    }
+    cairo_set_line_width(cr, 1.0);
+    cairo_stroke(cr);
+    
+    cairo_rectangle(cr, CARD_PADDING, 0, surface.width - CARD_PADDING * 2, layout.height);
+    cairo_clip(cr);
+    
+    cairo_font_extents_t font_extents;
+    double y = CARD_PADDING;
+    
+    // Header: app name (+ group count)
+    int header_size = std::max(6, config_.font_size - 2);
+    cairo_select_font_face(cr, config_.font_family.c_str(), CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, header_size);
+    cairo_font_extents(cr, &font_extents);
+    cairo_set_source_rgba(cr, foreground_[0], foreground_[1], foreground_[2], 0.7);
+    cairo_move_to(cr, CARD_PADDING, y + font_extents.ascent);
+    cairo_show_text(cr, layout.header.c_str());
+    y += GetLineHeight(header_size);
+    
+    int line_height = GetLineHeight(config_.font_size);
+    
+    cairo_select_font_face(cr, config_.font_family.c_str(), CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+    cairo_set_font_size(cr, config_.font_size);
+    cairo_font_extents(cr, &font_extents);
+    cairo_set_source_rgba(cr, foreground_[0], foreground_[1], foreground_[2], foreground_[3]);
+    for (const auto& line : layout.summary_lines) {
+        cairo_move_to(cr, CARD_PADDING, y + font_extents.ascent);
+        cairo_show_text(cr, line.c_str());
+        y += line_height;
+    }
+    
+    cairo_select_font_face(cr, config_.font_family.c_str(), CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_source_rgba(cr, foreground_[0], foreground_[1], foreground_[2], 0.85);
+    for (const auto& line : layout.body_lines) {
+        cairo_move_to(cr, CARD_PADDING, y + font_extents.ascent);
+        cairo_show_text(cr, line.c_str());
+        y += line_height;
+    }
+    
+    cairo_destroy(cr);
+    cairo_surface_flush(target);
+    cairo_surface_destroy(target);
+    
+    // Same buffer object: this only tells the scene the contents changed
+    wlr_scene_buffer_set_buffer(surface.node, surface.buffer->GetWlrBuffer());
+    
+    surface.bound_id = card.lead ? card.lead->id : 0;
+    surface.bound_revision = card.lead ? card.lead->revision : 0;
+    surface.bound_count = card.count;
+    surface.painted = true;
+}
+
+bool NotificationPresenter::EnsureRoot(Wayland::LayerManager* layer_manager) {
+    if (!layer_manager || !layer_manager->GetOutput()) {
+        return false;
+    }
+    
+    struct wlr_scene_tree* top = layer_manager->GetTopLayer();
+    if (!top) {
+        return false;
+    }
+    
+    if (!root_) {
+        root_ = wlr_scene_tree_create(top);
+        if (!root_) {
+            return false;
+        }
+    } else if (root_parent_ != top) {
+        // Focus moved to another output; take the cards with it
+        wlr_scene_node_reparent(&root_->node, top);
+    }
+    root_parent_ = top;
+    return true;
+}
+
+} // namespace UI
+} // namespace Leviathan
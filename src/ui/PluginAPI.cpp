@@ -170,8 +170,11 @@ int SubscribeToEvent(EventType type, EventListener listener) {
                             // Check if this event matches our subscription
                             bool matches = false;
                             if (type == EventType::TagSwitched && event_type_str == "tag_switched") matches = true;
+                            if (type == EventType::TagVisibilityChanged && event_type_str == "tag_visibility_changed") matches = true;
                             if (type == EventType::ClientAdded && event_type_str == "client_added") matches = true;
                             if (type == EventType::ClientRemoved && event_type_str == "client_removed") matches = true;
+                            if (type == EventType::ClientTagChanged && event_type_str == "client_tag_changed") matches = true;
+                            if (type == EventType::ClientFocused && event_type_str == "client_focused") matches = true;
                             if (type == EventType::LayoutChanged && event_type_str == "tiling_mode_changed") matches = true;
                             
                             if (matches) {
@@ -10,6 +10,7 @@
 #include "core/Screen.hpp"
 #include "Logger.hpp"
 #include "wayland/WaylandTypes.hpp"
+#include <cmath>
 #include <ctime>
 #include <cstring>
 #include <drm_fourcc.h>
@@ -41,15 +42,7 @@ StatusBar::StatusBar(const StatusBarConfig& config,
       bar_width_(0),
       bar_height_(0) {
     
-    // Calculate bar dimensions based on position
-    if (config_.position == StatusBarConfig::Position::Top || 
-        config_.position == StatusBarConfig::Position::Bottom) {
-        bar_width_ = output_width_;
-        bar_height_ = config_.height;
-    } else {  // Left or Right
-        bar_width_ = config_.width;
-        bar_height_ = output_height_;
-    }
+    UpdateGeometry();
     
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Creating status bar '{}' at position {} with size {}x{}", 
              config_.name, 
@@ -80,11 +73,24 @@ StatusBar::~StatusBar() {
         dirty_check_timer_ = nullptr;
     }
     
+    DestroyBuffer();
+    
+    if (texture_) {
+        wlr_texture_destroy(texture_);
+    }
+    // Scene nodes are cleaned up automatically by wlroots
+    // Popover rendering is now handled by LayerManager
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Destroyed status bar '{}'", config_.name);
+}
+
+void StatusBar::DestroyBuffer() {
     if (cairo_) {
         cairo_destroy(cairo_);
+        cairo_ = nullptr;
     }
     if (cairo_surface_) {
         cairo_surface_destroy(cairo_surface_);
+        cairo_surface_ = nullptr;
     }
     
     // Clean up SHM buffer (this will also clean up the wlr_buffer)
@@ -93,39 +99,55 @@ StatusBar::~StatusBar() {
         // ShmBuffer will be deleted by wlr_buffer_drop calling BufferDestroy
         shm_buffer_ = nullptr;
     }
+    buffer_data_ = nullptr;
+}
+
+void StatusBar::SetScale(float scale) {
+    if (scale <= 0.0f || scale == scale_) {
+        return;
+    }
+    scale_ = scale;
     
-    if (texture_) {
-        wlr_texture_destroy(texture_);
+    // Recreate the buffer at the new pixel size on the next render
+    if (scene_buffer_) {
+        wlr_scene_buffer_set_buffer(scene_buffer_, nullptr);
     }
-    // Scene nodes are cleaned up automatically by wlroots
-    // Popover rendering is now handled by LayerManager
-    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Destroyed status bar '{}'", config_.name);
+    DestroyBuffer();
+    Render();
 }
 
-void StatusBar::CreateSceneNodes() {
-    // Get the working area layer from the LayerManager
-    auto* working_layer = layer_manager_->GetLayer(Wayland::Layer::WorkingArea);
-    auto* top_layer = layer_manager_->GetLayer(Wayland::Layer::Top);
-    
-    // Parse background color from config
-    // Format: "#RRGGBB"
-    float bg_r = 0.18f, bg_g = 0.2f, bg_b = 0.25f;  // Default Nord color
-    if (config_.background_color.size() == 7 && config_.background_color[0] == '#') {
-        int r, g, b;
-        sscanf(config_.background_color.c_str(), "#%02x%02x%02x", &r, &g, &b);
-        bg_r = r / 255.0f;
-        bg_g = g / 255.0f;
-        bg_b = b / 255.0f;
+void StatusBar::SetOutputSize(uint32_t output_width, uint32_t output_height) {
+    if (output_width == output_width_ && output_height == output_height_) {
+        return;
     }
+    output_width_ = output_width;
+    output_height_ = output_height;
+    UpdateGeometry();
     
-    float bg_color[4] = { bg_r, bg_g, bg_b, 0.95f };  // 95% opacity
+    wlr_scene_rect_set_size(scene_rect_, bar_width_, bar_height_);
+    wlr_scene_node_set_position(&scene_rect_->node, pos_x_, pos_y_);
+    wlr_scene_node_set_position(&scene_buffer_->node, pos_x_, pos_y_);
     
-    // Create background rectangle
-    scene_rect_ = wlr_scene_rect_create(working_layer, bar_width_, bar_height_, bg_color);
+    // Recreate the buffer at the new size on the next render
+    wlr_scene_buffer_set_buffer(scene_buffer_, nullptr);
+    DestroyBuffer();
+    Render();
+}
+
+// Bar size and position from the output size and the configured edge
+void StatusBar::UpdateGeometry() {
+    if (config_.position == StatusBarConfig::Position::Top ||
+        config_.position == StatusBarConfig::Position::Bottom) {
+        bar_width_ = output_width_;
+        bar_height_ = config_.height;
+    } else {  // Left or Right
+        bar_width_ = config_.width;
+        bar_height_ = output_height_;
+    }
     
-    // Position based on config
     switch (config_.position) {
         case StatusBarConfig::Position::Top:
+        case StatusBarConfig::Position::Left:
             pos_x_ = 0;
             pos_y_ = 0;
             break;
@@ -133,16 +155,33 @@ void StatusBar::CreateSceneNodes() {
             pos_x_ = 0;
             pos_y_ = output_height_ - bar_height_;
             break;
-        case StatusBarConfig::Position::Left:
-            pos_x_ = 0;
-            pos_y_ = 0;
-            break;
         case StatusBarConfig::Position::Right:
             pos_x_ = output_width_ - bar_width_;
             pos_y_ = 0;
             break;
     }
+}
+
+void StatusBar::CreateSceneNodes() {
+    // Get the working area layer from the LayerManager
+    auto* working_layer = layer_manager_->GetLayer(Wayland::Layer::WorkingArea);
+    auto* top_layer = layer_manager_->GetLayer(Wayland::Layer::Top);
     
+    // Parse background color from config
+    // Format: "#RRGGBB"
+    float bg_r = 0.18f, bg_g = 0.2f, bg_b = 0.25f;  // Default Nord color
+    if (config_.background_color.size() == 7 && config_.background_color[0] == '#') {
+        int r, g, b;
+        sscanf(config_.background_color.c_str(), "#%02x%02x%02x", &r, &g, &b);
+        bg_r = r / 255.0f;
+        bg_g = g / 255.0f;
+        bg_b = b / 255.0f;
+    }
+    
+    float bg_color[4] = { bg_r, bg_g, bg_b, 0.95f };  // 95% opacity
+    
+    // Create background rectangle at the position UpdateGeometry picked
+    scene_rect_ = wlr_scene_rect_create(working_layer, bar_width_, bar_height_, bg_color);
     wlr_scene_node_set_position(&scene_rect_->node, pos_x_, pos_y_);
     wlr_scene_node_raise_to_top(&scene_rect_->node);
     
@@ -359,9 +398,11 @@ void StatusBar::CreateWidgets() {
 }
 
 void StatusBar::RenderToBuffer() {
-    // Create SHM buffer if needed (only once)
+    // Create SHM buffer if needed (once per scale)
     if (!shm_buffer_) {
-        shm_buffer_ = ShmBuffer::Create(bar_width_, bar_height_);
+        int pixel_width = static_cast<int>(std::ceil(bar_width_ * scale_));
+        int pixel_height = static_cast<int>(std::ceil(bar_height_ * scale_));
+        shm_buffer_ = ShmBuffer::Create(pixel_width, pixel_height);
         if (!shm_buffer_) {
             Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create SHM buffer for status bar");
             return;
@@ -373,15 +414,17 @@ void StatusBar::RenderToBuffer() {
         cairo_surface_ = cairo_image_surface_create_for_data(
             reinterpret_cast<unsigned char*>(buffer_data_),
             CAIRO_FORMAT_ARGB32,
-            bar_width_,
-            bar_height_,
+            pixel_width,
+            pixel_height,
             shm_buffer_->GetStride()
         );
         
+        // Widgets lay out and draw in logical pixels
         cairo_ = cairo_create(cairo_surface_);
+        cairo_scale(cairo_, scale_, scale_);
         
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Created Cairo surface {}x{} with SHM buffer", 
-                 bar_width_, bar_height_);
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Created Cairo surface {}x{} (scale {}) with SHM buffer",
+                 pixel_width, pixel_height, scale_);
     }
     
     // NOTE: We reuse the same buffer for all renders to avoid memory leaks.
@@ -500,6 +543,7 @@ void StatusBar::UploadToTexture() {
     // - Adds reference to new buffer (same object)
     // Net effect: reference count stays at 1 (held by scene_buffer)
     wlr_scene_buffer_set_buffer(scene_buffer_, wlr_buf);
+    wlr_scene_buffer_set_dest_size(scene_buffer_, bar_width_, bar_height_);
     
     //Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Buffer set on scene (locks={})", wlr_buf->n_locks);
 }
@@ -580,6 +624,24 @@ void StatusBar::CheckDirtyWidgets() {
     }
 }
 
+void StatusBar::SetSuspended(bool suspended) {
+    if (suspended == suspended_) {
+        return;
+    }
+    suspended_ = suspended;
+    
+    if (!dirty_check_timer_) {
+        return;
+    }
+    
+    if (suspended_) {
+        wl_event_source_timer_update(dirty_check_timer_, 0);  // Disarm
+    } else {
+        CheckDirtyWidgets();
+        wl_event_source_timer_update(dirty_check_timer_, 100);
+    }
+}
+
 void StatusBar::SetupDirtyCheckTimer() {
     if (!event_loop_) {
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "No event loop available for dirty check timer");
@@ -605,8 +667,10 @@ int StatusBar::OnDirtyCheckTimer(void* data) {
     // Check if any widgets need re-rendering
     bar->CheckDirtyWidgets();
     
-    // Re-arm the timer for next check
-    wl_event_source_timer_update(bar->dirty_check_timer_, 100);  // 100ms
+    // Re-arm the timer for next check (SetSuspended re-arms it on resume)
+    if (!bar->suspended_) {
+        wl_event_source_timer_update(bar->dirty_check_timer_, 100);  // 100ms
+    }
     
     return 0;  // Return value is ignored
 }
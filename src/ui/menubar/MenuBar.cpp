@@ -1,12 +1,26 @@
 #include "ui/menubar/MenuBar.hpp"
 #include "wayland/LayerManager.hpp"
+#include "wayland/OverlaySurfaceManager.hpp"
 #include "Logger.hpp"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 
 namespace Leviathan {
 namespace UI {
 
+namespace {
+
+// One search pass per frame at most, however fast keys arrive
+constexpr uint64_t SEARCH_FRAME_MS = 16;
+
+uint64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 // MenuItem base implementation
 bool MenuItem::Matches(const std::string& query) const {
     if (query.empty()) return true;
@@ -43,18 +57,12 @@ MenuBar::MenuBar(const MenuBarConfig& config,
     , layer_manager_(layer_manager)
     , event_loop_(event_loop)
     , scene_rect_(nullptr)
-    , scene_buffer_(nullptr)
-    , texture_(nullptr)
-    , renderer_(nullptr)
-    , shm_buffer_(nullptr)
-    , buffer_attached_(false)
+    , overlay_(nullptr)
     , pos_x_(0)
     , pos_y_(0)
     , output_width_(output_width)
     , output_height_(output_height)
-    , cairo_surface_(nullptr)
     , cairo_(nullptr)
-    , buffer_data_(nullptr)
     , is_visible_(false)
     , selected_index_(0)
     , scroll_offset_(0)
@@ -64,8 +72,15 @@ MenuBar::MenuBar(const MenuBarConfig& config,
     bar_width_ = output_width_;
     bar_height_ = config_.height + (config_.item_height * config_.max_visible_items);
     
-    // Create IconLoader
-    icon_loader_ = std::make_unique<IconLoader>();
+    // Create IconLoader (decodes off the main thread, repaint when icons arrive)
+    icon_loader_ = std::make_unique<IconLoader>(event_loop_);
+    icon_loader_->SetOnIconReady([this]() {
+        Render();
+    });
+    
+    if (event_loop_) {
+        search_timer_ = wl_event_loop_add_timer(event_loop_, OnSearchTimer, this);
+    }
     
     // Create TextField for search
     search_field_ = std::make_shared<TextField>("Type to search...", TextField::Variant::Standard);
@@ -80,8 +95,7 @@ MenuBar::MenuBar(const MenuBarConfig& config,
     // Set up callbacks
     search_field_->SetOnTextChanged([this](const std::string& text) {
         search_query_ = text;
-        UpdateFilteredItems();
-        Render();
+        ScheduleSearch();
     });
     
     search_field_->SetOnSubmit([this](const std::string&) {
@@ -120,38 +134,21 @@ MenuBar::MenuBar(const MenuBarConfig& config,
         }
     });
     
-    // Create buffer
-    shm_buffer_ = ShmBuffer::Create(bar_width_, bar_height_);
-    if (!shm_buffer_) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create ShmBuffer for menubar");
-        return;
-    }
-    buffer_data_ = reinterpret_cast<uint32_t*>(shm_buffer_->GetData());
-    
-    // Create cairo surface
-    cairo_surface_ = cairo_image_surface_create_for_data(
-        reinterpret_cast<unsigned char*>(buffer_data_),
-        CAIRO_FORMAT_ARGB32,
-        bar_width_,
-        bar_height_,
-        cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, bar_width_)
-    );
-    cairo_ = cairo_create(cairo_surface_);
-    
+    // The content buffer is borrowed from the output's overlay pool while shown
     CreateSceneNodes();
     
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "MenuBar created: {}x{}", bar_width_, bar_height_);
 }
 
 MenuBar::~MenuBar() {
-    if (cairo_) cairo_destroy(cairo_);
-    if (cairo_surface_) cairo_surface_destroy(cairo_surface_);
-    if (texture_) wlr_texture_destroy(texture_);
-    
-    // Clean up SHM buffer (drop reference)
-    if (shm_buffer_) {
-        wlr_buffer_drop(shm_buffer_->GetWlrBuffer());
-        shm_buffer_ = nullptr;
+    if (search_timer_) {
+        wl_event_source_remove(search_timer_);
+        search_timer_ = nullptr;
+    }
+    
+    // Hand the content buffer back to the pool
+    if (overlay_) {
+        overlay_->Hide();
     }
     
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "MenuBar destroyed");
@@ -172,13 +169,8 @@ void MenuBar::CreateSceneNodes() {
     wlr_scene_node_set_position(&scene_rect_->node, pos_x_, pos_y_);
     wlr_scene_node_set_enabled(&scene_rect_->node, false);
     
-    // Create scene buffer for content (hidden initially)
-    scene_buffer_ = wlr_scene_buffer_create(top_layer, nullptr);
-    wlr_scene_node_set_position(&scene_buffer_->node, pos_x_, pos_y_);
-    wlr_scene_node_set_enabled(&scene_buffer_->node, false);
-    
-    // Renderer will be retrieved on first render (lazy initialization)
-    renderer_ = nullptr;
+    // Content overlay (hidden until the first frame is presented)
+    overlay_ = layer_manager_->GetOverlays()->GetSurface("launcher");
 }
 
 void MenuBar::Show() {
@@ -195,9 +187,8 @@ void MenuBar::Show() {
     RefreshItems();
     UpdateFilteredItems();
     
-    // Enable scene nodes
+    // Enable background; the content overlay is shown by the first Render()
     wlr_scene_node_set_enabled(&scene_rect_->node, true);
-    wlr_scene_node_set_enabled(&scene_buffer_->node, true);
     
     Render();
     
@@ -210,9 +201,9 @@ void MenuBar::Hide() {
     is_visible_ = false;
     search_field_->Blur();  // Blur the text field
     
-    // Disable scene nodes
+    // Disable scene nodes and return the content buffer to the pool
     wlr_scene_node_set_enabled(&scene_rect_->node, false);
-    wlr_scene_node_set_enabled(&scene_buffer_->node, false);
+    overlay_->Hide();
     
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "MenuBar hidden");
 }
@@ -278,12 +269,14 @@ void MenuBar::ClearProviders() {
     providers_.clear();
     all_items_.clear();
     filtered_items_.clear();
+    filtered_valid_ = false;
     tab_bar_->ClearTabs();
     active_provider_index_ = 0;
 }
 
 void MenuBar::RefreshItems() {
     all_items_.clear();
+    filtered_valid_ = false;
     
     // If we have multiple providers, only load from the active one
     // If we have one or no providers, load all
@@ -323,13 +316,58 @@ void MenuBar::RefreshItems() {
                  providers_.size() > 1 ? 1 : providers_.size());
 }
 
+void MenuBar::ScheduleSearch() {
+    if (!search_timer_) {
+        RunSearch();
+        return;
+    }
+    if (search_pending_) {
+        return;
+    }
+    search_pending_ = true;
+    
+    // Keystrokes that arrive before the timer fires share one filter + render pass
+    uint64_t elapsed = NowMs() - last_search_ms_;
+    uint64_t delay = elapsed >= SEARCH_FRAME_MS ? 1 : SEARCH_FRAME_MS - elapsed;  // 0 would disarm the timer
+    wl_event_source_timer_update(search_timer_, static_cast<int>(delay));
+}
+
+int MenuBar::OnSearchTimer(void* data) {
+    auto* menubar = static_cast<MenuBar*>(data);
+    menubar->RunSearch();
+    return 0;
+}
+
+void MenuBar::RunSearch() {
+    search_pending_ = false;
+    last_search_ms_ = NowMs();
+    
+    if (!is_visible_) return;
+    
+    UpdateFilteredItems();
+    Render();
+}
+
 void MenuBar::UpdateFilteredItems() {
+    size_t min_chars = static_cast<size_t>(config_.min_chars_for_search);
+    
+    // Typing more characters can only narrow the result, so filter the previous
+    // matches instead of every item
+    bool narrowing = filtered_valid_ &&
+                     filtered_query_.size() >= min_chars &&
+                     search_query_.compare(0, filtered_query_.size(), filtered_query_) == 0;
+    std::vector<std::shared_ptr<MenuItem>> previous;
+    if (narrowing) {
+        previous.swap(filtered_items_);
+    }
+    const auto& candidates = narrowing ? previous : all_items_;
+    
     filtered_items_.clear();
     
-    if (search_query_.size() < static_cast<size_t>(config_.min_chars_for_search)) {
+    if (search_query_.size() < min_chars) {
         filtered_items_ = all_items_;
     } else {
-        for (const auto& item : all_items_) {
+        for (const auto& item : candidates) {
             if (config_.fuzzy_matching) {
                 if (FuzzyMatch(item->GetDisplayName(), search_query_)) {
                     filtered_items_.push_back(item);
@@ -342,6 +380,9 @@ void MenuBar::UpdateFilteredItems() {
         }
     }
     
+    filtered_query_ = search_query_;
+    filtered_valid_ = true;
+    
     // Reset selection
     selected_index_ = 0;
     scroll_offset_ = 0;
@@ -517,8 +558,16 @@ bool MenuBar::HandleHover(int x, int y) {
 void MenuBar::Render() {
     if (!is_visible_) return;
     
+    cairo_ = overlay_->BeginFrame(bar_width_, bar_height_);
+    if (!cairo_) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to get overlay buffer for menubar");
+        return;
+    }
+    
     RenderToBuffer();
-    UploadToTexture();
+    
+    overlay_->EndFrame(pos_x_, pos_y_);
+    cairo_ = nullptr;
 }
 
 void MenuBar::RenderToBuffer() {
@@ -557,15 +606,11 @@ void MenuBar::RenderToBuffer() {
             cairo_fill(cairo_);
         }
         
-        // Draw icon if available
+        // Draw icon if available (painted straight from the shared icon atlas)
         std::string icon_path = item->GetIconPath();
         if (!icon_path.empty() && icon_loader_) {
-            cairo_surface_t* icon_surface = icon_loader_->LoadIcon(icon_path, icon_size);
-            if (icon_surface) {
-                int icon_y = item_y + (config_.item_height - icon_size) / 2;
-                cairo_set_source_surface(cairo_, icon_surface, config_.padding, icon_y);
-                cairo_paint(cairo_);
-            }
+            int icon_y = item_y + (config_.item_height - icon_size) / 2;
+            icon_loader_->DrawIcon(cairo_, icon_path, icon_size, config_.padding, icon_y);
         }
         
         // Item name
@@ -601,38 +646,6 @@ void MenuBar::RenderToBuffer() {
         int tab_y = bar_height_ - config_.tab_height;
         tab_bar_->Render(cairo_, 0, tab_y, bar_width_);
     }
-    
-    cairo_surface_flush(cairo_surface_);
-}
-
-void MenuBar::UploadToTexture() {
-    // Get renderer from output on first upload (lazy initialization)
-    if (!renderer_) {
-        struct wlr_output* output = layer_manager_->GetOutput();
-        if (output && output->renderer) {
-            renderer_ = output->renderer;
-            Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Got renderer from output for menubar");
-        } else {
-            Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Cannot get renderer from output for menubar");
-            return;
-        }
-    }
-    
-    // Get wlr_buffer from ShmBuffer
-    struct wlr_buffer* wlr_buf = shm_buffer_->GetWlrBuffer();
-    if (!wlr_buf) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to get wlr_buffer from ShmBuffer for menubar");
-        return;
-    }
-    
-    // Set buffer on scene (using same approach as StatusBar)
-    if (!buffer_attached_) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Attaching menubar SHM buffer to scene_buffer (first time)");
-        buffer_attached_ = true;
-    }
-    
-    // Call set_buffer to tell wlroots the content changed
-    wlr_scene_buffer_set_buffer(scene_buffer_, wlr_buf);
 }
 
 void MenuBar::HandleKeyPress(uint32_t key, uint32_t modifiers) {
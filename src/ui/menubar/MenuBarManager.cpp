@@ -300,6 +300,26 @@ void MenuBarManager::RefreshAllItems() {
     }
 }
 
+std::map<int, IconAtlas::Stats> MenuBarManager::GetIconAtlasStats() const {
+    std::map<int, IconAtlas::Stats> totals;
+    for (const auto& [output, data] : menubars_) {
+        const IconLoader* loader = data.menubar->GetIconLoader();
+        if (!loader) {
+            continue;
+        }
+        for (const auto& [size, stats] : loader->GetAtlasStats()) {
+            auto& total = totals[size];
+            total.pages += stats.pages;
+            total.page_bytes += stats.page_bytes;
+            total.icons += stats.icons;
+            total.icon_bytes += stats.icon_bytes;
+            total.shelf_bytes += stats.shelf_bytes;
+            total.compactions += stats.compactions;
+        }
+    }
+    return totals;
+}
+
 void MenuBarManager::Shutdown() {
     menubars_.clear();
     providers_.clear();
@@ -1,5 +1,6 @@
 #include "ui/menubar/providers/AppsProvider.hpp"
 #include "Logger.hpp"
+#include "core/SpawnHelper.hpp"
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
@@ -36,29 +37,14 @@ std::vector<std::string> DesktopAppMenuItem::GetSearchKeywords() const {
 }
 
 void DesktopAppMenuItem::Execute() {
-    // Remove field codes like %f, %F, %u, %U from exec
-    std::string cleaned_exec = exec_;
-    size_t pos = 0;
-    while ((pos = cleaned_exec.find('%', pos)) != std::string::npos) {
-        if (pos + 1 < cleaned_exec.length()) {
-            cleaned_exec.erase(pos, 2);
-        } else {
-            break;
-        }
+    // Exec= is already an argument vector; no shell in between
+    std::vector<std::string> argv;
+    if (!Core::ParseDesktopExec(exec_, argv, name_, icon_)) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Invalid Exec= for application: {}", name_);
+        return;
     }
     
-    // Fork and execute
-    pid_t pid = fork();
-    if (pid == 0) {
-        // Child process
-        setsid();  // Create new session
-        execl("/bin/sh", "sh", "-c", cleaned_exec.c_str(), nullptr);
-        exit(1);  // If execl fails
-    } else if (pid < 0) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to fork process for: {}", name_);
-    } else {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Launched application: {} (PID: {})", name_, pid);
-    }
+    Core::SpawnHelper::Instance().Spawn(argv, name_);
 }
 
 // ============================================================================
@@ -1,7 +1,6 @@
 #include "ui/menubar/providers/BookmarksProvider.hpp"
 #include "Logger.hpp"
-#include <cstdlib>
-#include <unistd.h>
+#include "core/SpawnHelper.hpp"
 
 namespace Leviathan {
 namespace UI {
@@ -26,33 +25,9 @@ std::vector<std::string> BookmarkMenuItem::GetSearchKeywords() const {
 }
 
 void BookmarkMenuItem::Execute() {
-    std::string command;
-    
-    switch (type_) {
-        case BookmarkType::Directory:
-            // Open file manager in directory
-            command = "xdg-open \"" + target_ + "\"";
-            break;
-        case BookmarkType::File:
-            // Open file with default application
-            command = "xdg-open \"" + target_ + "\"";
-            break;
-        case BookmarkType::URL:
-            // Open URL in browser
-            command = "xdg-open \"" + target_ + "\"";
-            break;
-    }
-    
-    pid_t pid = fork();
-    if (pid == 0) {
-        setsid();
-        execl("/bin/sh", "sh", "-c", command.c_str(), nullptr);
-        exit(1);
-    } else if (pid < 0) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to open bookmark: {}", name_);
-    } else {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Opened bookmark: {}", name_);
-    }
+    // Directories open in the file manager, files and URLs in their default
+    // application; xdg-open picks either from the target
+    Core::SpawnHelper::Instance().Spawn({"xdg-open", target_}, name_);
 }
 
 // ============================================================================
@@ -1,7 +1,6 @@
 #include "ui/menubar/providers/CommandsProvider.hpp"
 #include "Logger.hpp"
-#include <cstdlib>
-#include <unistd.h>
+#include "core/SpawnHelper.hpp"
 
 namespace Leviathan {
 namespace UI {
@@ -44,16 +43,7 @@ void CustomCommandMenuItem::Execute() {
             func_();
         }
     } else {
-        pid_t pid = fork();
-        if (pid == 0) {
-            setsid();
-            execl("/bin/sh", "sh", "-c", command_.c_str(), nullptr);
-            exit(1);
-        } else if (pid < 0) {
-            Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to fork process for command: {}", name_);
-        } else {
-            Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Executed command: {} (PID: {})", name_, pid);
-        }
+        Core::SpawnHelper::Instance().SpawnCommand(command_, name_);
     }
 }
 
@@ -196,6 +196,16 @@ bool Modal::IsPointInContent(int x, int y) const {
            y >= content_y && y < content_y + content_height_;
 }
 
+void Modal::GetContentBounds(int& x, int& y, int& width, int& height) const {
+    // The border stroke is centered on the edge, so half of it lies outside;
+    // round up to whole pixels for antialiasing
+    int outset = (border_width_ + 1) / 2 + 1;
+    x = (screen_width_ - content_width_) / 2 - outset;
+    y = (screen_height_ - content_height_) / 2 - outset;
+    width = content_width_ + outset * 2;
+    height = content_height_ + outset * 2;
+}
+
 void Modal::DrawRoundedRectangle(cairo_t* cr, double x, double y,
                                 double width, double height, double radius) {
     double degrees = M_PI / 180.0;
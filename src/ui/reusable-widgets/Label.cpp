@@ -7,9 +7,9 @@ namespace UI {
 
 void Label::CalculateSize(int available_width, int available_height) {
     
-    // Create a temporary cairo surface to measure text
-    cairo_surface_t* temp_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-    cairo_t* temp_cr = cairo_create(temp_surface);
+    // Measure on the shared context instead of a fresh surface per call
+    cairo_t* temp_cr = GetMeasureContext();
+    cairo_save(temp_cr);
     
     cairo_select_font_face(temp_cr, font_family_.c_str(), 
                           CAIRO_FONT_SLANT_NORMAL, 
@@ -31,8 +31,7 @@ void Label::CalculateSize(int available_width, int available_height) {
     width_ = std::min(width_, available_width);
     height_ = std::min(height_, available_height);
     
-    cairo_destroy(temp_cr);
-    cairo_surface_destroy(temp_surface);
+    cairo_restore(temp_cr);
 }
 
 void Label::Render(cairo_t* cr) {
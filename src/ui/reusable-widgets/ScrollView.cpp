@@ -1,16 +1,55 @@
 #include "ui/reusable-widgets/ScrollView.hpp"
+#include "ui/reusable-widgets/Container.hpp"
 #include "Logger.hpp"
 #include <algorithm>
 #include <cmath>  // For M_PI
+#include <cstdlib>
 
 namespace Leviathan {
 namespace UI {
 
-ScrollView::ScrollView() 
+namespace {
+
+// Rows are usually small containers (HBox of Labels). A Label::SetText only
+// dirties the label itself, so look at the whole row subtree.
+bool IsSubtreeDirty(Widget* widget) {
+    if (widget->IsDirty()) return true;
+    if (auto* container = dynamic_cast<Container*>(widget)) {
+        for (auto& child : container->GetChildren()) {
+            if (IsSubtreeDirty(child.get())) return true;
+        }
+    }
+    return false;
+}
+
+void ClearSubtreeDirty(Widget* widget) {
+    widget->ClearDirty();
+    if (auto* container = dynamic_cast<Container*>(widget)) {
+        for (auto& child : container->GetChildren()) {
+            ClearSubtreeDirty(child.get());
+        }
+    }
+}
+
+} // anonymous namespace
+
+ScrollView::ScrollView()
     : Widget() {
 }
 
+ScrollView::~ScrollView() {
+    DestroyViewportSurfaces();
+}
+
 void ScrollView::SetChild(std::shared_ptr<Widget> child) {
+    // Leaving virtualized mode (if we were in it)
+    active_rows_.clear();
+    recycle_pool_.clear();
+    item_builder_ = nullptr;
+    item_type_fn_ = nullptr;
+    item_count_ = 0;
+    DestroyViewportSurfaces();
+    
     child_ = child;
     if (child_) {
         child_->SetParent(nullptr);  // ScrollView is not a Container
@@ -18,31 +57,125 @@ void ScrollView::SetChild(std::shared_ptr<Widget> child) {
     // RecalculateSize will be called when SetSize is called
 }
 
+void ScrollView::SetItemBuilder(size_t item_count, ItemBuilder builder, ItemTypeFn type_fn) {
+    child_ = nullptr;
+    active_rows_.clear();
+    recycle_pool_.clear();  // Pooled rows belong to the old builder
+    
+    item_builder_ = std::move(builder);
+    item_type_fn_ = std::move(type_fn);
+    item_count_ = item_count;
+    scroll_offset_ = 0;
+    viewport_valid_ = false;
+    
+    ResetItemHeights();
+    UpdateVisibleRows();
+}
+
+void ScrollView::SetFixedItemHeight(int height) {
+    fixed_item_height_ = std::max(0, height);
+    ResetItemHeights();
+    RecycleAllRows();
+    UpdateVisibleRows();
+}
+
+void ScrollView::SetEstimatedItemHeight(int height) {
+    fixed_item_height_ = 0;
+    estimated_item_height_ = std::max(1, height);
+    ResetItemHeights();
+    RecycleAllRows();
+    UpdateVisibleRows();
+}
+
+void ScrollView::SetItemSpacing(int spacing) {
+    item_spacing_ = std::max(0, spacing);
+    RebuildOffsets();
+    viewport_valid_ = false;
+    UpdateVisibleRows();
+}
+
+void ScrollView::NotifyItemsChanged(size_t item_count) {
+    item_count_ = item_count;
+    ResetItemHeights();
+    
+    // Hand every bound row back to the builder - indices may now point at
+    // different items
+    RecycleAllRows();
+    ClampScrollOffset();
+    UpdateVisibleRows();
+}
+
+void ScrollView::NotifyItemChanged(size_t index) {
+    if (!item_builder_ || index >= item_count_) return;
+    
+    for (auto& row : active_rows_) {
+        if (row.index != index) continue;
+        
+        auto widget = item_builder_(index, row.widget);
+        if (widget) {
+            row.widget = widget;
+            row.widget->SetParent(nullptr);
+            if (MeasureRow(row)) {
+                RebuildOffsets();
+            }
+        }
+        viewport_valid_ = false;
+        UpdateVisibleRows();
+        return;
+    }
+    
+    // Not on screen: only the cached height is stale
+    if (fixed_item_height_ == 0 && item_heights_[index] != estimated_item_height_) {
+        item_heights_[index] = estimated_item_height_;
+        RebuildOffsets();
+    }
+}
+
 void ScrollView::ScrollBy(int delta_y) {
     scroll_offset_ += delta_y;
     ClampScrollOffset();
+    UpdateVisibleRows();
 }
 
 void ScrollView::ScrollTo(int y) {
     scroll_offset_ = y;
     ClampScrollOffset();
+    UpdateVisibleRows();
 }
 
 void ScrollView::ScrollToTop() {
     scroll_offset_ = 0;
+    UpdateVisibleRows();
 }
 
 void ScrollView::ScrollToBottom() {
     scroll_offset_ = GetMaxScrollOffset();
+    UpdateVisibleRows();
 }
 
-int ScrollView::GetMaxScrollOffset() const {
-    if (!child_) return 0;
+void ScrollView::ScrollToItem(size_t index) {
+    if (!item_builder_ || index >= item_count_) return;
     
-    int child_height = child_->GetHeight();
-    int viewport_height = height_;
+    int item_top = GetItemOffset(index);
+    int item_bottom = item_top + GetItemHeight(index);
     
-    return std::max(0, child_height - viewport_height);
+    if (item_top < scroll_offset_) {
+        ScrollTo(item_top);
+    } else if (item_bottom > scroll_offset_ + height_) {
+        ScrollTo(item_bottom - height_);
+    }
+}
+
+int ScrollView::GetContentHeight() const {
+    if (item_builder_) {
+        if (item_count_ == 0) return 0;
+        return GetItemOffset(item_count_ - 1) + GetItemHeight(item_count_ - 1);
+    }
+    return child_ ? child_->GetHeight() : 0;
+}
+
+int ScrollView::GetMaxScrollOffset() const {
+    return std::max(0, GetContentHeight() - height_);
 }
 
 bool ScrollView::CanScrollUp() const {
@@ -58,8 +191,198 @@ void ScrollView::ClampScrollOffset() {
     scroll_offset_ = std::clamp(scroll_offset_, 0, max_offset);
 }
 
+void ScrollView::MarkNeedsPaint() {
+    Widget::MarkNeedsPaint();
+    viewport_valid_ = false;
+    
+    if (child_) {
+        child_->MarkNeedsPaint();
+    }
+}
+
+// ============================================================================
+// Virtualized list: item geometry
+// ============================================================================
+
+void ScrollView::ResetItemHeights() {
+    if (fixed_item_height_ > 0) {
+        // Fixed rows are pure arithmetic - no per-item storage at all
+        item_heights_.clear();
+        item_offsets_.clear();
+    } else {
+        item_heights_.assign(item_count_, estimated_item_height_);
+        RebuildOffsets();
+    }
+    viewport_valid_ = false;
+}
+
+void ScrollView::RebuildOffsets() {
+    if (fixed_item_height_ > 0) return;
+    
+    item_offsets_.resize(item_count_ + 1);
+    item_offsets_[0] = 0;
+    for (size_t i = 0; i < item_count_; i++) {
+        item_offsets_[i + 1] = item_offsets_[i] + item_heights_[i] + item_spacing_;
+    }
+}
+
+int ScrollView::GetItemOffset(size_t index) const {
+    if (fixed_item_height_ > 0) {
+        return static_cast<int>(index) * (fixed_item_height_ + item_spacing_);
+    }
+    return item_offsets_[index];
+}
+
+int ScrollView::GetItemHeight(size_t index) const {
+    if (fixed_item_height_ > 0) {
+        return fixed_item_height_;
+    }
+    return item_heights_[index];
+}
+
+size_t ScrollView::FindItemAt(int content_y) const {
+    if (item_count_ == 0) return 0;
+    
+    size_t index;
+    if (fixed_item_height_ > 0) {
+        index = static_cast<size_t>(std::max(0, content_y) / (fixed_item_height_ + item_spacing_));
+    } else {
+        // item_offsets_ is sorted - find the last item starting at or above content_y
+        auto it = std::upper_bound(item_offsets_.begin(), item_offsets_.end() - 1, content_y);
+        index = it == item_offsets_.begin() ? 0 : static_cast<size_t>(it - item_offsets_.begin()) - 1;
+    }
+    return std::min(index, item_count_ - 1);
+}
+
+// ============================================================================
+// Virtualized list: row binding and recycling
+// ============================================================================
+
+bool ScrollView::MeasureRow(ActiveRow& row) {
+    int available_height = fixed_item_height_ > 0 ? fixed_item_height_ : std::max(height_, estimated_item_height_);
+    row.widget->CalculateSize(row_layout_width_, available_height);
+    
+    if (fixed_item_height_ > 0) return false;
+    
+    int measured = row.widget->GetHeight();
+    if (measured == item_heights_[row.index]) return false;
+    item_heights_[row.index] = measured;
+    return true;
+}
+
+void ScrollView::RecycleAllRows() {
+    for (auto& row : active_rows_) {
+        recycle_pool_[row.type].push_back(row.widget);
+    }
+    active_rows_.clear();
+    viewport_valid_ = false;
+}
+
+void ScrollView::UpdateVisibleRows() {
+    if (!item_builder_ || height_ <= 0) return;
+    
+    if (row_layout_width_ < 0) {
+        row_layout_width_ = width_;
+    }
+    
+    // Measuring freshly built rows can change offsets (estimated heights),
+    // which can change which rows are visible - settle in a few passes
+    for (int pass = 0; pass < 3; pass++) {
+        ClampScrollOffset();
+        
+        std::vector<ActiveRow> rows;
+        bool heights_changed = false;
+        
+        if (item_count_ > 0) {
+            size_t first = FindItemAt(scroll_offset_);
+            size_t last = FindItemAt(scroll_offset_ + height_ - 1);
+            rows.reserve(last - first + 1);
+            
+            // Rows that scrolled out go back to the pool first so they can be
+            // reused for the rows scrolling in
+            std::vector<ActiveRow> kept;
+            kept.reserve(active_rows_.size());
+            for (auto& row : active_rows_) {
+                if (row.index < first || row.index > last) {
+                    recycle_pool_[row.type].push_back(std::move(row.widget));
+                } else {
+                    kept.push_back(std::move(row));
+                }
+            }
+            
+            auto kept_it = kept.begin();
+            for (size_t i = first; i <= last; i++) {
+                if (kept_it != kept.end() && kept_it->index == i) {
+                    rows.push_back(std::move(*kept_it));
+                    ++kept_it;
+                    continue;
+                }
+                
+                int type = item_type_fn_ ? item_type_fn_(i) : 0;
+                std::shared_ptr<Widget> recycled;
+                auto& pool = recycle_pool_[type];
+                if (!pool.empty()) {
+                    recycled = std::move(pool.back());
+                    pool.pop_back();
+                }
+                
+                auto widget = item_builder_(i, recycled);
+                if (!widget) continue;
+                if (recycled && widget != recycled) {
+                    pool.push_back(std::move(recycled));
+                }
+                widget->SetParent(nullptr);  // ScrollView is not a Container
+                
+                ActiveRow row{i, type, widget};
+                heights_changed |= MeasureRow(row);
+                
+                // Newly bound rows always land in the exposed strip, which is
+                // painted anyway - don't let binding force a full repaint
+                ClearSubtreeDirty(row.widget.get());
+                rows.push_back(std::move(row));
+            }
+        } else {
+            RecycleAllRows();
+        }
+        
+        active_rows_ = std::move(rows);
+        
+        if (!heights_changed) break;
+        RebuildOffsets();
+        viewport_valid_ = false;
+    }
+    
+    // Rows live in viewport-local coordinates
+    for (auto& row : active_rows_) {
+        row.widget->SetPosition(0, GetItemOffset(row.index) - scroll_offset_);
+    }
+}
+
+ScrollView::ActiveRow* ScrollView::FindRowAtViewportY(int local_y) {
+    int content_y = local_y + scroll_offset_;
+    for (auto& row : active_rows_) {
+        int top = GetItemOffset(row.index);
+        if (content_y >= top && content_y < top + GetItemHeight(row.index)) {
+            return &row;
+        }
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
 void ScrollView::Render(cairo_t* cr) {
-    if (!IsVisible() || !child_) return;
+    if (!IsVisible()) return;
+    
+    if (item_builder_) {
+        RenderVirtualized(cr);
+        DrawScrollbar(cr);
+        return;
+    }
+    
+    if (!child_) return;
     
     // Save cairo state
     cairo_save(cr);
@@ -77,13 +400,111 @@ void ScrollView::Render(cairo_t* cr) {
     // Restore cairo state
     cairo_restore(cr);
     
+    DrawScrollbar(cr);
+}
+
+void ScrollView::EnsureViewportSurfaces() {
+    if (viewport_front_ &&
+        cairo_image_surface_get_width(viewport_front_) == width_ &&
+        cairo_image_surface_get_height(viewport_front_) == height_) {
+        return;
+    }
+    
+    DestroyViewportSurfaces();
+    viewport_front_ = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width_, height_);
+    viewport_back_ = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width_, height_);
+    viewport_valid_ = false;
+}
+
+void ScrollView::DestroyViewportSurfaces() {
+    if (viewport_front_) cairo_surface_destroy(viewport_front_);
+    if (viewport_back_) cairo_surface_destroy(viewport_back_);
+    viewport_front_ = nullptr;
+    viewport_back_ = nullptr;
+    viewport_valid_ = false;
+}
+
+void ScrollView::PaintRows(cairo_t* cr, int top, int bottom) {
+    cairo_save(cr);
+    cairo_rectangle(cr, 0, top, width_, bottom - top);
+    cairo_clip(cr);
+    
+    for (auto& row : active_rows_) {
+        int row_top = row.widget->GetY();
+        int row_bottom = row_top + GetItemHeight(row.index);
+        if (row_bottom <= top || row_top >= bottom) continue;
+        if (row.widget->IsVisible()) {
+            row.widget->Render(cr);
+        }
+    }
+    
+    cairo_restore(cr);
+}
+
+void ScrollView::RenderVirtualized(cairo_t* cr) {
+    if (width_ <= 0 || height_ <= 0) return;
+    
+    UpdateVisibleRows();
+    EnsureViewportSurfaces();
+    
+    for (auto& row : active_rows_) {
+        if (IsSubtreeDirty(row.widget.get())) {
+            viewport_valid_ = false;
+            break;
+        }
+    }
+    
+    int delta = scroll_offset_ - viewport_scroll_offset_;
+    
+    if (!viewport_valid_ || std::abs(delta) >= height_) {
+        // Full repaint of the viewport
+        cairo_t* vcr = cairo_create(viewport_front_);
+        cairo_set_operator(vcr, CAIRO_OPERATOR_CLEAR);
+        cairo_paint(vcr);
+        cairo_set_operator(vcr, CAIRO_OPERATOR_OVER);
+        PaintRows(vcr, 0, height_);
+        cairo_destroy(vcr);
+    } else if (delta != 0) {
+        // Scroll: shift the retained pixels and paint only the exposed strip.
+        // SOURCE leaves the area the old frame doesn't cover transparent.
+        cairo_t* vcr = cairo_create(viewport_back_);
+        cairo_set_operator(vcr, CAIRO_OPERATOR_SOURCE);
+        cairo_set_source_surface(vcr, viewport_front_, 0, -delta);
+        cairo_paint(vcr);
+        cairo_set_operator(vcr, CAIRO_OPERATOR_OVER);
+        
+        int strip_top = delta > 0 ? height_ - delta : 0;
+        int strip_bottom = delta > 0 ? height_ : -delta;
+        PaintRows(vcr, strip_top, strip_bottom);
+        cairo_destroy(vcr);
+        
+        std::swap(viewport_front_, viewport_back_);
+    }
+    
+    cairo_surface_flush(viewport_front_);
+    viewport_valid_ = true;
+    viewport_scroll_offset_ = scroll_offset_;
+    
+    for (auto& row : active_rows_) {
+        ClearSubtreeDirty(row.widget.get());
+    }
+    
+    // Blit the retained viewport
+    cairo_save(cr);
+    cairo_set_source_surface(cr, viewport_front_, x_, y_);
+    cairo_rectangle(cr, x_, y_, width_, height_);
+    cairo_fill(cr);
+    cairo_restore(cr);
+}
+
+void ScrollView::DrawScrollbar(cairo_t* cr) {
     // Draw scrollbar if enabled and content is scrollable
     if (show_scrollbar_ && GetMaxScrollOffset() > 0) {
         int max_offset = GetMaxScrollOffset();
-        int child_height = child_->GetHeight();
+        int content_height = GetContentHeight();
         
         // Calculate scrollbar dimensions
-        float viewport_ratio = static_cast<float>(height_) / child_height;
+        float viewport_ratio = static_cast<float>(height_) / content_height;
         int scrollbar_height = std::max(20, static_cast<int>(height_ * viewport_ratio));
         
         // Calculate scrollbar position
@@ -93,19 +514,19 @@ void ScrollView::Render(cairo_t* cr) {
         int scrollbar_x = x_ + width_ - scrollbar_width_;
         
         // Draw scrollbar track (lighter)
-        cairo_set_source_rgba(cr, 
-            scrollbar_color_[0] * 0.3, 
-            scrollbar_color_[1] * 0.3, 
-            scrollbar_color_[2] * 0.3, 
+        cairo_set_source_rgba(cr,
+            scrollbar_color_[0] * 0.3,
+            scrollbar_color_[1] * 0.3,
+            scrollbar_color_[2] * 0.3,
             scrollbar_color_[3] * 0.5);
         cairo_rectangle(cr, scrollbar_x, y_, scrollbar_width_, height_);
         cairo_fill(cr);
         
         // Draw scrollbar thumb
-        cairo_set_source_rgba(cr, 
-            scrollbar_color_[0], 
-            scrollbar_color_[1], 
-            scrollbar_color_[2], 
+        cairo_set_source_rgba(cr,
+            scrollbar_color_[0],
+            scrollbar_color_[1],
+            scrollbar_color_[2],
             scrollbar_color_[3]);
         
         // Rounded rectangle for scrollbar
@@ -125,6 +546,21 @@ void ScrollView::CalculateSize(int available_width, int available_height) {
     width_ = available_width;
     height_ = available_height;
     
+    if (item_builder_) {
+        // Virtualized: only the rows in the viewport are measured
+        if (row_layout_width_ != available_width) {
+            row_layout_width_ = available_width;
+            bool heights_changed = false;
+            for (auto& row : active_rows_) {
+                heights_changed |= MeasureRow(row);
+            }
+            if (heights_changed) RebuildOffsets();
+            viewport_valid_ = false;
+        }
+        UpdateVisibleRows();
+        return;
+    }
+    
     if (child_) {
         // Let child calculate its natural size (it can be taller than viewport)
         child_->CalculateSize(available_width, available_height * 2);  // Give it more space
@@ -135,21 +571,49 @@ void ScrollView::CalculateSize(int available_width, int available_height) {
 }
 
 bool ScrollView::HandleClick(int x, int y) {
-    if (!IsVisible() || !child_) return false;
+    if (!IsVisible()) return false;
+    if (!child_ && !item_builder_) return false;
     
     // Check if click is within our bounds
     if (x < x_ || x >= x_ + width_ || y < y_ || y >= y_ + height_) {
         return false;
     }
     
+    if (item_builder_) {
+        // Rows are positioned in viewport-local coordinates
+        int local_x = x - x_;
+        int local_y = y - y_;
+        ActiveRow* row = FindRowAtViewportY(local_y);
+        return row && row->widget->HandleClick(local_x, local_y);
+    }
+    
     // Adjust coordinates for scroll offset
     int child_y = y + scroll_offset_;
     
     return child_->HandleClick(x, child_y);
 }
 
+bool ScrollView::HandleHover(int x, int y) {
+    if (!IsVisible()) return false;
+    if (!child_ && !item_builder_) return false;
+    
+    if (x < x_ || x >= x_ + width_ || y < y_ || y >= y_ + height_) {
+        return false;
+    }
+    
+    if (item_builder_) {
+        int local_x = x - x_;
+        int local_y = y - y_;
+        ActiveRow* row = FindRowAtViewportY(local_y);
+        return row && row->widget->HandleHover(local_x, local_y);
+    }
+    
+    return child_->HandleHover(x, y + scroll_offset_);
+}
+
 bool ScrollView::HandleScroll(int x, int y, double delta_x, double delta_y) {
-    if (!IsVisible() || !child_) return false;
+    if (!IsVisible()) return false;
+    if (!child_ && !item_builder_) return false;
     
     // Check if scroll is within our bounds
     if (x < x_ || x >= x_ + width_ || y < y_ || y >= y_ + height_) {
@@ -1,4 +1,5 @@
 #include "ui/reusable-widgets/TabBar.hpp"
+#include "ui/BaseWidget.hpp"
 #include "Logger.hpp"
 #include <algorithm>
 #include <cmath>
@@ -327,9 +328,8 @@ void TabBar::Render(cairo_t* cr, int x, int y, int width) {
 int TabBar::GetPreferredWidth() const {
     if (tabs_.empty()) return 0;
     
-    // Create a temporary cairo surface to measure text
-    cairo_surface_t* temp_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-    cairo_t* temp_cr = cairo_create(temp_surface);
+    cairo_t* temp_cr = Widget::GetMeasureContext();
+    cairo_save(temp_cr);
     
     cairo_select_font_face(temp_cr, config_.font_family.c_str(),
                           CAIRO_FONT_SLANT_NORMAL,
@@ -346,8 +346,7 @@ int TabBar::GetPreferredWidth() const {
         total_width += (tabs_.size() - 1) * config_.separator_width;
     }
     
-    cairo_destroy(temp_cr);
-    cairo_surface_destroy(temp_surface);
+    cairo_restore(temp_cr);
     
     return total_width;
 }
@@ -389,8 +388,8 @@ void TabBar::CalculateTabWidths(int available_width, std::vector<int>& widths) c
         widths.resize(tabs_.size(), tab_width);
     } else {
         // Tabs sized based on content, within min/max bounds
-        cairo_surface_t* temp_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-        cairo_t* temp_cr = cairo_create(temp_surface);
+        cairo_t* temp_cr = Widget::GetMeasureContext();
+        cairo_save(temp_cr);
         
         cairo_select_font_face(temp_cr, config_.font_family.c_str(),
                               CAIRO_FONT_SLANT_NORMAL,
@@ -405,8 +404,7 @@ void TabBar::CalculateTabWidths(int available_width, std::vector<int>& widths) c
             total_width += tab_width;
         }
         
-        cairo_destroy(temp_cr);
-        cairo_surface_destroy(temp_surface);
+        cairo_restore(temp_cr);
         
         // If tabs don't fill available width, distribute extra space
         int separator_space = config_.show_separators ? (tabs_.size() - 1) * config_.separator_width : 0;
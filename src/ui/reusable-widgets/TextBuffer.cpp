@@ -0,0 +1,196 @@
+#include "ui/reusable-widgets/TextBuffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Leviathan {
+namespace UI {
+
+namespace {
+
+// Length of the UTF-8 sequence introduced by a lead byte (0 = not a lead byte)
+size_t SequenceLength(unsigned char lead) {
+    if (lead < 0x80) return 1;
+    if ((lead & 0xE0) == 0xC0) return lead >= 0xC2 ? 2 : 0;  // C0/C1 are overlong
+    if ((lead & 0xF0) == 0xE0) return 3;
+    if ((lead & 0xF8) == 0xF0) return lead <= 0xF4 ? 4 : 0;
+    return 0;
+}
+
+} // namespace
+
+TextBuffer::TextBuffer()
+    : buffer_(MIN_GAP),
+      gap_start_(0),
+      gap_end_(MIN_GAP) {
+}
+
+void TextBuffer::Insert(size_t pos, const std::string& text) {
+    if (text.empty()) {
+        return;
+    }
+    pos = std::min(pos, Length());
+    
+    MoveGap(pos);
+    Reserve(text.size());
+    std::memcpy(buffer_.data() + gap_start_, text.data(), text.size());
+    gap_start_ += text.size();
+    revision_++;
+}
+
+void TextBuffer::Erase(size_t pos, size_t count) {
+    size_t length = Length();
+    if (pos >= length || count == 0) {
+        return;
+    }
+    count = std::min(count, length - pos);
+    
+    // Deleting right after the gap just widens it
+    MoveGap(pos);
+    gap_end_ += count;
+    revision_++;
+}
+
+void TextBuffer::Assign(const std::string& text) {
+    buffer_.assign(text.size() + MIN_GAP, '\0');
+    std::memcpy(buffer_.data(), text.data(), text.size());
+    gap_start_ = text.size();
+    gap_end_ = buffer_.size();
+    revision_++;
+}
+
+void TextBuffer::Clear() {
+    gap_start_ = 0;
+    gap_end_ = buffer_.size();
+    revision_++;
+}
+
+const std::string& TextBuffer::Str() const {
+    if (text_cache_revision_ != revision_) {
+        text_cache_.assign(buffer_.data(), gap_start_);
+        text_cache_.append(buffer_.data() + gap_end_, buffer_.size() - gap_end_);
+        text_cache_revision_ = revision_;
+    }
+    return text_cache_;
+}
+
+std::string TextBuffer::Substr(size_t pos, size_t count) const {
+    size_t length = Length();
+    if (pos >= length) {
+        return "";
+    }
+    count = std::min(count, length - pos);
+    
+    std::string result;
+    result.reserve(count);
+    for (size_t i = pos; i < pos + count; i++) {
+        result.push_back(At(i));
+    }
+    return result;
+}
+
+size_t TextBuffer::NextBoundary(size_t pos) const {
+    size_t length = Length();
+    if (pos >= length) {
+        return length;
+    }
+    pos++;
+    while (pos < length && IsContinuation(At(pos))) {
+        pos++;
+    }
+    return pos;
+}
+
+size_t TextBuffer::PrevBoundary(size_t pos) const {
+    if (pos == 0) {
+        return 0;
+    }
+    pos = std::min(pos, Length()) - 1;
+    while (pos > 0 && IsContinuation(At(pos))) {
+        pos--;
+    }
+    return pos;
+}
+
+uint32_t TextBuffer::DecodeAt(size_t pos, size_t* length) const {
+    size_t end = NextBoundary(pos);
+    size_t count = end - pos;
+    if (length) {
+        *length = count;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    
+    unsigned char lead = static_cast<unsigned char>(At(pos));
+    if (SequenceLength(lead) != count) {
+        return 0xFFFD;
+    }
+    if (count == 1) {
+        return lead;
+    }
+    
+    uint32_t cp = lead & (0x7F >> count);
+    for (size_t i = 1; i < count; i++) {
+        cp = (cp << 6) | (static_cast<unsigned char>(At(pos + i)) & 0x3F);
+    }
+    return cp;
+}
+
+std::string TextBuffer::FilterPrintable(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    
+    size_t i = 0;
+    while (i < text.size()) {
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        size_t count = SequenceLength(lead);
+        bool valid = count > 0 && i + count <= text.size();
+        for (size_t k = 1; valid && k < count; k++) {
+            valid = IsContinuation(text[i + k]);
+        }
+        if (!valid) {
+            i++;
+            continue;
+        }
+        // Skip C0 controls and DEL
+        if (count > 1 || (lead >= 0x20 && lead != 0x7F)) {
+            result.append(text, i, count);
+        }
+        i += count;
+    }
+    return result;
+}
+
+void TextBuffer::MoveGap(size_t pos) {
+    if (pos < gap_start_) {
+        // Shift [pos, gap_start) to the end of the gap
+        size_t count = gap_start_ - pos;
+        std::memmove(buffer_.data() + gap_end_ - count, buffer_.data() + pos, count);
+        gap_start_ -= count;
+        gap_end_ -= count;
+    } else if (pos > gap_start_) {
+        // Shift the text after the gap down to its start
+        size_t count = pos - gap_start_;
+        std::memmove(buffer_.data() + gap_start_, buffer_.data() + gap_end_, count);
+        gap_start_ += count;
+        gap_end_ += count;
+    }
+}
+
+void TextBuffer::Reserve(size_t extra) {
+    if (GapSize() >= extra) {
+        return;
+    }
+    
+    // Grow geometrically so a stream of inserts stays amortized O(1)
+    size_t tail = buffer_.size() - gap_end_;
+    size_t new_size = std::max(buffer_.size() * 2, Length() + extra + MIN_GAP);
+    std::vector<char> grown(new_size);
+    std::memcpy(grown.data(), buffer_.data(), gap_start_);
+    std::memcpy(grown.data() + new_size - tail, buffer_.data() + gap_end_, tail);
+    gap_end_ = new_size - tail;
+    buffer_.swap(grown);
+}
+
+} // namespace UI
+} // namespace Leviathan
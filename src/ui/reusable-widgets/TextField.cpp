@@ -6,27 +6,46 @@
 namespace Leviathan {
 namespace UI {
 
-void TextField::CalculateSize(int available_width, int available_height) {
+TextField::~TextField() {
+    if (measure_cr_) {
+        cairo_destroy(measure_cr_);
+    }
+    if (measure_surface_) {
+        cairo_surface_destroy(measure_surface_);
+    }
+}
+
+void TextField::SetText(const std::string& text) {
+    std::string filtered = TextBuffer::FilterPrintable(text);
+    if (text_.Str() == filtered) {
+        return;
+    }
     
-    // Create temporary cairo surface to measure text
-    cairo_surface_t* temp_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-    cairo_t* temp_cr = cairo_create(temp_surface);
+    text_.Assign(filtered);
+    cursor_pos_ = text_.Length();
+    ClearSelection();
+    InvalidateWidthsFrom(0);
+    dirty_ = true;
     
-    cairo_select_font_face(temp_cr, font_family_.c_str(),
-                          CAIRO_FONT_SLANT_NORMAL,
-                          CAIRO_FONT_WEIGHT_NORMAL);
-    cairo_set_font_size(temp_cr, font_size_);
+    NotifyTextChanged();
+}
+
+void TextField::CalculateSize(int available_width, int available_height) {
+    cairo_t* measure_cr = GetMeasureContext();
     
     // Get font metrics for consistent height
     cairo_font_extents_t font_extents;
-    cairo_font_extents(temp_cr, &font_extents);
+    cairo_font_extents(measure_cr, &font_extents);
     
     // Calculate content width (use placeholder if text is empty)
-    cairo_text_extents_t extents;
-    const std::string& display_text = text_.empty() ? placeholder_ : text_;
-    cairo_text_extents(temp_cr, display_text.c_str(), &extents);
-    
-    int content_width = static_cast<int>(extents.width);
+    int content_width;
+    if (text_.Empty()) {
+        cairo_text_extents_t extents;
+        cairo_text_extents(measure_cr, placeholder_.c_str(), &extents);
+        content_width = static_cast<int>(extents.width);
+    } else {
+        content_width = static_cast<int>(GetWidthAt(text_.Length()));
+    }
     int content_height = static_cast<int>(font_extents.ascent + font_extents.descent);
     
     // Add padding
@@ -48,9 +67,6 @@ void TextField::CalculateSize(int available_width, int available_height) {
     // Calculate height
     height_ = content_height + total_padding;
     height_ = std::min(height_, available_height);
-    
-    cairo_destroy(temp_cr);
-    cairo_surface_destroy(temp_surface);
 }
 
 void TextField::Render(cairo_t* cr) {
@@ -141,19 +157,11 @@ void TextField::Render(cairo_t* cr) {
     
     // Draw selection background if text is selected
     if (HasSelection()) {
-        cairo_text_extents_t extents_before, extents_selection;
-        
         int sel_start = std::min(selection_start_, selection_end_);
         int sel_end = std::max(selection_start_, selection_end_);
         
-        std::string before_selection = text_.substr(0, sel_start);
-        std::string selection = text_.substr(sel_start, sel_end - sel_start);
-        
-        cairo_text_extents(cr, before_selection.c_str(), &extents_before);
-        cairo_text_extents(cr, selection.c_str(), &extents_selection);
-        
-        double sel_x = text_x + extents_before.x_advance;
-        double sel_w = extents_selection.x_advance;
+        double sel_x = text_x + GetWidthAt(sel_start);
+        double sel_w = GetWidthAt(sel_end) - GetWidthAt(sel_start);
         
         cairo_set_source_rgba(cr, selection_color_[0], selection_color_[1],
                             selection_color_[2], selection_color_[3]);
@@ -163,7 +171,7 @@ void TextField::Render(cairo_t* cr) {
     }
     
     // Draw text or placeholder
-    if (text_.empty() && !placeholder_.empty()) {
+    if (text_.Empty() && !placeholder_.empty()) {
         // Draw placeholder
         cairo_set_source_rgba(cr, placeholder_color_[0], placeholder_color_[1],
                             placeholder_color_[2], placeholder_color_[3]);
@@ -174,16 +182,12 @@ void TextField::Render(cairo_t* cr) {
         cairo_set_source_rgba(cr, text_color_[0], text_color_[1],
                             text_color_[2], text_color_[3]);
         cairo_move_to(cr, text_x, text_y);
-        cairo_show_text(cr, text_.c_str());
+        cairo_show_text(cr, text_.Str().c_str());
     }
     
     // Draw cursor if focused and visible
-    if (is_focused_ && cursor_visible_ && !text_.empty()) {
-        cairo_text_extents_t extents;
-        std::string before_cursor = text_.substr(0, cursor_pos_);
-        cairo_text_extents(cr, before_cursor.c_str(), &extents);
-        
-        double cursor_x = text_x + extents.x_advance;
+    if (is_focused_ && cursor_visible_ && !text_.Empty()) {
+        double cursor_x = text_x + GetWidthAt(cursor_pos_);
         
         cairo_set_source_rgba(cr, cursor_color_[0], cursor_color_[1],
                             cursor_color_[2], cursor_color_[3]);
@@ -191,7 +195,7 @@ void TextField::Render(cairo_t* cr) {
         cairo_move_to(cr, cursor_x, content_y + padding_);
         cairo_line_to(cr, cursor_x, content_y + content_h - padding_);
         cairo_stroke(cr);
-    } else if (is_focused_ && cursor_visible_ && text_.empty()) {
+    } else if (is_focused_ && cursor_visible_ && text_.Empty()) {
         // Draw cursor at start when empty
         cairo_set_source_rgba(cr, cursor_color_[0], cursor_color_[1],
                             cursor_color_[2], cursor_color_[3]);
@@ -237,41 +241,39 @@ bool TextField::HandleKeyPress(uint32_t key, uint32_t modifiers) {
     if (key == 65288) {  // Backspace
         if (HasSelection()) {
             DeleteSelection();
+            NotifyTextChanged();
         } else if (cursor_pos_ > 0) {
-            cursor_pos_--;
-            text_.erase(cursor_pos_, 1);
-            if (on_text_changed_) {
-                on_text_changed_(text_);
-            }
+            // Remove the whole code point before the cursor
+            EraseRange(text_.PrevBoundary(cursor_pos_), cursor_pos_);
+            NotifyTextChanged();
         }
         dirty_ = true;
         return true;
     } else if (key == 65535) {  // Delete
         if (HasSelection()) {
             DeleteSelection();
-        } else if (cursor_pos_ < text_.length()) {
-            text_.erase(cursor_pos_, 1);
-            if (on_text_changed_) {
-                on_text_changed_(text_);
-            }
+            NotifyTextChanged();
+        } else if (cursor_pos_ < text_.Length()) {
+            EraseRange(cursor_pos_, text_.NextBoundary(cursor_pos_));
+            NotifyTextChanged();
         }
         dirty_ = true;
         return true;
     } else if (key == 65293) {  // Enter/Return
         if (on_submit_) {
-            on_submit_(text_);
+            on_submit_(text_.Str());
         }
         return true;
     } else if (key == 65361) {  // Left arrow
         if (cursor_pos_ > 0) {
-            cursor_pos_--;
+            MoveCursor(-1);
             if (!shift) ClearSelection();
         }
         dirty_ = true;
         return true;
     } else if (key == 65363) {  // Right arrow
-        if (cursor_pos_ < text_.length()) {
-            cursor_pos_++;
+        if (cursor_pos_ < text_.Length()) {
+            MoveCursor(1);
             if (!shift) ClearSelection();
         }
         dirty_ = true;
@@ -282,7 +284,7 @@ bool TextField::HandleKeyPress(uint32_t key, uint32_t modifiers) {
         dirty_ = true;
         return true;
     } else if (key == 65367) {  // End
-        cursor_pos_ = text_.length();
+        cursor_pos_ = text_.Length();
         if (!shift) ClearSelection();
         dirty_ = true;
         return true;
@@ -301,7 +303,8 @@ bool TextField::HandleKeyPress(uint32_t key, uint32_t modifiers) {
         if (HasSelection()) {
             DeleteSelection();
         }
-        InsertChar(static_cast<char>(key));
+        InsertText(std::string(1, static_cast<char>(key)));
+        NotifyTextChanged();
         dirty_ = true;
         return true;
     }
@@ -313,17 +316,19 @@ void TextField::HandleTextInput(const std::string& text) {
     if (!is_focused_) return;
     
     
-    // Delete any selected text first
-    if (HasSelection()) {
-        DeleteSelection();
+    // Whole UTF-8 sequences only; control characters are dropped
+    std::string printable = TextBuffer::FilterPrintable(text);
+    if (printable.empty()) {
+        return;
     }
     
-    // Insert each character from the UTF-8 string
-    for (char c : text) {
-        if (c >= 32 && c < 127) {  // Printable ASCII
-            InsertChar(c);
-        }
+    // Delete any selected text first, then insert the whole string as one
+    // edit so listeners see a single change however long the input is
+    if (HasSelection()) {
+        DeleteSelection();
     }
+    InsertText(printable);
+    NotifyTextChanged();
     
     dirty_ = true;
 }
@@ -342,24 +347,18 @@ void TextField::UpdateCursorBlink(uint32_t current_time) {
 
 // Helper methods
 
-void TextField::InsertChar(char c) {
-    text_.insert(cursor_pos_, 1, c);
-    cursor_pos_++;
-    
-    if (on_text_changed_) {
-        on_text_changed_(text_);
-    }
+void TextField::InsertText(const std::string& text) {
+    text_.Insert(cursor_pos_, text);
+    InvalidateWidthsFrom(cursor_pos_);
+    cursor_pos_ += text.size();
 }
 
-void TextField::DeleteChar() {
-    if (cursor_pos_ > 0) {
-        text_.erase(cursor_pos_ - 1, 1);
-        cursor_pos_--;
-        
-        if (on_text_changed_) {
-            on_text_changed_(text_);
-        }
-    }
+void TextField::EraseRange(size_t start, size_t end) {
+    if (end <= start) return;
+    
+    text_.Erase(start, end - start);
+    InvalidateWidthsFrom(start);
+    cursor_pos_ = start;
 }
 
 void TextField::DeleteSelection() {
@@ -368,64 +367,55 @@ void TextField::DeleteSelection() {
     int sel_start = std::min(selection_start_, selection_end_);
     int sel_end = std::max(selection_start_, selection_end_);
     
-    text_.erase(sel_start, sel_end - sel_start);
-    cursor_pos_ = sel_start;
+    EraseRange(sel_start, sel_end);
     ClearSelection();
-    
+}
+
+void TextField::NotifyTextChanged() {
     if (on_text_changed_) {
-        on_text_changed_(text_);
+        on_text_changed_(text_.Str());
     }
 }
 
 void TextField::MoveCursor(int delta) {
-    int new_pos = static_cast<int>(cursor_pos_) + delta;
-    cursor_pos_ = std::max(0, std::min(new_pos, static_cast<int>(text_.length())));
+    // Step whole code points so the cursor never lands inside a sequence
+    for (; delta < 0 && cursor_pos_ > 0; delta++) {
+        cursor_pos_ = text_.PrevBoundary(cursor_pos_);
+    }
+    for (; delta > 0 && cursor_pos_ < text_.Length(); delta--) {
+        cursor_pos_ = text_.NextBoundary(cursor_pos_);
+    }
 }
 
 void TextField::MoveCursorToPosition(int x) {
-    // Create temporary cairo surface to measure text
-    cairo_surface_t* temp_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-    cairo_t* temp_cr = cairo_create(temp_surface);
-    
-    cairo_select_font_face(temp_cr, font_family_.c_str(),
-                          CAIRO_FONT_SLANT_NORMAL,
-                          CAIRO_FONT_WEIGHT_NORMAL);
-    cairo_set_font_size(temp_cr, font_size_);
-    
     int content_x = x_ + padding_;
     if (variant_ == Variant::Outlined) {
         content_x += border_width_;
     }
     
-    int relative_x = x - content_x;
-    
-    // Find cursor position by measuring text width
-    size_t best_pos = 0;
-    int min_distance = std::abs(relative_x);
+    double relative_x = x - content_x;
     
-    for (size_t i = 0; i <= text_.length(); i++) {
-        std::string substr = text_.substr(0, i);
-        cairo_text_extents_t extents;
-        cairo_text_extents(temp_cr, substr.c_str(), &extents);
-        
-        int distance = std::abs(relative_x - static_cast<int>(extents.x_advance));
-        if (distance < min_distance) {
-            min_distance = distance;
-            best_pos = i;
-        }
+    // Prefix widths are sorted: binary search, then snap to the nearer code point edge
+    EnsureWidths();
+    auto it = std::lower_bound(prefix_widths_.begin(), prefix_widths_.end(), relative_x);
+    size_t after = std::min(static_cast<size_t>(it - prefix_widths_.begin()), text_.Length());
+    while (!text_.IsBoundary(after)) {
+        after++;  // Inside a code point: move to its end
     }
+    size_t before = text_.PrevBoundary(after);
     
-    cursor_pos_ = best_pos;
+    if (after > 0 && std::abs(relative_x - GetWidthAt(before)) <= std::abs(relative_x - GetWidthAt(after))) {
+        cursor_pos_ = before;
+    } else {
+        cursor_pos_ = after;
+    }
     ClearSelection();
-    
-    cairo_destroy(temp_cr);
-    cairo_surface_destroy(temp_surface);
 }
 
 void TextField::SelectAll() {
     selection_start_ = 0;
-    selection_end_ = text_.length();
-    cursor_pos_ = text_.length();
+    selection_end_ = text_.Length();
+    cursor_pos_ = text_.Length();
 }
 
 void TextField::ClearSelection() {
@@ -448,23 +438,81 @@ void TextField::PasteFromClipboard() {
 }
 
 int TextField::GetCursorXPosition() const {
-    // Create temporary cairo surface to measure text
-    cairo_surface_t* temp_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-    cairo_t* temp_cr = cairo_create(temp_surface);
-    
-    cairo_select_font_face(temp_cr, font_family_.c_str(),
-                          CAIRO_FONT_SLANT_NORMAL,
-                          CAIRO_FONT_WEIGHT_NORMAL);
-    cairo_set_font_size(temp_cr, font_size_);
+    return static_cast<int>(GetWidthAt(cursor_pos_));
+}
+
+void TextField::InvalidateFont() {
+    advance_cache_.clear();
+    measure_font_dirty_ = true;
+    InvalidateWidthsFrom(0);
+}
+
+void TextField::InvalidateWidthsFrom(size_t pos) {
+    widths_valid_ = std::min(widths_valid_, pos);
+}
+
+void TextField::EnsureWidths() const {
+    size_t length = text_.Length();
+    if (widths_valid_ >= length && prefix_widths_.size() == length + 1) {
+        return;
+    }
+    prefix_widths_.resize(length + 1);
     
-    std::string before_cursor = text_.substr(0, cursor_pos_);
-    cairo_text_extents_t extents;
-    cairo_text_extents(temp_cr, before_cursor.c_str(), &extents);
+    // Reflow from the first code point at or before the invalidated position;
+    // everything before it is unchanged by the edit
+    size_t pos = std::min(widths_valid_, length);
+    while (!text_.IsBoundary(pos)) {
+        pos--;
+    }
+    if (pos == 0) {
+        prefix_widths_[0] = 0.0;
+    }
     
-    cairo_destroy(temp_cr);
-    cairo_surface_destroy(temp_surface);
+    while (pos < length) {
+        size_t count = 0;
+        uint32_t codepoint = text_.DecodeAt(pos, &count);
+        double start = prefix_widths_[pos];
+        for (size_t i = 1; i < count; i++) {
+            prefix_widths_[pos + i] = start;
+        }
+        prefix_widths_[pos + count] = start + GetAdvance(codepoint, pos, count);
+        pos += count;
+    }
+    widths_valid_ = length;
+}
+
+double TextField::GetAdvance(uint32_t codepoint, size_t pos, size_t length) const {
+    auto it = advance_cache_.find(codepoint);
+    if (it != advance_cache_.end()) {
+        return it->second;
+    }
     
-    return static_cast<int>(extents.x_advance);
+    // First time this code point is seen in this font: shape just this glyph
+    std::string glyph = text_.Substr(pos, length);
+    cairo_text_extents_t extents;
+    cairo_text_extents(GetMeasureContext(), glyph.c_str(), &extents);
+    advance_cache_[codepoint] = extents.x_advance;
+    return extents.x_advance;
+}
+
+double TextField::GetWidthAt(size_t pos) const {
+    EnsureWidths();
+    return prefix_widths_[std::min(pos, text_.Length())];
+}
+
+cairo_t* TextField::GetMeasureContext() const {
+    if (!measure_cr_) {
+        measure_surface_ = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+        measure_cr_ = cairo_create(measure_surface_);
+    }
+    if (measure_font_dirty_) {
+        cairo_select_font_face(measure_cr_, font_family_.c_str(),
+                              CAIRO_FONT_SLANT_NORMAL,
+                              CAIRO_FONT_WEIGHT_NORMAL);
+        cairo_set_font_size(measure_cr_, font_size_);
+        measure_font_dirty_ = false;
+    }
+    return measure_cr_;
 }
 
 } // namespace UI
@@ -0,0 +1,329 @@
+#include "wayland/FrameGovernor.hpp"
+#include "wayland/Server.hpp"
+#include "wayland/Output.hpp"
+#include "wayland/View.hpp"
+#include "core/Client.hpp"
+#include "config/ConfigParser.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace Leviathan {
+namespace Wayland {
+
+namespace {
+
+constexpr uint64_t SAMPLE_INTERVAL_MS = 1000;
+constexpr uint64_t POWER_CHECK_INTERVAL_NS = 30ULL * 1000000000ULL;
+
+uint64_t TimespecToNs(const struct timespec& ts) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+uint64_t NowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return TimespecToNs(now);
+}
+
+std::string ReadFirstLine(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+} // namespace
+
+FrameGovernor::FrameGovernor(Server* server, struct wl_event_loop* event_loop)
+    : server_(server) {
+    sample_timer_ = wl_event_loop_add_timer(event_loop, HandleSampleTimer, this);
+    release_timer_ = wl_event_loop_add_timer(event_loop, HandleReleaseTimer, this);
+    commit_timer_ = wl_event_loop_add_timer(event_loop, HandleCommitTimer, this);
+    UpdatePowerSource();
+}
+
+FrameGovernor::~FrameGovernor() {
+    if (sample_timer_) {
+        wl_event_source_remove(sample_timer_);
+    }
+    if (release_timer_) {
+        wl_event_source_remove(release_timer_);
+    }
+    if (commit_timer_) {
+        wl_event_source_remove(commit_timer_);
+    }
+}
+
+void FrameGovernor::RecordCommit(Core::Client* client) {
+    if (!client) {
+        return;
+    }
+    // The sample timer only runs while somebody commits
+    if (!sampling_ && sample_timer_) {
+        sampling_ = true;
+        wl_event_source_timer_update(sample_timer_, SAMPLE_INTERVAL_MS);
+    }
+}
+
+void FrameGovernor::HoldCommit(Core::Client* client) {
+    const auto& config = Config().frame_governor;
+    auto* view = client ? client->GetView() : nullptr;
+    if (!view || view->is_xwayland || !view->surface || config.storm_fps <= 0 ||
+        !client->GetGovernorState().throttled) {
+        return;
+    }
+    
+    // Every held state keeps its buffer; a client with more in flight gets
+    // its oldest one applied rather than queueing without bound
+    auto& state = client->GetGovernorState();
+    uint64_t now = NowNs();
+    if (state.held_count == Core::FrameGovernorState::MAX_HELD_COMMITS) {
+        ReleaseOldestCommit(client, now);
+    }
+    
+    // The state being committed is cached instead of applied until its lock goes
+    state.held_commits[state.held_count++] = wlr_surface_lock_pending(view->surface);
+    ArmCommitTimer(std::max(state.last_release_ns + 1000000000ULL / config.storm_fps, now), now);
+}
+
+void FrameGovernor::ReleaseClient(Core::Client* client) {
+    uint64_t now = NowNs();
+    while (client && client->GetGovernorState().held_count > 0) {
+        ReleaseOldestCommit(client, now);
+    }
+}
+
+void FrameGovernor::ReleaseOldestCommit(Core::Client* client, uint64_t now_ns) {
+    auto& state = client->GetGovernorState();
+    uint32_t seq = state.held_commits[0];
+    std::copy(state.held_commits + 1, state.held_commits + state.held_count, state.held_commits);
+    state.held_count--;
+    state.last_release_ns = now_ns;
+    
+    // The next held state has a lock of its own, so exactly this one applies
+    wlr_surface_unlock_cached(client->GetView()->surface, seq);
+}
+
+void FrameGovernor::ArmCommitTimer(uint64_t due_ns, uint64_t now_ns) {
+    if (commit_release_at_ns_ && commit_release_at_ns_ <= due_ns) {
+        return;
+    }
+    commit_release_at_ns_ = due_ns;
+    uint64_t delay_ms = due_ns > now_ns ? (due_ns - now_ns + 999999) / 1000000 : 1;
+    wl_event_source_timer_update(commit_timer_, static_cast<int>(std::max<uint64_t>(delay_ms, 1)));
+}
+
+int FrameGovernor::GetCap(const Core::Client* client) const {
+    const auto& config = Config().frame_governor;
+    const auto& state = client->GetGovernorState();
+    if (!config.enabled) {
+        return 0;
+    }
+    if (state.rule_cap >= 0) {
+        return state.rule_cap;
+    }
+    
+    int cap = 0;
+    if (client->GetView() != server_->GetFocusedView()) {
+        cap = on_battery_ ? config.battery_unfocused_fps : config.unfocused_fps;
+    }
+    if (state.throttled && config.storm_fps > 0) {
+        cap = cap > 0 ? std::min(cap, config.storm_fps) : config.storm_fps;
+    }
+    return cap;
+}
+
+void FrameGovernor::SendFrameDone(Output* output, const struct timespec& now) {
+    if (output->wlr_output->refresh > 0) {
+        refresh_hz_ = std::max(refresh_hz_, output->wlr_output->refresh / 1000);
+    }
+    
+    FramePass pass{};
+    pass.governor = this;
+    pass.scene_output = output->scene_output;
+    pass.event.output = output->scene_output;
+    pass.event.when = now;
+    pass.now_ns = TimespecToNs(now);
+    pass.refresh_ns = output->pacing.refresh_ns > 0 ? output->pacing.refresh_ns : 1000000000ULL / 60;
+    wlr_scene_output_for_each_buffer(output->scene_output, SendBufferFrameDone, &pass);
+    
+    if (pass.next_due_ns) {
+        HoldOutput(output->wlr_output, pass.next_due_ns, pass.now_ns);
+    }
+}
+
+void FrameGovernor::SendBufferFrameDone(struct wlr_scene_buffer* buffer, int sx, int sy, void* data) {
+    auto* pass = static_cast<FramePass*>(data);
+    
+    // Same rule as wlr_scene_output_send_frame_done: one output per buffer
+    if (buffer->primary_output != pass->scene_output) {
+        return;
+    }
+    
+    struct wlr_scene_surface* scene_surface = wlr_scene_surface_try_from_buffer(buffer);
+    Core::Client* client = scene_surface ? pass->governor->ClientForSurface(scene_surface->surface) : nullptr;
+    int cap = client ? pass->governor->GetCap(client) : 0;
+    if (cap > 0) {
+        auto& state = client->GetGovernorState();
+        
+        // Within half a refresh of due counts as due, so 30 fps on a 60 Hz
+        // output is every other frame rather than every third. Every surface
+        // of the client goes in the same frame
+        uint64_t due_ns = state.last_frame_done_ns + 1000000000ULL / cap;
+        if (state.last_frame_done_ns != pass->now_ns && pass->now_ns + pass->refresh_ns / 2 < due_ns) {
+            uint64_t release_ns = due_ns - pass->refresh_ns / 2;
+            pass->next_due_ns = pass->next_due_ns ? std::min(pass->next_due_ns, release_ns) : release_ns;
+            return;
+        }
+        state.last_frame_done_ns = pass->now_ns;
+    }
+    
+    // Frame-callback latency runs until the toplevel's next commit, so only
+    // callbacks the toplevel surface asked for count
+    if (client && scene_surface->surface == client->GetView()->surface &&
+        !wl_list_empty(&scene_surface->surface->current.frame_callback_list)) {
+        client->RecordFrameCallback(pass->now_ns);
+    }
+    wlr_scene_buffer_send_frame_done(buffer, &pass->event);
+}
+
+Core::Client* FrameGovernor::ClientForSurface(struct wlr_surface* wlr_surface) const {
+    // Subsurfaces and popups belong to the toplevel they hang off
+    struct wlr_surface* surface = wlr_surface_get_root_surface(wlr_surface);
+    struct wlr_xdg_surface* xdg_surface = wlr_xdg_surface_try_from_wlr_surface(surface);
+    while (xdg_surface && xdg_surface->role == WLR_XDG_SURFACE_ROLE_POPUP && xdg_surface->popup->parent) {
+        surface = wlr_surface_get_root_surface(xdg_surface->popup->parent);
+        xdg_surface = wlr_xdg_surface_try_from_wlr_surface(surface);
+    }
+    if (!xdg_surface || xdg_surface->role != WLR_XDG_SURFACE_ROLE_TOPLEVEL || !xdg_surface->data) {
+        return nullptr;
+    }
+    
+    // Server::OnNewXdgToplevel: base->data is the view's scene tree, node.data the view
+    auto* tree = static_cast<struct wlr_scene_tree*>(xdg_surface->data);
+    auto* view = static_cast<View*>(tree->node.data);
+    return view ? view->client : nullptr;
+}
+
+void FrameGovernor::HoldOutput(struct wlr_output* wlr_output, uint64_t due_ns, uint64_t now_ns) {
+    if (std::find(held_outputs_.begin(), held_outputs_.end(), wlr_output) == held_outputs_.end()) {
+        held_outputs_.push_back(wlr_output);
+    }
+    
+    if (release_at_ns_ && release_at_ns_ <= due_ns) {
+        return;  // Already armed early enough
+    }
+    release_at_ns_ = due_ns;
+    uint64_t delay_ms = due_ns > now_ns ? (due_ns - now_ns + 999999) / 1000000 : 1;
+    wl_event_source_timer_update(release_timer_, static_cast<int>(std::max<uint64_t>(delay_ms, 1)));
+}
+
+int FrameGovernor::HandleReleaseTimer(void* data) {
+    auto* governor = static_cast<FrameGovernor*>(data);
+    governor->release_at_ns_ = 0;
+    
+    // A frame without damage only sends callbacks; outputs that went away
+    // since are no longer found
+    for (auto* wlr_output : governor->held_outputs_) {
+        if (governor->server_->FindOutput(wlr_output)) {
+            wlr_output_schedule_frame(wlr_output);
+        }
+    }
+    governor->held_outputs_.clear();
+    return 0;
+}
+
+int FrameGovernor::HandleCommitTimer(void* data) {
+    auto* governor = static_cast<FrameGovernor*>(data);
+    governor->commit_release_at_ns_ = 0;
+    uint64_t now = NowNs();
+    
+    // One held commit per client and tick (storm_fps 0 since a reload: all of them)
+    int storm_fps = Config().frame_governor.storm_fps;
+    uint64_t interval_ns = storm_fps > 0 ? 1000000000ULL / storm_fps : 0;
+    for (auto* client : governor->server_->GetAllClients()) {
+        const auto& state = client->GetGovernorState();
+        if (state.held_count == 0) {
+            continue;
+        }
+        if (interval_ns == 0) {
+            governor->ReleaseClient(client);
+            continue;
+        }
+        if (state.last_release_ns + interval_ns <= now + 1000000) {
+            governor->ReleaseOldestCommit(client, now);
+        }
+        if (state.held_count > 0) {
+            governor->ArmCommitTimer(state.last_release_ns + interval_ns, now);
+        }
+    }
+    return 0;
+}
+
+int FrameGovernor::HandleSampleTimer(void* data) {
+    static_cast<FrameGovernor*>(data)->Sample();
+    return 0;
+}
+
+void FrameGovernor::Sample() {
+    const auto& config = Config().frame_governor;
+    uint64_t now = NowNs();
+    
+    if (now - last_power_check_ns_ >= POWER_CHECK_INTERVAL_NS) {
+        UpdatePowerSource();
+    }
+    
+    uint32_t storm_rate = static_cast<uint32_t>(config.storm_factor * refresh_hz_);
+    bool active = false;
+    for (auto* client : server_->GetAllClients()) {
+        // The rate leviathanctl top shows; it goes stale once the client stops committing
+        const auto& stats = client->GetStats();
+        uint32_t commit_rate = stats.RatesCurrent(now) ? stats.commit_rate : 0;
+        auto& state = client->GetGovernorState();
+        
+        bool stormable = config.enabled && config.storm_factor > 0 && state.rule_cap != 0;
+        if (!state.throttled && stormable && commit_rate > storm_rate) {
+            state.throttled = true;
+            state.throttle_events++;
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Throttling '{}': {} commits/s on {} Hz outputs",
+                                       client->GetAppId(), commit_rate, refresh_hz_);
+        } else if (state.throttled && (!stormable || commit_rate <= static_cast<uint32_t>(refresh_hz_))) {
+            state.throttled = false;
+            ReleaseClient(client);
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "'{}' no longer throttled ({} commits/s)",
+                                       client->GetAppId(), commit_rate);
+        }
+        
+        active = active || commit_rate > 0 || state.throttled;
+    }
+    
+    // Once everything is quiet the timer stops until the next commit
+    sampling_ = active;
+    wl_event_source_timer_update(sample_timer_, active ? SAMPLE_INTERVAL_MS : 0);
+}
+
+void FrameGovernor::UpdatePowerSource() {
+    last_power_check_ns_ = NowNs();
+    
+    bool on_battery = false;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/class/power_supply", ec)) {
+        if (ReadFirstLine(entry.path() / "type") == "Battery" &&
+            ReadFirstLine(entry.path() / "status") == "Discharging") {
+            on_battery = true;
+            break;
+        }
+    }
+    
+    if (on_battery != on_battery_) {
+        on_battery_ = on_battery;
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Frame governor: running on {}", on_battery ? "battery" : "AC power");
+    }
+}
+
+} // namespace Wayland
+} // namespace Leviathan
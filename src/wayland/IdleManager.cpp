@@ -0,0 +1,179 @@
+#include "wayland/IdleManager.hpp"
+#include "wayland/Server.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Leviathan {
+namespace Wayland {
+
+namespace {
+
+uint64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* StateName(IdleManager::State state) {
+    switch (state) {
+        case IdleManager::State::Active: return "active";
+        case IdleManager::State::Idle: return "idle";
+        case IdleManager::State::PoweredOff: return "powered off";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+IdleManager::IdleManager(Server* server, struct wl_display* display, struct wl_event_loop* event_loop, struct wlr_seat* seat)
+    : server_(server), seat_(seat), last_activity_ms_(NowMs()) {
+    notifier_ = wlr_idle_notifier_v1_create(display);
+    inhibit_manager_ = wlr_idle_inhibit_v1_create(display);
+    if (inhibit_manager_) {
+        new_inhibitor_.notify = HandleNewInhibitor;
+        wl_signal_add(&inhibit_manager_->events.new_inhibitor, &new_inhibitor_);
+    } else {
+        wl_list_init(&new_inhibitor_.link);
+    }
+    
+    timer_ = wl_event_loop_add_timer(event_loop, HandleTimer, this);
+}
+
+IdleManager::~IdleManager() {
+    if (timer_) {
+        wl_event_source_remove(timer_);
+    }
+    for (auto& inhibitor : inhibitors_) {
+        wl_list_remove(&inhibitor->destroy.link);
+    }
+    inhibitors_.clear();
+    wl_list_remove(&new_inhibitor_.link);
+}
+
+void IdleManager::SetTimeouts(int idle_seconds, int dpms_seconds) {
+    idle_timeout_ms_ = std::max(0, idle_seconds) * 1000;
+    dpms_timeout_ms_ = std::max(0, dpms_seconds) * 1000;
+    ArmTimer();
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Idle timeouts: idle={}s, dpms={}s", idle_seconds, dpms_seconds);
+}
+
+void IdleManager::NotifyActivity() {
+    last_activity_ms_ = NowMs();
+    if (notifier_) {
+        wlr_idle_notifier_v1_notify_activity(notifier_, seat_);
+    }
+    if (state_ != State::Active) {
+        SetState(State::Active);
+        ArmTimer();
+    }
+}
+
+void IdleManager::ArmTimer() {
+    if (!timer_) {
+        return;
+    }
+    
+    // Next stage still ahead of us, measured from the last activity
+    int next_ms = 0;
+    if (state_ == State::Active) {
+        next_ms = idle_timeout_ms_ > 0 ? idle_timeout_ms_ : dpms_timeout_ms_;
+    } else if (state_ == State::Idle) {
+        next_ms = dpms_timeout_ms_;
+    }
+    if (next_ms <= 0) {
+        wl_event_source_timer_update(timer_, 0);
+        return;
+    }
+    
+    uint64_t elapsed = NowMs() - last_activity_ms_;
+    uint64_t deadline = static_cast<uint64_t>(next_ms);
+    int remaining = deadline > elapsed ? static_cast<int>(deadline - elapsed) : 1;
+    wl_event_source_timer_update(timer_, remaining);
+}
+
+void IdleManager::OnTimer() {
+    // An inhibitor (video playback) counts as continuous activity
+    if (IsInhibited()) {
+        last_activity_ms_ = NowMs();
+        ArmTimer();
+        return;
+    }
+    
+    uint64_t elapsed = NowMs() - last_activity_ms_;
+    if (dpms_timeout_ms_ > 0 && elapsed >= static_cast<uint64_t>(dpms_timeout_ms_)) {
+        SetState(State::PoweredOff);
+    } else if (state_ == State::Active && idle_timeout_ms_ > 0 && elapsed >= static_cast<uint64_t>(idle_timeout_ms_)) {
+        SetState(State::Idle);
+    }
+    ArmTimer();
+}
+
+void IdleManager::SetState(State state) {
+    if (state == state_) {
+        return;
+    }
+    State old_state = state_;
+    state_ = state;
+    
+    // Outputs go off last and come back first, so nothing renders to a dark screen
+    if (old_state == State::PoweredOff) {
+        server_->SetOutputsPowered(true);
+    }
+    server_->SetUISuspended(state_ != State::Active);
+    if (state_ == State::PoweredOff) {
+        server_->SetOutputsPowered(false);
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Session is now {}", StateName(state_));
+}
+
+void IdleManager::RemoveInhibitor(Inhibitor* inhibitor) {
+    wl_list_remove(&inhibitor->destroy.link);
+    inhibitors_.erase(std::remove_if(inhibitors_.begin(), inhibitors_.end(),
+        [inhibitor](const std::unique_ptr<Inhibitor>& entry) { return entry.get() == inhibitor; }),
+        inhibitors_.end());
+    
+    if (notifier_) {
+        wlr_idle_notifier_v1_set_inhibited(notifier_, IsInhibited());
+    }
+    if (!IsInhibited()) {
+        // The idle countdown starts when playback ends
+        last_activity_ms_ = NowMs();
+        ArmTimer();
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Idle inhibitor removed ({} left)", inhibitors_.size());
+}
+
+int IdleManager::HandleTimer(void* data) {
+    static_cast<IdleManager*>(data)->OnTimer();
+    return 0;
+}
+
+void IdleManager::HandleNewInhibitor(struct wl_listener* listener, void* data) {
+    IdleManager* manager = wl_container_of(listener, manager, new_inhibitor_);
+    auto* wlr_inhibitor = static_cast<struct wlr_idle_inhibitor_v1*>(data);
+    
+    auto inhibitor = std::make_unique<Inhibitor>();
+    inhibitor->manager = manager;
+    inhibitor->wlr_inhibitor = wlr_inhibitor;
+    inhibitor->destroy.notify = HandleInhibitorDestroy;
+    wl_signal_add(&wlr_inhibitor->events.destroy, &inhibitor->destroy);
+    manager->inhibitors_.push_back(std::move(inhibitor));
+    
+    if (manager->notifier_) {
+        wlr_idle_notifier_v1_set_inhibited(manager->notifier_, true);
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Idle inhibitor added ({} active)", manager->inhibitors_.size());
+}
+
+void IdleManager::HandleInhibitorDestroy(struct wl_listener* listener, void* data) {
+    Inhibitor* inhibitor = wl_container_of(listener, inhibitor, destroy);
+    inhibitor->manager->RemoveInhibitor(inhibitor);
+}
+
+} // namespace Wayland
+} // namespace Leviathan
@@ -10,6 +10,13 @@
 namespace Leviathan {
 namespace Wayland {
 
+// Every input event resets the idle countdown (and wakes powered-down outputs)
+static void notify_activity(Server* server) {
+    if (IdleManager* idle = server->GetIdleManager()) {
+        idle->NotifyActivity();
+    }
+}
+
 static void keyboard_handle_modifiers(struct wl_listener* listener, void* data) {
     Keyboard* keyboard = wl_container_of(listener, keyboard, modifiers);
     wlr_seat_set_keyboard(keyboard->server->GetSeat(), keyboard->wlr_keyboard);
@@ -23,6 +30,8 @@ static void keyboard_handle_key(struct wl_listener* listener, void* data) {
     struct wlr_keyboard_key_event* event = static_cast<struct wlr_keyboard_key_event*>(data);
     struct wlr_seat* seat = server->GetSeat();
     
+    notify_activity(server);
+    
     // Get keysyms first
     uint32_t keycode = event->keycode + 8;
     const xkb_keysym_t* syms;
@@ -230,6 +239,7 @@ static void process_cursor_motion(Server* server, uint32_t time) {
                                    static_cast<int>(server->cursor->y))) {
         // Cursor is over a status bar, don't send to client surfaces
         wlr_seat_pointer_clear_focus(server->seat);
+        server->SetCursorShape("default");
         return;
     }
     
@@ -270,7 +280,9 @@ static void process_cursor_motion(Server* server, uint32_t time) {
         wlr_seat_pointer_notify_enter(server->seat, surface, sx, sy);
         wlr_seat_pointer_notify_motion(server->seat, time, sx, sy);
     } else {
+        // Nobody owns the pointer here; the last client's cursor must not linger
         wlr_seat_pointer_clear_focus(server->seat);
+        server->SetCursorShape("default");
     }
 }
 
@@ -279,6 +291,8 @@ void InputManager::HandleCursorMotion(struct wl_listener* listener, void* data)
     struct wlr_pointer_motion_event* event = 
         static_cast<struct wlr_pointer_motion_event*>(data);
     
+    notify_activity(server);
+    
     // Move cursor by relative delta
     wlr_cursor_move(server->cursor, &event->pointer->base,
                     event->delta_x, event->delta_y);
@@ -291,6 +305,8 @@ void InputManager::HandleCursorMotionAbsolute(struct wl_listener* listener, void
     struct wlr_pointer_motion_absolute_event* event = 
         static_cast<struct wlr_pointer_motion_absolute_event*>(data);
     
+    notify_activity(server);
+    
     // Warp cursor to absolute position (0..1 coordinates)
     wlr_cursor_warp_absolute(server->cursor, &event->pointer->base, 
                             event->x, event->y);
@@ -303,6 +319,8 @@ void InputManager::HandleCursorButton(struct wl_listener* listener, void* data)
     struct wlr_pointer_button_event* event = 
         static_cast<struct wlr_pointer_button_event*>(data);
     
+    notify_activity(server);
+    
     // Check if click is on a status bar first (before sending to clients)
     if (event->state == WL_POINTER_BUTTON_STATE_PRESSED && 
         event->button == BTN_LEFT) {
@@ -349,6 +367,8 @@ void InputManager::HandleCursorAxis(struct wl_listener* listener, void* data) {
     struct wlr_pointer_axis_event* event = 
         static_cast<struct wlr_pointer_axis_event*>(data);
     
+    notify_activity(server);
+    
     int cursor_x = static_cast<int>(server->cursor->x);
     int cursor_y = static_cast<int>(server->cursor->y);
     
@@ -381,7 +401,25 @@ void InputManager::HandleCursorFrame(struct wl_listener* listener, void* data) {
 }
 
 void InputManager::HandleRequestCursor(struct wl_listener* listener, void* data) {
-    // Future: handle cursor requests
+    Server* server = wl_container_of(listener, server, request_cursor);
+    auto* event = static_cast<struct wlr_seat_pointer_request_set_cursor_event*>(data);
+    
+    // Only the client with pointer focus may set the cursor
+    if (event->seat_client != server->seat->pointer_state.focused_client) {
+        return;
+    }
+    server->SetCursorSurface(event->surface, event->hotspot_x, event->hotspot_y);
+}
+
+void InputManager::HandleRequestCursorShape(struct wl_listener* listener, void* data) {
+    Server* server = wl_container_of(listener, server, request_cursor_shape);
+    auto* event = static_cast<struct wlr_cursor_shape_manager_v1_request_set_shape_event*>(data);
+    
+    if (event->device_type != WLR_CURSOR_SHAPE_MANAGER_V1_DEVICE_TYPE_POINTER ||
+        event->seat_client != server->seat->pointer_state.focused_client) {
+        return;
+    }
+    server->SetCursorShape(wlr_cursor_shape_v1_name(event->shape));
 }
 
 void InputManager::HandleRequestSetSelection(struct wl_listener* listener, void* data) {
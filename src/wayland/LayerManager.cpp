@@ -4,10 +4,12 @@
 #include "wayland/Server.hpp"
 #include "wayland/Output.hpp"
 #include "wayland/NightLight.hpp"
+#include "wayland/OverlaySurfaceManager.hpp"
 #include "core/Tag.hpp"
 #include "core/Client.hpp"
 #include "core/Screen.hpp"
 #include "core/Events.hpp"
+#include "core/FrameArena.hpp"
 #include "layout/TilingLayout.hpp"
 #include "layout/TilingLayout.hpp"
 #include "config/ConfigParser.hpp"
@@ -39,6 +41,9 @@ namespace Wayland {
 LayerManager::LayerManager(struct wlr_scene* scene, struct wlr_output* output, struct wl_event_loop* event_loop)
     : output_(output),
       event_loop_(event_loop) {
+    static int next_index = 0;
+    index_ = next_index++;
+    
     // Create layer trees in order (bottom to top)
     layers_[static_cast<size_t>(Layer::Background)] = 
         wlr_scene_tree_create(&scene->tree);
@@ -68,6 +73,10 @@ LayerManager::LayerManager(struct wlr_scene* scene, struct wlr_output* output, s
     // Create layout engine for this output
     layout_engine_ = new TilingLayout();
     
+    // Modals, popovers and the launcher share one buffer pool in the Top layer
+    overlays_ = std::make_unique<OverlaySurfaceManager>(
+        layers_[static_cast<size_t>(Layer::Top)], event_loop_);
+    
     // Initialize night light on its dedicated layer
     night_light_ = std::make_unique<NightLight>(
         layers_[static_cast<size_t>(Layer::NightLight)],
@@ -78,8 +87,10 @@ LayerManager::LayerManager(struct wlr_scene* scene, struct wlr_output* output, s
     
     // Set output dimensions for night light
     if (night_light_) {
-        night_light_->SetOutputDimensions(output_->width, output_->height);
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set night light dimensions: {}x{}", output_->width, output_->height);
+        int logical_width = 0, logical_height = 0;
+        GetLogicalSize(logical_width, logical_height);
+        night_light_->SetOutputDimensions(logical_width, logical_height);
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set night light dimensions: {}x{}", logical_width, logical_height);
     }
     
     // Wallpaper will be initialized when SetMonitorConfig is called
@@ -95,16 +106,8 @@ LayerManager::~LayerManager() {
     // Clean up wallpaper
     ClearWallpaper();
     
-    // Clean up popover rendering resources
-    if (popover_cairo_) {
-        cairo_destroy(popover_cairo_);
-    }
-    if (popover_cairo_surface_) {
-        cairo_surface_destroy(popover_cairo_surface_);
-    }
-    if (popover_shm_buffer_) {
-        wlr_buffer_drop(popover_shm_buffer_->GetWlrBuffer());
-    }
+    // Release overlay buffers and their scene nodes
+    overlays_.reset();
     
     // Clean up layout engine
     delete layout_engine_;
@@ -116,12 +119,72 @@ LayerManager::~LayerManager() {
 void LayerManager::SetMonitorConfig(const MonitorConfig& config) {
     monitor_config_ = &config;
     
+    // A different monitor group may have configured this output before
+    ClearWallpaper();
+    
     // Initialize wallpaper if configured
     if (!config.wallpaper.empty()) {
         InitializeWallpaper();
     }
 }
 
+void LayerManager::GetLogicalSize(int& width, int& height) const {
+    width = output_->width;
+    height = output_->height;
+    wlr_output_effective_resolution(output_, &width, &height);
+}
+
+void LayerManager::SetScale(float scale) {
+    int logical_width = 0, logical_height = 0;
+    GetLogicalSize(logical_width, logical_height);
+    
+    overlays_->SetScale(scale);
+    for (auto* bar : status_bars_) {
+        bar->SetScale(scale);
+        bar->SetOutputSize(logical_width, logical_height);
+    }
+    
+    if (night_light_) {
+        night_light_->SetOutputDimensions(logical_width, logical_height);
+    }
+    
+    // The wallpaper keeps covering the output in layout coordinates
+    if (wallpaper_node_) {
+        if (wallpaper_node_->type == WLR_SCENE_NODE_RECT) {
+            wlr_scene_rect_set_size(wlr_scene_rect_from_node(wallpaper_node_), logical_width, logical_height);
+        } else if (wallpaper_node_->type == WLR_SCENE_NODE_BUFFER) {
+            wlr_scene_buffer_set_dest_size(wlr_scene_buffer_from_node(wallpaper_node_), logical_width, logical_height);
+        }
+    }
+    
+    // Open modals are laid out against the screen size
+    for (auto& [name, modal] : active_modals_) {
+        if (modal && modal->IsVisible()) {
+            modal->SetScreenSize(logical_width, logical_height);
+        }
+    }
+    RenderModals();
+    
+    // Tiled windows were laid out against the old logical size
+    AutoTile();
+}
+
+void LayerManager::SetSuspended(bool suspended) {
+    if (suspended == suspended_) {
+        return;
+    }
+    suspended_ = suspended;
+    
+    for (auto* bar : status_bars_) {
+        bar->SetSuspended(suspended);
+    }
+    
+    // Rotation restarts with a full interval rather than flipping right on wake-up
+    if (wallpaper_timer_) {
+        wl_event_source_timer_update(wallpaper_timer_, suspended_ ? 0 : wallpaper_interval_ms_);
+    }
+}
+
 struct wlr_scene_tree* LayerManager::GetLayer(Layer layer) {
     size_t index = static_cast<size_t>(layer);
     if (index >= static_cast<size_t>(Layer::COUNT)) {
@@ -155,7 +218,7 @@ UsableArea LayerManager::CalculateUsableArea(int32_t output_x, int32_t output_y,
     return area;
 }
 
-void LayerManager::TileViews(std::vector<View*>& views,
+void LayerManager::TileViews(std::pmr::vector<View*>& views,
                              Core::Tag* tag,
                              TilingLayout* layout_engine) {
     if (!output_ || !tag || !layout_engine) {
@@ -171,7 +234,9 @@ void LayerManager::TileViews(std::vector<View*>& views,
     }
     
     // Calculate usable workspace area for this output
-    auto workspace = CalculateUsableArea(0, 0, output_->width, output_->height);
+    int logical_width = 0, logical_height = 0;
+    GetLogicalSize(logical_width, logical_height);
+    auto workspace = CalculateUsableArea(0, 0, logical_width, logical_height);
     
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Tiling {} views on output '{}' in workspace: pos=({},{}), size=({}x{})",
               views.size(), output_->name,
@@ -207,10 +272,10 @@ void LayerManager::TileViews(std::vector<View*>& views,
                 // Layout engine set position relative to (0,0)
                 // We need to offset by workspace position
                 wlr_scene_node_set_position(&view->scene_tree->node,
-                                           view->x + workspace.x,
-                                           view->y + workspace.y);
+                                           view->GetX() + workspace.x,
+                                           view->GetY() + workspace.y);
                 Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "  Offset view to ({},{}) for workspace at ({},{})",
-                         view->x + workspace.x, view->y + workspace.y,
+                         view->GetX() + workspace.x, view->GetY() + workspace.y,
                          workspace.x, workspace.y);
             }
         }
@@ -294,6 +359,7 @@ void LayerManager::CreateStatusBars(const std::vector<std::string>& bar_names,
         
         // Create and render the StatusBar
         Leviathan::StatusBar* bar = new Leviathan::StatusBar(*bar_config, this, event_loop_, output_width, output_height);
+        bar->SetScale(output_->scale);
         AddStatusBar(bar);
     }
     
@@ -311,7 +377,7 @@ void LayerManager::InitializeTags(const std::vector<TagConfig>& tag_configs) {
     if (tag_configs.empty()) {
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "No tag configs provided to LayerManager for output '{}'", output_->name);
         // Create default single tag
-        auto tag = std::make_unique<Core::Tag>("1");
+        auto tag = std::make_unique<Core::Tag>("1", 0, index_);
         tag->SetVisible(true);
         tags_.push_back(std::move(tag));
     } else {
@@ -321,7 +387,7 @@ void LayerManager::InitializeTags(const std::vector<TagConfig>& tag_configs) {
             if (!tag_config.icon.empty()) {
                 tag_name = tag_config.icon + " " + tag_config.name;
             }
-            auto tag = std::make_unique<Core::Tag>(tag_name);
+            auto tag = std::make_unique<Core::Tag>(tag_name, static_cast<int>(tags_.size()), index_);
             // First tag is visible by default
             tag->SetVisible(tags_.empty());
             tags_.push_back(std::move(tag));
@@ -358,7 +424,9 @@ void LayerManager::ToggleModal(const std::string& modal_name) {
         }
         
         // Set screen size
-        modal->SetScreenSize(output_->width, output_->height);
+        int logical_width = 0, logical_height = 0;
+        GetLogicalSize(logical_width, logical_height);
+        modal->SetScreenSize(logical_width, logical_height);
         
         // Show and store the modal
         modal->Show();
@@ -381,8 +449,8 @@ bool LayerManager::HandleModalScroll(int x, int y, double delta_x, double delta_
     for (const auto& [name, modal] : active_modals_) {
         if (modal && modal->IsVisible()) {
             if (modal->HandleScroll(x, y, delta_x, delta_y)) {
-                // Modal handled the scroll, trigger re-render
-                RenderModals();
+                // Modal handled the scroll; only its content box changed
+                RenderModals(true);
                 return true;
             }
         }
@@ -419,6 +487,11 @@ void LayerManager::SwitchToTag(int index) {
     new_tag->SetVisible(true);
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Switched to tag {} on output '{}'", index, output_->name);
     
+    // Windows on the old tag get suspended once it stays hidden
+    if (server_) {
+        server_->ScheduleVisibilityUpdate();
+    }
+    
     // Publish tag switched event
     Core::TagSwitchedEvent event(old_tag, new_tag, nullptr);  // TODO: Pass screen once available
     Core::EventBus::Instance().Publish(event);
@@ -451,6 +524,7 @@ void LayerManager::SetLayout(LayoutType layout) {
     tag->SetLayout(layout);
     AutoTile();
     
+    Core::EventBus::Instance().Publish(Core::LayoutChangedEvent(tag));
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Set layout for output '{}' tag {}", output_->name, current_tag_index_);
 }
 
@@ -572,12 +646,12 @@ void LayerManager::AutoTile() {
         return;
     }
     
-    // Collect views that should be tiled
-    std::vector<View*> tiled_views;
+    // Collect views that should be tiled (scratch, freed with the frame)
+    auto tiled_views = Core::MakeFrameVector<View*>();
     const auto& clients = tag->GetClients();
     for (auto* client : clients) {
         auto* view = client->GetView();
-        if (view && view->mapped && !view->is_floating && !view->is_fullscreen) {
+        if (view && client->IsMapped() && !client->IsFloating() && !client->IsFullscreen()) {
             tiled_views.push_back(view);
         }
     }
@@ -586,6 +660,11 @@ void LayerManager::AutoTile() {
         TileViews(tiled_views, tag, layout_engine_);
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Auto-tiled {} views on output '{}'", tiled_views.size(), output_->name);
     }
+    
+    // Maps, unmaps, moves between tags and layout changes all retile
+    if (server_) {
+        server_->ScheduleVisibilityUpdate();
+    }
 }
 
 void LayerManager::UpdateNightLight() {
@@ -716,8 +795,16 @@ void LayerManager::InitializeWallpaper() {
         return;
     }
     
+    if (wallpaper_config->type == WallpaperType::SolidColor) {
+        SetSolidWallpaper(wallpaper_config->color);
+        return;
+    }
+    
     if (wallpaper_config->wallpapers.empty()) {
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Wallpaper config '{}' has no wallpaper paths", monitor_config_->wallpaper);
+        if (!wallpaper_config->color.empty()) {
+            SetSolidWallpaper(wallpaper_config->color);
+        }
         return;
     }
     
@@ -733,6 +820,9 @@ void LayerManager::InitializeWallpaper() {
     wallpaper_buffer_ = LoadWallpaperImage(wallpaper_path, output_->width, output_->height);
     if (!wallpaper_buffer_) {
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to load wallpaper image '{}'", wallpaper_path);
+        if (!wallpaper_config->color.empty()) {
+            SetSolidWallpaper(wallpaper_config->color);
+        }
         return;
     }
     
@@ -752,6 +842,11 @@ void LayerManager::InitializeWallpaper() {
     
     wallpaper_node_ = &scene_buffer->node;
     wlr_scene_node_set_position(wallpaper_node_, 0, 0);
+    
+    // The image is decoded at pixel size; scale it down to the layout size
+    int logical_width = 0, logical_height = 0;
+    GetLogicalSize(logical_width, logical_height);
+    wlr_scene_buffer_set_dest_size(scene_buffer, logical_width, logical_height);
 
     
     current_wallpaper_path_ = wallpaper_path;
@@ -760,20 +855,41 @@ void LayerManager::InitializeWallpaper() {
     if (wallpaper_config->change_interval_seconds > 0 && wallpaper_paths_.size() > 1) {
         wallpaper_timer_ = wl_event_loop_add_timer(event_loop_, WallpaperRotationCallback, this);
         if (wallpaper_timer_) {
-            wl_event_source_timer_update(wallpaper_timer_, 
-                                        wallpaper_config->change_interval_seconds * 1000);
+            wallpaper_interval_ms_ = wallpaper_config->change_interval_seconds * 1000;
+            wl_event_source_timer_update(wallpaper_timer_, suspended_ ? 0 : wallpaper_interval_ms_);
             Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Started wallpaper rotation every {} seconds for output '{}'",
                         wallpaper_config->change_interval_seconds, output_->name);
         }
     }
 }
 
+void LayerManager::SetSolidWallpaper(const std::string& color) {
+    float rgba[4];
+    ConfigParser::HexToRGBA(color, rgba);
+    
+    // A rect costs no memory and is drawn as a fill, unlike a full-output ShmBuffer
+    int logical_width = 0, logical_height = 0;
+    GetLogicalSize(logical_width, logical_height);
+    struct wlr_scene_rect* rect = wlr_scene_rect_create(GetBackgroundLayer(), logical_width, logical_height, rgba);
+    if (!rect) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create solid wallpaper for output '{}'", output_->name);
+        return;
+    }
+    
+    wallpaper_node_ = &rect->node;
+    wlr_scene_node_set_position(wallpaper_node_, 0, 0);
+    current_wallpaper_path_.clear();
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set solid wallpaper {} for output '{}'", color, output_->name);
+}
+
 void LayerManager::ClearWallpaper() {
     // Remove rotation timer
     if (wallpaper_timer_) {
         wl_event_source_remove(wallpaper_timer_);
         wallpaper_timer_ = nullptr;
     }
+    wallpaper_interval_ms_ = 0;
     
     // Destroy wallpaper scene node (this will also drop the buffer reference)
     if (wallpaper_node_) {
@@ -832,10 +948,17 @@ void LayerManager::NextWallpaper() {
 int LayerManager::WallpaperRotationCallback(void* data) {
     LayerManager* manager = static_cast<LayerManager*>(data);
     manager->NextWallpaper();
-    return 0;  // Timer will be re-armed in SetWallpaper if needed
+    
+    // Timers are one-shot; SetSuspended re-arms it on resume
+    if (manager->wallpaper_timer_ && !manager->suspended_) {
+        wl_event_source_timer_update(manager->wallpaper_timer_, manager->wallpaper_interval_ms_);
+    }
+    return 0;
 }
 
-void LayerManager::RenderModals() {
+void LayerManager::RenderModals(bool content_only) {
+    OverlaySurface* overlay = overlays_->GetSurface("modal");
+    
     // Find the topmost visible modal
     UI::Modal* visible_modal = nullptr;
     for (auto& [name, modal] : active_modals_) {
@@ -846,100 +969,34 @@ void LayerManager::RenderModals() {
         }
     }
     
-    // If no visible modal, hide the scene buffer
+    // If no visible modal, hide the overlay and hand its buffer back to the pool
     if (!visible_modal) {
-        if (modal_scene_buffer_) {
-            wlr_scene_node_set_enabled(&modal_scene_buffer_->node, false);
-        }
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "No visible modal, hiding modal scene buffer");
+        overlay->Hide();
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "No visible modal, hiding modal overlay");
         return;
     }
     
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Rendering visible modal to top layer");
     
-    // Modal always renders full screen
-    int modal_width = output_->width;
-    int modal_height = output_->height;
-    
-    // Create SHM buffer if it doesn't exist
-    // Note: We recreate on every render for simplicity
-    // Could optimize by caching and only recreating on size change
-    if (modal_shm_buffer_) {
-        // Drop the old buffer (reference counted)
-        wlr_buffer_drop(modal_shm_buffer_->GetWlrBuffer());
-        modal_shm_buffer_ = nullptr;
-    }
-    
-    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Creating modal buffer: {}x{}", modal_width, modal_height);
-    modal_shm_buffer_ = ShmBuffer::Create(modal_width, modal_height);
-    if (!modal_shm_buffer_) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create SHM buffer for modal");
-        return;
-    }
-    
-    // Create Cairo surface for rendering
-    cairo_surface_t* surface = cairo_image_surface_create_for_data(
-        reinterpret_cast<unsigned char*>(modal_shm_buffer_->GetData()),
-        CAIRO_FORMAT_ARGB32,
-        modal_width, modal_height,
-        modal_shm_buffer_->GetStride()
-    );
-    
-    if (!surface) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create Cairo surface for modal");
-        return;
+    // Modal always renders full screen, but a scroll only changes the box in the middle
+    OverlayRect damage;
+    if (content_only) {
+        visible_modal->GetContentBounds(damage.x, damage.y, damage.width, damage.height);
     }
     
-    cairo_t* cr = cairo_create(surface);
+    int logical_width = 0, logical_height = 0;
+    GetLogicalSize(logical_width, logical_height);
+    cairo_t* cr = overlay->BeginFrame(logical_width, logical_height, content_only ? &damage : nullptr);
     if (!cr) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create Cairo context for modal");
-        cairo_surface_destroy(surface);
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to get overlay buffer for modal");
         return;
     }
     
-    // Clear buffer (transparent)
-    cairo_save(cr);
-    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(cr);
-    cairo_restore(cr);
-    
-    // Render the modal
+    // Render the modal (clipped to the damaged area)
     visible_modal->Render(cr);
     
-    // Flush Cairo
-    cairo_surface_flush(surface);
-    
-    // Cleanup Cairo resources
-    cairo_destroy(cr);
-    cairo_surface_destroy(surface);
-    
-    // Create or update scene buffer in Top layer
-    auto* top_layer = GetTopLayer();
-    if (!modal_scene_buffer_ && top_layer) {
-        modal_scene_buffer_ = wlr_scene_buffer_create(
-            top_layer,
-            modal_shm_buffer_->GetWlrBuffer()
-        );
-        
-        if (!modal_scene_buffer_) {
-            Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create scene buffer for modal");
-            return;
-        }
-        
-        // Position at (0, 0) since modal covers full screen
-        wlr_scene_node_set_position(&modal_scene_buffer_->node, 0, 0);
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Created modal scene buffer in Top layer");
-    } else if (modal_scene_buffer_) {
-        // Update existing buffer
-        wlr_scene_buffer_set_buffer(modal_scene_buffer_, modal_shm_buffer_->GetWlrBuffer());
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Updated modal scene buffer");
-    }
-    
-    // Ensure the scene buffer is visible
-    if (modal_scene_buffer_) {
-        wlr_scene_node_set_enabled(&modal_scene_buffer_->node, true);
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Modal rendered and displayed on Top layer");
-    }
+    // Position at (0, 0) since modal covers full screen
+    overlay->EndFrame(0, 0);
 }
 
 void LayerManager::RenderPopovers() {
@@ -988,11 +1045,11 @@ void LayerManager::RenderPopovers() {
         }
     }
     
+    OverlaySurface* overlay = overlays_->GetSurface("popover");
+    
     // If no visible popover, hide the Top layer buffer
     if (!visible_popover) {
-        if (popover_scene_buffer_) {
-            wlr_scene_node_set_enabled(&popover_scene_buffer_->node, false);
-        }
+        overlay->Hide();
         is_rendering_popover_ = false;
         return;
     }
@@ -1006,16 +1063,14 @@ void LayerManager::RenderPopovers() {
     // Validate dimensions
     if (popover_width <= 0 || popover_height <= 0) {
         Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Invalid popover dimensions: {}x{}", popover_width, popover_height);
-        if (popover_scene_buffer_) {
-            wlr_scene_node_set_enabled(&popover_scene_buffer_->node, false);
-        }
+        overlay->Hide();
         is_rendering_popover_ = false;
         return;
     }
     
     // Adjust popover position to keep it on screen
-    int output_width = output_->width;
-    int output_height = output_->height;
+    int output_width = 0, output_height = 0;
+    GetLogicalSize(output_width, output_height);
     
     if (popover_x + popover_width > output_width) {
         popover_x = output_width - popover_width;
@@ -1029,105 +1084,24 @@ void LayerManager::RenderPopovers() {
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Rendering popover at ({}, {}) size {}x{}", 
               popover_x, popover_y, popover_width, popover_height);
     
-    // Create or recreate SHM buffer if size changed
-    bool need_new_buffer = false;
-    if (!popover_shm_buffer_) {
-        need_new_buffer = true;
-    } else {
-        int current_width = cairo_image_surface_get_width(popover_cairo_surface_);
-        int current_height = cairo_image_surface_get_height(popover_cairo_surface_);
-        if (current_width != popover_width || current_height != popover_height) {
-            need_new_buffer = true;
-        }
-    }
-    
-    if (need_new_buffer) {
-        // Cleanup old resources
-        if (popover_cairo_) {
-            cairo_destroy(popover_cairo_);
-            popover_cairo_ = nullptr;
-        }
-        if (popover_cairo_surface_) {
-            cairo_surface_destroy(popover_cairo_surface_);
-            popover_cairo_surface_ = nullptr;
-        }
-        if (popover_shm_buffer_) {
-            wlr_buffer_drop(popover_shm_buffer_->GetWlrBuffer());
-            popover_shm_buffer_ = nullptr;
-            popover_buffer_data_ = nullptr;
-        }
-        
-        // Create new buffer
-        popover_shm_buffer_ = ShmBuffer::Create(popover_width, popover_height);
-        if (!popover_shm_buffer_) {
-            Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create SHM buffer for popover");
-            is_rendering_popover_ = false;
-            return;
-        }
-        
-        popover_buffer_data_ = static_cast<uint32_t*>(popover_shm_buffer_->GetData());
-        
-        // Create Cairo surface
-        popover_cairo_surface_ = cairo_image_surface_create_for_data(
-            reinterpret_cast<unsigned char*>(popover_buffer_data_),
-            CAIRO_FORMAT_ARGB32,
-            popover_width,
-            popover_height,
-            popover_shm_buffer_->GetStride()
-        );
-        
-        popover_cairo_ = cairo_create(popover_cairo_surface_);
-        popover_buffer_attached_ = false;
+    // Reuses a pooled buffer; cleared to transparent
+    cairo_t* cr = overlay->BeginFrame(popover_width, popover_height);
+    if (!cr) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to get overlay buffer for popover");
+        is_rendering_popover_ = false;
+        return;
     }
     
-    // Clear the popover surface (fully transparent)
-    cairo_save(popover_cairo_);
-    cairo_set_operator(popover_cairo_, CAIRO_OPERATOR_CLEAR);
-    cairo_paint(popover_cairo_);
-    cairo_restore(popover_cairo_);
-    
     // Render the popover at (0, 0) on its own surface
     // Save and restore position since popover renders to its own surface
     int saved_x, saved_y;
     visible_popover->GetPosition(saved_x, saved_y);
     visible_popover->SetPosition(0, 0);
-    visible_popover->Render(popover_cairo_);
+    visible_popover->Render(cr);
     visible_popover->SetPosition(saved_x, saved_y);
     
-    cairo_surface_flush(popover_cairo_surface_);
-    
-    // Upload to scene buffer
-    if (!popover_shm_buffer_ || !popover_cairo_) {
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Cannot upload popover - missing buffer or cairo");
-        is_rendering_popover_ = false;
-        return;
-    }
-    
-    wlr_buffer* wlr_buf = popover_shm_buffer_->GetWlrBuffer();
-    
-    // Create or update scene buffer in Top layer
-    auto* top_layer = GetTopLayer();
-    if (!popover_scene_buffer_ && top_layer) {
-        popover_scene_buffer_ = wlr_scene_buffer_create(top_layer, wlr_buf);
-        if (!popover_scene_buffer_) {
-            Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create popover scene buffer");
-            is_rendering_popover_ = false;
-            return;
-        }
-        wlr_scene_node_set_position(&popover_scene_buffer_->node, popover_x, popover_y);
-        popover_buffer_attached_ = true;
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Created popover scene buffer in Top layer");
-    } else if (popover_scene_buffer_) {
-        wlr_scene_buffer_set_buffer(popover_scene_buffer_, wlr_buf);
-        wlr_scene_node_set_position(&popover_scene_buffer_->node, popover_x, popover_y);
-    }
-    
-    // Raise to top and enable
-    if (popover_scene_buffer_) {
-        wlr_scene_node_raise_to_top(&popover_scene_buffer_->node);
-        wlr_scene_node_set_enabled(&popover_scene_buffer_->node, true);
-        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Popover rendered and uploaded to Top layer at ({}, {})", popover_x, popover_y);
-    }
+    overlay->EndFrame(popover_x, popover_y);
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Popover rendered and uploaded to Top layer at ({}, {})", popover_x, popover_y);
     
     is_rendering_popover_ = false;
 }
@@ -96,7 +96,9 @@ void LayerSurfaceManager::HandleMap(struct wl_listener* listener, void* data) {
         struct wlr_output_layout* layout = server->GetOutputLayout();
         wlr_output = wlr_output_layout_output_at(layout, 0, 0);
         if (wlr_output) {
-            wlr_layer_surface_v1_configure(wlr_ls, wlr_output->width, wlr_output->height);
+            int width = 0, height = 0;
+            wlr_output_effective_resolution(wlr_output, &width, &height);
+            wlr_layer_surface_v1_configure(wlr_ls, width, height);
             Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Assigned layer surface to output");
         } else {
             Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "No output available for layer surface!");
@@ -187,9 +189,11 @@ void LayerSurfaceManager::HandleCommit(struct wl_listener* listener, void* data)
             uint32_t width = wlr_ls->current.desired_width;
             uint32_t height = wlr_ls->current.desired_height;
             
-            // If client didn't specify size, use output size
-            if (width == 0) width = wlr_ls->output->width;
-            if (height == 0) height = wlr_ls->output->height;
+            // If client didn't specify size, use output size (surface-local, so logical)
+            int output_width = 0, output_height = 0;
+            wlr_output_effective_resolution(wlr_ls->output, &output_width, &output_height);
+            if (width == 0) width = output_width;
+            if (height == 0) height = output_height;
             
             wlr_layer_surface_v1_configure(wlr_ls, width, height);
             Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Sent initial configure to layer surface: {}x{}", width, height);
@@ -3,16 +3,46 @@
 #include "Logger.hpp"
 #include "wayland/Server.hpp"
 #include "wayland/LayerManager.hpp"
+#include "wayland/View.hpp"
+#include "core/Client.hpp"
 #include "core/Seat.hpp"
+#include "core/AllocationCounter.hpp"
+#include "core/FrameArena.hpp"
+#include "config/ConfigParser.hpp"
 #include "wayland/WaylandTypes.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 
 namespace Leviathan {
 namespace Wayland {
 
+OutputManager::FrameObserver OutputManager::frame_observer_;
+
+namespace {
+
+// Render time slack: covers the commit and a late wakeup
+constexpr uint64_t PACING_MARGIN_NS = 1000000;
+
+// Holding a frame for less than this is not worth a timer round trip
+constexpr uint64_t PACING_MIN_DELAY_NS = 1000000;
+
+uint64_t TimespecToNs(const struct timespec& ts) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+uint64_t NowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return TimespecToNs(now);
+}
+
+} // namespace
+
 Output::Output(struct wlr_output* output, Server* srv)
-    : wlr_output(output), scene_output(nullptr), core_screen(nullptr), server(srv), layer_manager(nullptr) {
+    : wlr_output(output), scene_output(nullptr), repaint_timer(nullptr), core_screen(nullptr), server(srv), layer_manager(nullptr) {
+    frame_stats.allocation_mark = Core::GetAllocationCount();
+    frame_stats.allocated_bytes_mark = Core::GetAllocatedBytes();
 }
 
 Output::~Output() {
@@ -36,7 +66,6 @@ Output::~Output() {
 }
 
 void OutputManager::HandleFrame(struct wl_listener* listener, void* data) {
-    // Frame callback - render and notify clients
     Output* output = wl_container_of(listener, output, frame);
     
     if (!output->scene_output) {
@@ -44,30 +73,293 @@ void OutputManager::HandleFrame(struct wl_listener* listener, void* data) {
         return;
     }
     
+    if (output->pacing.frame_pending) {
+        return;
+    }
+    
+    uint64_t now_ns = NowNs();
+    uint64_t delay_ns = ComputeFrameDelay(output, now_ns);
+    if (delay_ns >= PACING_MIN_DELAY_NS && output->repaint_timer) {
+        // Render as late as possible: clients get their frame callbacks
+        // closer to vblank, so what they draw next is fresher
+        output->pacing.frame_pending = true;
+        output->pacing.frame_requested_ns = now_ns;
+        wl_event_source_timer_update(output->repaint_timer, static_cast<int>(delay_ns / 1000000));
+        return;
+    }
+    
+    output->frame_stats.last_delay_ns = 0;
+    RenderFrame(output);
+}
+
+int OutputManager::HandleRepaintTimer(void* data) {
+    Output* output = static_cast<Output*>(data);
+    output->pacing.frame_pending = false;
+    output->frame_stats.last_delay_ns = NowNs() - output->pacing.frame_requested_ns;
+    RenderFrame(output);
+    return 0;
+}
+
+void OutputManager::HandlePresent(struct wl_listener* listener, void* data) {
+    Output* output = wl_container_of(listener, output, present);
+    auto* event = static_cast<struct wlr_output_event_present*>(data);
+    
+    if (!event->presented) {
+        return;
+    }
+    
+    // wp_presentation feedback itself is sent by the scene; keep the
+    // timing to predict the next vblank
+    output->frame_stats.presented++;
+    output->pacing.last_present_ns = TimespecToNs(event->when);
+    output->pacing.refresh_ns = event->refresh > 0 ? static_cast<uint64_t>(event->refresh) : 0;
+}
+
+void OutputManager::HandleCommit(struct wl_listener* listener, void* data) {
+    Output* output = wl_container_of(listener, output, commit);
+    auto* event = static_cast<struct wlr_output_event_commit*>(data);
+    
+    // Any of these changes the logical size (wlr-output-management, monitor groups, Screen::SetScale)
+    if (!(event->state->committed & (WLR_OUTPUT_STATE_SCALE | WLR_OUTPUT_STATE_MODE | WLR_OUTPUT_STATE_TRANSFORM))) {
+        return;
+    }
+    
+    // Clients learn the new scale from the scene (wp_fractional_scale_v1 and
+    // wl_surface.preferred_buffer_scale); compositor-drawn UI is redrawn here
+    float scale = output->wlr_output->scale;
+    if (output->core_screen) {
+        output->core_screen->SyncFromOutput();
+    }
+    if (output->layer_manager) {
+        output->layer_manager->SetScale(scale);
+    }
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Output '{}' is now {}x{} at scale {:.2f}", output->wlr_output->name,
+                               output->wlr_output->width, output->wlr_output->height, scale);
+}
+
+uint64_t OutputManager::ComputeFrameDelay(Output* output, uint64_t now_ns) {
+    const auto& rendering = Config().rendering;
+    const auto& pacing = output->pacing;
+    if (!rendering.frame_pacing || pacing.refresh_ns == 0 || pacing.last_present_ns == 0 ||
+        pacing.last_present_ns > now_ns) {
+        return 0;
+    }
+    
+    // Next vblank after now
+    uint64_t since_present = now_ns - pacing.last_present_ns;
+    uint64_t next_vblank = pacing.last_present_ns + (since_present / pacing.refresh_ns + 1) * pacing.refresh_ns;
+    
+    uint64_t budget = rendering.max_render_time > 0
+        ? static_cast<uint64_t>(rendering.max_render_time) * 1000000ULL
+        : pacing.render_estimate_ns + PACING_MARGIN_NS;
+    
+    if (now_ns + budget >= next_vblank) {
+        return 0;
+    }
+    return next_vblank - budget - now_ns;
+}
+
+void OutputManager::RenderFrame(Output* output) {
+    if (!output->scene_output) {
+        return;
+    }
+    
     // Update night light effect (checks time and applies color temperature)
     if (output->layer_manager) {
         output->layer_manager->UpdateNightLight();
     }
     
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
     // Render the scene if needed and commit the output
-    if (!wlr_scene_output_commit(output->scene_output, nullptr)) {
-        // Scene is clean, nothing needs to be rendered
-        // Still need to send frame_done to keep clients updated
+    if (!CommitScene(output)) {
+        // Commit failed; still need to send frame_done to keep clients updated
+    }
+    
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    uint64_t render_ns = TimespecToNs(end) - TimespecToNs(start);
+    
+    // Jumps up at once, decays by 1/16 per frame
+    auto& pacing = output->pacing;
+    if (render_ns >= pacing.render_estimate_ns) {
+        pacing.render_estimate_ns = render_ns;
+    } else {
+        pacing.render_estimate_ns -= (pacing.render_estimate_ns - render_ns) / 16;
     }
     
+    auto& stats = output->frame_stats;
+    uint64_t allocations = Core::GetAllocationCount();
+    uint64_t allocated_bytes = Core::GetAllocatedBytes();
+    stats.frames++;
+    stats.last_render_ns = render_ns;
+    stats.max_render_ns = std::max(stats.max_render_ns, render_ns);
+    stats.last_allocations = allocations - stats.allocation_mark;
+    stats.last_allocated_bytes = allocated_bytes - stats.allocated_bytes_mark;
+    stats.allocation_mark = allocations;
+    stats.allocated_bytes_mark = allocated_bytes;
+    
+    bool software_cursor = UsesSoftwareCursor(output->wlr_output);
+    if (software_cursor) {
+        stats.software_cursor_frames++;
+        if (!stats.software_cursor) {
+            stats.software_cursor_fallbacks++;
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Output '{}' fell back to a software cursor", output->wlr_output->name);
+        }
+    }
+    stats.software_cursor = software_cursor;
+    
+    if (frame_observer_) {
+        frame_observer_(output, render_ns);
+    }
+    
+    // Per-frame scratch memory is dead once the frame is out
+    Core::FrameArena::Instance().Reset();
+    
     // CRITICAL: Send frame_done to all surfaces so they know we're ready for next frame
-    // Without this, clients will render once and then freeze waiting for us
-    struct timespec now;
-    clock_gettime(CLOCK_MONOTONIC, &now);
-    wlr_scene_output_send_frame_done(output->scene_output, &now);
+    // Without this, clients will render once and then freeze waiting for us.
+    // The governor holds back callbacks of capped clients until they are due
+    auto* governor = output->server ? output->server->GetFrameGovernor() : nullptr;
+    if (governor) {
+        governor->SendFrameDone(output, end);
+    } else {
+        wlr_scene_output_send_frame_done(output->scene_output, &end);
+    }
+    
+    // Window moves and resizes reach the snapshot from here
+    if (auto* publisher = output->server ? output->server->GetStatePublisher() : nullptr) {
+        publisher->CheckForChanges();
+    }
+}
+
+bool OutputManager::CommitScene(Output* output) {
+    auto& sync = output->sync;
+    struct wlr_output* wlr_output = output->wlr_output;
+    
+    bool vrr = WantsAdaptiveSync(output);
+    if (vrr != sync.adaptive_sync_wanted) {
+        sync.adaptive_sync_wanted = vrr;
+        sync.rejected_adaptive_sync = -1;
+    }
+    bool vrr_enabled = wlr_output->adaptive_sync_status == WLR_OUTPUT_ADAPTIVE_SYNC_ENABLED;
+    bool vrr_change = vrr != vrr_enabled && sync.rejected_adaptive_sync != static_cast<int>(vrr);
+    
+    if (!vrr_change && !wlr_scene_output_needs_frame(output->scene_output)) {
+        return true;
+    }
+    
+    struct wlr_output_state state;
+    wlr_output_state_init(&state);
+    if (!wlr_scene_output_build_state(output->scene_output, &state, nullptr)) {
+        wlr_output_state_finish(&state);
+        return false;
+    }
+    
+    if (vrr_change) {
+        wlr_output_state_set_adaptive_sync_enabled(&state, vrr);
+        if (!wlr_output_test_state(wlr_output, &state)) {
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Output '{}' does not support {} adaptive sync",
+                         wlr_output->name, vrr ? "enabling" : "disabling");
+            sync.rejected_adaptive_sync = static_cast<int>(vrr);
+            state.committed &= ~WLR_OUTPUT_STATE_ADAPTIVE_SYNC_ENABLED;
+        }
+    }
+    
+    // Fall back to a regular flip if the backend can't tear with this state
+    state.tearing_page_flip = WantsTearing(output);
+    if (state.tearing_page_flip && !wlr_output_test_state(wlr_output, &state)) {
+        state.tearing_page_flip = false;
+    }
+    
+    bool committed = wlr_output_commit_state(wlr_output, &state);
+    sync.tearing_active = committed && state.tearing_page_flip;
+    wlr_output_state_finish(&state);
+    return committed;
+}
+
+View* OutputManager::GetFullscreenView(Output* output) {
+    if (!output->server || !output->layer_manager) {
+        return nullptr;
+    }
+    View* view = output->server->GetFocusedView();
+    if (!view || !view->client || !view->IsMapped() || !view->IsFullscreen()) {
+        return nullptr;
+    }
+    return view->client->GetOutputIndex() == output->layer_manager->GetIndex() ? view : nullptr;
+}
+
+bool OutputManager::WantsAdaptiveSync(Output* output) {
+    switch (output->sync.adaptive_sync) {
+        case AdaptiveSyncMode::ON:
+            return true;
+        case AdaptiveSyncMode::AUTO:
+            return GetFullscreenView(output) != nullptr;
+        case AdaptiveSyncMode::OFF:
+        default:
+            return false;
+    }
+}
+
+bool OutputManager::WantsTearing(Output* output) {
+    if (!output->sync.allow_tearing || !output->server) {
+        return false;
+    }
+    View* view = GetFullscreenView(output);
+    auto* tearing_control = output->server->GetTearingControl();
+    if (!view || !view->surface || !tearing_control) {
+        return false;
+    }
+    return wlr_tearing_control_manager_v1_surface_hint_from_surface(tearing_control, view->surface) ==
+           WP_TEARING_CONTROL_V1_PRESENTATION_HINT_ASYNC;
+}
+
+void OutputManager::UpdateSyncState(Output* output) {
+    if (!output->scene_output || !output->wlr_output->enabled) {
+        return;
+    }
+    bool vrr = WantsAdaptiveSync(output);
+    bool vrr_enabled = output->wlr_output->adaptive_sync_status == WLR_OUTPUT_ADAPTIVE_SYNC_ENABLED;
+    bool retry = vrr != output->sync.adaptive_sync_wanted || output->sync.rejected_adaptive_sync != static_cast<int>(vrr);
+    if (vrr != vrr_enabled && retry) {
+        wlr_output_schedule_frame(output->wlr_output);
+    }
+}
+
+bool OutputManager::UsesSoftwareCursor(struct wlr_output* wlr_output) {
+    struct wlr_output_cursor* cursor;
+    wl_list_for_each(cursor, &wlr_output->cursors, link) {
+        if (cursor->enabled && cursor->visible && wlr_output->hardware_cursor != cursor) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void OutputManager::SetFrameObserver(FrameObserver observer) {
+    frame_observer_ = std::move(observer);
 }
 
 void OutputManager::HandleDestroy(struct wl_listener* listener, void* data) {
     Output* output = wl_container_of(listener, output, destroy);
     
     wl_list_remove(&output->frame.link);
+    wl_list_remove(&output->present.link);
+    wl_list_remove(&output->commit.link);
     wl_list_remove(&output->destroy.link);
+    if (output->repaint_timer) {
+        wl_event_source_remove(output->repaint_timer);
+        output->repaint_timer = nullptr;
+    }
+    wl_list_remove(&output->link);
+    
+    // Undocking can make a different monitor group match the remaining outputs
+    Server* server = output->server;
     delete output;
+    if (server) {
+        server->ScheduleMonitorGroupConfiguration();
+    }
 }
 
 void OutputManager::HandleNewOutput(struct wl_listener* listener, void* data) {
@@ -0,0 +1,359 @@
+#include "wayland/OverlaySurfaceManager.hpp"
+#include "wayland/WaylandTypes.hpp"
+#include "ui/ShmBuffer.hpp"
+#include "Logger.hpp"
+
+#include <wlr/types/wlr_scene.h>
+#include <cairo/cairo.h>
+#include <pixman.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Leviathan {
+namespace Wayland {
+
+namespace {
+
+uint64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int RoundUp(int value, int bucket) {
+    return ((value + bucket - 1) / bucket) * bucket;
+}
+
+// Logical size to buffer pixels
+int ToPixels(int value, float scale) {
+    return static_cast<int>(std::ceil(value * scale));
+}
+
+} // namespace
+
+struct OverlaySurface::PooledBuffer {
+    ShmBuffer* buffer = nullptr;
+    cairo_surface_t* surface = nullptr;
+    cairo_t* cr = nullptr;
+    int width = 0;   // Pixels
+    int height = 0;
+    float scale = 1.0f;
+    bool in_use = false;
+    uint64_t released_ms = 0;
+};
+
+// ---------------------------------------------------------------------------
+// OverlaySurface
+// ---------------------------------------------------------------------------
+
+OverlaySurface::OverlaySurface(OverlaySurfaceManager* manager, struct wlr_scene_tree* parent)
+    : manager_(manager) {
+    node_ = wlr_scene_buffer_create(parent, nullptr);
+    if (node_) {
+        wlr_scene_node_set_enabled(&node_->node, false);
+    }
+}
+
+OverlaySurface::~OverlaySurface() {
+    if (node_) {
+        wlr_scene_node_destroy(&node_->node);
+        node_ = nullptr;
+    }
+}
+
+cairo_t* OverlaySurface::BeginFrame(int width, int height, const OverlayRect* damage) {
+    if (width <= 0 || height <= 0 || !node_) {
+        return nullptr;
+    }
+    
+    // Keep the current buffer while it still fits this size's bucket at this scale
+    float scale = manager_->GetScale();
+    if (buffer_ && (buffer_->scale != scale ||
+                    buffer_->width != RoundUp(ToPixels(width, scale), OverlaySurfaceManager::BUCKET) ||
+                    buffer_->height != RoundUp(ToPixels(height, scale), OverlaySurfaceManager::BUCKET))) {
+        manager_->Release(buffer_);
+        buffer_ = nullptr;
+    }
+    if (!buffer_) {
+        buffer_ = manager_->Acquire(width, height);
+        if (!buffer_) {
+            return nullptr;
+        }
+        full_damage_ = true;
+    }
+    
+    // Old pixels are only worth keeping if they were drawn at this size
+    if (width != width_ || height != height_ || !visible_) {
+        full_damage_ = true;
+    }
+    width_ = width;
+    height_ = height;
+    
+    if (full_damage_ || !damage) {
+        damage_ = OverlayRect{0, 0, width, height};
+        full_damage_ = true;
+    } else {
+        int x1 = std::max(damage->x, 0);
+        int y1 = std::max(damage->y, 0);
+        int x2 = std::min(damage->x + damage->width, width);
+        int y2 = std::min(damage->y + damage->height, height);
+        damage_ = OverlayRect{x1, y1, std::max(x2 - x1, 0), std::max(y2 - y1, 0)};
+    }
+    
+    cairo_t* cr = buffer_->cr;
+    cairo_save(cr);
+    cairo_rectangle(cr, damage_.x, damage_.y, damage_.width, damage_.height);
+    cairo_clip(cr);
+    
+    // Clear the damaged area (fully transparent)
+    cairo_save(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(cr);
+    cairo_restore(cr);
+    
+    in_frame_ = true;
+    return cr;
+}
+
+void OverlaySurface::EndFrame(int x, int y) {
+    if (!in_frame_ || !buffer_) {
+        return;
+    }
+    in_frame_ = false;
+    
+    cairo_restore(buffer_->cr);
+    cairo_surface_flush(buffer_->surface);
+    
+    // The pooled buffer can be larger than the overlay; only show our part,
+    // at its logical size (the buffer holds scale pixels per unit)
+    float scale = buffer_->scale;
+    struct wlr_fbox source = {0, 0, static_cast<double>(ToPixels(width_, scale)), static_cast<double>(ToPixels(height_, scale))};
+    wlr_scene_buffer_set_source_box(node_, &source);
+    wlr_scene_buffer_set_dest_size(node_, width_, height_);
+    
+    struct wlr_buffer* wlr_buf = buffer_->buffer->GetWlrBuffer();
+    if (full_damage_) {
+        wlr_scene_buffer_set_buffer(node_, wlr_buf);
+    } else if (damage_.width > 0 && damage_.height > 0) {
+        // Same buffer, drawn in place: only re-upload what changed (buffer pixels)
+        int x1 = static_cast<int>(std::floor(damage_.x * scale));
+        int y1 = static_cast<int>(std::floor(damage_.y * scale));
+        int x2 = ToPixels(damage_.x + damage_.width, scale);
+        int y2 = ToPixels(damage_.y + damage_.height, scale);
+        pixman_region32_t region;
+        pixman_region32_init_rect(&region, x1, y1, x2 - x1, y2 - y1);
+        wlr_scene_buffer_set_buffer_with_damage(node_, wlr_buf, &region);
+        pixman_region32_fini(&region);
+    }
+    full_damage_ = false;
+    
+    wlr_scene_node_set_position(&node_->node, x, y);
+    wlr_scene_node_raise_to_top(&node_->node);
+    wlr_scene_node_set_enabled(&node_->node, true);
+    visible_ = true;
+}
+
+void OverlaySurface::Hide() {
+    if (in_frame_ && buffer_) {
+        cairo_restore(buffer_->cr);
+        in_frame_ = false;
+    }
+    
+    if (node_) {
+        wlr_scene_node_set_enabled(&node_->node, false);
+        wlr_scene_buffer_set_buffer(node_, nullptr);
+    }
+    
+    if (buffer_) {
+        manager_->Release(buffer_);
+        buffer_ = nullptr;
+    }
+    visible_ = false;
+    full_damage_ = true;
+}
+
+// ---------------------------------------------------------------------------
+// OverlaySurfaceManager
+// ---------------------------------------------------------------------------
+
+OverlaySurfaceManager::OverlaySurfaceManager(struct wlr_scene_tree* parent, struct wl_event_loop* event_loop)
+    : parent_(parent),
+      event_loop_(event_loop) {
+    if (event_loop_) {
+        idle_timer_ = wl_event_loop_add_timer(event_loop_, OnIdleTimer, this);
+    }
+}
+
+OverlaySurfaceManager::~OverlaySurfaceManager() {
+    if (idle_timer_) {
+        wl_event_source_remove(idle_timer_);
+        idle_timer_ = nullptr;
+    }
+    
+    // Detach buffers from the scene before dropping them
+    surfaces_.clear();
+    
+    for (auto& buffer : buffers_) {
+        DestroyBuffer(*buffer);
+    }
+    buffers_.clear();
+}
+
+OverlaySurface* OverlaySurfaceManager::GetSurface(const std::string& name) {
+    auto it = surfaces_.find(name);
+    if (it != surfaces_.end()) {
+        return it->second.get();
+    }
+    
+    std::unique_ptr<OverlaySurface> surface(new OverlaySurface(this, parent_));
+    OverlaySurface* result = surface.get();
+    surfaces_[name] = std::move(surface);
+    return result;
+}
+
+OverlaySurfaceManager::Stats OverlaySurfaceManager::GetStats() const {
+    Stats stats;
+    stats.buffers = buffers_.size();
+    for (const auto& buffer : buffers_) {
+        if (!buffer->in_use) {
+            stats.idle_buffers++;
+        }
+        stats.bytes += buffer->buffer->GetSize();
+    }
+    stats.allocations = allocations_;
+    stats.reuses = reuses_;
+    stats.releases = releases_;
+    return stats;
+}
+
+void OverlaySurfaceManager::SetScale(float scale) {
+    if (scale <= 0.0f || scale == scale_) {
+        return;
+    }
+    scale_ = scale;
+    
+    // Idle buffers were sized for the old scale; visible overlays switch on their next frame
+    for (auto& buffer : buffers_) {
+        if (!buffer->in_use) {
+            buffer->released_ms = 0;
+        }
+    }
+    ReleaseIdleBuffers();
+}
+
+OverlaySurfaceManager::PooledBuffer* OverlaySurfaceManager::Acquire(int width, int height) {
+    int bucket_width = RoundUp(ToPixels(width, scale_), BUCKET);
+    int bucket_height = RoundUp(ToPixels(height, scale_), BUCKET);
+    
+    for (auto& buffer : buffers_) {
+        if (!buffer->in_use && buffer->scale == scale_ && buffer->width == bucket_width && buffer->height == bucket_height) {
+            buffer->in_use = true;
+            reuses_++;
+            return buffer.get();
+        }
+    }
+    
+    ShmBuffer* shm = ShmBuffer::Create(bucket_width, bucket_height);
+    if (!shm) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create overlay buffer {}x{}", bucket_width, bucket_height);
+        return nullptr;
+    }
+    
+    auto buffer = std::make_unique<PooledBuffer>();
+    buffer->buffer = shm;
+    buffer->surface = cairo_image_surface_create_for_data(
+        static_cast<unsigned char*>(shm->GetData()),
+        CAIRO_FORMAT_ARGB32,
+        bucket_width, bucket_height,
+        shm->GetStride());
+    buffer->cr = cairo_create(buffer->surface);
+    cairo_scale(buffer->cr, scale_, scale_);
+    buffer->width = bucket_width;
+    buffer->height = bucket_height;
+    buffer->scale = scale_;
+    buffer->in_use = true;
+    allocations_++;
+    
+    Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Overlay pool: new {}x{} buffer ({} total)", bucket_width, bucket_height, buffers_.size() + 1);
+    
+    buffers_.push_back(std::move(buffer));
+    return buffers_.back().get();
+}
+
+void OverlaySurfaceManager::Release(PooledBuffer* buffer) {
+    buffer->in_use = false;
+    buffer->released_ms = NowMs();
+    ArmIdleTimer();
+}
+
+void OverlaySurfaceManager::DestroyBuffer(PooledBuffer& buffer) {
+    if (buffer.cr) {
+        cairo_destroy(buffer.cr);
+        buffer.cr = nullptr;
+    }
+    if (buffer.surface) {
+        cairo_surface_destroy(buffer.surface);
+        buffer.surface = nullptr;
+    }
+    if (buffer.buffer) {
+        // Freed once the scene lets go of it
+        wlr_buffer_drop(buffer.buffer->GetWlrBuffer());
+        buffer.buffer = nullptr;
+    }
+}
+
+void OverlaySurfaceManager::ArmIdleTimer() {
+    if (!idle_timer_) {
+        return;
+    }
+    
+    // Fire when the oldest idle buffer expires
+    uint64_t now = NowMs();
+    uint64_t next = 0;
+    for (const auto& buffer : buffers_) {
+        if (buffer->in_use) {
+            continue;
+        }
+        uint64_t expiry = buffer->released_ms + static_cast<uint64_t>(idle_timeout_ms_);
+        if (next == 0 || expiry < next) {
+            next = expiry;
+        }
+    }
+    
+    int delay = 0;  // 0 disarms the timer
+    if (next != 0) {
+        delay = next > now ? static_cast<int>(next - now) : 1;
+    }
+    wl_event_source_timer_update(idle_timer_, delay);
+}
+
+void OverlaySurfaceManager::ReleaseIdleBuffers() {
+    uint64_t now = NowMs();
+    
+    size_t before = buffers_.size();
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+        [this, now](std::unique_ptr<PooledBuffer>& buffer) {
+            if (buffer->in_use || now - buffer->released_ms < static_cast<uint64_t>(idle_timeout_ms_)) {
+                return false;
+            }
+            DestroyBuffer(*buffer);
+            return true;
+        }), buffers_.end());
+    
+    size_t released = before - buffers_.size();
+    if (released > 0) {
+        releases_ += released;
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Overlay pool: released {} idle buffer(s), {} left", released, buffers_.size());
+    }
+    
+    ArmIdleTimer();
+}
+
+int OverlaySurfaceManager::OnIdleTimer(void* data) {
+    auto* manager = static_cast<OverlaySurfaceManager*>(data);
+    manager->ReleaseIdleBuffers();
+    return 0;
+}
+
+} // namespace Wayland
+} // namespace Leviathan
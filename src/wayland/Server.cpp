@@ -3,6 +3,7 @@
 #include "wayland/View.hpp"
 #include "wayland/Input.hpp"
 #include "wayland/LayerSurface.hpp"
+#include "wayland/IdleManager.hpp"
 #include "ui/StatusBar.hpp"
 #include "ui/ModalManager.hpp"
 #include "ui/KeybindingHelpModal.hpp"
@@ -12,14 +13,19 @@
 #include "ui/menubar/MenuItemProviders.hpp"
 #include "config/ConfigParser.hpp"
 #include "core/Events.hpp"
+#include "core/AllocationCounter.hpp"
+#include "core/FrameArena.hpp"
+#include "core/SpawnHelper.hpp"
+#include "ipc/StateSnapshot.h"
 #include "Logger.hpp"
 #include "wayland/WaylandTypes.hpp"
 #include <nlohmann/json.hpp>
 #include <algorithm>
 #include <iostream>
 #include <cstring>
+#include <cstdio>
 #include <cerrno>			 // For errno and EPIPE
-#include <unistd.h>		 // For fork(), execlp(), setenv()
+#include <unistd.h>		 // For setenv()
 #include <sys/types.h> // For pid_t
 
 namespace Leviathan
@@ -96,12 +102,100 @@ namespace Leviathan
 			InputManager::HandleCursorFrame(listener, data);
 		}
 
+		static void handle_output_manager_apply(struct wl_listener *listener, void *data)
+		{
+			Server *server = wl_container_of(listener, server, output_manager_apply);
+			server->OnOutputManagerApply(static_cast<struct wlr_output_configuration_v1 *>(data), false);
+		}
+
+		static void handle_output_manager_test(struct wl_listener *listener, void *data)
+		{
+			Server *server = wl_container_of(listener, server, output_manager_test);
+			server->OnOutputManagerApply(static_cast<struct wlr_output_configuration_v1 *>(data), true);
+		}
+
+		static void handle_output_layout_change(struct wl_listener *listener, void *data)
+		{
+			Server *server = wl_container_of(listener, server, output_layout_change);
+			server->OnOutputLayoutChange();
+		}
+
+		static void handle_monitor_config_idle(void *data)
+		{
+			static_cast<Server *>(data)->OnMonitorConfigIdle();
+		}
+
+		static void handle_output_manager_idle(void *data)
+		{
+			static_cast<Server *>(data)->OnOutputManagerIdle();
+		}
+
+		// Hidden this long before a window is suspended, so quick tag flips don't thrash
+		static constexpr uint64_t SUSPEND_DELAY_MS = 1000;
+
+		static void handle_visibility_idle(void *data)
+		{
+			static_cast<Server *>(data)->OnVisibilityIdle();
+		}
+
+		static int handle_suspend_timer(void *data)
+		{
+			static_cast<Server *>(data)->OnSuspendTimer();
+			return 0;
+		}
+
+		static int handle_spawn_replies(int fd, uint32_t mask, void *data)
+		{
+			static_cast<Server *>(data)->OnSpawnReplies(mask);
+			return 0;
+		}
+
+		static void handle_request_cursor(struct wl_listener *listener, void *data)
+		{
+			InputManager::HandleRequestCursor(listener, data);
+		}
+
+		static void handle_request_cursor_shape(struct wl_listener *listener, void *data)
+		{
+			InputManager::HandleRequestCursorShape(listener, data);
+		}
+
 		static void handle_xwayland_ready(struct wl_listener *listener, void *data)
 		{
 			Server *server = wl_container_of(listener, server, xwayland_ready);
 			server->OnXwaylandReady();
 		}
 
+		static void handle_xwayland_start(struct wl_listener *listener, void *data)
+		{
+			Server *server = wl_container_of(listener, server, xwayland_start);
+			server->OnXwaylandStart();
+		}
+
+		// Resident set size of a process in KiB, 0 if unavailable
+		static uint64_t read_process_rss_kb(pid_t pid)
+		{
+			char path[64];
+			snprintf(path, sizeof(path), "/proc/%d/status", static_cast<int>(pid));
+			FILE *file = fopen(path, "r");
+			if (!file)
+			{
+				return 0;
+			}
+
+			char line[256];
+			unsigned long long rss_kb = 0;
+			while (fgets(line, sizeof(line), file))
+			{
+				if (sscanf(line, "VmRSS: %llu kB", &rss_kb) == 1)
+				{
+					break;
+				}
+			}
+			fclose(file);
+			return rss_kb;
+		}
+
 		static void handle_new_xwayland_surface(struct wl_listener *listener, void *data)
 		{
 			Server *server = wl_container_of(listener, server, new_xwayland_surface);
@@ -109,7 +203,7 @@ namespace Leviathan
 		}
 
 		Server::Server()
-				: wl_display(nullptr), wl_event_loop(nullptr), backend(nullptr), session(nullptr), renderer(nullptr), allocator(nullptr), compositor(nullptr), subcompositor(nullptr), data_device_manager(nullptr), primary_selection_mgr(nullptr), data_control_mgr(nullptr), scene(nullptr), scene_layout(nullptr), output_layout(nullptr), xdg_shell(nullptr), xwayland(nullptr), cursor(nullptr), cursor_mgr(nullptr), seat(nullptr), focused_view_(nullptr), should_shutdown_(false)
+				: wl_display(nullptr), wl_event_loop(nullptr), backend(nullptr), session(nullptr), renderer(nullptr), allocator(nullptr), compositor(nullptr), subcompositor(nullptr), data_device_manager(nullptr), primary_selection_mgr(nullptr), data_control_mgr(nullptr), linux_dmabuf(nullptr), presentation(nullptr), tearing_control(nullptr), viewporter(nullptr), fractional_scale_mgr(nullptr), single_pixel_buffer_mgr(nullptr), xdg_output_mgr(nullptr), screencopy_mgr(nullptr), export_dmabuf_mgr(nullptr), image_copy_capture_mgr(nullptr), output_capture_source_mgr(nullptr), output_manager(nullptr), scene(nullptr), scene_layout(nullptr), output_layout(nullptr), xdg_shell(nullptr), xwayland(nullptr), cursor(nullptr), cursor_mgr(nullptr), cursor_shape_mgr(nullptr), seat(nullptr), focused_view_(nullptr), should_shutdown_(false)
 		{
 
 			wl_list_init(&outputs);
@@ -136,6 +230,7 @@ namespace Leviathan
 		Server::~Server()
 		{
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Server destructor - cleaning up resources");
+			tearing_down_ = true;
 
 			// Shutdown MenuBar manager
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Shutting down MenuBar manager...");
@@ -149,6 +244,10 @@ namespace Leviathan
 				notification_daemon_.reset();
 			}
 
+			// Clean up remaining clients (before their views: destroying a client unlinks its view)
+			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Cleaning up {} remaining clients...", client_store_.Size());
+			client_store_.Clear();
+
 			// Clean up remaining views (in case they weren't destroyed by Wayland)
 			// Note: Normally Wayland destroy callbacks handle this, but we clean up for safety
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Cleaning up {} remaining views...", views.size());
@@ -158,14 +257,6 @@ namespace Leviathan
 			}
 			views.clear();
 
-			// Clean up remaining clients
-			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Cleaning up {} remaining clients...", clients_.size());
-			for (auto *client : clients_)
-			{
-				delete client;
-			}
-			clients_.clear();
-
 			// core_seat_ is a unique_ptr, it will automatically clean up (and delete tags)
 			// Outputs are cleaned up by wlroots destroy callbacks
 
@@ -183,7 +274,34 @@ namespace Leviathan
 			wl_list_remove(&cursor_axis.link);
 			wl_list_remove(&cursor_frame.link);
 			wl_list_remove(&request_cursor.link);
+			wl_list_remove(&request_cursor_shape.link);
 			wl_list_remove(&request_set_selection.link);
+			if (output_manager)
+			{
+				wl_list_remove(&output_manager_apply.link);
+				wl_list_remove(&output_manager_test.link);
+				wl_list_remove(&output_layout_change.link);
+			}
+			if (monitor_config_idle_)
+			{
+				wl_event_source_remove(monitor_config_idle_);
+			}
+			if (output_manager_idle_)
+			{
+				wl_event_source_remove(output_manager_idle_);
+			}
+			if (spawn_replies_)
+			{
+				wl_event_source_remove(spawn_replies_);
+			}
+			if (visibility_idle_)
+			{
+				wl_event_source_remove(visibility_idle_);
+			}
+			if (suspend_timer_)
+			{
+				wl_event_source_remove(suspend_timer_);
+			}
 
 			// Remove session listener if present
 			if (session)
@@ -194,10 +312,16 @@ namespace Leviathan
 			// Remove Xwayland listeners if present
 			if (xwayland)
 			{
+				wl_list_remove(&xwayland_start.link);
 				wl_list_remove(&xwayland_ready.link);
 				wl_list_remove(&new_xwayland_surface.link);
 			}
 
+			// Own event loop timers and protocol listeners
+			idle_manager_.reset();
+			frame_governor_.reset();
+			state_publisher_.reset();
+
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Destroying Wayland display...");
 			if (wl_display)
 			{
@@ -248,7 +372,25 @@ namespace Leviathan
 				return false;
 			}
 
-			wlr_renderer_init_wl_display(renderer, wl_display);
+			// wl_shm always; linux-dmabuf v4 when the renderer can import DMA-BUFs.
+			// Keep the dmabuf global so the scene can send per-surface feedback.
+			if (!wlr_renderer_init_wl_shm(renderer, wl_display))
+			{
+				std::cerr << "Failed to initialize wl_shm\n";
+				return false;
+			}
+			if (wlr_renderer_get_texture_formats(renderer, WLR_BUFFER_CAP_DMABUF))
+			{
+				linux_dmabuf = wlr_linux_dmabuf_v1_create_with_renderer(wl_display, 4, renderer);
+			}
+			if (linux_dmabuf)
+			{
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "linux-dmabuf v4 enabled");
+			}
+			else
+			{
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Renderer has no DMA-BUF import, clients will use wl_shm");
+			}
 
 			// Create allocator
 			allocator = wlr_allocator_autocreate(backend, renderer);
@@ -261,6 +403,21 @@ namespace Leviathan
 			// Create compositor
 			compositor = wlr_compositor_create(wl_display, 5, renderer);
 			subcompositor = wlr_subcompositor_create(wl_display);
+
+			// wp_presentation: the scene sends feedback with real vblank times
+			presentation = wlr_presentation_create(wl_display, backend, 2);
+
+			// wp_tearing_control_v1: fullscreen clients may ask for async page flips
+			tearing_control = wlr_tearing_control_manager_v1_create(wl_display, 1);
+
+			// wp_viewporter and wp_fractional_scale_v1: the scene reports each
+			// surface's fractional scale and honours client viewports
+			viewporter = wlr_viewporter_create(wl_display);
+			fractional_scale_mgr = wlr_fractional_scale_manager_v1_create(wl_display, 1);
+
+			// wp_single_pixel_buffer_manager_v1: solid 1x1 buffers the scene draws as rects
+			single_pixel_buffer_mgr = wlr_single_pixel_buffer_manager_v1_create(wl_display);
+
 			data_device_manager = wlr_data_device_manager_create(wl_display);
 			primary_selection_mgr = wlr_primary_selection_v1_device_manager_create(wl_display);
 			data_control_mgr = wlr_data_control_manager_v1_create(wl_display);
@@ -273,6 +430,31 @@ namespace Leviathan
 			// Create scene
 			scene = wlr_scene_create();
 			scene_layout = wlr_scene_attach_output_layout(scene, output_layout);
+			if (linux_dmabuf)
+			{
+				// Per-surface feedback steers clients to formats the output can scan out
+				wlr_scene_set_linux_dmabuf_v1(scene, linux_dmabuf);
+			}
+
+			// Screen capture. All of these copy from the buffer the scene just
+			// committed (damage-tracked where the protocol allows it), so a capture
+			// never costs an extra render; an idle output only re-commits on request
+			xdg_output_mgr = wlr_xdg_output_manager_v1_create(wl_display, output_layout);
+			screencopy_mgr = wlr_screencopy_manager_v1_create(wl_display);
+			export_dmabuf_mgr = wlr_export_dmabuf_manager_v1_create(wl_display);
+			image_copy_capture_mgr = wlr_ext_image_copy_capture_manager_v1_create(wl_display, 1);
+			output_capture_source_mgr = wlr_ext_output_image_capture_source_manager_v1_create(wl_display, 1);
+			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Screen capture enabled (ext-image-copy-capture, wlr-screencopy, export-dmabuf)");
+
+			// Output management: clients (kanshi, wdisplays) see heads for every output
+			// and apply whole configurations, which we commit as one backend transaction
+			output_manager = wlr_output_manager_v1_create(wl_display);
+			output_manager_apply.notify = handle_output_manager_apply;
+			wl_signal_add(&output_manager->events.apply, &output_manager_apply);
+			output_manager_test.notify = handle_output_manager_test;
+			wl_signal_add(&output_manager->events.test, &output_manager_test);
+			output_layout_change.notify = handle_output_layout_change;
+			wl_signal_add(&output_layout->events.change, &output_layout_change);
 
 			// Note: LayerManager is now created per-output in OnNewOutput()
 			// Window layer will be from the output's LayerManager
@@ -283,7 +465,7 @@ namespace Leviathan
 			wl_signal_add(&backend->events.new_output, &new_output);
 
 			// Create XDG shell
-			xdg_shell = wlr_xdg_shell_create(wl_display, 3);
+			xdg_shell = wlr_xdg_shell_create(wl_display, 6); // v6: suspended toplevel state
 
 			// Create XDG decoration manager (for server-side decorations)
 			xdg_decoration_mgr = wlr_xdg_decoration_manager_v1_create(wl_display);
@@ -310,30 +492,63 @@ namespace Leviathan
 			setenv("XKBCOMP_FLAGS", "-w 0", 1); // Suppress all xkbcomp warnings
 
 			// Create Xwayland server for X11 compatibility
-			// Use lazy=false to start Xwayland immediately (lazy=true requires shell_v1 protocol)
-			xwayland = wlr_xwayland_create(wl_display, compositor, false);
+			// Lazy mode only opens the X11 sockets; the server is spawned on the
+			// first X11 connection (wlroots provides xwayland_shell_v1 for it)
+			const auto &xwayland_config = Config().xwayland;
+			if (xwayland_config.enabled)
+			{
+				xwayland = xwayland_create_with_options(wl_display, compositor, xwayland_config.lazy, xwayland_config.idle_timeout);
+			}
 			if (xwayland)
 			{
+				xwayland_start.notify = handle_xwayland_start;
+				wl_signal_add(xwayland_get_server_start_signal(xwayland), &xwayland_start);
+				if (xwayland_get_server_pid(xwayland) > 0)
+				{
+					OnXwaylandStart(); // Eager servers are spawned during creation
+				}
+
 				xwayland_ready.notify = handle_xwayland_ready;
 				wl_signal_add(xwayland_get_ready_signal(xwayland), &xwayland_ready);
 
 				new_xwayland_surface.notify = handle_new_xwayland_surface;
 				wl_signal_add(xwayland_get_new_surface_signal(xwayland), &new_xwayland_surface);
 
-				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Xwayland support enabled");
+				// The display name exists as soon as the sockets do, so children
+				// can be given DISPLAY before the server has started
+				const char *display_name = xwayland_get_display_name(xwayland);
+				setenv("DISPLAY", display_name, true);
+
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Xwayland support enabled on {} ({})", display_name,
+																	 xwayland_config.lazy ? "lazy" : "eager");
+				if (xwayland_config.lazy && xwayland_config.idle_timeout > 0 && !xwayland_has_terminate_delay())
+				{
+					Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Xwayland has no -terminate delay support; it keeps running once started");
+				}
 			}
-			else
+			else if (xwayland_config.enabled)
 			{
 				Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Failed to create Xwayland server - X11 apps will not work");
 			}
+			else
+			{
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Xwayland disabled by configuration");
+			}
 
 			// Create cursor for input tracking
 			cursor = wlr_cursor_create();
 			wlr_cursor_attach_output_layout(cursor, output_layout);
 
-			// Create cursor manager with a default theme
+			// Create cursor manager with a default theme. wlr_cursor loads the theme
+			// again for each output scale; images are shared by outputs of that scale
 			cursor_mgr = wlr_xcursor_manager_create(NULL, 24);
 			wlr_xcursor_manager_load(cursor_mgr, 1);
+			SetCursorShape("default");
+
+			// wp_cursor_shape_v1: clients name a shape instead of uploading a cursor surface
+			cursor_shape_mgr = wlr_cursor_shape_manager_v1_create(wl_display, 1);
+			request_cursor_shape.notify = handle_request_cursor_shape;
+			wl_signal_add(&cursor_shape_mgr->events.request_set_shape, &request_cursor_shape);
 
 			// Setup cursor event listeners
 			cursor_motion.notify = handle_cursor_motion;
@@ -353,6 +568,18 @@ namespace Leviathan
 
 			// Create seat
 			seat = wlr_seat_create(wl_display, "seat0");
+			request_cursor.notify = handle_request_cursor;
+			wl_signal_add(&seat->events.request_set_cursor, &request_cursor);
+
+			// Idle notify/inhibit and output power-down, fed by InputManager
+			idle_manager_ = std::make_unique<IdleManager>(this, wl_display, wl_event_loop, seat);
+			idle_manager_->SetTimeouts(Config().idle.timeout, Config().idle.dpms_timeout);
+
+			// Frame callback caps, fed by view commits and output frames
+			frame_governor_ = std::make_unique<FrameGovernor>(this, wl_event_loop);
+
+			// Delayed suspension of hidden windows (UpdateSuspendedClients)
+			suspend_timer_ = wl_event_loop_add_timer(wl_event_loop, handle_suspend_timer, this);
 
 			// Setup input listener
 			new_input.notify = handle_new_input;
@@ -399,6 +626,20 @@ namespace Leviathan
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "EventBus configured for IPC broadcasting");
 			}
 
+			// Shared-memory snapshot of tags, outputs and clients (get_state_fd)
+			state_publisher_ = std::make_unique<StatePublisher>(this, wl_event_loop, ipc_server_.get());
+
+			// Initialize notification daemon (expiry and card rendering run off wl_event_loop)
+			if (Config().notifications.enabled)
+			{
+				notification_daemon_ = std::make_unique<UI::NotificationDaemon>(this);
+				if (!notification_daemon_->Initialize())
+				{
+					Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Failed to initialize notification daemon - another one may be running");
+					notification_daemon_.reset();
+				}
+			}
+
 			// Initialize MenuBar Manager
 			UI::MenuBarManager::Instance().Initialize(wl_event_loop);
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "MenuBarManager initialized");
@@ -444,13 +685,30 @@ namespace Leviathan
 		}
 
 		void Server::Run()
+		{
+			if (!Start())
+			{
+				return;
+			}
+
+			// Run event loop with IPC handling
+			while (wl_display_get_destroy_listener(wl_display, nullptr) == nullptr)
+			{
+				if (!DispatchOnce(1)) // 1ms timeout
+				{
+					break;
+				}
+			}
+		}
+
+		bool Server::Start()
 		{
 			// Add socket for clients to connect
 			const char *socket = wl_display_add_socket_auto(wl_display);
 			if (!socket)
 			{
 				Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to add socket");
-				return;
+				return false;
 			}
 
 			// Save socket name for child processes
@@ -460,7 +718,7 @@ namespace Leviathan
 			if (!wlr_backend_start(backend))
 			{
 				Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to start backend");
-				return;
+				return false;
 			}
 
 			// If this is a wayland backend, create an output (window) manually
@@ -479,6 +737,12 @@ namespace Leviathan
 			setenv("WAYLAND_DISPLAY", socket, true);
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Running compositor on WAYLAND_DISPLAY={}", socket);
 
+			// Launch results come back asynchronously from the helper forked in main()
+			if (Core::SpawnHelper::Instance().IsRunning())
+			{
+				spawn_replies_ = wl_event_loop_add_fd(wl_event_loop, Core::SpawnHelper::Instance().GetFd(), WL_EVENT_READABLE, handle_spawn_replies, this);
+			}
+
 			// Start watchdog timer (10 second timeout)
 			watchdog_ = std::make_unique<Core::WatchdogTimer>(10);
 			watchdog_->Start();
@@ -497,52 +761,67 @@ namespace Leviathan
 			wl_event_source_timer_update(terminal_launch_timer, 100); // 100ms delay
 
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Terminal will launch in 100ms");
+			return true;
+		}
 
-			// Run event loop with IPC handling
-			while (wl_display_get_destroy_listener(wl_display, nullptr) == nullptr)
+		bool Server::DispatchOnce(int timeout_ms)
+		{
+			// Pet the watchdog to prevent timeout
+			if (watchdog_)
 			{
-				// Pet the watchdog to prevent timeout
-				if (watchdog_)
-				{
-					watchdog_->Pet();
-				}
+				watchdog_->Pet();
+			}
 
-				// Check for IPC-initiated shutdown
-				if (should_shutdown_)
-				{
-					Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "IPC shutdown requested - initiating graceful shutdown");
-					Shutdown();
-					break;
-				}
+			// Check for IPC-initiated shutdown
+			if (should_shutdown_)
+			{
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "IPC shutdown requested - initiating graceful shutdown");
+				Shutdown();
+				return false;
+			}
 
-				// Handle IPC events
-				if (ipc_server_)
-				{
-					ipc_server_->HandleEvents();
-				}
+			// Handle IPC events
+			if (ipc_server_)
+			{
+				ipc_server_->HandleEvents();
+			}
 
-				// Update notification daemon (process expired notifications)
-				if (notification_daemon_)
-				{
-					notification_daemon_->Update();
-				}
+			// Deliver events posted by worker threads
+			Core::EventBus::Instance().DrainInbox();
+
+			// Auto adaptive sync follows fullscreen focus; repaint where it changed
+			Output *sync_output;
+			wl_list_for_each(sync_output, &outputs, link)
+			{
+				OutputManager::UpdateSyncState(sync_output);
+			}
+
+			// Dispatch notification DBus calls (expiry is timer driven)
+			if (notification_daemon_)
+			{
+				notification_daemon_->Update();
+			}
 
-				// Process Wayland events with error handling
-				wl_display_flush_clients(wl_display); // Returns void, not int
+			// Process Wayland events with error handling
+			wl_display_flush_clients(wl_display); // Returns void, not int
 
-				int dispatch_result = wl_event_loop_dispatch(wl_event_loop, 1); // 1ms timeout
-				if (dispatch_result < 0)
+			int dispatch_result = wl_event_loop_dispatch(wl_event_loop, timeout_ms);
+			if (dispatch_result < 0)
+			{
+				if (errno == EPIPE)
 				{
-					if (errno == EPIPE)
-					{
-						Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Client disconnected (broken pipe during dispatch) - continuing");
-					}
-					else
-					{
-						Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "wl_event_loop_dispatch failed: {} - continuing", strerror(errno));
-					}
+					Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Client disconnected (broken pipe during dispatch) - continuing");
+				}
+				else
+				{
+					Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "wl_event_loop_dispatch failed: {} - continuing", strerror(errno));
 				}
 			}
+
+			// Scratch memory from handlers outside a frame (input, IPC, timers) must
+			// not pile up while no output renders (none connected, or all powered off)
+			Core::FrameArena::Instance().Reset();
+			return true;
 		}
 
 		void Server::Shutdown()
@@ -550,6 +829,7 @@ namespace Leviathan
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "========================================");
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Starting graceful compositor shutdown...");
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "========================================");
+			tearing_down_ = true;
 
 			// Stop watchdog timer first to allow clean shutdown
 			if (watchdog_)
@@ -564,8 +844,8 @@ namespace Leviathan
 			UI::MenuBarManager::Instance().Shutdown();
 
 			// Step 2: Close all client windows gracefully
-			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Step 2: Closing {} client windows...", clients_.size());
-			for (auto *client : clients_)
+			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Step 2: Closing {} client windows...", client_store_.Size());
+			for (auto *client : client_store_.GetClients())
 			{
 				if (client && client->GetView())
 				{
@@ -581,7 +861,8 @@ namespace Leviathan
 				notification_daemon_->Shutdown();
 			}
 
-			// Step 4: Shutdown IPC server
+			// Step 4: Shutdown IPC server (the snapshot announces itself through it)
+			state_publisher_.reset();
 			if (ipc_server_)
 			{
 				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Step 4: Shutting down IPC server...");
@@ -662,6 +943,8 @@ namespace Leviathan
 			if (!output->scene_output)
 			{
 				Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to create scene output for '{}'", wlr_output->name);
+				wl_list_remove(&output->link);
+				wlr_output->data = nullptr;
 				delete output;
 				return;
 			}
@@ -716,20 +999,47 @@ namespace Leviathan
 
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Registered frame listener for output '{}'", wlr_output->name);
 
+			// Presentation timing drives frame pacing
+			output->present.notify = OutputManager::HandlePresent;
+			wl_signal_add(&wlr_output->events.present, &output->present);
+			output->repaint_timer = wl_event_loop_add_timer(wl_event_loop, OutputManager::HandleRepaintTimer, output);
+
+			// Scale changes redraw bars and overlays at the new resolution
+			output->commit.notify = OutputManager::HandleCommit;
+			wl_signal_add(&wlr_output->events.commit, &output->commit);
+
 			// Register destroy listener
 			output->destroy.notify = OutputManager::HandleDestroy;
 			wl_signal_add(&wlr_output->events.destroy, &output->destroy);
 
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Output '{}' fully configured and enabled", wlr_output->name);
 
-			// Apply monitor group configuration
-			ApplyMonitorGroupConfiguration();
+			// Apply monitor group configuration once every output of a hotplug burst is in
+			ScheduleMonitorGroupConfiguration();
+
+			// The cursor image follows onto the new output by itself (wlr_cursor
+			// re-applies the current shape or surface at this output's scale)
+		}
 
-			// Set cursor image for this output
-			if (cursor_mgr)
+		void Server::ScheduleMonitorGroupConfiguration()
+		{
+			// Outputs destroyed by wl_display_destroy would otherwise queue an idle
+			// source on a loop that is about to go away
+			if (tearing_down_)
 			{
-				wlr_cursor_set_xcursor(cursor, cursor_mgr, "default");
+				return;
 			}
+			if (!monitor_config_idle_)
+			{
+				monitor_config_idle_ = wl_event_loop_add_idle(wl_event_loop, handle_monitor_config_idle, this);
+			}
+		}
+
+		void Server::OnMonitorConfigIdle()
+		{
+			// Idle sources fire once and are removed by the loop; a later hotplug schedules a new one
+			monitor_config_idle_ = nullptr;
+			ApplyMonitorGroupConfiguration();
 		}
 
 		void Server::ApplyMonitorGroupConfiguration()
@@ -768,7 +1078,16 @@ namespace Leviathan
 
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Applying monitor group: '{}'", group->name);
 
-			// Apply configuration for each monitor in the group
+			// Build every output's state first, so the whole group is one modeset
+			struct PendingMonitor
+			{
+				Output *output;
+				const MonitorConfig *config;
+			};
+			std::vector<PendingMonitor> pending;
+			std::vector<struct wlr_backend_output_state> states;
+			states.reserve(group->monitors.size());
+
 			for (const auto &mon_config : group->monitors)
 			{
 				// Find the matching output
@@ -825,8 +1144,11 @@ namespace Leviathan
 				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Configuring output '{}' from monitor group", output->wlr_output->name);
 
 				// Create output state for applying configuration
-				struct wlr_output_state state;
+				struct wlr_backend_output_state &entry = states.emplace_back();
+				entry.output = output->wlr_output;
+				struct wlr_output_state &state = entry.base;
 				wlr_output_state_init(&state);
+				wlr_output_state_set_enabled(&state, true);
 
 				// Apply mode if specified
 				if (mon_config.mode.has_value())
@@ -882,91 +1204,474 @@ namespace Leviathan
 								}
 							}
 
-							if (best_mode)
+							if (best_mode)
+							{
+								wlr_output_state_set_mode(&state, best_mode);
+								Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set mode {}x{}@{}Hz for '{}'",
+																					 width, height, best_mode->refresh / 1000,
+																					 output->wlr_output->name);
+							}
+							else
+							{
+								Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Mode {} not available for '{}'", mode_str, output->wlr_output->name);
+							}
+						}
+						catch (const std::exception &e)
+						{
+							Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to parse mode '{}': {}", mode_str, e.what());
+						}
+					}
+				}
+
+				// Apply scale if specified
+				if (mon_config.scale.has_value())
+				{
+					wlr_output_state_set_scale(&state, mon_config.scale.value());
+					Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set scale {} for '{}'", mon_config.scale.value(), output->wlr_output->name);
+				}
+
+				// Apply transform if specified
+				if (mon_config.transform.has_value())
+				{
+					enum wl_output_transform transform;
+					switch (mon_config.transform.value())
+					{
+					case 90:
+						transform = WL_OUTPUT_TRANSFORM_90;
+						break;
+					case 180:
+						transform = WL_OUTPUT_TRANSFORM_180;
+						break;
+					case 270:
+						transform = WL_OUTPUT_TRANSFORM_270;
+						break;
+					default:
+						transform = WL_OUTPUT_TRANSFORM_NORMAL;
+						break;
+					}
+					wlr_output_state_set_transform(&state, transform);
+					Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set transform {} for '{}'", mon_config.transform.value(), output->wlr_output->name);
+				}
+
+				// Adaptive sync and tearing are applied per frame (OutputManager::CommitScene)
+				output->sync.adaptive_sync = mon_config.adaptive_sync;
+				output->sync.allow_tearing = mon_config.allow_tearing;
+				output->sync.rejected_adaptive_sync = -1;
+
+				pending.push_back({output, &mon_config});
+			}
+
+			if (!CommitOutputStates(states.data(), states.size(), false))
+			{
+				// Keep the old behaviour as a fallback: one unsupported mode in the
+				// group should not leave every other monitor unconfigured
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Monitor group '{}' rejected as a whole, committing outputs one by one", group->name);
+				for (auto &entry : states)
+				{
+					if (!wlr_output_commit_state(entry.output, &entry.base))
+					{
+						Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to commit configuration for '{}'", entry.output->name);
+					}
+				}
+			}
+			for (auto &entry : states)
+			{
+				wlr_output_state_finish(&entry.base);
+			}
+
+			// Layout, bars, menubar and wallpaper after the commit, once per output.
+			// Outputs already showing this monitor config (a re-apply after another
+			// output was plugged in) keep their bars and wallpaper
+			for (const auto &[output, mon_config] : pending)
+			{
+				PlaceOutput(output, true, mon_config->position);
+
+				if (output->layer_manager->GetMonitorConfig() == mon_config)
+				{
+					continue;
+				}
+
+				// Bars are laid out in logical coordinates; they draw at output scale themselves
+				int logical_width = 0, logical_height = 0;
+				output->layer_manager->GetLogicalSize(logical_width, logical_height);
+
+				// Create status bars for this monitor (handled by LayerManager)
+				output->layer_manager->ClearAllStatusBars();
+				output->layer_manager->SetReservedSpace(ReservedSpace{});
+				output->layer_manager->CreateStatusBars(
+						mon_config->status_bars,
+						config.status_bars,
+						logical_width,
+						logical_height);
+
+				// Register menubar for this output
+				UI::MenuBarManager::Instance().RegisterMenuBar(
+						output->wlr_output,
+						output->layer_manager,
+						logical_width,
+						logical_height);
+
+				// Pass monitor config to LayerManager (triggers wallpaper initialization if configured)
+				output->layer_manager->SetMonitorConfig(*mon_config);
+			}
+
+			ArrangeOutputs();
+			UpdateOutputManagerConfig();
+
+			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Monitor group '{}' configuration applied", group->name);
+		}
+
+		bool Server::CommitOutputStates(struct wlr_backend_output_state *states, size_t states_len, bool test_only)
+		{
+			if (states_len == 0)
+			{
+				return true;
+			}
+
+			if (!wlr_backend_test(backend, states, states_len))
+			{
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Backend rejected configuration for {} output(s)", states_len);
+				return false;
+			}
+			if (test_only)
+			{
+				return true;
+			}
+
+			if (!wlr_backend_commit(backend, states, states_len))
+			{
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to commit configuration for {} output(s)", states_len);
+				return false;
+			}
+
+			// An explicit enable or disable replaces what idle power-down did
+			for (size_t i = 0; i < states_len; i++)
+			{
+				Output *output = FindOutput(states[i].output);
+				if (output && (states[i].base.committed & WLR_OUTPUT_STATE_ENABLED))
+				{
+					output->idle_powered_off = false;
+				}
+			}
+
+			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Committed configuration for {} output(s)", states_len);
+			return true;
+		}
+
+		void Server::PlaceOutput(Output *output, bool enabled, std::optional<std::pair<int, int>> position)
+		{
+			struct wlr_output_layout_output *layout_output = wlr_output_layout_get(output_layout, output->wlr_output);
+
+			if (!enabled)
+			{
+				// Removing the layout output also destroys the scene output attached to it
+				if (layout_output)
+				{
+					wlr_output_layout_remove(output_layout, output->wlr_output);
+					output->scene_output = nullptr;
+				}
+				return;
+			}
+
+			bool was_placed = layout_output != nullptr;
+			if (position.has_value())
+			{
+				auto [x, y] = position.value();
+				layout_output = wlr_output_layout_add(output_layout, output->wlr_output, x, y);
+				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set position {}x{} for '{}'", x, y, output->wlr_output->name);
+			}
+			else if (!was_placed)
+			{
+				layout_output = wlr_output_layout_add_auto(output_layout, output->wlr_output);
+			}
+
+			// Re-enabled output: it needs a scene output again
+			if (!was_placed && layout_output)
+			{
+				output->scene_output = wlr_scene_output_create(scene, output->wlr_output);
+				if (output->scene_output)
+				{
+					wlr_scene_output_layout_add_output(scene_layout, layout_output, output->scene_output);
+				}
+			}
+		}
+
+		void Server::ArrangeOutputs()
+		{
+			Output *output;
+			wl_list_for_each(output, &outputs, link)
+			{
+				if (output->layer_manager && output->wlr_output->enabled)
+				{
+					output->layer_manager->AutoTile();
+				}
+			}
+		}
+
+		void Server::UpdateOutputManagerConfig()
+		{
+			if (!output_manager)
+			{
+				return;
+			}
+
+			struct wlr_output_configuration_v1 *config = wlr_output_configuration_v1_create();
+			Output *output;
+			wl_list_for_each(output, &outputs, link)
+			{
+				struct wlr_output_configuration_head_v1 *head = wlr_output_configuration_head_v1_create(config, output->wlr_output);
+				if (!head)
+				{
+					continue;
+				}
+
+				struct wlr_box box;
+				wlr_output_layout_get_box(output_layout, output->wlr_output, &box);
+				head->state.enabled = output->wlr_output->enabled && !wlr_box_empty(&box);
+				head->state.x = box.x;
+				head->state.y = box.y;
+			}
+
+			// Takes ownership of config
+			wlr_output_manager_v1_set_configuration(output_manager, config);
+		}
+
+		void Server::OnOutputLayoutChange()
+		{
+			// Fires for every output of a reconfiguration (and while one is being
+			// destroyed); publish once the loop is idle
+			if (!output_manager_idle_)
+			{
+				output_manager_idle_ = wl_event_loop_add_idle(wl_event_loop, handle_output_manager_idle, this);
+			}
+			if (state_publisher_)
+			{
+				state_publisher_->MarkDirty();
+			}
+		}
+
+		void Server::OnOutputManagerIdle()
+		{
+			output_manager_idle_ = nullptr;
+			UpdateOutputManagerConfig();
+		}
+
+		void Server::ScheduleVisibilityUpdate()
+		{
+			if (!visibility_idle_ && wl_event_loop)
+			{
+				visibility_idle_ = wl_event_loop_add_idle(wl_event_loop, handle_visibility_idle, this);
+			}
+		}
+
+		void Server::OnVisibilityIdle()
+		{
+			visibility_idle_ = nullptr;
+			UpdateSuspendedClients();
+		}
+
+		void Server::OnSuspendTimer()
+		{
+			UpdateSuspendedClients();
+		}
+
+		void Server::UpdateSuspendedClients()
+		{
+			// Windows somebody can see: the visible tag of every output, minus
+			// whatever a fullscreen window or the top monocle window covers
+			std::vector<Core::Client *> shown;
+			Output *output;
+			wl_list_for_each(output, &outputs, link)
+			{
+				Core::Tag *tag = output->layer_manager ? output->layer_manager->GetCurrentTag() : nullptr;
+				if (!tag || !tag->IsVisible())
+				{
+					continue;
+				}
+
+				Core::Client *fullscreen = nullptr;
+				for (auto *client : tag->GetClients())
+				{
+					if (client->IsMapped() && client->IsFullscreen() && (!fullscreen || client == tag->GetFocusedClient()))
+					{
+						fullscreen = client;
+					}
+				}
+				if (fullscreen)
+				{
+					shown.push_back(fullscreen);
+					continue;
+				}
+
+				if (tag->GetLayout() != LayoutType::MONOCLE)
+				{
+					shown.insert(shown.end(), tag->GetClients().begin(), tag->GetClients().end());
+					continue;
+				}
+
+				// Monocle stacks every tiled window at the same size; only the one on
+				// top of the scene shows. Floating windows sit above it
+				Core::Client *top = nullptr;
+				for (auto *client : tag->GetClients())
+				{
+					auto *view = client->GetView();
+					if (client->IsFloating())
+					{
+						shown.push_back(client);
+					}
+					else if (client->IsMapped() && view && view->scene_tree)
+					{
+						if (!top)
+						{
+							top = client;
+							continue;
+						}
+						// Later siblings are drawn above earlier ones
+						struct wlr_scene_node *node;
+						wl_list_for_each(node, &view->scene_tree->node.parent->children, link)
+						{
+							if (node == &top->GetView()->scene_tree->node)
 							{
-								wlr_output_state_set_mode(&state, best_mode);
-								Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set mode {}x{}@{}Hz for '{}'",
-																					 width, height, best_mode->refresh / 1000,
-																					 output->wlr_output->name);
+								top = client;
+								break;
 							}
-							else
+							if (node == &view->scene_tree->node)
 							{
-								Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Mode {} not available for '{}'", mode_str, output->wlr_output->name);
+								break;
 							}
 						}
-						catch (const std::exception &e)
-						{
-							Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to parse mode '{}': {}", mode_str, e.what());
-						}
 					}
 				}
+				if (top)
+				{
+					shown.push_back(top);
+				}
+			}
 
-				// Apply scale if specified
-				if (mon_config.scale.has_value())
+			uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+			uint64_t next_ms = 0;
+			for (auto *client : client_store_.GetClients())
+			{
+				auto *view = client->GetView();
+				if (!view || !view->xdg_toplevel)
 				{
-					wlr_output_state_set_scale(&state, mon_config.scale.value());
-					Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set scale {} for '{}'", mon_config.scale.value(), output->wlr_output->name);
+					continue;
+				}
+				if (!client->IsMapped())
+				{
+					// Restart the countdown on remap instead of suspending at once
+					client->SetHiddenSince(0);
+					continue;
 				}
 
-				// Apply transform if specified
-				if (mon_config.transform.has_value())
+				if (std::find(shown.begin(), shown.end(), client) != shown.end())
 				{
-					enum wl_output_transform transform;
-					switch (mon_config.transform.value())
+					client->SetHiddenSince(0);
+					if (client->IsSuspended())
 					{
-					case 90:
-						transform = WL_OUTPUT_TRANSFORM_90;
-						break;
-					case 180:
-						transform = WL_OUTPUT_TRANSFORM_180;
-						break;
-					case 270:
-						transform = WL_OUTPUT_TRANSFORM_270;
-						break;
-					default:
-						transform = WL_OUTPUT_TRANSFORM_NORMAL;
-						break;
+						client->SetSuspended(false);
 					}
-					wlr_output_state_set_transform(&state, transform);
-					Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set transform {} for '{}'", mon_config.transform.value(), output->wlr_output->name);
+					continue;
 				}
 
-				// Commit the output configuration
-				if (!wlr_output_commit_state(output->wlr_output, &state))
+				if (client->GetHiddenSince() == 0)
 				{
-					Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to commit configuration for '{}'", output->wlr_output->name);
+					client->SetHiddenSince(now);
+				}
+				if (client->IsSuspended())
+				{
+					continue;
 				}
 
-				// Cleanup output state
-				wlr_output_state_finish(&state);
-
-				// Apply position if specified
-				if (mon_config.position.has_value())
+				uint64_t hidden_for = now - client->GetHiddenSince();
+				if (hidden_for >= SUSPEND_DELAY_MS)
+				{
+					client->SetSuspended(true);
+					Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Suspended hidden window '{}'", client->GetTitle());
+				}
+				else
 				{
-					auto [x, y] = mon_config.position.value();
-					wlr_output_layout_add(output_layout, output->wlr_output, x, y);
-					Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Set position {}x{} for '{}'", x, y, output->wlr_output->name);
+					uint64_t remaining = SUSPEND_DELAY_MS - hidden_for;
+					next_ms = next_ms ? std::min(next_ms, remaining) : remaining;
 				}
+			}
 
-				// Create status bars for this monitor (handled by LayerManager)
-				output->layer_manager->CreateStatusBars(
-						mon_config.status_bars,
-						config.status_bars,
-						output->wlr_output->width,
-						output->wlr_output->height);
+			if (suspend_timer_)
+			{
+				wl_event_source_timer_update(suspend_timer_, static_cast<int>(next_ms));
+			}
+		}
 
-				// Register menubar for this output
-				UI::MenuBarManager::Instance().RegisterMenuBar(
-						output->wlr_output,
-						output->layer_manager,
-						output->wlr_output->width,
-						output->wlr_output->height);
+		size_t Server::GetSuspendedClientCount() const
+		{
+			size_t count = 0;
+			for (auto *client : client_store_.GetClients())
+			{
+				count += client->IsSuspended() ? 1 : 0;
+			}
+			return count;
+		}
 
-				// Pass monitor config to LayerManager (triggers wallpaper initialization if configured)
-				output->layer_manager->SetMonitorConfig(mon_config);
+		void Server::OnSpawnReplies(uint32_t mask)
+		{
+			auto &helper = Core::SpawnHelper::Instance();
+			helper.DispatchReplies();
+
+			// Helper gone: launches fall back to posix_spawn from here
+			if (!helper.IsRunning() || (mask & (WL_EVENT_HANGUP | WL_EVENT_ERROR)))
+			{
+				helper.Stop();
+				wl_event_source_remove(spawn_replies_);
+				spawn_replies_ = nullptr;
+			}
+		}
+
+		void Server::OnOutputManagerApply(struct wlr_output_configuration_v1 *config, bool test_only)
+		{
+			size_t states_len = 0;
+			struct wlr_backend_output_state *states = wlr_output_configuration_v1_build_state(config, &states_len);
+			bool ok = states != nullptr;
+
+			if (ok)
+			{
+				ok = CommitOutputStates(states, states_len, test_only);
+				for (size_t i = 0; i < states_len; i++)
+				{
+					wlr_output_state_finish(&states[i].base);
+				}
+				free(states);
 			}
 
-			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Monitor group '{}' configuration applied", group->name);
+			if (ok && !test_only)
+			{
+				struct wlr_output_configuration_head_v1 *head;
+				wl_list_for_each(head, &config->heads, link)
+				{
+					Output *output = FindOutput(head->state.output);
+					if (output)
+					{
+						PlaceOutput(output, head->state.enabled, std::make_pair(head->state.x, head->state.y));
+					}
+				}
+				ArrangeOutputs();
+			}
+
+			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Output configuration {} {}", test_only ? "test" : "apply", ok ? "succeeded" : "failed");
+			if (ok)
+			{
+				wlr_output_configuration_v1_send_succeeded(config);
+			}
+			else
+			{
+				wlr_output_configuration_v1_send_failed(config);
+			}
+			wlr_output_configuration_v1_destroy(config);
+
+			if (!test_only)
+			{
+				UpdateOutputManagerConfig();
+			}
 		}
 
 		void Server::OnNewXdgSurface(struct wlr_xdg_surface *xdg_surface)
@@ -1015,8 +1720,7 @@ namespace Leviathan
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Created scene tree for toplevel view");
 
 			// Create client wrapper
-			auto *client = new Core::Client(view);
-			clients_.push_back(client);
+			auto *client = client_store_.Create(view);
 
 			// Add to core seat
 			core_seat_->AddClient(client);
@@ -1084,8 +1788,7 @@ namespace Leviathan
 			// Do NOT manually call configure functions here
 
 			// Create client wrapper
-			auto *client = new Core::Client(view);
-			clients_.push_back(client);
+			auto *client = client_store_.Create(view);
 
 			// Add to core seat
 			core_seat_->AddClient(client);
@@ -1121,28 +1824,8 @@ namespace Leviathan
 
 		void Server::LaunchDefaultTerminal()
 		{
-			pid_t pid = fork();
-
-			if (pid < 0)
-			{
-				Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to fork process for terminal");
-				return;
-			}
-
-			if (pid == 0)
-			{
-				// Child process
-				// Set environment variable so terminal knows which display to use
-				setenv("WAYLAND_DISPLAY", wayland_socket_name_.c_str(), 1);
-				// Execute terminal - try kitty, then fallback
-				execlp("kitty", "kitty", nullptr);
-
-				// If we get here, exec failed
-				_exit(EXIT_FAILURE);
-			}
-
-			// Parent process
-			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Launched alacritty terminal (PID: {})", pid);
+			// WAYLAND_DISPLAY is already in the environment the helper passes on
+			Core::SpawnHelper::Instance().Spawn({"kitty"}, "terminal");
 		}
 
 		void Server::OnSessionActive(bool active)
@@ -1159,16 +1842,69 @@ namespace Leviathan
 			}
 		}
 
+		void Server::SetUISuspended(bool suspended)
+		{
+			Output *output;
+			wl_list_for_each(output, &outputs, link)
+			{
+				if (output->layer_manager)
+				{
+					output->layer_manager->SetSuspended(suspended);
+				}
+			}
+			UI::SetWidgetUpdatesPaused(suspended);
+		}
+
+		void Server::SetOutputsPowered(bool powered)
+		{
+			Output *output;
+			wl_list_for_each(output, &outputs, link)
+			{
+				// Only wake what idle powered off: outputs disabled by a monitor
+				// group or wlr-output-management stay off
+				if (powered ? !output->idle_powered_off : !output->wlr_output->enabled)
+				{
+					continue;
+				}
+
+				struct wlr_output_state state;
+				wlr_output_state_init(&state);
+				wlr_output_state_set_enabled(&state, powered);
+				if (wlr_output_commit_state(output->wlr_output, &state))
+				{
+					output->idle_powered_off = !powered;
+				}
+				else
+				{
+					Leviathan::Log::WriteToLog(Leviathan::LogLevel::ERROR, "Failed to power {} output '{}'",
+											   powered ? "on" : "off", output->wlr_output->name);
+				}
+				wlr_output_state_finish(&state);
+
+				if (powered)
+				{
+					wlr_output_schedule_frame(output->wlr_output);
+				}
+			}
+		}
+
+		void Server::OnXwaylandStart()
+		{
+			xwayland_starts_++;
+			xwayland_started_at_ = std::chrono::steady_clock::now();
+			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Starting Xwayland (start #{})", xwayland_starts_);
+		}
+
 		void Server::OnXwaylandReady()
 		{
-			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Xwayland server is ready");
+			// With lazy startup this runs on the first X11 connection, and again
+			// each time an idled-out server is respawned
+			xwayland_startup_time_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+					std::chrono::steady_clock::now() - xwayland_started_at_);
+			Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "Xwayland server is ready ({}ms)", xwayland_startup_time_.count());
 
-			// Set the X11 display environment variable for child processes
 			if (xwayland)
 			{
-				const char *display_name = xwayland_get_display_name(xwayland);
-				setenv("DISPLAY", display_name, true);
-				Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "X11 DISPLAY set to {}", display_name);
 
 				// Assign seat to Xwayland for clipboard/selection handling
 				if (seat)
@@ -1215,8 +1951,9 @@ namespace Leviathan
 			views.push_back(view);
 
 			// Create client wrapper (same as XDG toplevels)
-			auto *client = new Core::Client(view);
-			clients_.push_back(client);
+			auto *client = client_store_.Create(view);
+			client->StoreGeometry(xwayland_surface_get_x(xwayland_surface), xwayland_surface_get_y(xwayland_surface),
+														xwayland_surface_get_width(xwayland_surface), xwayland_surface_get_height(xwayland_surface));
 
 			// Add to core seat
 			core_seat_->AddClient(client);
@@ -1246,7 +1983,7 @@ namespace Leviathan
 
 		void Server::FocusView(View *view)
 		{
-			if (!view || !view->mapped)
+			if (!view || !view->IsMapped())
 			{
 				return;
 			}
@@ -1275,6 +2012,9 @@ namespace Leviathan
 				wlr_scene_node_raise_to_top(&view->scene_tree->node);
 			}
 
+			// Raising changes which monocle window is on top
+			ScheduleVisibilityUpdate();
+
 			// Set keyboard focus
 			if (view->surface)
 			{
@@ -1350,57 +2090,32 @@ namespace Leviathan
 				Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Cleared focused_view since it was the destroyed view");
 			}
 
-			// Find and remove the associated Client
-			Core::Client *client_to_remove = nullptr;
-			for (auto *client : clients_)
-			{
-				if (client->GetView() == view)
-				{
-					client_to_remove = client;
-					break;
-				}
-			}
-
+			// Remove the associated Client
+			Core::Client *client_to_remove = view->client;
 			if (client_to_remove)
 			{
 				Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Found client for view, removing from seat and deleting");
 
-				// Remove from tag first
-				auto *focused_screen = core_seat_->GetFocusedScreen();
-				if (focused_screen)
+				// Remove from the tag it was recorded on (any screen, not just the focused one)
+				int output_index = client_to_remove->GetOutputIndex();
+				int tag_index = client_to_remove->GetTagIndex();
+				Output *iter;
+				wl_list_for_each(iter, &outputs, link)
 				{
-					Output *iter;
-					wl_list_for_each(iter, &outputs, link)
+					if (iter->layer_manager && iter->layer_manager->GetIndex() == output_index)
 					{
-						if (iter->core_screen == focused_screen && iter->layer_manager)
+						const auto &tags = iter->layer_manager->GetTags();
+						if (tag_index >= 0 && tag_index < static_cast<int>(tags.size()))
 						{
-							// Try to find the client in any tag
-							for (auto *tag : iter->layer_manager->GetTags())
-							{
-								const auto &tag_clients = tag->GetClients();
-								if (std::find(tag_clients.begin(), tag_clients.end(), client_to_remove) != tag_clients.end())
-								{
-									tag->RemoveClient(client_to_remove);
-									Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Removed client from tag");
-									break;
-								}
-							}
-							break;
+							tags[tag_index]->RemoveClient(client_to_remove);
+							Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Removed client from tag");
 						}
+						break;
 					}
 				}
 
 				core_seat_->RemoveClient(client_to_remove);
-
-				// Remove from clients_ vector
-				auto client_it = std::find(clients_.begin(), clients_.end(), client_to_remove);
-				if (client_it != clients_.end())
-				{
-					clients_.erase(client_it);
-				}
-
-				// Delete the client to prevent memory leak
-				delete client_to_remove;
+				client_store_.Destroy(client_to_remove->GetId());
 			}
 		}
 
@@ -1517,6 +2232,8 @@ namespace Leviathan
 				{
 					response.success = true;
 
+					uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+							std::chrono::steady_clock::now().time_since_epoch()).count();
 					// Iterate through all tags to find which tag each client belongs to
 					auto tags = GetTags(); // Use Server's method
 					for (const auto *tag : tags)
@@ -1524,6 +2241,7 @@ namespace Leviathan
 						for (const auto *client : tag->GetClients())
 						{
 							IPC::ClientInfo info;
+							info.id = client->GetId().ToU64();
 							info.title = client->GetTitle();
 							info.app_id = client->GetAppId();
 
@@ -1552,11 +2270,23 @@ namespace Leviathan
 
 							info.floating = client->IsFloating();
 							info.fullscreen = client->IsFullscreen();
+							info.suspended = client->IsSuspended();
 							info.tag = tag->GetName();
+							const auto &stats = client->GetStats();
+							info.shm_commits = stats.shm_commits;
+							info.dmabuf_commits = stats.dmabuf_commits;
+							info.commit_rate = stats.RatesCurrent(now_ns) ? stats.commit_rate : 0;
+
+							const auto &governor = client->GetGovernorState();
+							info.frame_cap = frame_governor_ ? frame_governor_->GetCap(client) : 0;
+							info.throttled = governor.throttled;
+							info.throttle_events = governor.throttle_events;
 
 							response.clients.push_back(info);
 						}
 					}
+					response.data["suspended_clients"] = std::to_string(GetSuspendedClientCount());
+					response.data["on_battery"] = frame_governor_ && frame_governor_->IsOnBattery() ? "true" : "false";
 					break;
 				}
 
@@ -1565,7 +2295,7 @@ namespace Leviathan
 					response.success = true;
 
 					// Get Screen objects which have parsed EDID info
-					auto screens = GetScreens();
+					const auto &screens = GetScreens();
 					for (const auto *screen : screens)
 					{
 						IPC::OutputInfo info;
@@ -1586,6 +2316,7 @@ namespace Leviathan
 							info.phys_width_mm = wlr_output->phys_width;
 							info.phys_height_mm = wlr_output->phys_height;
 							info.enabled = wlr_output->enabled;
+							info.adaptive_sync_active = wlr_output->adaptive_sync_status == WLR_OUTPUT_ADAPTIVE_SYNC_ENABLED;
 						}
 						else
 						{
@@ -1595,6 +2326,15 @@ namespace Leviathan
 							info.enabled = false;
 						}
 
+						if (auto *output = FindOutput(wlr_output))
+						{
+							static const char *sync_modes[] = {"off", "on", "auto"};
+							info.adaptive_sync = sync_modes[static_cast<int>(output->sync.adaptive_sync)];
+							info.adaptive_sync_wanted = OutputManager::WantsAdaptiveSync(output);
+							info.tearing_allowed = output->sync.allow_tearing;
+							info.tearing_active = output->sync.tearing_active;
+						}
+
 						response.outputs.push_back(info);
 					}
 					break;
@@ -1697,6 +2437,160 @@ namespace Leviathan
 					break;
 				}
 
+				case IPC::CommandType::GET_ICON_ATLAS:
+				{
+					response.success = true;
+
+					// Occupancy = share of atlas page memory covered by live icons
+					auto occupancy = [](size_t used, size_t total) {
+						char buf[16];
+						snprintf(buf, sizeof(buf), "%.1f", total ? 100.0 * used / total : 0.0);
+						return std::string(buf);
+					};
+
+					UI::IconAtlas::Stats total;
+					for (const auto &[size, stats] : UI::MenuBarManager::Instance().GetIconAtlasStats())
+					{
+						response.data["size_" + std::to_string(size)] =
+							"pages=" + std::to_string(stats.pages) +
+							" icons=" + std::to_string(stats.icons) +
+							" occupancy=" + occupancy(stats.icon_bytes, stats.page_bytes) + "%" +
+							" compactions=" + std::to_string(stats.compactions);
+						total.pages += stats.pages;
+						total.page_bytes += stats.page_bytes;
+						total.icons += stats.icons;
+						total.icon_bytes += stats.icon_bytes;
+						total.shelf_bytes += stats.shelf_bytes;
+						total.compactions += stats.compactions;
+					}
+
+					response.data["pages"] = std::to_string(total.pages);
+					response.data["page_bytes"] = std::to_string(total.page_bytes);
+					response.data["icons"] = std::to_string(total.icons);
+					response.data["icon_bytes"] = std::to_string(total.icon_bytes);
+					response.data["shelf_bytes"] = std::to_string(total.shelf_bytes);
+					response.data["occupancy"] = occupancy(total.icon_bytes, total.page_bytes);
+					response.data["compactions"] = std::to_string(total.compactions);
+					break;
+				}
+
+				case IPC::CommandType::GET_FRAME_STATS:
+				{
+					response.success = true;
+
+					auto format_ms = [](uint64_t ns) {
+						char buf[32];
+						snprintf(buf, sizeof(buf), "%.3f", ns / 1e6);
+						return std::string(buf);
+					};
+
+					Output *output;
+					wl_list_for_each(output, &outputs, link)
+					{
+						const auto &stats = output->frame_stats;
+						response.data["output_" + std::string(output->wlr_output->name)] =
+							"frames=" + std::to_string(stats.frames) +
+							" render_ms=" + format_ms(stats.last_render_ns) +
+							" max_render_ms=" + format_ms(stats.max_render_ns) +
+							" allocations=" + std::to_string(stats.last_allocations) +
+							" allocated_bytes=" + std::to_string(stats.last_allocated_bytes) +
+							" pacing_delay_ms=" + format_ms(stats.last_delay_ns) +
+							" presented=" + std::to_string(stats.presented) +
+							" sw_cursor=" + (stats.software_cursor ? "yes" : "no") +
+							" sw_cursor_frames=" + std::to_string(stats.software_cursor_frames) +
+							" sw_cursor_fallbacks=" + std::to_string(stats.software_cursor_fallbacks);
+					}
+
+					auto arena = Core::FrameArena::Instance().GetStats();
+					response.data["arena_capacity"] = std::to_string(arena.capacity);
+					response.data["arena_high_water"] = std::to_string(arena.high_water);
+					response.data["arena_overflows"] = std::to_string(arena.overflows);
+					response.data["allocation_counting"] = Core::IsAllocationCountingEnabled() ? "true" : "false";
+					break;
+				}
+
+				case IPC::CommandType::GET_XWAYLAND:
+				{
+					response.success = true;
+
+					const auto &xwayland_config = Config().xwayland;
+					response.data["enabled"] = xwayland ? "true" : "false";
+					response.data["lazy"] = xwayland_config.lazy ? "true" : "false";
+					// Effective timeout: 0 when Xwayland can't take a -terminate delay
+					bool idle_exit = xwayland_config.lazy && xwayland_has_terminate_delay();
+					response.data["idle_timeout"] = std::to_string(idle_exit ? xwayland_config.idle_timeout : 0);
+					if (!xwayland)
+					{
+						break;
+					}
+
+					pid_t pid = xwayland_get_server_pid(xwayland);
+					response.data["display"] = xwayland_get_display_name(xwayland);
+					response.data["running"] = pid > 0 ? "true" : "false";
+					response.data["starts"] = std::to_string(xwayland_starts_);
+					response.data["startup_ms"] = std::to_string(xwayland_startup_time_.count());
+					if (pid > 0)
+					{
+						auto uptime = std::chrono::duration_cast<std::chrono::seconds>(
+								std::chrono::steady_clock::now() - xwayland_started_at_);
+						response.data["pid"] = std::to_string(pid);
+						response.data["uptime_s"] = std::to_string(uptime.count());
+						response.data["rss_kb"] = std::to_string(read_process_rss_kb(pid));
+					}
+					break;
+				}
+
+				case IPC::CommandType::GET_CLIENT_STATS:
+				{
+					response.success = true;
+
+					uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+							std::chrono::steady_clock::now().time_since_epoch()).count();
+					int xwayland_clients = 0;
+					for (const auto *client : GetAllClients())
+					{
+						const auto &stats = client->GetStats();
+						bool current = stats.RatesCurrent(now_ns);
+
+						IPC::ClientStatsInfo info;
+						info.id = client->GetId().ToU64();
+						info.app_id = client->GetAppId();
+						info.title = client->GetTitle();
+						info.xwayland = client->GetView() && client->GetView()->is_xwayland;
+						info.commits = stats.commits;
+						info.commit_rate = current ? stats.commit_rate : 0;
+						info.damage_rate = current ? stats.damage_rate : 0;
+						info.shm_bytes = stats.shm_bytes;
+						info.dmabuf_bytes = stats.dmabuf_bytes;
+						info.frame_latency_us = stats.frame_latency_ns / 1000;
+						info.max_frame_latency_us = stats.max_frame_latency_ns / 1000;
+						info.configure_rtt_us = stats.configure_rtt_ns / 1000;
+						info.max_configure_rtt_us = stats.max_configure_rtt_ns / 1000;
+						xwayland_clients += info.xwayland ? 1 : 0;
+
+						response.client_stats.push_back(info);
+					}
+					response.data["clients"] = std::to_string(response.client_stats.size());
+					response.data["xwayland_clients"] = std::to_string(xwayland_clients);
+					break;
+				}
+
+				case IPC::CommandType::GET_STATE_FD:
+				{
+					if (!state_publisher_ || state_publisher_->GetFd() < 0)
+					{
+						response.success = false;
+						response.error = "State snapshot not available";
+						break;
+					}
+					response.success = true;
+					response.fd = state_publisher_->GetFd();
+					response.data["size"] = std::to_string(state_publisher_->GetSize());
+					response.data["version"] = std::to_string(LEVIATHAN_STATE_VERSION);
+					response.data["sequence"] = std::to_string(state_publisher_->GetSequence());
+					break;
+				}
+
 				case IPC::CommandType::SET_ACTIVE_TAG:
 				{
 					if (!j.contains("args") || !j["args"].contains("tag"))
@@ -1854,11 +2748,12 @@ namespace Leviathan
 		}
 
 		// CompositorState interface implementation
-		std::vector<Core::Screen *> Server::GetScreens() const
+		const std::vector<Core::Screen *> &Server::GetScreens() const
 		{
+			static const std::vector<Core::Screen *> no_screens;
 			if (!core_seat_)
 			{
-				return {};
+				return no_screens;
 			}
 			return core_seat_->GetScreens();
 		}
@@ -2041,16 +2936,17 @@ namespace Leviathan
 			Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "Cannot switch tag: LayerManager not found for focused screen");
 		}
 
-		std::vector<Core::Client *> Server::GetAllClients() const
+		const std::vector<Core::Client *> &Server::GetAllClients() const
 		{
-			return clients_;
+			return client_store_.GetClients();
 		}
 
-		std::vector<Core::Client *> Server::GetClientsOnTag(Core::Tag *tag) const
+		const std::vector<Core::Client *> &Server::GetClientsOnTag(Core::Tag *tag) const
 		{
+			static const std::vector<Core::Client *> no_clients;
 			if (!tag)
 			{
-				return {};
+				return no_clients;
 			}
 			return tag->GetClients();
 		}
@@ -2085,6 +2981,24 @@ namespace Leviathan
 			return &UI::MenuBarManager::Instance();
 		}
 
+		void Server::SetCursorShape(const char *name)
+		{
+			// Pointer motion calls this constantly; re-setting the same image would
+			// re-upload it to every output's cursor plane
+			if (!cursor_mgr || cursor_shape_ == name)
+			{
+				return;
+			}
+			cursor_shape_ = name;
+			wlr_cursor_set_xcursor(cursor, cursor_mgr, name);
+		}
+
+		void Server::SetCursorSurface(struct wlr_surface *surface, int32_t hotspot_x, int32_t hotspot_y)
+		{
+			cursor_shape_.clear();
+			wlr_cursor_set_surface(cursor, surface, hotspot_x, hotspot_y);
+		}
+
 		Output *Server::GetFirstOutput()
 		{
 			if (wl_list_empty(&outputs))
@@ -0,0 +1,265 @@
+#include "wayland/StatePublisher.hpp"
+#include "wayland/Server.hpp"
+#include "wayland/LayerManager.hpp"
+#include "wayland/View.hpp"
+#include "core/Client.hpp"
+#include "core/ClientStore.hpp"
+#include "core/Events.hpp"
+#include "core/Screen.hpp"
+#include "core/Tag.hpp"
+#include "ipc/IPC.hpp"
+#include "ipc/StateSnapshot.h"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef F_SEAL_FUTURE_WRITE
+#define F_SEAL_FUTURE_WRITE 0x0010  // Linux 5.1
+#endif
+
+namespace Leviathan {
+namespace Wayland {
+
+namespace {
+
+static_assert(static_cast<int>(LayoutType::MASTER_STACK) == LEVIATHAN_LAYOUT_MASTER_STACK &&
+              static_cast<int>(LayoutType::MONOCLE) == LEVIATHAN_LAYOUT_MONOCLE &&
+              static_cast<int>(LayoutType::FLOATING) == LEVIATHAN_LAYOUT_FLOATING &&
+              static_cast<int>(LayoutType::GRID) == LEVIATHAN_LAYOUT_GRID,
+              "leviathan_state_layout must follow LayoutType");
+
+static_assert(Core::CLIENT_MAPPED == LEVIATHAN_CLIENT_MAPPED &&
+              Core::CLIENT_FLOATING == LEVIATHAN_CLIENT_FLOATING &&
+              Core::CLIENT_FULLSCREEN == LEVIATHAN_CLIENT_FULLSCREEN &&
+              Core::CLIENT_VISIBLE == LEVIATHAN_CLIENT_VISIBLE &&
+              Core::CLIENT_FOCUSED == LEVIATHAN_CLIENT_FOCUSED &&
+              Core::CLIENT_SUSPENDED == LEVIATHAN_CLIENT_SUSPENDED,
+              "LEVIATHAN_CLIENT_* must follow ClientFlag");
+
+// Copy and NUL-terminate, cutting at the field size
+template<size_t N>
+void CopyString(char (&dest)[N], const std::string& src) {
+    size_t length = std::min(src.size(), N - 1);
+    memcpy(dest, src.data(), length);
+    memset(dest + length, 0, N - length);
+}
+
+uint64_t NowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+} // namespace
+
+StatePublisher::StatePublisher(Server* server, struct wl_event_loop* event_loop, IPC::Server* ipc_server)
+    : server_(server), event_loop_(event_loop), ipc_server_(ipc_server) {
+    if (!CreateMemfd()) {
+        return;
+    }
+    
+    // Everything that changes tags, focus or client lists goes through the bus
+    auto& bus = Core::EventBus::Instance();
+    subscriptions_.push_back(bus.Subscribe<Core::TagSwitchedEvent>([this](const auto&) { MarkDirty(); }));
+    subscriptions_.push_back(bus.Subscribe<Core::TagVisibilityChangedEvent>([this](const auto&) { MarkDirty(); }));
+    subscriptions_.push_back(bus.Subscribe<Core::ClientAddedEvent>([this](const auto&) { MarkDirty(); }));
+    subscriptions_.push_back(bus.Subscribe<Core::ClientRemovedEvent>([this](const auto&) { MarkDirty(); }));
+    subscriptions_.push_back(bus.Subscribe<Core::ClientTagChangedEvent>([this](const auto&) { MarkDirty(); }));
+    subscriptions_.push_back(bus.Subscribe<Core::ClientFocusedEvent>([this](const auto&) { MarkDirty(); }));
+    subscriptions_.push_back(bus.Subscribe<Core::LayoutChangedEvent>([this](const auto&) { MarkDirty(); }));
+    
+    MarkDirty();
+}
+
+StatePublisher::~StatePublisher() {
+    for (int id : subscriptions_) {
+        Core::EventBus::Instance().Unsubscribe(id);
+    }
+    if (idle_) {
+        wl_event_source_remove(idle_);
+    }
+    if (state_) {
+        munmap(state_, sizeof(leviathan_state));
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool StatePublisher::CreateMemfd() {
+    int fd = memfd_create("leviathan-state", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "State snapshot disabled: memfd_create failed: {}", strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, sizeof(leviathan_state)) < 0) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "State snapshot disabled: ftruncate failed: {}", strerror(errno));
+        close(fd);
+        return false;
+    }
+    
+    void* map = mmap(nullptr, sizeof(leviathan_state), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "State snapshot disabled: mmap failed: {}", strerror(errno));
+        close(fd);
+        return false;
+    }
+    
+    // Our mapping stays writable; readers can neither resize the file nor
+    // map it writable. Kernels before 5.1 lack FUTURE_WRITE
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_FUTURE_WRITE | F_SEAL_SEAL) < 0) {
+        Leviathan::Log::WriteToLog(Leviathan::LogLevel::WARN, "State snapshot: write seal unsupported ({}), readers could modify it",
+                                   strerror(errno));
+        fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+    }
+    
+    fd_ = fd;
+    state_ = static_cast<leviathan_state*>(map);
+    state_->magic = LEVIATHAN_STATE_MAGIC;
+    state_->version = LEVIATHAN_STATE_VERSION;
+    state_->size = sizeof(leviathan_state);
+    state_->focused_output = -1;
+    return true;
+}
+
+size_t StatePublisher::GetSize() const {
+    return sizeof(leviathan_state);
+}
+
+uint32_t StatePublisher::GetSequence() const {
+    return state_ ? __atomic_load_n(&state_->sequence, __ATOMIC_RELAXED) : 0;
+}
+
+void StatePublisher::MarkDirty() {
+    if (state_ && !idle_) {
+        idle_ = wl_event_loop_add_idle(event_loop_, HandleIdle, this);
+    }
+}
+
+void StatePublisher::CheckForChanges() {
+    if (server_->GetClientStore().GetColumns().revision != published_revision_) {
+        MarkDirty();
+    }
+}
+
+void StatePublisher::HandleIdle(void* data) {
+    auto* publisher = static_cast<StatePublisher*>(data);
+    publisher->idle_ = nullptr;
+    publisher->Publish();
+}
+
+void StatePublisher::Publish() {
+    published_revision_ = server_->GetClientStore().GetColumns().revision;
+    
+    // Seqlock write: odd while the entries change. The release fence keeps
+    // the odd sequence ahead of the entry stores, the release store keeps
+    // them ahead of the even one
+    uint32_t sequence = __atomic_load_n(&state_->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&state_->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    Fill(state_);
+    __atomic_store_n(&state_->sequence, sequence + 2, __ATOMIC_RELEASE);
+    
+    if (ipc_server_ && ipc_server_->HasEventSubscribers()) {
+        IPC::EventMessage event;
+        event.type = IPC::EventType::STATE_CHANGED;
+        event.data["sequence"] = std::to_string(sequence + 2);
+        ipc_server_->BroadcastEvent(event);
+    }
+}
+
+void StatePublisher::Fill(leviathan_state* state) {
+    uint32_t truncated = 0;
+    uint32_t output_count = 0;
+    uint32_t tag_count = 0;
+    state->focused_output = -1;
+    
+    Core::Screen* focused_screen = server_->GetFocusedScreen();
+    for (auto* screen : server_->GetScreens()) {
+        LayerManager* layer_manager = server_->GetLayerManagerForScreen(screen);
+        if (!layer_manager) {
+            continue;
+        }
+        if (output_count == LEVIATHAN_STATE_MAX_OUTPUTS) {
+            truncated = 1;
+            break;
+        }
+        
+        auto tags = layer_manager->GetTags();
+        int current = layer_manager->GetCurrentTagIndex();
+        auto& out = state->outputs[output_count++];
+        CopyString(out.name, screen->GetName());
+        out.id = layer_manager->GetIndex();
+        out.x = screen->GetX();
+        out.y = screen->GetY();
+        out.width = screen->GetWidth();
+        out.height = screen->GetHeight();
+        out.refresh_mhz = screen->GetWlrOutput() ? screen->GetWlrOutput()->refresh : 0;
+        out.current_tag = current >= 0 && current < static_cast<int>(tags.size()) ? current : -1;
+        out.layout = out.current_tag >= 0 ? static_cast<uint32_t>(tags[current]->GetLayout()) : 0;
+        out.scale = screen->GetScale();
+        out.enabled = screen->GetWlrOutput() && screen->GetWlrOutput()->enabled;
+        if (screen == focused_screen) {
+            state->focused_output = out.id;
+        }
+        
+        for (auto* tag : tags) {
+            if (tag_count == LEVIATHAN_STATE_MAX_TAGS) {
+                truncated = 1;
+                break;
+            }
+            auto& entry = state->tags[tag_count++];
+            CopyString(entry.name, tag->GetName());
+            entry.output_id = out.id;
+            entry.index = tag->GetIndex();
+            entry.client_count = static_cast<uint32_t>(tag->GetClients().size());
+            entry.layout = static_cast<uint32_t>(tag->GetLayout());
+            entry.visible = tag->IsVisible();
+            entry.reserved = 0;
+        }
+    }
+    
+    uint32_t client_count = 0;
+    for (auto* client : server_->GetAllClients()) {
+        if (client_count == LEVIATHAN_STATE_MAX_CLIENTS) {
+            truncated = 1;
+            break;
+        }
+        auto* view = client->GetView();
+        uint32_t flags = client->IsMapped() ? LEVIATHAN_CLIENT_MAPPED : 0;
+        flags |= client->IsFloating() ? LEVIATHAN_CLIENT_FLOATING : 0;
+        flags |= client->IsFullscreen() ? LEVIATHAN_CLIENT_FULLSCREEN : 0;
+        flags |= client->IsVisible() ? LEVIATHAN_CLIENT_VISIBLE : 0;
+        flags |= client->IsFocused() ? LEVIATHAN_CLIENT_FOCUSED : 0;
+        flags |= client->IsSuspended() ? LEVIATHAN_CLIENT_SUSPENDED : 0;
+        flags |= view && view->is_xwayland ? LEVIATHAN_CLIENT_XWAYLAND : 0;
+        
+        auto& entry = state->clients[client_count++];
+        entry.id = client->GetId().ToU64();
+        entry.x = client->GetX();
+        entry.y = client->GetY();
+        entry.width = client->GetWidth();
+        entry.height = client->GetHeight();
+        entry.flags = flags;
+        entry.output_id = client->GetOutputIndex();
+        entry.tag_index = client->GetTagIndex();
+        entry.reserved = 0;
+        CopyString(entry.app_id, client->GetAppId());
+        CopyString(entry.title, client->GetTitle());
+    }
+    
+    View* focused = server_->GetFocusedView();
+    state->focused_client = focused && focused->client ? focused->client->GetId().ToU64() : 0;
+    state->output_count = output_count;
+    state->tag_count = tag_count;
+    state->client_count = client_count;
+    state->truncated = truncated;
+    state->published_ns = NowNs();
+}
+
+} // namespace Wayland
+} // namespace Leviathan
@@ -5,6 +5,7 @@
 #include "wayland/Server.hpp"
 #include "config/ConfigParser.hpp"
 #include "wayland/WaylandTypes.hpp"
+#include "core/Client.hpp"
 #include <algorithm>
 #include <cstdlib>
 
@@ -15,6 +16,7 @@ namespace Wayland {
 static void view_handle_associate(struct wl_listener* listener, void* data);
 static void view_handle_surface_destroy(struct wl_listener* listener, void* data);
 static void view_handle_commit(struct wl_listener* listener, void* data);
+static void view_handle_client_commit(struct wl_listener* listener, void* data);
 static void view_handle_map(struct wl_listener* listener, void* data);
 static void view_handle_unmap(struct wl_listener* listener, void* data);
 static void view_handle_destroy(struct wl_listener* listener, void* data);
@@ -22,6 +24,18 @@ static void view_handle_request_move(struct wl_listener* listener, void* data);
 static void view_handle_request_resize(struct wl_listener* listener, void* data);
 static void view_handle_request_maximize(struct wl_listener* listener, void* data);
 static void view_handle_request_fullscreen(struct wl_listener* listener, void* data);
+static void view_handle_configure(struct wl_listener* listener, void* data);
+static void view_handle_ack_configure(struct wl_listener* listener, void* data);
+
+namespace {
+
+uint64_t NowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+} // namespace
 
 View::View(struct wlr_xdg_toplevel* toplevel, Server* srv)
     : xdg_toplevel(toplevel)
@@ -39,11 +53,7 @@ View::View(struct wlr_xdg_toplevel* toplevel, Server* srv)
     , shadow_right(nullptr)
     , shadow_bottom(nullptr)
     , shadow_left(nullptr)
-    , x(0), y(0)
-    , width(0), height(0)
-    , is_floating(false)
-    , is_fullscreen(false)
-    , mapped(false)
+    , client(nullptr)
     , opacity(1.0f)
     , border_radius(0) {
     
@@ -51,6 +61,9 @@ View::View(struct wlr_xdg_toplevel* toplevel, Server* srv)
     commit.notify = view_handle_commit;
     wl_signal_add(&xdg_toplevel->base->surface->events.commit, &commit);
     
+    client_commit.notify = view_handle_client_commit;
+    wl_signal_add(&xdg_toplevel->base->surface->events.client_commit, &client_commit);
+    
     // Setup listeners
     map.notify = view_handle_map;
     wl_signal_add(&xdg_toplevel->base->surface->events.map, &map);
@@ -72,6 +85,12 @@ View::View(struct wlr_xdg_toplevel* toplevel, Server* srv)
     
     request_fullscreen.notify = view_handle_request_fullscreen;
     wl_signal_add(&xdg_toplevel->events.request_fullscreen, &request_fullscreen);
+    
+    configure.notify = view_handle_configure;
+    wl_signal_add(&xdg_toplevel->base->events.configure, &configure);
+    
+    ack_configure.notify = view_handle_ack_configure;
+    wl_signal_add(&xdg_toplevel->base->events.ack_configure, &ack_configure);
 }
 
 // Xwayland constructor
@@ -91,11 +110,7 @@ View::View(struct ::wlr_xwayland_surface* xwayland_surf, Server* srv)
     , shadow_right(nullptr)
     , shadow_bottom(nullptr)
     , shadow_left(nullptr)
-    , x(xwayland_surface_get_x(xwayland_surf)), y(xwayland_surface_get_y(xwayland_surf))
-    , width(xwayland_surface_get_width(xwayland_surf)), height(xwayland_surface_get_height(xwayland_surf))
-    , is_floating(false)
-    , is_fullscreen(false)
-    , mapped(false)
+    , client(nullptr)
     , opacity(1.0f)
     , border_radius(0) {
     
@@ -173,6 +188,10 @@ View::~View() {
     if (is_xwayland) {
         wl_list_remove(&associate.link);
         wl_list_remove(&surface_destroy.link);
+    } else {
+        wl_list_remove(&configure.link);
+        wl_list_remove(&ack_configure.link);
+        wl_list_remove(&client_commit.link);
     }
 }
 
@@ -244,9 +263,65 @@ void view_handle_associate(struct wl_listener* listener, void* data) {
     }
 }
 
+// Count the commit as SHM or DMA-BUF if it attached a buffer, and how big
+// the buffer is
+static void view_record_buffer_commit(View* view) {
+    if (!view->client || !view->surface || !(view->surface->current.committed & WLR_SURFACE_STATE_BUFFER)) {
+        return;
+    }
+    
+    struct wlr_buffer* buffer = view->surface->current.buffer;
+    if (!buffer && view->surface->buffer) {
+        buffer = view->surface->buffer->source;
+    }
+    if (!buffer) {
+        view->client->RecordBuffer(0, 0);
+        return;  // NULL attach, or the client already released it
+    }
+    
+    struct wlr_dmabuf_attributes dmabuf;
+    struct wlr_shm_attributes shm;
+    if (wlr_buffer_get_dmabuf(buffer, &dmabuf)) {
+        // Planes may be subsampled, but stride x height bounds each of them
+        uint64_t bytes = 0;
+        for (int i = 0; i < dmabuf.n_planes; i++) {
+            bytes += static_cast<uint64_t>(dmabuf.stride[i]) * dmabuf.height;
+        }
+        view->client->RecordBuffer(0, bytes);
+    } else if (wlr_buffer_get_shm(buffer, &shm)) {
+        view->client->RecordBuffer(static_cast<uint64_t>(shm.stride) * shm.height, 0);
+    }
+}
+
+// Buffer pixels the commit damaged; walks pixman's rectangles in place
+static uint64_t view_damage_pixels(View* view) {
+    int count = 0;
+    const pixman_box32_t* rects = pixman_region32_rectangles(&view->surface->buffer_damage, &count);
+    uint64_t pixels = 0;
+    for (int i = 0; i < count; i++) {
+        pixels += static_cast<uint64_t>(rects[i].x2 - rects[i].x1) * static_cast<uint64_t>(rects[i].y2 - rects[i].y1);
+    }
+    return pixels;
+}
+
+static void view_handle_client_commit(struct wl_listener* listener, void* data) {
+    View* view = wl_container_of(listener, view, client_commit);
+    if (view->server && view->server->GetFrameGovernor()) {
+        view->server->GetFrameGovernor()->HoldCommit(view->client);
+    }
+}
+
 static void view_handle_commit(struct wl_listener* listener, void* data) {
     View* view = wl_container_of(listener, view, commit);
     
+    view_record_buffer_commit(view);
+    if (view->client && view->surface) {
+        view->client->RecordCommit(NowNs(), view_damage_pixels(view));
+    }
+    if (view->server && view->server->GetFrameGovernor()) {
+        view->server->GetFrameGovernor()->RecordCommit(view->client);
+    }
+    
     // XWayland surfaces don't use XDG shell protocol, so skip XDG-specific handling
     if (view->is_xwayland) {
         // X11 windows don't need configure events - they manage their own size
@@ -257,13 +332,12 @@ static void view_handle_commit(struct wl_listener* listener, void* data) {
             
             // Only update if the surface size has actually changed
             if (surface_width > 0 && surface_height > 0 &&
-                (surface_width != view->width || surface_height != view->height)) {
+                (surface_width != view->GetWidth() || surface_height != view->GetHeight())) {
                 Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "X11 surface size changed from {}x{} to {}x{}, updating borders",
-                             view->width, view->height, surface_width, surface_height);
+                             view->GetWidth(), view->GetHeight(), surface_width, surface_height);
                 
                 // Update view dimensions to match surface
-                view->width = surface_width;
-                view->height = surface_height;
+                view->StoreSize(surface_width, surface_height);
             }
         }
         return;
@@ -318,13 +392,12 @@ static void view_handle_commit(struct wl_listener* listener, void* data) {
             
             // Only update if the surface size has actually changed
             if (surface_width > 0 && surface_height > 0 &&
-                (surface_width != view->width || surface_height != view->height)) {
+                (surface_width != view->GetWidth() || surface_height != view->GetHeight())) {
                 Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Surface size changed from {}x{} to {}x{}, updating borders",
-                             view->width, view->height, surface_width, surface_height);
+                             view->GetWidth(), view->GetHeight(), surface_width, surface_height);
                 
                 // Update view dimensions to match surface
-                view->width = surface_width;
-                view->height = surface_height;
+                view->StoreSize(surface_width, surface_height);
                 
                 // Note: Border updates are now handled by window decoration system
             }
@@ -334,7 +407,7 @@ static void view_handle_commit(struct wl_listener* listener, void* data) {
 
 static void view_handle_map(struct wl_listener* listener, void* data) {
     View* view = wl_container_of(listener, view, map);
-    view->mapped = true;
+    view->SetMapped(true);
     
     std::string app_id;
     std::string title;
@@ -381,7 +454,7 @@ static void view_handle_map(struct wl_listener* listener, void* data) {
     
     // Apply window decorations based on rules (works for both XDG and X11)
     const auto* rule = Leviathan::Config().window_rules.FindMatch(
-        app_id, title, "", view->is_floating
+        app_id, title, "", view->IsFloating()
     );
     
     if (rule) {
@@ -402,14 +475,18 @@ static void view_handle_map(struct wl_listener* listener, void* data) {
         }
         
         // Apply other rule actions
-        if (rule->force_floating && !view->is_floating) {
-            view->is_floating = true;
+        if (rule->force_floating && !view->IsFloating()) {
+            view->SetFloating(true);
             Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Forced window '{}' to float", app_id);
         }
-        if (rule->force_tiled && view->is_floating) {
-            view->is_floating = false;
+        if (rule->force_tiled && view->IsFloating()) {
+            view->SetFloating(false);
             Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Forced window '{}' to tile", app_id);
         }
+        if (rule->max_fps.has_value() && view->client) {
+            view->client->GetGovernorState().rule_cap = rule->max_fps.value();
+            Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "Frame cap for '{}': {} fps", app_id, rule->max_fps.value());
+        }
         if (rule->opacity_override.has_value()) {
             float opacity = rule->opacity_override.value() / 100.0f;
             view->SetOpacity(opacity);
@@ -453,7 +530,7 @@ static void view_handle_map(struct wl_listener* listener, void* data) {
 
 static void view_handle_unmap(struct wl_listener* listener, void* data) {
     View* view = wl_container_of(listener, view, unmap);
-    view->mapped = false;
+    view->SetMapped(false);
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::INFO, "View unmapped! view={}", static_cast<void*>(view));
     
     // Trigger auto-tiling to reorganize remaining views
@@ -472,6 +549,19 @@ static void view_handle_unmap(struct wl_listener* listener, void* data) {
 static void view_handle_destroy(struct wl_listener* listener, void* data) {
     View* view = wl_container_of(listener, view, destroy);
     
+    // Commits the frame governor held back apply now, before the wl_surface
+    // (which can outlive the toplevel) is left locked. With the commit
+    // listeners gone they no longer reach this view or hold anything again
+    if (!view->is_xwayland) {
+        wl_list_remove(&view->commit.link);
+        wl_list_remove(&view->client_commit.link);
+        wl_list_init(&view->commit.link);
+        wl_list_init(&view->client_commit.link);
+        if (view->server && view->server->GetFrameGovernor()) {
+            view->server->GetFrameGovernor()->ReleaseClient(view->client);
+        }
+    }
+    
     // Do cleanup BEFORE deleting the view
     if (view->server) {
         view->server->RemoveView(view);
@@ -504,8 +594,27 @@ static void view_handle_request_fullscreen(struct wl_listener* listener, void* d
     
     struct wlr_xdg_toplevel* toplevel = static_cast<struct wlr_xdg_toplevel*>(data);
     
-    view->is_fullscreen = toplevel->requested.fullscreen;
+    view->SetFullscreen(toplevel->requested.fullscreen);
     wlr_xdg_toplevel_set_fullscreen(view->xdg_toplevel, toplevel->requested.fullscreen);
+    if (view->server) {
+        view->server->ScheduleVisibilityUpdate();
+    }
+}
+
+static void view_handle_configure(struct wl_listener* listener, void* data) {
+    View* view = wl_container_of(listener, view, configure);
+    auto* event = static_cast<struct wlr_xdg_surface_configure*>(data);
+    if (view->client) {
+        view->client->RecordConfigure(event->serial, NowNs());
+    }
+}
+
+static void view_handle_ack_configure(struct wl_listener* listener, void* data) {
+    View* view = wl_container_of(listener, view, ack_configure);
+    auto* event = static_cast<struct wlr_xdg_surface_configure*>(data);
+    if (view->client) {
+        view->client->RecordAckConfigure(event->serial, NowNs());
+    }
 }
 
 void ViewManager::HandleNewXdgSurface(struct wl_listener* listener, void* data) {
@@ -540,6 +649,64 @@ void ViewManager::HandleRequestFullscreen(struct wl_listener* listener, void* da
     view_handle_request_fullscreen(listener, data);
 }
 
+int View::GetX() const {
+    return client ? client->GetX() : 0;
+}
+
+int View::GetY() const {
+    return client ? client->GetY() : 0;
+}
+
+int View::GetWidth() const {
+    return client ? client->GetWidth() : 0;
+}
+
+int View::GetHeight() const {
+    return client ? client->GetHeight() : 0;
+}
+
+bool View::IsMapped() const {
+    return client && client->IsMapped();
+}
+
+bool View::IsFloating() const {
+    return client && client->IsFloating();
+}
+
+bool View::IsFullscreen() const {
+    return client && client->IsFullscreen();
+}
+
+void View::SetMapped(bool is_mapped) {
+    if (client) {
+        client->SetMapped(is_mapped);
+    }
+}
+
+void View::SetFloating(bool floating) {
+    if (client) {
+        client->SetFloating(floating);
+    }
+}
+
+void View::SetFullscreen(bool fullscreen) {
+    if (client) {
+        client->StoreFullscreen(fullscreen);
+    }
+}
+
+void View::StoreSize(int new_width, int new_height) {
+    if (client) {
+        client->StoreSize(new_width, new_height);
+    }
+}
+
+void View::StoreGeometry(int new_x, int new_y, int new_width, int new_height) {
+    if (client) {
+        client->StoreGeometry(new_x, new_y, new_width, new_height);
+    }
+}
+
 void View::CreateBorders(int border_width, const float color[4]) {
     if (!scene_tree || border_width <= 0) {
         return;
@@ -548,6 +715,9 @@ void View::CreateBorders(int border_width, const float color[4]) {
     // Destroy existing borders first
     DestroyBorders();
     
+    const int width = GetWidth();
+    const int height = GetHeight();
+    
     Leviathan::Log::WriteToLog(Leviathan::LogLevel::DEBUG, "CreateBorders: view={}, width={}, height={}, border_width={}", 
                   static_cast<void*>(this), width, height, border_width);
     
@@ -597,6 +767,9 @@ void View::UpdateBorderSize(int border_width) {
         return;
     }
     
+    const int width = GetWidth();
+    const int height = GetHeight();
+    
     if (border_top) {
         wlr_scene_rect_set_size(border_top, width + 2 * border_width, border_width);
         wlr_scene_node_set_position(&border_top->node, -border_width, -border_width);
@@ -677,6 +850,9 @@ void View::CreateShadows(int shadow_size, const float color[4], float shadow_opa
     // Destroy existing shadows first
     DestroyShadows();
     
+    const int width = GetWidth();
+    const int height = GetHeight();
+    
     // Create shadow color with opacity
     float shadow_color[4] = {
         color[0],
@@ -6,6 +6,7 @@
 
 #define WLR_USE_UNSTABLE
 #include <wlr/xwayland/xwayland.h>
+#include <wlr/xwayland/server.h>
 #include <wlr/types/wlr_compositor.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -114,3 +115,44 @@ struct wl_signal* xwayland_get_new_surface_signal(struct wlr_xwayland* xwayland)
     if (!xwayland) return NULL;
     return &xwayland->events.new_surface;
 }
+
+struct wl_signal* xwayland_get_server_start_signal(struct wlr_xwayland* xwayland) {
+    if (!xwayland || !xwayland->server) return NULL;
+    return &xwayland->server->events.start;
+}
+
+pid_t xwayland_get_server_pid(struct wlr_xwayland* xwayland) {
+    if (!xwayland || !xwayland->server) return 0;
+    return xwayland->server->pid;
+}
+
+bool xwayland_has_terminate_delay(void) {
+#ifdef HAVE_XWAYLAND_TERMINATE_DELAY
+    return true;
+#else
+    return false;
+#endif
+}
+
+struct wlr_xwayland* xwayland_create_with_options(struct wl_display* display, struct wlr_compositor* compositor,
+                                                  bool lazy, int terminate_delay) {
+    /* Same as wlr_xwayland_create(), but with our own idle timeout. A lazy
+     * server that exits after terminate_delay is re-armed by wlroots and
+     * respawned on the next X11 connection. Xwayland builds without delay
+     * support refuse "-terminate N", so they get none. */
+    struct wlr_xwayland_server_options options = {
+        .lazy = lazy,
+        .enable_wm = true,
+        .terminate_delay = lazy && xwayland_has_terminate_delay() ? terminate_delay : 0,
+    };
+    struct wlr_xwayland_server* server = wlr_xwayland_server_create(display, &options);
+    if (!server) return NULL;
+
+    /* The server goes away with the display, and takes the wlr_xwayland with it */
+    struct wlr_xwayland* xwayland = wlr_xwayland_create_with_server(display, compositor, server);
+    if (!xwayland) {
+        wlr_xwayland_server_destroy(server);
+        return NULL;
+    }
+    return xwayland;
+}